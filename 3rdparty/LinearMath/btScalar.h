@@ -213,7 +213,9 @@ inline int btIsDoublePrecision()
 		#else//USE_LIBSPE2
 	//non-windows systems
 
-			#if (defined (__APPLE__) && (!defined (BT_USE_DOUBLE_PRECISION)))
+			//Stonefish: SSE is also enabled on Linux x86 in single precision, where glibc malloc and C++17 aligned new
+			//return 16-byte aligned memory (define __BT_DISABLE_SSE__ to fall back to the scalar code)
+			#if ((defined (__APPLE__) || (defined (__linux__) && defined (__SSE2__) && !defined (__BT_DISABLE_SSE__))) && (!defined (BT_USE_DOUBLE_PRECISION)))
 				#if defined (__i386__) || defined (__x86_64__)
 					#define BT_USE_SIMD_VECTOR3
 					#define BT_USE_SSE
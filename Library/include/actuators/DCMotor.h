@@ -59,6 +59,12 @@ namespace sf
          */
         void SetupGearbox(bool enable, Scalar ratio, Scalar efficiency);
         
+        //! A method to enable solving the motor electrics together with the joint velocity.
+        /*!
+         \param enable a flag to indicate if the implicit coupling should be used
+         */
+        void setImplicitCoupling(bool enable);
+        
         //! A method to set the voltage driving the motor.
         /*!
          \param volt the voltage at the motor terminals [V]
@@ -95,7 +101,12 @@ namespace sf
         //! A method returning the ratio of the motor gearbox.
         Scalar getGearRatio() const;
         
+        //! A method informing if the motor electrics are solved together with the joint velocity.
+        bool isImplicitCoupling() const;
+        
     private:
+        Scalar getJointInertia() const;
+        
         Scalar V;
         Scalar I;
         Scalar R;
@@ -106,7 +117,8 @@ namespace sf
         bool gearEnabled;
         Scalar gearRatio;
         Scalar gearEff;
-        Scalar lastVoverL;
+        bool implicit;
+        bool stepped;
     };
 }
 
@@ -85,6 +85,12 @@ namespace sf
          */
         void AttachToSolid(SolidEntity* body, const Transform& origin);
         
+        //! A method used to move the device when the simulation world is re-centred (only affects devices attached to the world).
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
+        
         //! A method which updates the pose of the light
         /*!
          \param dt a time step of the simulation
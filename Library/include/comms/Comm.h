@@ -102,6 +102,12 @@ namespace sf
          */
         void AttachToSolid(MovingEntity* body, const Transform& origin);
         
+        //! A method used to move the device when the simulation world is re-centred (only affects devices attached to the world).
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
+        
         //! A method implementing the rendering of the comm device.
         virtual std::vector<Renderable> Render();
         
@@ -84,8 +84,7 @@ namespace sf
         std::map<uint64_t, BeaconInfo> beacons;
         bool noise;
         
-        static std::random_device randomDevice;
-        static std::mt19937 randomGenerator;
+        std::mt19937 randomGenerator;
     };
 }
     
@@ -63,6 +63,7 @@ namespace sf
     protected:
         void Init();
         void LoopInternal();
+        void CleanUp();
         
     private:
         SDL_Thread* simulationThread;
@@ -43,7 +43,7 @@ namespace sf
          \param lon the longitude of the NED origin [deg]
          \param height the height above the ground [m]
          */
-        void Init(const Scalar lat, const Scalar lon, const Scalar height);
+        void Init(const double lat, const double lon, const double height);
         
         //! A method transforming the geodetic coordinates to ECEF.
         /*!
@@ -118,24 +118,30 @@ namespace sf
                           Scalar& lat, Scalar& lon, Scalar& height) const;
         
     private:
-        Scalar _init_lat;
-        Scalar _init_lon;
-        Scalar _init_h;
-        Scalar _init_ecef_x;
-        Scalar _init_ecef_y;
-        Scalar _init_ecef_z;
-        Matrix3 _ecef_to_ned_matrix;
-        Matrix3 _ned_to_ecef_matrix;
+        //Internal state is kept in double precision, also in single precision builds,
+        //because ECEF coordinates are of the order of 1e6 m.
+        double _init_lat;
+        double _init_lon;
+        double _init_h;
+        double _init_ecef_x;
+        double _init_ecef_y;
+        double _init_ecef_z;
+        double _ecef_to_ned_matrix[3][3];
+        double _ned_to_ecef_matrix[3][3];
         
-        Scalar __cbrt__(const Scalar x) const;
-        Matrix3 __nRe__(const Scalar lat_rad, const Scalar lon_rad) const;
+        void Geodetic2EcefD(double lat, double lon, double height, double& x, double& y, double& z) const;
+        void Ecef2GeodeticD(double x, double y, double z, double& lat, double& lon, double& height) const;
+        void Ecef2NedD(double x, double y, double z, double& north, double& east, double& depth) const;
+        void Ned2EcefD(double north, double east, double depth, double& x, double& y, double& z) const;
+        double __cbrt__(const double x) const;
+        void __nRe__(const double lat_rad, const double lon_rad, double m[3][3]) const;
         
         //World Geodetic System 1984 (WGS84)
-        static const Scalar a;
-        static const Scalar b;
-        static const Scalar esq;
-        static const Scalar e1sq;
-        static const Scalar f;
+        static const double a;
+        static const double b;
+        static const double esq;
+        static const double e1sq;
+        static const double f;
     };
 }
 
@@ -26,6 +26,8 @@
 #ifndef __Stonefish_NameManager__
 #define __Stonefish_NameManager__
 
+#include <unordered_set>
+#include <unordered_map>
 #include "StonefishCommon.h"
 
 namespace sf
@@ -47,6 +49,21 @@ namespace sf
          */
         std::string AddName(std::string proposedName);
         
+        //! A method used to reserve space for a number of new names (speeds up bulk creation of objects).
+        /*!
+         \param count the number of names that will be added
+         */
+        void Reserve(size_t count);
+        
+        //! A method used to register a number of names derived from the same proposed name in one pass.
+        /*!
+         The returned names are handed over unchanged when the objects are created with them.
+         \param proposedName a name proposed by the user
+         \param count the number of names to register
+         \return a list of unique names
+         */
+        std::vector<std::string> ReserveNames(const std::string& proposedName, size_t count);
+        
         //! A method used to remove names from the pool.
         /*!
          \param name a name to remove
@@ -57,7 +74,11 @@ namespace sf
         void ClearNames();
         
     private:
-        std::vector<std::string> names;
+        std::string UniqueName(const std::string& proposedName);
+        
+        std::unordered_set<std::string> names;
+        std::unordered_set<std::string> reserved; //Names registered in advance, not yet claimed by objects
+        std::unordered_map<std::string, unsigned int> suffixes; //Next suffix to try for each proposed name
     };
 }
     
@@ -47,6 +47,7 @@ namespace sf
     class FixedJoint;
     struct Color;
     enum class ColorMap;
+    struct CameraOutputSettings;
   
     //! A class that implements parsing of XML files describing a simulation scenario.
     class ScenarioParser
@@ -58,6 +59,9 @@ namespace sf
          */
         ScenarioParser(SimulationManager* sm);
         
+        //! A destructor.
+        virtual ~ScenarioParser();
+        
         //! A method used to parse a scenario description file.
         /*!
          \param filename path to the scenario description file
@@ -65,6 +69,17 @@ namespace sf
          */
         virtual bool Parse(std::string filename);
 
+        //! A method used to apply the changes of a scenario description file to the live world, without restarting the scenario.
+        /*!
+         Static and dynamic bodies are added, removed or moved, materials and looks are created or updated in place.
+         All other resources are kept, graphical objects of the removed bodies are released by the rendering thread once they are no longer drawn.
+         Has to be called with the simulation stopped (the simulation settings are locked while the world is modified), from the thread owning the rendering context.
+         The file is validated before the world is modified, but a body or texture that fails to load afterwards leaves the world partially updated.
+         \param filename path to the scenario description file
+         \return success (false means that the scenario has to be restarted with SimulationManager::RestartScenario(), or stopped if it was running)
+         */
+        virtual bool HotReload(std::string filename);
+
         //! A method saving the log to a text file.
         /*!
          \param filename path to the log file
@@ -80,6 +95,13 @@ namespace sf
 
     protected:
         Console log;
+        
+        //! A method used to find and apply the changes of a scenario description file (called by HotReload with the simulation settings locked).
+        /*!
+         \param filename path to the scenario description file
+         \return success
+         */
+        virtual bool ApplyChanges(std::string filename);
 
         //! A method used to pre-process the xml description file after loading.
         /*!
@@ -111,6 +133,13 @@ namespace sf
          \return success
          */
         virtual bool IncludeFiles(XMLNode* node);
+        
+        //! A method that expands repeated (instanced) content of the processed file.
+        /*!
+         \param node a pointer to a node
+         \return success
+         */
+        virtual bool ExpandRepeats(XMLNode* node);
 
         //! A method used to parse solver configuration.
         /*!
@@ -133,6 +162,19 @@ namespace sf
          */
         virtual bool ParseMaterials(XMLElement* element);
         
+        //! A method used to parse a single physical material.
+        /*!
+         \param element a pointer to the XML node
+         \return success
+         */
+        virtual bool ParseMaterial(XMLElement* element);
+        
+        //! A method used to parse the table of friction coefficients between materials.
+        /*!
+         \param element a pointer to the XML node
+         */
+        virtual void ParseFrictionTable(XMLElement* element);
+        
         //! A method used to parse the graphical materials information.
         /*!
          \param element a pointer to the XML node
@@ -140,6 +182,14 @@ namespace sf
          */
         virtual bool ParseLooks(XMLElement* element);
         
+        //! A method used to parse a single graphical material.
+        /*!
+         \param element a pointer to the XML node
+         \param update a flag indicating if an existing look should be updated instead of creating a new one
+         \return success
+         */
+        virtual bool ParseLook(XMLElement* element, bool update = false);
+        
         //! A method used to parse a definition of a velocity field (current, wind).
         /*!
          \param element a pointer to the XML node
@@ -161,6 +211,13 @@ namespace sf
          */
         virtual bool ParseAnimated(XMLElement* element);
 
+        //! A method used to parse a swarm description.
+        /*!
+         \param element a pointer to the XML node
+         \return success
+         */
+        virtual bool ParseSwarm(XMLElement* element);
+
         //! A method used to parse a dynamic object description.
         /*!
          \param element a pointer to the XML node
@@ -284,15 +341,22 @@ namespace sf
         bool isGraphicalSim();
 
     private:
+        bool LoadDescription(const std::string& filename);
+        std::string PrintNode(const XMLNode* node, const char* skipChild = nullptr);
         bool CopyNode(XMLNode* destParent, const XMLNode* src);
         bool ParseVector(const char* components, Vector3& v);
         bool ParseTransform(XMLElement* element, Transform& T);
+        void SetTransform(XMLElement* element, const Transform& T);
+        bool ParseArguments(XMLElement* element, std::map<std::string, std::string>& args);
         bool ParseColor(XMLElement* element, Color& c);
         bool ParseColorMap(XMLElement* element, ColorMap& cm);
+        bool ParseCameraOutput(XMLElement* element, CameraOutputSettings& s);
     
         XMLDocument doc;
         SimulationManager* sm;
         bool graphical;
+        uint64_t scenarioKey;
+        std::string description;
     };
 }
 
@@ -82,6 +82,9 @@ namespace sf
         //! A method that performs a single simulation step and necessary updates.
         virtual void StepSimulation();
         
+        //! A method that ends the application loop.
+        virtual void Quit();
+        
         //! A method returning simulation state.
         SimulationState getState() const;
 
@@ -112,7 +115,6 @@ namespace sf
         virtual void Init();
         virtual void LoopInternal() = 0;
         virtual void CleanUp();
-        virtual void Quit();
         
         virtual void InitializeSimulation();
         
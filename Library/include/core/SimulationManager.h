@@ -31,6 +31,13 @@
 #include "entities/forcefields/Atmosphere.h"
 #include "entities/SolidEntity.h"
 #include "utils/PerformanceMonitor.h"
+#include <unordered_map>
+#include <atomic>
+
+#define FLUID_SPLIT_MIN_FACES 2048 //Minimum number of faces of a body to split its fluid forces computation between threads
+#define RT_HISTOGRAM_BINS 64 //Number of bins of the step latency histogram (covering twice the deadline)
+#define RT_PREFAULT_HEAP (64 * 1024 * 1024) //Size of the heap pool pre-faulted in the real-time mode [B]
+#define RT_PREFAULT_STACK (256 * 1024) //Size of the stack pre-faulted in the real-time mode [B]
 
 namespace sf
 {
@@ -47,6 +54,7 @@ namespace sf
     class Joint;
     class Actuator;
     class Sensor;
+    class SensorDispatcher;
     class Comm;
     class Contact;
     class OpenGLTrackball;
@@ -65,10 +73,75 @@ namespace sf
         Entity* B;
     };
     
+    //! A structure used to filter the results of spatial queries.
+    struct SpatialQueryFilter
+    {
+        unsigned int entityTypes; //!< Bit mask of accepted entity types (see TypeBit).
+        int collisionGroups; //!< Bit mask tested against the collision group of each object (see CollisionMask).
+        Entity* exclude; //!< An entity excluded from the results (e.g. the querying body).
+        
+        //! A constructor accepting all entities.
+        SpatialQueryFilter() : entityTypes(0xFFFFFFFF), collisionGroups(-1), exclude(nullptr) {}
+        
+        //! A method returning the bit corresponding to an entity type.
+        /*!
+         \param type the type of entity
+         \return bit to be used in the entity type mask
+         */
+        static unsigned int TypeBit(EntityType type) { return 1u << (unsigned int)type; }
+    };
+    
+    //! An enum defining the type of a spatial query.
+    enum class SpatialQueryType {AABB, SPHERE, NEAREST};
+    
+    //! A structure describing a single spatial query, used in batched queries.
+    struct SpatialQuery
+    {
+        SpatialQueryType type; //!< Type of the query.
+        Vector3 p1; //!< Minimum corner of the box or center of the sphere/reference point.
+        Vector3 p2; //!< Maximum corner of the box (AABB only).
+        Scalar radius; //!< Radius of the sphere or maximum search distance (NEAREST).
+        unsigned int k; //!< Number of nearest entities to find (NEAREST only).
+        SpatialQueryFilter filter; //!< Result filter.
+        
+        //! A constructor.
+        SpatialQuery() : type(SpatialQueryType::AABB), p1(V0()), p2(V0()), radius(BT_LARGE_FLOAT), k(1) {}
+    };
+    
+    //! A structure holding a persistent partition of the fluid forces computation between worker threads.
+    struct FluidWorkPartition
+    {
+        std::vector<btCollisionObject*> bodies; //!< Bodies interacting with the fluid (sorted).
+        std::vector<std::vector<btCollisionObject*>> workers; //!< Bodies assigned to each of the worker threads.
+        std::vector<btCollisionObject*> split; //!< Large bodies, with faces processed by all worker threads.
+        std::vector<btCollisionObject*> reaching; //!< Bodies reaching the fluid in the current step (reused to avoid allocation).
+        std::unordered_map<btCollisionObject*, double> cost; //!< Last measured computation time of each body [s].
+        double faceCost; //!< Average computation time per face, used for bodies never measured [s].
+        
+        //! A constructor.
+        FluidWorkPartition() : faceCost(1e-7) {}
+    };
+    
+    //! A structure holding the timing statistics of the real-time stepping mode.
+    struct RealtimeStats
+    {
+        uint64_t steps; //!< Number of recorded steps (each step computed to catch up is recorded separately).
+        uint64_t deadlineMisses; //!< Number of steps computed longer than the deadline.
+        uint64_t droppedSteps; //!< Number of simulation steps dropped by the catch-up policy.
+        double meanLatency; //!< Mean computation time of a step, including the step completion callback [us].
+        uint64_t maxLatency; //!< Maximum computation time of a step [us].
+        double meanWakeupJitter; //!< Mean delay of the wake-up of the simulation thread [us].
+        uint64_t maxWakeupJitter; //!< Maximum delay of the wake-up of the simulation thread [us].
+        uint64_t deadline; //!< Deadline of a step [us].
+        uint64_t binWidth; //!< Width of the bins of the latency histogram [us].
+        std::vector<uint64_t> histogram; //!< Histogram of the step computation time (the last bin also counts all longer steps).
+    };
+    
     //! An abstract class managing the simulation world, the solver settings and implementing custom physics callbacks.
     class SimulationManager
     {
         friend class OpenGLPipeline;
+        friend class ScenarioParser;
         
     public:
         //! A constructor.
@@ -160,6 +233,14 @@ namespace sf
          \param origin a pose of the body in the world frame
          */
         void AddSolidEntity(SolidEntity* ent, const Transform& origin);
+        
+        //! A method that adds a large number of dynamic rigid bodies to the simulation world at once.
+        /*!
+         The names of the bodies can be registered in one pass, before creating them, with NameManager::ReserveNames.
+         \param ents a list of pointers to the dynamic body objects
+         \param origins a list of poses of the bodies in the world frame
+         */
+        void AddSolidEntities(const std::vector<SolidEntity*>& ents, const std::vector<Transform>& origins);
 
         //! A method that removes a dynamic rigid body from the simulation world.
         /*!
@@ -167,6 +248,12 @@ namespace sf
          */
         void RemoveSolidEntity(SolidEntity* ent);
 
+        //! A method that removes a static body from the simulation world.
+        /*!
+         \param ent a pointer to the static body object
+         */
+        void RemoveStaticEntity(StaticEntity* ent);
+
         //! A method that adds a rigid multibody to the simulation world.
         /*!
          \param ent a pointer to the multibody object
@@ -180,6 +267,24 @@ namespace sf
          */
         void RemoveFeatherstoneEntity(FeatherstoneEntity* ent);
         
+        //! A method that registers a dynamic body for the computation of fluid forces.
+        /*!
+         \param co a pointer to the collision object of the body (rigid body or multibody link)
+         */
+        void AddFluidBody(btCollisionObject* co);
+        
+        //! A method that updates the registration of a body after its physics mode changed.
+        /*!
+         \param co a pointer to the collision object of the body (rigid body or multibody link)
+         */
+        void UpdateFluidBody(btCollisionObject* co);
+        
+        //! A method that removes a body from the computation of fluid forces.
+        /*!
+         \param co a pointer to the collision object of the body (rigid body or multibody link)
+         */
+        void RemoveFluidBody(btCollisionObject* co);
+        
         //! A method that adds a discrete joint to the simulation world.
         /*!
          \param jnt a pointer to the joint object
@@ -256,6 +361,45 @@ namespace sf
          */
         std::pair<Entity*, int> PickEntity(Vector3 eye, Vector3 ray);
         
+        //! A method that finds all entities with a bounding box overlapping the specified box.
+        /*!
+         \param min the minimum corner of the box in the world frame
+         \param max the maximum corner of the box in the world frame
+         \param results a caller-provided buffer, cleared and filled with the found entities
+         \param filter a filter applied to the results
+         \return number of found entities
+         */
+        size_t QueryAABB(const Vector3& min, const Vector3& max, std::vector<Entity*>& results, const SpatialQueryFilter& filter = SpatialQueryFilter());
+        
+        //! A method that finds all entities with a bounding box overlapping the specified sphere.
+        /*!
+         \param center the center of the sphere in the world frame
+         \param radius the radius of the sphere
+         \param results a caller-provided buffer, cleared and filled with the found entities
+         \param filter a filter applied to the results
+         \return number of found entities
+         */
+        size_t QuerySphere(const Vector3& center, Scalar radius, std::vector<Entity*>& results, const SpatialQueryFilter& filter = SpatialQueryFilter());
+        
+        //! A method that finds the entities with bounding boxes nearest to a point, sorted by distance.
+        /*!
+         \param point the reference point in the world frame
+         \param k the maximum number of entities to find
+         \param results a caller-provided buffer, cleared and filled with the found entities
+         \param filter a filter applied to the results
+         \param maxDistance the maximum distance from the point to the bounding box of an entity
+         \return number of found entities
+         */
+        size_t QueryNearest(const Vector3& point, unsigned int k, std::vector<Entity*>& results, 
+                            const SpatialQueryFilter& filter = SpatialQueryFilter(), Scalar maxDistance = BT_LARGE_FLOAT);
+        
+        //! A method that runs many spatial queries in parallel.
+        /*!
+         \param queries a list of query descriptions
+         \param results a caller-provided list of buffers, resized to the number of queries and filled with the results
+         */
+        void QueryBatch(const std::vector<SpatialQuery>& queries, std::vector<std::vector<Entity*>>& results);
+        
         //! A method that sets new valve for the amount of simulation steps in a second.
         /*!
          \param steps number steps of simulation per second
@@ -271,6 +415,25 @@ namespace sf
          */
         void setFluidDynamicsPrescaler(unsigned int presc);
 
+        //! A method used to setup multi-rate integration of isolated rigid bodies.
+        /*!
+         \param divider a number of simulation steps between updates of the bodies running at reduced rate (1 disables multi-rate integration)
+         \param promotionDistance a distance to the robots, sensors and other high-rate bodies, below which bodies are integrated at full rate [m]
+         */
+        void setMultiRateParams(unsigned int divider, Scalar promotionDistance);
+        
+        //! A method used to enable the floating origin of the simulation world.
+        /*!
+         \param distance a horizontal distance between the robots and the world origin, above which the world is re-centred [m] (0 disables)
+         */
+        void setFloatingOrigin(Scalar distance);
+        
+        //! A method used to set the seed of all random number streams (has to be called before the scenario is built).
+        /*!
+         \param seed the seed of the simulation
+         */
+        void setRandomSeed(uint32_t seed);
+        
         //! A method that sets how simulation time relates to real time.
         /*!
          \param f a multiple of real time (1.0 = real time)
@@ -289,6 +452,41 @@ namespace sf
         void setICSolverParams(bool useGravity, Scalar timeStep = Scalar(0.001), unsigned int maxIterations = 100000,
                                Scalar maxTime = BT_LARGE_FLOAT, Scalar linearTolerance = Scalar(1e-6), Scalar angularTolerance = Scalar(1e-6));
         
+        //! A method used to define when the bodies are considered settled by the initial conditions solver (enables gravity during IC solving).
+        /*!
+         \param kineticEnergy a total kinetic energy of the bodies below which they are settled [J] (0 disables the check)
+         \param contactImpulse a change of the total contact impulse between two steps below which the bodies are settled [Ns] (0 disables the check)
+         */
+        void setSettlingThresholds(Scalar kineticEnergy, Scalar contactImpulse);
+        
+        //! A method used to set the file caching the settled initial state between runs.
+        /*!
+         \param filename a path to the cache file (empty string disables caching)
+         \param scenarioKey a hash identifying the scenario and its inputs
+         */
+        void setSettledStateCache(const std::string& filename, uint64_t scenarioKey);
+        
+        //! A method used to enable the real-time stepping mode, with bounded latency of the steps.
+        /*!
+         \param enabled a flag enabling the mode
+         \param maxCatchUpSteps a maximum number of steps computed to catch up with the real time (the remaining time is dropped)
+         \param deadline a maximum computation time of a step used for the latency statistics [s] (0 means the duration of one step)
+         \param priority a SCHED_FIFO priority of the simulation thread (0 keeps the default scheduling)
+         \param cpuCore an index of the CPU core to which the simulation thread is pinned (-1 disables pinning)
+         \param lockMemory a flag deciding if the memory of the process should be locked and the memory pools pre-faulted
+         */
+        void setRealtimeMode(bool enabled, unsigned int maxCatchUpSteps = 2, Scalar deadline = Scalar(0), 
+                             int priority = 0, int cpuCore = -1, bool lockMemory = false);
+        
+        //! A method applying the scheduling, pinning and memory settings of the real-time mode to the calling thread.
+        void ConfigureRealtimeThread();
+        
+        //! A method returning the timing statistics of the real-time mode.
+        RealtimeStats getRealtimeStats() const;
+        
+        //! A method resetting the timing statistics of the real-time mode (can be called from any thread while the simulation runs).
+        void ResetRealtimeStats();
+        
         //! A method used to change some global solver params for stability tuning.
         /*!
          \param erp error reduction for constraint solving
@@ -314,6 +512,9 @@ namespace sf
          */
         DisplayMode getSolidDisplayMode() const;
         
+        //! A method informing if the real-time stepping mode is enabled.
+        bool isRealtimeMode() const;
+        
         //! A method returning the usage of the CPU by the physics computation in percent.
         Scalar getCpuUsage() const;
         
@@ -478,6 +679,9 @@ namespace sf
         
         //! A method returning a reference to the performance monitor.
         PerformanceMonitor& getPerformanceMonitor();
+        
+        //! A method returning a pointer to the dispatcher running sensor callbacks asynchronously (created on first use).
+        SensorDispatcher* getSensorDispatcher();
 
         //! A method returning a pointer to the trackball view.
         OpenGLTrackball* getTrackball();
@@ -497,6 +701,28 @@ namespace sf
         //! A method returning the simulation setup related to joint constraints.
         void getJointErp(Scalar& erp, Scalar& stopErp) const;
         
+        //! A method returning the multi-rate integration settings.
+        void getMultiRateParams(unsigned int& divider, Scalar& promotionDistance) const;
+        
+        //! A method returning the distance which triggers re-centring of the simulation world (0 when disabled).
+        Scalar getFloatingOriginDistance() const;
+        
+        //! A method returning the position of the simulation world origin in the NED frame.
+        Vector3 getWorldOrigin() const;
+        
+        //! A method returning the seed of the simulation.
+        uint32_t getRandomSeed() const;
+        
+        //! A method deriving a seed of an independent random number stream.
+        /*!
+         \param streamName the name of the stream (usually the name of the object using it)
+         \return the seed of the stream, depending only on the seed of the simulation and the name
+         */
+        uint32_t DeriveRandomSeed(const std::string& streamName) const;
+        
+        //! A method computing a hash of the positions and velocities of all bodies, used to compare simulation runs.
+        uint64_t ComputeStateHash();
+        
         //------ Aliases created to shorten the code needed to build the scenario ------
         
         //! A method that creates a new material.
@@ -535,6 +761,32 @@ namespace sf
                                const std::string& albedoTexturePath = "", const std::string& normalTexturePath = "", 
                                const std::string& temperatureTexturePath = "", const std::pair<float, float>& temperatureRange = std::make_pair(20.f, 20.f));
         
+        //! A method used to update an existing rendering look in place (textures are reloaded only if their paths changed).
+        /*!
+         \param name the name of the look
+         \param color a color of the material
+         \param roughness how smooth the material looks
+         \param metalness how metallic the material looks
+         \param reflectivity how reflective the material is
+         \param albedoTexturePath a path to a texture specifying albedo color
+         \param normalTexturePath a path to a texture specifying surface normal (bump mapping)
+         \param temperatureTexturePath a path to a texture specifying temperature distribution
+         \param temperatureRange a range of temperatures represented by the texture values
+         \return was the look found and updated?
+         */
+        bool UpdateLook(const std::string& name, Color color, float roughness, float metalness = 0.f, float reflectivity = 0.f, 
+                        const std::string& albedoTexturePath = "", const std::string& normalTexturePath = "", 
+                        const std::string& temperatureTexturePath = "", const std::pair<float, float>& temperatureRange = std::make_pair(20.f, 20.f));
+        
+        //! A method used to store the expanded description of the loaded scenario (used for hot-reloading).
+        /*!
+         \param description the xml text of the scenario
+         */
+        void setScenarioDescription(const std::string& description);
+        
+        //! A method returning the expanded description of the loaded scenario (empty if the scenario was not loaded from a file).
+        const std::string& getScenarioDescription() const;
+        
     protected:
         static void SolveICTickCallback(btDynamicsWorld* world, Scalar timeStep);
         static void SimulationTickCallback(btDynamicsWorld* world, Scalar timeStep);
@@ -542,6 +794,9 @@ namespace sf
         static bool CustomMaterialCombinerCallback(btManifoldPoint& cp,	const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0, const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1);
         static bool ContactInfoUpdateCallback(btManifoldPoint& cp, void* body0, void* body1);
         static bool ContactInfoDestroyCallback(void* userPersistentData);
+        static void UpdateFluidForces(SimulationManager* simManager, btDynamicsWorld* world, bool recompute, bool mrUpdate);
+        static void UpdateFluidWorkPartition(const std::vector<btCollisionObject*>& bodies, FluidWorkPartition& part, bool allowSplit);
+        static void MeasureFluidWork(FluidWorkPartition& part, btCollisionObject* co, double time);
 
         btSoftMultiBodyDynamicsWorld* dynamicsWorld;
         btMultiBodyConstraintSolver* mbSolver;
@@ -557,6 +812,15 @@ namespace sf
         void RenderBulletDebug();
         void InitializeSolver();
         void InitializeScenario();
+        void UpdateIntegrationRates(bool forceFull = false);
+        void ShiftWorldOrigin(const Vector3& shift);
+        Scalar ComputeKineticEnergy();
+        Scalar ComputeContactImpulse();
+        uint64_t SettledStateKey() const;
+        void RecordStepLatency(uint64_t latency);
+        static void UpdateMaximum(std::atomic<uint64_t>& maximum, uint64_t value);
+        bool SaveSettledState();
+        bool LoadSettledState();
         
         // State
         Scalar simulationTime; // Time of simulation run in seconds
@@ -565,18 +829,24 @@ namespace sf
         uint64_t ssus;         // Simulation step time in us
         bool simulationFresh;
         bool callSimulationStepCompleted;
+        std::string scenarioDescription;
 
         // Performance
         PerformanceMonitor perfMon;
+        SensorDispatcher* sensorDispatcher;
         Scalar realtimeFactor;
         Scalar cpuUsage;
         unsigned int fdPrescaler;
         unsigned int fdCounter;
+        FluidWorkPartition hydroPartition;
+        FluidWorkPartition aeroPartition;
+        std::unordered_map<btCollisionObject*, BodyPhysicsMode> fluidBodies; //All registered dynamic bodies
+        std::vector<btCollisionObject*> hydroBodies; //Floating and submerged bodies (sorted)
+        std::vector<btCollisionObject*> aeroBodies; //Aerodynamic bodies (sorted)
         
         // Threading
         SDL_mutex* simSettingsMutex;
         SDL_mutex* simInfoMutex;
-        SDL_mutex* simHydroMutex;
         
         // IC solver settings
         bool icUseGravity;
@@ -585,6 +855,11 @@ namespace sf
         Scalar icMaxTime;
         Scalar icLinTolerance;
         Scalar icAngTolerance;
+        Scalar icKinThreshold;
+        Scalar icImpThreshold;
+        Scalar icLastImpulse;
+        std::string icCacheFile;
+        uint64_t icCacheKey;
         unsigned int mlcpFallbacks;
         bool icProblemSolved;
 
@@ -596,6 +871,31 @@ namespace sf
         Scalar angSleepThreshold;
         Scalar jointErp;
         Scalar jointLimitErp;
+        unsigned int mrDivider;
+        unsigned int mrCounter;
+        Scalar mrDistance;
+        Scalar foDistance;
+        Vector3 worldOrigin;
+        Vector3 trackballShift;
+        uint32_t randomSeed;
+        
+        // Real-time mode
+        bool rtEnabled;
+        unsigned int rtMaxCatchUp;
+        uint64_t rtDeadline;
+        int rtPriority;
+        int rtCpuCore;
+        bool rtLockMemory;
+        int64_t rtTickStart;
+        std::atomic<uint64_t> rtSteps;
+        std::atomic<uint64_t> rtMisses;
+        std::atomic<uint64_t> rtDropped;
+        std::atomic<uint64_t> rtLatencySum;
+        std::atomic<uint64_t> rtMaxLatency;
+        std::atomic<uint64_t> rtWakeups;
+        std::atomic<uint64_t> rtJitterSum;
+        std::atomic<uint64_t> rtMaxJitter;
+        std::atomic<uint64_t> rtHistogram[RT_HISTOGRAM_BINS];
 
         // Scenario
         NameManager* nameManager;
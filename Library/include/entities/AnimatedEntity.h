@@ -185,6 +185,12 @@ namespace sf
          \param max a point located at the maximum coordinate corner
          */
         void getAABB(Vector3& min, Vector3& max);
+
+        //! A method used to move the state of the entity when the simulation world is re-centred.
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
       
     private:
         void BuildRigidBody(btCollisionShape* shape, bool collides);
@@ -193,6 +199,7 @@ namespace sf
         Transform T_O2G;
         Transform T_O2C;
         Trajectory* tr;
+        Vector3 trShift;
         int phyObjectId;
     };
 }
@@ -33,7 +33,7 @@
 namespace sf
 {
     //! An enum specifying the type of entity.
-    enum class EntityType {STATIC, SOLID, ANIMATED, FEATHERSTONE, CABLE, FORCEFIELD};
+    enum class EntityType {STATIC, SOLID, ANIMATED, FEATHERSTONE, CABLE, FORCEFIELD, SWARM};
     
     //! An enum used for collision filtering.
     typedef enum
@@ -97,6 +97,13 @@ namespace sf
          */
         virtual void getAABB(Vector3& min, Vector3& max) = 0;
         
+        //! A method used to move the state of the entity when the simulation world is re-centred.
+        /*!
+         Collision objects registered in the physics world are moved by the simulation manager.
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        virtual void ShiftOrigin(const Vector3& shift);
+        
     private:
         bool renderable;
         std::string name;
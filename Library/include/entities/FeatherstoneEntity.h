@@ -63,11 +63,12 @@ namespace sf
          \param c the id of the child link
          */
         FeatherstoneJoint(std::string n, btMultibodyLink::eFeatherstoneJointType t, unsigned int p, unsigned int c)
-        : name(n), type(t), feedback(NULL), limit(NULL), motor(NULL), parent(p), child(c), sigDamping(0), velDamping(0), lowerLimit(10e9), upperLimit(-10e9) {}
+        : name(n), type(t), feedback(NULL), feedbackEnabled(false), limit(NULL), motor(NULL), parent(p), child(c), sigDamping(0), velDamping(0), lowerLimit(10e9), upperLimit(-10e9) {}
         
         std::string name;
         btMultibodyLink::eFeatherstoneJointType type;
         btMultiBodyJointFeedback* feedback;
+        bool feedbackEnabled;
         btMultiBodyJointLimitConstraint* limit;
         btMultiBodyJointMotor* motor;
         
@@ -257,6 +258,13 @@ namespace sf
          */
         Scalar getJointTorque(unsigned int index);
         
+        //! A method returning the effective inertia of the multibody seen by the joint.
+        /*!
+         \param index an id of the joint
+         \return the effective inertia [kg*m^2] or mass [kg], zero if not available
+         */
+        Scalar getJointInertia(unsigned int index);
+        
         //! A method to change the maximum force/torque produced by the joint motor.
         /*!
          \param index the id of the joint
@@ -288,12 +296,29 @@ namespace sf
         
         //! A method returning the joint feedback.
         /*!
+         If the feedback was never enabled or requested, it is enabled by the first call, which returns zero.
          \param index an id of the joint
          \param force a reference to a variable that will store the forces acting on the joint [N]
          \param torque a reference to a variable that will store the torques acting on the joint [Nm]
          */
         unsigned int getJointFeedback(unsigned int index, Vector3& force, Vector3& torque);
         
+        //! A method used to compute the joint feedback in every simulation step (by default it is only computed for the force-torque sensors).
+        /*!
+         \param index an id of the joint
+         \param enabled a flag indicating if the feedback should be computed in every step
+         */
+        void setJointFeedbackEnabled(unsigned int index, bool enabled);
+        
+        //! A method used to request the computation of the joint feedback in the next simulation step.
+        /*!
+         \param index an id of the joint
+         */
+        void RequestJointFeedback(unsigned int index);
+        
+        //! A method used to stop the computation of the feedback of all joints (requests are renewed before every step).
+        void ClearJointFeedbackRequests();
+        
         //! A method used to set the position of the multibody in the world frame.
         /*!
          \param trans the transformation of the multibody base in the world frame
@@ -63,7 +63,7 @@ namespace sf
          */
         virtual void getAABB(Vector3& min, Vector3& max);
         
-        //! A method returning the pair caching object for the force field.
+        //! A method returning the pair caching object for the force field (nullptr if not used).
         btPairCachingGhostObject* getGhost();
         
         //! A method returning the type of the force field.
@@ -48,6 +48,8 @@ namespace sf
      AERODYNAMIC -> aerodynamics
     */
     enum class BodyPhysicsMode {DISABLED, SURFACE, FLOATING, SUBMERGED, AERODYNAMIC};
+    //! An enum defining the rate at which a rigid body is integrated (FULL -> every step, REDUCED -> sub-cycled by the simulation manager).
+    enum class IntegrationRate {FULL, REDUCED};
     //! A structure defining the physics computation settings for the body.
     struct BodyPhysicsSettings
     {
@@ -60,6 +62,31 @@ namespace sf
         }
     };
 
+    //! A structure holding the physics mesh data preprocessed for the integration of fluid forces.
+    struct HydroMesh
+    {
+        //! A structure holding the precomputed properties of a single face (in the mesh frame).
+        struct Face
+        {
+            GLuint vertexID[3]; //Indices of unique vertices
+            glm::vec3 normal; //Normalised normal
+            glm::vec3 centroid;
+            GLfloat area;
+            GLfloat det; //Triple product of the vertices (volume integral)
+            glm::vec3 detMoment; //Sum of the vertices multiplied by the triple product (first moment of volume)
+            glm::mat3 normalMoment; //Outer product of the sum of the vertices and the double area normal
+        };
+
+        std::vector<glm::vec3> vertices; //Vertices with duplicates removed
+        std::vector<Face> faces; //Non-degenerate faces
+
+        //! A constructor.
+        /*!
+         \param mesh a pointer to the physics mesh
+         */
+        HydroMesh(const Mesh* mesh);
+    };
+
     struct HydrodynamicsSettings;
     class Ocean;
     class Atmosphere;
@@ -152,7 +179,7 @@ namespace sf
          \param _Vsub output of the submerged volume
          \param debug output of the debug rendering
         */
-        static void ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const Mesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
+        static void ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const HydroMesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
                                                      const Vector3& linearV, const Vector3& angularV, Vector3& _Fb, Vector3& _Tb, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf, 
                                                      Scalar& _Swet, Scalar& _Vsub, Renderable& debug);
         
@@ -168,9 +195,11 @@ namespace sf
          \param _Tdq output of the torque induced by form drag
          \param _Fdf output of the damping force resulting from skin friction
          \param _Tdf output of the torque induced by skin friction
+         \param splitFaces a flag deciding if the faces should be processed by all worker threads
         */
-        static void ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
-                                                       const Vector3& linearV, const Vector3& angularV, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf);
+        static void ComputeHydrodynamicForcesSubmerged(const HydroMesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
+                                                       const Vector3& linearV, const Vector3& angularV, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf,
+                                                       bool splitFaces = false);
         
         //! A method that computes aerodynamics.
         /*!
@@ -371,6 +400,12 @@ namespace sf
         //! A method returning a pointer to the physics mesh.
         const Mesh* getPhysicsMesh();
 
+        //! A method returning a pointer to the physics mesh data used for fluid dynamics (built on first use).
+        const HydroMesh* getHydroMesh();
+        
+        //! A method returning the number of faces of the physics mesh (used to estimate the cost of fluid dynamics).
+        virtual size_t getPhysicsFaceCount();
+
         //! A method that returns a copy of all physics mesh vertices in body origin frame.
         virtual std::vector<Vector3>* getMeshVertices() const;
         
@@ -380,10 +415,52 @@ namespace sf
         //! A method informing what kind of physics computations are performed for the body.
         BodyPhysicsMode getBodyPhysicsMode() const;
         
+        //! A method used to change the kind of physics computations performed for the body.
+        /*!
+         \param m the new physics mode (floating and submerged fall back to surface if ocean is disabled)
+         */
+        void setBodyPhysicsMode(BodyPhysicsMode m);
+        
+        //! A method used to change the integration rate of the body (used by the simulation manager).
+        /*!
+         \param rate the new integration rate
+         */
+        void setIntegrationRate(IntegrationRate rate);
+        
+        //! A method returning the current integration rate of the body.
+        IntegrationRate getIntegrationRate() const;
+        
+        //! A method used to force integration of the body at the full simulation rate.
+        /*!
+         \param enabled a flag deciding if the body can never be integrated at a reduced rate
+         */
+        void setFullRateOnly(bool enabled);
+        
+        //! A method informing if the body is always integrated at the full simulation rate.
+        bool isFullRateOnly() const;
+        
+        //! A method waking up a body integrated at a reduced rate, so that forces can be applied to it.
+        void WakeReducedRate();
+        
+        //! A method integrating the motion of a body running at a reduced rate, using the accumulated forces.
+        /*!
+         \param dt the time step of the reduced rate integration [s]
+         */
+        void IntegrateReducedRate(Scalar dt);
+        
+        //! A method interpolating the pose of a body running at a reduced rate (used for rendering and sensing).
+        /*!
+         \param alpha the interpolation factor between the last and the next integrated pose <0,1>
+         */
+        void InterpolateReducedRate(Scalar alpha);
+        
         //Rendering
         //! A method used to build the graphical representation of the body.
         virtual void BuildGraphicalObject();
         
+        //! A method used to release the graphical representation of the body (done later by the rendering thread).
+        virtual void DestroyGraphicalObject();
+        
         //! A method returning the elements that should be rendered.
         virtual std::vector<Renderable> Render();
         
@@ -393,6 +470,12 @@ namespace sf
          \param max a point located at the maximum coordinate corner
          */
         void getAABB(Vector3& min, Vector3& max);
+
+        //! A method used to move the state of the entity when the simulation world is re-centred.
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
         
         //! A method used to set if the body CG should be rendered.
         void setDisplayCoordSys(bool enabled);
@@ -415,6 +498,7 @@ namespace sf
         btMultiBodyLinkCollider* multibodyCollider;
         
         Mesh* phyMesh; //Mesh used for physics calculation
+        HydroMesh* hydroMesh; //Preprocessed physics mesh used for fluid dynamics
         Scalar thick;
         Scalar volume;
         Scalar surface;
@@ -460,6 +544,12 @@ namespace sf
         Vector3 lastV;
         Vector3 lastOmega;
         
+        //Multi-rate integration
+        IntegrationRate intRate;
+        bool intFullRateOnly;
+        int intActivationState;
+        Transform intLastTrans;
+        
         //Display
         int phyObjectId;
         Renderable submerged;
@@ -67,6 +67,12 @@ namespace sf
          */
         virtual void AddToSimulation(SimulationManager* sm, const Transform& origin);
         
+        //! A method used to remove the static entity from the simulation.
+        /*!
+         \param sm a pointer to the simulation manager
+         */
+        void RemoveFromSimulation(SimulationManager* sm);
+        
         //! A method returning the extents of the entity axis alligned bounding box.
         /*!
          \param min a point located at the minimum coordinate corner
@@ -101,6 +107,9 @@ namespace sf
          */
         void setDisplayMode(DisplayMode m);
         
+        //! A method used to release the graphical representation of the body (done later by the rendering thread).
+        virtual void DestroyGraphicalObject();
+        
         //! A static method used to transform a group of static entities together (useful to change the position of multiple linked objects).
         /*!
          \param objects a vector holiding a list of pointers to the objects that are to be transformed
@@ -0,0 +1,165 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  Swarm.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_Swarm__
+#define __Stonefish_Swarm__
+
+#include "entities/Entity.h"
+
+namespace sf
+{
+    //! An enum defining the behaviour of the swarm agents.
+    enum class SwarmBehaviour {BOIDS, DRIFT};
+
+    //! A class representing a large group of non-colliding agents (fish school, jellyfish, debris), drawn with instancing.
+    class Swarm : public Entity
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param uniqueName a name for the entity
+         \param agentCount the number of agents
+         \param modelFilename a path to the 3d model of a single agent (x axis pointing forward)
+         \param scale a scale factor to be used when reading the mesh file
+         \param material the name of the material the agents are made of (used by sonars)
+         \param look the name of the graphical material used for rendering
+         \param behaviour the behaviour model of the agents
+         */
+        Swarm(std::string uniqueName, unsigned int agentCount, std::string modelFilename, Scalar scale,
+              std::string material, std::string look = "", SwarmBehaviour behaviour = SwarmBehaviour::BOIDS);
+
+        //! A destructor.
+        virtual ~Swarm();
+
+        //! A method used to define the region occupied by the swarm.
+        /*!
+         \param origin the pose of the region centre in the world frame
+         \param halfExtents the half extents of the box-shaped region [m]
+         */
+        void setRegion(const Transform& origin, const Vector3& halfExtents);
+
+        //! A method used to set the swimming speed of the agents.
+        /*!
+         \param cruise the preferred speed of the agents [m/s]
+         \param max the maximum speed of the agents [m/s]
+         */
+        void setSpeed(Scalar cruise, Scalar max);
+
+        //! A method used to set the parameters of the boids model.
+        /*!
+         \param neighbourRadius the radius in which agents interact [m]
+         \param separationDistance the distance below which agents push each other away [m]
+         \param cohesion the gain of the steering towards the local centre of the group
+         \param alignment the gain of the steering towards the local mean velocity
+         \param separation the gain of the steering away from close neighbours
+         */
+        void setBoidsParameters(Scalar neighbourRadius, Scalar separationDistance, Scalar cohesion, Scalar alignment, Scalar separation);
+
+        //! A method used to add the entity to the simulation (places the agents in the region, using the current speed settings).
+        /*!
+         \param sm a pointer to a simulation manager
+         */
+        void AddToSimulation(SimulationManager* sm);
+
+        //! A method updating the state of all agents.
+        /*!
+         \param dt a time step [s]
+         */
+        void Update(Scalar dt);
+
+        //! A method implementing rendering of the entity.
+        std::vector<Renderable> Render();
+
+        //! A method returning the extents of the entity axis alligned bounding box.
+        /*!
+         \param min a point located at the minimum coordinate corner
+         \param max a point located at the maximum coordinate corner
+         */
+        void getAABB(Vector3& min, Vector3& max);
+
+        //! A method used to move the state of the entity when the simulation world is re-centred.
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
+
+        //! A method returning the position of an agent.
+        /*!
+         \param index the id of the agent
+         \return the position of the agent in the world frame [m]
+         */
+        Vector3 getAgentPosition(unsigned int index) const;
+
+        //! A method returning the velocity of an agent.
+        /*!
+         \param index the id of the agent
+         \return the velocity of the agent in the world frame [m/s]
+         */
+        Vector3 getAgentVelocity(unsigned int index) const;
+
+        //! A method returning the number of agents.
+        unsigned int getAgentCount() const;
+
+        //! A method returning the behaviour of the agents.
+        SwarmBehaviour getBehaviour() const;
+
+        //! A method returning the type of the entity.
+        EntityType getType() const;
+
+    private:
+        void BuildGrid();
+        void Scatter();
+
+        SwarmBehaviour behaviour;
+        std::string materialName;
+        int objectId;
+        int lookId;
+        Transform regionOrigin;
+        Vector3 regionHalfExtents;
+        Scalar cruiseSpeed;
+        Scalar maxSpeed;
+        Scalar neighbourRadius;
+        Scalar separationDistance;
+        Scalar kCohesion;
+        Scalar kAlignment;
+        Scalar kSeparation;
+
+        //Agent state (structure of arrays)
+        std::vector<Scalar> px, py, pz;
+        std::vector<Scalar> vx, vy, vz;
+        std::vector<Scalar> nvx, nvy, nvz;
+        std::vector<Scalar> hx, hy, hz;
+
+        //Uniform grid used for neighbour search
+        Vector3 gridMin;
+        Scalar cellSize;
+        int gridDim[3];
+        std::vector<unsigned int> cellStart;
+        std::vector<unsigned int> cellAgents;
+        std::vector<unsigned int> agentCell;
+    };
+}
+
+#endif
@@ -94,6 +94,12 @@ namespace sf
          */
         void ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute);
         
+        //! A method used to move the wind fields when the simulation world is re-centred.
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
+        
         //! A method returning the position of the sun in the sky.
         /*!
          \param azimuthDeg a reference to the variable that will store the azimuth of the sun [deg]
@@ -122,6 +128,14 @@ namespace sf
          */
         bool IsInsideFluid(const Vector3& point) const;
         
+        //! A method checking if a body can be in contact with the air.
+        /*!
+         \param aabbMin the minimum corner of the body axis aligned bounding box [m]
+         \param aabbMax the maximum corner of the body axis aligned bounding box [m]
+         \return is any part of the body above the ground and ocean surface level?
+         */
+        bool IsReachingFluid(const Vector3& aabbMin, const Vector3& aabbMax) const;
+        
         //! A method returning a pointer to the gas filling the atmosphere.
         Fluid getGas() const;
         
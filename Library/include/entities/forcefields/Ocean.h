@@ -26,7 +26,6 @@
 #ifndef __Stonefish_Ocean__
 #define __Stonefish_Ocean__
 
-#include <SDL2/SDL_mutex.h>
 #include "core/MaterialManager.h"
 #include "entities/ForcefieldEntity.h"
 #include "graphics/OpenGLOcean.h"
@@ -38,6 +37,7 @@ namespace sf
     {
         bool dampingForces;
         bool reallisticBuoyancy;
+        bool splitFaces; //Process faces of the body using all worker threads
     };
     
     class VelocityField;
@@ -75,8 +75,15 @@ namespace sf
          \param world a pointer to the dynamics world
          \param co a pointer to the collision object
          \param recompute a flag deciding if hydrodynamic forces need to be recomputed
+         \param splitFaces a flag deciding if the faces of the body should be processed by all worker threads
          */
-        void ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute);
+        void ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute, bool splitFaces = false);
+        
+        //! A method used to move the currents and the waves when the simulation world is re-centred.
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
         
         //! A method returning the water velocity.
         /*!
@@ -93,6 +100,14 @@ namespace sf
          */
         bool IsInsideFluid(const Vector3& point);
         
+        //! A method checking if a body can be in contact with the water.
+        /*!
+         \param aabbMin the minimum corner of the body axis aligned bounding box [m]
+         \param aabbMax the maximum corner of the body axis aligned bounding box [m]
+         \return can the body be wetted, including by the highest waves?
+         */
+        bool IsReachingFluid(const Vector3& aabbMin, const Vector3& aabbMax) const;
+        
         //! A method returning the hydrostatic pressure of the fluid at the specified point.
         /*!
          \param point the position of the measurement point [m]
@@ -114,7 +129,7 @@ namespace sf
         //! A method to disable all defined currents.
         void DisableCurrents();
 
-        //! A method updating the currents data in the OpenGL ocean.
+        //! A method updating the currents data and the wave origin in the OpenGL ocean.
         void UpdateCurrentsData();
         
         //! A method used to setup the properties of the water.
@@ -152,10 +167,10 @@ namespace sf
         ForcefieldType getForcefieldType();
         
         //! A method initializing the rendering of the ocean.
-        /*!
-         \param hydrodynamics a pointer to a mutex
-         */
-        void InitGraphics(SDL_mutex* hydrodynamics);
+        void InitGraphics();
+        
+        //! A method making the latest wave data published by the renderer available to the hydrodynamics.
+        void AcquireWaveData();
         
         //! A method implementing the rendering of the force field.
         std::vector<Renderable> Render();
@@ -168,6 +183,8 @@ namespace sf
         std::vector<VelocityField*> currents;
         OpenGLOcean* glOcean;
         OceanCurrentsUBO glOceanCurrentsUBOData;
+        glm::dvec2 waveOrigin;
+        glm::dvec2 glWaveOrigin;
         Scalar depth;
         Scalar waterType;
         Scalar salinity;
@@ -55,6 +55,12 @@ namespace sf
          */
         Vector3 GetVelocityAtPoint(const Vector3& p) const;
         
+        //! A method used to move the velocity field when the simulation world is re-centred.
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
+        
         //! A method implementing the rendering of the stream.
         std::vector<Renderable> Render(VelocityFieldUBO& ubo);
 
@@ -51,6 +51,12 @@ namespace sf
          */
         virtual Vector3 GetVelocityAtPoint(const Vector3& p) const = 0;
         
+        //! A method used to move the velocity field when the simulation world is re-centred.
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        virtual void ShiftOrigin(const Vector3& shift);
+        
         //! A method implementing the rendering of the velocity field.
         virtual std::vector<Renderable> Render(VelocityFieldUBO& ubo) = 0;
 
@@ -107,6 +107,9 @@ namespace sf
         //! A method that returns the type of solid.
         SolidType getSolidType();
         
+        //! A method that returns the total number of faces of the physics meshes of all parts.
+        size_t getPhysicsFaceCount();
+        
         //! A method that returns a copy of all physics mesh vertices in body origin frame.
         std::vector<Vector3>* getMeshVertices() const;
         
@@ -119,6 +122,9 @@ namespace sf
         //! A method that builds a graphical object for the body.
         void BuildGraphicalObject();
         
+        //! A method that releases the graphical objects of the parts.
+        void DestroyGraphicalObject();
+        
         //! A method that returns elements that have to be rendered for the body.
         std::vector<Renderable> Render();
 
@@ -26,6 +26,7 @@
 #ifndef __Stonefish_Polyhedron__
 #define __Stonefish_Polyhedron__
 
+#include <map>
 #include "entities/SolidEntity.h"
 
 namespace sf
@@ -72,9 +73,20 @@ namespace sf
         //! A destructor.
         ~Polyhedron();
         
+        //! A method used to set the parameters of the convex hull used for collisions (has to be called before adding the body to the simulation, by default the exact hull is used). It also enables polyhedral contact clipping for the body.
+        /*!
+         \param maxVertices the maximum number of hull vertices (0 means the exact hull is used)
+         \param maxVolumeError the maximum relative loss of hull volume allowed by the simplification
+         \param margin the collision margin, the hull is shrunk by it so that the rounded shape matches the mesh [m]
+         */
+        void setCollisionHull(unsigned int maxVertices, Scalar maxVolumeError = Scalar(0.02), Scalar margin = Scalar(0));
+        
         //! A method that returns the type of solid.
         SolidType getSolidType();
         
+        //! A static method used to clear the cache of collision hulls (hulls are recomputed from the mesh files).
+        static void ClearHullCache();
+        
         //! A method that returns the collision shape.
         btCollisionShape* BuildCollisionShape();
         
@@ -82,7 +94,17 @@ namespace sf
         void BuildGraphicalObject();
         
     private:
+        static std::vector<Vector3> ComputeHull(const std::vector<Vector3>& points, unsigned int maxVertices, Scalar maxVolumeError);
+        
         Mesh *graMesh; //Mesh used for rendering
+        std::vector<Vector3> hullInput; //Vertices of the original (not refined) physics mesh
+        std::string hullKey;
+        unsigned int hullMaxVertices;
+        Scalar hullMaxVolumeError;
+        Scalar hullMargin;
+        bool hullFeatures; //Polyhedral features built for contact clipping (only for explicitly defined hulls)
+        
+        static std::map<std::string, std::vector<Vector3>> hullCache;
     };
 }
 
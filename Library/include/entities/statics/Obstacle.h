@@ -102,6 +102,9 @@ namespace sf
         //! A method implementing the rendering of the entity.
         std::vector<Renderable> Render();
         
+        //! A method used to release the graphical representation of the body (done later by the rendering thread).
+        void DestroyGraphicalObject();
+        
         //! A method that returns the static body type.
         StaticEntityType getStaticType();
         
@@ -250,7 +250,7 @@ namespace sf
          */
         bool BindShaderStorageBlock(std::string name, GLuint bindingPoint);
 
-        //! A method to check if the shader is valid.
+        //! A method to check if the shader is valid (waits for the compilation to finish).
         bool isValid();
         
         //! A method used to get the OpenGL program handle
@@ -279,6 +279,8 @@ namespace sf
         static GLuint LoadShader(GLenum shaderType, const std::string& filename, const std::string& header, GLint* shaderCompiled);
         
     private:
+        void Link(const std::vector<GLuint>& sharedShaders, const std::vector<GLuint>& ownedShaders);
+        void Finalize();
         bool GetAttribute(std::string name, ParameterType type, GLint& index);
         bool GetUniform(std::string name, ParameterType type, GLint& location);
         
@@ -286,10 +288,18 @@ namespace sf
         std::vector<GLSLUniform> uniforms;
         GLuint program;
         bool valid;
+
+        //Program linked but not queried yet (the driver may still be compiling it)
+        bool pending;
+        std::vector<GLuint> shared;
+        std::vector<GLuint> owned;
+        std::vector<std::string> ownedFiles;
+        std::vector<std::pair<std::string, GLuint>> uniformBlocks;
+        std::vector<std::pair<std::string, GLuint>> storageBlocks;
         
         static GLuint saqVertexShader;
         static bool verbose;
-        static GLuint CreateProgram(const std::vector<GLuint>& compiledShaders, unsigned int doNotDeleteNFirstShaders = 0);
+        static GLuint CompileShader(GLenum shaderType, const std::string& filename, const std::string& header);
     };
 }
 
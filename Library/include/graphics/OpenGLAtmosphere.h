@@ -92,13 +92,20 @@ namespace sf
          */
         void DrawSkyAndSunTemperature(const OpenGLView* view);
         
-        //! A method that bakes the shadow maps for the sun.
+        //! A method that bakes the shadow maps for the sun (reused if the last ones cover the view).
         /*!
          \param pipe a pointer to the rendering pipeline
          \param view a pointer to the current view
          */
         void BakeShadowmaps(OpenGLPipeline* pipe, OpenGLView* view);
         
+        //! A method returning the number of times the sun shadow maps were baked and reused.
+        /*!
+         \param baked a reference to a variable that will store the number of bakes
+         \param reused a reference to a variable that will store the number of reuses
+         */
+        void getShadowmapStats(unsigned long& baked, unsigned long& reused) const;
+        
         //! A method to setup a material shaders.
         void SetupMaterialShaders();
          
@@ -176,6 +183,7 @@ namespace sf
         glm::mat4 BuildCropProjMatrix(ViewFrustum &f);
         void UpdateFrustumCorners(ViewFrustum &f, glm::vec3 center, glm::vec3 dir, glm::vec3 up);
         void UpdateSplitDist(GLfloat nd, GLfloat fd);
+        bool ShadowmapsCoverView(OpenGLPipeline* pipe, OpenGLView* view);
         GLuint sunShadowmapArray;
         GLuint sunDepthSampler;
         GLuint sunShadowSampler;
@@ -186,6 +194,13 @@ namespace sf
         glm::mat4x4 sunModelView;
         ViewFrustum* sunShadowFrustum;
         GLuint sunShadowFBO;
+        GLSLShader* sunShadowCasterShader; //layered rendering of all cascades
+        bool sunShadowValid;
+        unsigned long sunShadowVersion;
+        glm::vec3 sunShadowSunDir;
+        GLfloat sunShadowFar;
+        unsigned long sunShadowBakes;
+        unsigned long sunShadowReuses;
 		GLSLShader* sunShadowmapShader; //debug draw shadowmap
         
         //Rendering
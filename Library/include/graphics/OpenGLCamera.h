@@ -63,6 +63,15 @@ namespace sf
         glm::vec4 jitters[AO_RANDOMTEX_SIZE*AO_RANDOMTEX_SIZE];
     };
  
+    //! A structure holding object culling statistics of a camera view.
+    struct CullingStats
+    {
+        GLuint submitted;
+        GLuint frustumCulled;
+        GLuint occlusionCulled;
+        GLuint drawn;
+    };
+    
     class GLSLShader;
     
     //! An abstract class implementing a camera view.
@@ -132,6 +141,28 @@ namespace sf
         */
         void GenerateLinearDepth(bool front);
         
+        //! A method that culls objects invisible in the current frame.
+        /*!
+         \param objects a reference to a vector of renderables
+         */
+        virtual void CullObjects(const std::vector<Renderable>& objects);
+        
+        //! A method building the hierarchical depth buffer used for occlusion culling in the next frame.
+        void BuildHiZ();
+        
+        //! A method to bind the indirect draw commands written by the occlusion culling pass.
+        void BindDrawCommands();
+        
+        //! A method returning the draw command assigned to a renderable by the culling pass.
+        /*!
+         \param index the index of the renderable in the vector passed to the culling pass
+         \return -2 if culled, -1 if drawn directly, otherwise the index of the indirect draw command
+         */
+        GLint getDrawCommand(size_t index) const;
+        
+        //! A method returning the culling statistics (occlusion culling results lag one frame behind).
+        CullingStats getCullingStats() const;
+        
         //! A method to show the color texture.
         /*!
          \param rect the rectangle in which to render the texture on screen
@@ -246,6 +277,9 @@ namespace sf
 
         //! A method informing if view is using ambient occlusion.
         bool hasAO();
+        
+        //! A method informing if view is using occlusion culling.
+        bool usingOcclusionCulling();
 		
 		//! A method informing if HDR tone mapping is enabled.
 		bool usingToneMapping();
@@ -260,6 +294,9 @@ namespace sf
         static void Destroy();
         
     protected:
+        //! A method returning the view-projection matrix used to extract the culling frustum.
+        virtual glm::mat4 GetCullingViewProjection() const;
+
         //Buffers
         GLuint renderColorTex[2];
         GLuint renderViewNormalTex;
@@ -294,6 +331,21 @@ namespace sf
         GLuint aoDataUBO;
         AOData aoData;
         
+        //Occlusion culling
+        bool occlusionCulling;
+        GLuint hiZTex;
+        GLuint hiZLevels;
+        glm::ivec2 hiZSize;
+        glm::mat4 hiZViewProjection;
+        bool hiZValid;
+        GLuint cullBoundsSSBO;
+        GLuint cullCommandsBuffer;
+        GLuint cullCounterSSBO;
+        bool cullPending;
+        std::vector<GLint> drawCommands;
+        CullingStats pendingStats;
+        CullingStats cullingStats;
+        
         //Data
         GLuint aoFactor;
         GLfloat fovx;
@@ -313,6 +365,8 @@ namespace sf
         static GLSLShader* flipShader;
         static GLSLShader* ssrBlur;
         static GLSLShader* bloomBlur;
+        static GLSLShader* hiZShader;
+        static GLSLShader* occlusionCullShader;
     };
 }
 
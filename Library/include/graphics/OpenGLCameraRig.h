@@ -0,0 +1,142 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLCameraRig.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_OpenGLCameraRig__
+#define __Stonefish_OpenGLCameraRig__
+
+#include "graphics/OpenGLCamera.h"
+
+namespace sf
+{
+    class CameraRig;
+
+    //! A class implementing a rig of identical cameras (stereo pair, multi-camera head) rendered as one view.
+    class OpenGLCameraRig : public OpenGLCamera
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param eyes the number of cameras in the rig
+         \param originX the x coordinate of the view origin in the program window [px]
+         \param originY the y coordinate of the view origin in the program window [px]
+         \param width the width of the view of each camera [px]
+         \param height the height of the view of each camera [px]
+         \param horizontalFovDeg the horizontal field of view of each camera [deg]
+         \param range the minimum and maximum rendering distance of the cameras [m]
+         \param continuousUpdate a flag indicating if the rig has to be always updated
+         */
+        OpenGLCameraRig(unsigned int eyes, GLint originX, GLint originY, GLint width, GLint height,
+                        GLfloat horizontalFovDeg, glm::vec2 range, bool continuousUpdate);
+
+        //! A destructor.
+        ~OpenGLCameraRig();
+
+        //! A method to render the low dynamic range (final) image of the active camera.
+        /*!
+         \param destinationFBO the id of the framebuffer used as the destination for rendering
+         \param updated a flag indicating if view content was updated
+         */
+        void DrawLDR(GLuint destinationFBO, bool updated) override;
+
+        //! A method that culls objects invisible in the current frame (once per rig if the cameras are parallel).
+        /*!
+         \param objects a reference to a vector of renderables
+         */
+        void CullObjects(const std::vector<Renderable>& objects) override;
+
+        //! A method used to set up one of the cameras.
+        /*!
+         \param eye the id of the camera
+         \param position the position of the camera [m]
+         \param dir a unit vector parallel to the camera optical axis
+         \param up a unit vector pointing to the top edge of the image
+         */
+        void SetupEye(unsigned int eye, glm::vec3 position, glm::vec3 dir, glm::vec3 up);
+
+        //! A method selecting the camera that is currently rendered.
+        /*!
+         \param eye the id of the camera
+         */
+        void setActiveEye(unsigned int eye);
+
+        //! A method returning the number of cameras in the rig.
+        unsigned int getNumOfEyes() const;
+
+        //! A method that updates the world transforms of all cameras.
+        void UpdateTransform() override;
+
+        //! A method that flags the rig as needing update.
+        void Update();
+
+        //! A method returning the view matrix of the active camera.
+        glm::mat4 GetViewMatrix() const override;
+
+        //! A method returning the eye position of the active camera.
+        glm::vec3 GetEyePosition() const override;
+
+        //! A method returning a unit vector parallel to the optical axis of the active camera.
+        glm::vec3 GetLookingDirection() const override;
+
+        //! A method returning a unit vector pointing to the top edge of the image of the active camera.
+        glm::vec3 GetUpDirection() const override;
+
+        //! A method returning the type of the view.
+        ViewType getType() const override;
+
+        //! A method to set a pointer to a camera rig sensor.
+        /*!
+         \param rig a pointer to a camera rig sensor
+         */
+        void setCameraRig(CameraRig* rig);
+
+        //! A method that informs if the rig needs update.
+        bool needsUpdate() override;
+
+    protected:
+        glm::mat4 GetCullingViewProjection() const override;
+
+    private:
+        CameraRig* camera;
+        GLuint rigFBO;
+        std::vector<GLuint> eyeColorTex;
+        GLuint rigColorArrayTex;
+        GLuint rigPBO;
+
+        std::vector<glm::vec3> eye;
+        std::vector<glm::vec3> dir;
+        std::vector<glm::vec3> up;
+        std::vector<glm::vec3> tempEye;
+        std::vector<glm::vec3> tempDir;
+        std::vector<glm::vec3> tempUp;
+        std::vector<glm::mat4> eyeTransform;
+        unsigned int activeEye;
+        bool sharedCulling;
+        glm::mat4 rigCullingVP;
+        bool _needsUpdate;
+        bool newData;
+    };
+}
+
+#endif
@@ -54,13 +54,16 @@ namespace sf
     };
     
     #pragma pack(1)
-    //! A structure representing data of the Lights UBO (std140 aligned)
+    //! A structure representing data of the Lights UBO (std140 aligned), light data is stored in SSBOs.
     struct LightsUBO
     {
-        PointLightUBO pointLights[MAX_POINT_LIGHTS];
-        SpotLightUBO spotLights[MAX_SPOT_LIGHTS];
+        glm::vec4 clusterEye;   //Eye position of the view used for clustering
+        glm::vec4 clusterDir;   //Looking direction of the view used for clustering
+        glm::vec4 clusterDepth; //Exponential depth slicing scale and bias, inverse viewport size
+        glm::ivec4 clusterGrid; //Number of clusters in each dimension and max number of lights in a cluster
         GLint numPointLights;
         GLint numSpotLights;
+        uint8_t pad[8];
     };
     //! A structure representing a velocity field UBO (std140 aligned).
     struct VelocityFieldUBO
@@ -215,13 +218,37 @@ namespace sf
          */
         void DrawPrimitives(PrimitiveType type, std::vector<glm::vec3>& vertices, glm::vec4 color, glm::mat4 M = glm::mat4(1.f));
         
+        //! A method to upload (or replace) cached helper geometry.
+        /*!
+         \param id the id of the cached geometry
+         \param type the type of primitives
+         \param vertices a vector of vertices
+         */
+        void UpdateHelperGeometry(int id, PrimitiveType type, const std::vector<glm::vec3>& vertices);
+        
+        //! A method to draw cached helper geometry.
+        /*!
+         \param id the id of the cached geometry
+         \param color the color of the primitives
+         \param M the model matrix
+         */
+        void DrawHelperGeometry(int id, glm::vec4 color, glm::mat4 M = glm::mat4(1.f));
+        
+        //! A method to upload the instance transforms of an object, turning it into an instanced object.
+        /*!
+         \param objectId the id of the graphical object
+         \param instances a vector of pairs of points, defining the position and the forward direction of each instance
+         */
+        void UpdateInstances(int objectId, const std::vector<glm::vec3>& instances);
+        
         //! A method to draw an object.
         /*!
          \param objectId the id of the graphical object
          \param lookId the id of the graphical material
          \param M the model matrix
+         \param drawCommand the index of the indirect draw command to use (-1 means direct draw)
          */
-        void DrawObject(int objectId, int lookId, const glm::mat4& M);
+        void DrawObject(int objectId, int lookId, const glm::mat4& M, GLint drawCommand = -1);
 
         //! A method to draw the light source.
         /*!
@@ -248,6 +275,25 @@ namespace sf
          */
         unsigned int BuildObject(Mesh* mesh);
         
+        //! A method to release the buffers of a graphical object (ids of the other objects stay valid).
+        /*!
+         \param objectId the id of the object
+         */
+        void DestroyObject(int objectId);
+        
+        //! A method to schedule the release of the buffers of a graphical object.
+        /*!
+         \param objectId the id of the object
+         \param queueVersion the first version of the drawing queue which does not refer to the object
+         */
+        void DestroyObjectLater(int objectId, unsigned long queueVersion);
+        
+        //! A method to release the buffers of the objects no longer referred to by the drawing queue.
+        /*!
+         \param queueVersion the version of the drawing queue being rendered
+         */
+        void DestroyScheduledObjects(unsigned long queueVersion);
+        
         //! A method to create a new simple look.
         /*!
          \param name the name of the look
@@ -278,6 +324,23 @@ namespace sf
                                        GLfloat reflectivity = 0.f, const std::string& albedoTexturePath = "", const std::string& normalMapPath = "", 
                                        const std::string& temperatureMapPath = "", glm::vec2 temperatureRange = glm::vec2(20.f));
         
+        //! A method to update an existing physical look in place (textures are reloaded only if their paths changed).
+        /*!
+         \param name the name of the look
+         \param rgbColor the diffuse color
+         \param roughness the roughness of the surface
+         \param metalness the amount of metal look
+         \param relfectivity the amount of reflection
+         \param albedoTexturePath a path to the texture file specifying albedo color
+         \param normalMapPath a path to the texture file specifying surface normal (bump mapping)
+         \param temperatureMapPath a path to the texture file specifying surface temperature
+         \param temperatureRange a pair of values specifying the temperature range represented by the thermal map
+         \return was the look found and updated?
+         */
+        bool UpdatePhysicalLook(const std::string& name, glm::vec3 rgbColor, GLfloat roughness, GLfloat metalness = 0.f, 
+                                GLfloat reflectivity = 0.f, const std::string& albedoTexturePath = "", const std::string& normalMapPath = "", 
+                                const std::string& temperatureMapPath = "", glm::vec2 temperatureRange = glm::vec2(20.f));
+        
         //! A method to use a look.
         /*!
          \param look a reference to the look structure
@@ -306,7 +369,7 @@ namespace sf
         //! A method returning the number of lights.
         size_t getLightsCount();
         
-        //! A method that updates lights UBO.
+        //! A method that updates lights UBO and light buffers.
         void SetupLights();
         
         //! A method returing the id of a look.
@@ -321,6 +384,9 @@ namespace sf
          \param id the id of the object
          */
         const Object& getObject(size_t id);
+        
+        //! A method returning the number of objects.
+        size_t getObjectsCount();
 
         //! A method returning a reference to the look structure.
         /*!
@@ -381,6 +447,12 @@ namespace sf
          */
         static Mesh* LoadMesh(const std::string& filename, GLfloat scale, bool smooth);
         
+        //! A static method to enable caching of the meshes loaded from files.
+        /*!
+         \param enabled a flag indicating if repeated loads should return copies of cached meshes (disabling frees the cache)
+         */
+        static void setMeshCaching(bool enabled);
+        
         //! A static method to build a graphical plane object.
         /*!
          \param halfExtents the size of the plane [m]
@@ -520,6 +592,8 @@ namespace sf
         std::vector<OpenGLView*> views;
         std::vector<OpenGLLight*> lights;
         std::vector<Object> objects; //VBAs
+        std::vector<std::pair<int, unsigned long>> scheduledObjects; //Objects to release and the drawing queue version from which it is safe
+        std::map<int, HelperGeometry> helperGeometry;
         std::vector<Look> looks; //OpenGL materials
         NameManager lookNameManager;
         std::string currentLookName;
@@ -542,12 +616,28 @@ namespace sf
         Object cylinder; //used for approximating fluid dynamics coeffs
         GLuint lightsUBO;
         LightsUBO lightsUBOData;
+        GLuint pointLightsSSBO;
+        GLuint spotLightsSSBO;
+        GLuint lightClustersSSBO;
+        GLuint lightClustersReadback; //Copy of the overflow counter read without stalling
+        GLsync lightClustersFence;
+        bool lightClustersOverflow;
+        std::vector<PointLightUBO> pointLightsData;
+        std::vector<SpotLightUBO> spotLightsData;
         GLuint viewUBO;
         
         //Shaders
         std::map<std::string, GLSLShader*> basicShaders;
         std::vector<MaterialShader> materialShaders;
         GLSLShader* lightSourceShader[2];
+        GLSLShader* lightClusterShader;
+        
+        void BuildLightClusters(OpenGLView* v);
+        void ResetInstanceAttributes();
+        
+        static Mesh* CopyMesh(const Mesh* mesh);
+        static bool meshCaching;
+        static std::map<std::string, Mesh*> meshCache;
     };
 }
 
@@ -84,10 +84,19 @@
 #define SSBO_PARTICLE_VEL       ((GLuint)8)
 #define SSBO_QTREE_INDIRECT     ((GLuint)9)
 #define SSBO_QTREE_SIZE         ((GLuint)10)
+#define SSBO_POINT_LIGHTS       ((GLuint)11)
+#define SSBO_SPOT_LIGHTS        ((GLuint)12)
+#define SSBO_LIGHT_CLUSTERS     ((GLuint)13)
+#define SSBO_CULL_BOUNDS        ((GLuint)14)
+#define SSBO_CULL_COMMANDS      ((GLuint)15)
+#define SSBO_CULL_COUNTER       ((GLuint)16)
 
 //Light params
-#define MAX_POINT_LIGHTS        ((GLint)32)
-#define MAX_SPOT_LIGHTS         ((GLint)32)
+#define LIGHT_CLUSTERS_X        ((GLint)16)
+#define LIGHT_CLUSTERS_Y        ((GLint)9)
+#define LIGHT_CLUSTERS_Z        ((GLint)24)
+#define MAX_CLUSTER_LIGHTS      ((GLint)64)
+#define LIGHT_CUTOFF_LUMINANCE  ((GLfloat)0.001)
 #define MAX_OCEAN_CURRENTS      ((GLint)64)
 #define SPOT_LIGHT_SHADOWMAP_SIZE   ((GLint)2048)
 
@@ -323,6 +332,20 @@ namespace sf
         GLuint vboIndex;
         GLsizei faceCount;
         bool texturable;
+        glm::vec3 aabbMin;
+        glm::vec3 aabbMax;
+        GLuint vboInstance;
+        GLsizei instanceCount;
+        glm::vec3 instanceAabbMin;
+        glm::vec3 instanceAabbMax;
+    };
+    
+    //! A structure representing helper geometry uploaded once and drawn many times.
+    struct HelperGeometry
+    {
+        GLuint vbo;
+        GLsizei vertexCount;
+        PrimitiveType type;
     };
     
     //! An enum representing the rendering mode.
@@ -477,6 +500,9 @@ namespace sf
         GLuint normalMap;
         GLuint temperatureMap;
         glm::vec2 temperatureRange;
+        std::string albedoTexturePath;
+        std::string normalMapPath;
+        std::string temperatureMapPath;
 
         Look()
         {
@@ -536,6 +562,7 @@ namespace sf
         RenderQuality aa;
         RenderQuality ssr;
         bool verticalSync;
+        bool occlusionCulling;
         
         //! A constructor.
         RenderSettings()
@@ -549,6 +576,7 @@ namespace sf
             aa = RenderQuality::MEDIUM;
             ssr = RenderQuality::MEDIUM;
             verticalSync = false;
+            occlusionCulling = false;
         }
     };
     
@@ -578,6 +606,45 @@ namespace sf
         }
     };
     
+    //! An enum defining the pixel format of the camera output.
+    enum class CameraOutputFormat {NATIVE, MONO8, BAYER_RGGB8, BAYER_BGGR8, BAYER_GRBG8, BAYER_GBRG8, DEPTH_UINT16};
+    
+    //! A structure containing settings of the camera output stage, executed on the GPU before the data transfer.
+    struct CameraOutputSettings
+    {
+        GLuint roiX;
+        GLuint roiY;
+        GLuint roiWidth;
+        GLuint roiHeight;
+        GLuint binning;
+        CameraOutputFormat format;
+        GLfloat depthScale;
+        
+        //! A constructor.
+        CameraOutputSettings()
+        {
+            roiX = 0;
+            roiY = 0;
+            roiWidth = 0; //Zero means up to the image edge
+            roiHeight = 0;
+            binning = 1;
+            format = CameraOutputFormat::NATIVE;
+            depthScale = 1000.f; //Depth in millimetres
+        }
+        
+        //! A method informing if the output is identical to the rendered image.
+        /*!
+         \param width the width of the rendered image [px]
+         \param height the height of the rendered image [px]
+         \return true if the output stage can be skipped
+         */
+        bool isPassThrough(GLuint width, GLuint height) const
+        {
+            return roiX == 0 && roiY == 0 && (roiWidth == 0 || roiWidth == width) && (roiHeight == 0 || roiHeight == height)
+                   && binning <= 1 && format == CameraOutputFormat::NATIVE;
+        }
+    };
+    
     typedef btTransform Transform;
     typedef btVector3 Vector3;
     
@@ -33,6 +33,7 @@ namespace sf
 {
     class GLSLShader;
     class Camera;
+    class OpenGLOutputStage;
     class SolidEntity;
     
     //! A class representing a depth camera.
@@ -171,6 +172,7 @@ namespace sf
         GLuint linearDepthTex;
         GLuint linearDepthFBO;
         GLuint linearDepthPBO;
+        OpenGLOutputStage* outputStage;
         static GLSLShader** depthCameraOutputShader;
         static GLSLShader* depthVisualizeShader;
     };
@@ -0,0 +1,111 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLMultiCamera.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_OpenGLMultiCamera__
+#define __Stonefish_OpenGLMultiCamera__
+
+#include "graphics/OpenGLRealCamera.h"
+
+namespace sf
+{
+    class GLSLShader;
+
+    //! A class implementing a camera producing colour, depth, segmentation and optical flow from a single view.
+    class OpenGLMultiCamera : public OpenGLRealCamera
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param eyePosition the position of the camera eye in world space [m]
+         \param direction a unit vector parallel to the camera optical axis
+         \param cameraUp a unit vector pointing to the top edge of the image
+         \param originX the x coordinate of the view origin in the program window [px]
+         \param originY the y coordinate of the view origin in the program window [px]
+         \param width the width of the view [px]
+         \param height the height of the view [px]
+         \param horizontalFovDeg the horizontal field of view of the camera [deg]
+         \param range the minimum and maximum rendering distance of the camera [m]
+         \param continuousUpdate a flag indicating if this camera has to be always updated
+         */
+        OpenGLMultiCamera(glm::vec3 eyePosition, glm::vec3 direction, glm::vec3 cameraUp,
+                          GLint originX, GLint originY, GLint width, GLint height,
+                          GLfloat horizontalFovDeg, glm::vec2 range, bool continuousUpdate);
+
+        //! A destructor.
+        ~OpenGLMultiCamera();
+
+        //! A method that renders the depth, segmentation and optical flow outputs in a single geometry pass.
+        /*!
+         \param objects a reference to a vector of renderable objects
+         \param culled a flag indicating if the objects were already culled for this view
+         */
+        void ComputeOutput(std::vector<Renderable>& objects, bool culled);
+
+        //! A method to render the low dynamic range (final) image to the screen.
+        /*!
+         \param destinationFBO the id of the framebuffer used as the destination for rendering
+         \param updated a flag indicating if view content was updated
+         */
+        void DrawLDR(GLuint destinationFBO, bool updated) override;
+
+        //! A method that updates camera world transform.
+        void UpdateTransform();
+
+        //! A method to enable the outputs of the camera.
+        /*!
+         \param color a flag indicating if the lit colour image is rendered
+         \param depth a flag indicating if the depth image is rendered
+         \param segmentation a flag indicating if the object id image is rendered
+         \param flow a flag indicating if the optical flow image is rendered
+         */
+        void setOutputs(bool color, bool depth, bool segmentation, bool flow);
+
+        //! A method informing if the lit colour image is rendered.
+        bool isColorEnabled() const;
+
+        //! A method returning the type of the view.
+        ViewType getType() const override;
+
+        //! A static method to load shaders.
+        static void Init();
+
+        //! A static method to destroy shaders.
+        static void Destroy();
+
+    private:
+        GLuint auxFBO;
+        GLuint auxDepthTex;
+        GLuint auxTex[3];
+        GLuint auxFlipTex[3];
+        GLuint auxPBO[3];
+        bool outputEnabled[4];
+        bool newAuxData;
+        GLfloat focalLength;
+
+        static GLSLShader* multiOutputShader;
+    };
+}
+
+#endif
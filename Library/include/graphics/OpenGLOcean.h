@@ -212,12 +212,24 @@ namespace sf
          \return wave height [m]
          */
         virtual GLfloat ComputeWaveHeight(GLfloat x, GLfloat y);
+        
+        //! A method making the latest wave data available to the wave height computation (called by the simulation thread).
+        virtual void AcquireWaveData();
 
         //! A method returning the id of the wave texture.
         GLuint getWaveTexture();
 
         //! A method returning the vector of wave grid sizes.
         glm::vec4 getWaveGridSizes();
+        
+        //! A method to set the horizontal position of the original world origin, at which the waves are sampled.
+        /*!
+         \param origin the position of the current world origin in the original world frame [m]
+         */
+        void setWaveOrigin(const glm::vec2& origin);
+        
+        //! A method returning the horizontal position of the current world origin in the original world frame.
+        glm::vec2 getWaveOrigin();
 
         //! A method returning calculated light attenuation coefficient.
         glm::vec3 getLightAttenuation();
@@ -234,6 +246,7 @@ namespace sf
         glm::vec3 scattering[64];
         OceanCurrentsUBO oceanCurrentsUBOData;
         GLfloat oceanSize;
+        glm::vec2 waveOrigin;
         OceanParams params;
         glm::vec3 lightAbsorption;
         glm::vec3 lightScattering;
@@ -0,0 +1,86 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLOutputStage.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_OpenGLOutputStage__
+#define __Stonefish_OpenGLOutputStage__
+
+#include "graphics/OpenGLDataStructs.h"
+
+namespace sf
+{
+    class GLSLShader;
+    
+    //! An enum defining the type of data processed by the output stage.
+    enum class OutputStageSource {COLOR, DEPTH, ID};
+    
+    //! A class implementing the GPU-side cropping, binning and format conversion of camera images, before the data transfer.
+    class OpenGLOutputStage
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param source the type of data stored in the source texture
+         \param settings the output settings (ROI already clamped to the image size)
+         */
+        OpenGLOutputStage(OutputStageSource source, const CameraOutputSettings& settings);
+        
+        //! A destructor.
+        ~OpenGLOutputStage();
+        
+        //! A method that processes the source texture and starts the transfer of the result to the pixel buffer.
+        /*!
+         \param sourceTexture the id of the source texture
+         \param flipHeight the height of the source texture if it has to be flipped vertically, 0 otherwise
+         \param destinationPBO the id of the pixel buffer object receiving the output data
+         */
+        void Process(GLuint sourceTexture, GLint flipHeight, GLuint destinationPBO);
+        
+        //! A method returning the size of the output image [px].
+        glm::uvec2 getOutputSize() const;
+        
+        //! A method returning the size of the output data [B].
+        GLsizeiptr getDataSize() const;
+        
+        //! A static method to load shaders.
+        static void Init();
+        
+        //! A static method to destroy shaders.
+        static void Destroy();
+        
+    private:
+        CameraOutputSettings settings;
+        glm::uvec2 size;
+        GLuint outputTex;
+        GLuint outputFBO;
+        GLenum outputFormat;
+        GLenum outputType;
+        GLuint pixelSize;
+        GLSLShader* shader;
+        
+        static GLSLShader* outputShaders[4];
+    };
+}
+
+#endif
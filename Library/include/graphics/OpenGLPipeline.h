@@ -34,6 +34,8 @@
 namespace sf
 {
     class SimulationManager;
+    class Ocean;
+    class Atmosphere;
     class OpenGLContent;
     class OpenGLCamera;
 
@@ -76,7 +78,10 @@ namespace sf
         void AddToSelectedDrawingQueue(const std::vector<Renderable>& r);
 		
         //! A method that draws all normal objects.
-        void DrawObjects();
+        /*!
+         \param view an optional pointer to a camera whose culling results should be used
+         */
+        void DrawObjects(OpenGLCamera* view = nullptr);
 		
 		//! A method that draws all lights.
 		void DrawLights();
@@ -108,8 +113,21 @@ namespace sf
         //! A method returning a pointer to the OpenGL content manager.
         OpenGLContent* getContent();
         
+        //! A method returning the objects being rendered in the current frame.
+        const std::vector<Renderable>& getDrawingQueue() const;
+        
+        //! A method returning a counter incremented every time new objects are copied for rendering.
+        unsigned long getDrawingQueueVersion() const;
+        
+        //! A method scheduling the release of a graphical object, done by the rendering thread once no drawing queue refers to it.
+        /*!
+         \param objectId the id of the object
+         */
+        void ReleaseObject(int objectId);
+        
     private:
         void PerformDrawingQueueCopy(SimulationManager* sim);
+        void DrawLitView(OpenGLCamera* camera, Ocean* ocean, Atmosphere* atm, unsigned int renderMode);
         void DrawHelpers();
         
         RenderSettings rSettings;
@@ -124,6 +142,7 @@ namespace sf
         GLuint screenTex;
         OpenGLContent* content;
         Scalar lastSimTime;
+        unsigned long drawingQueueVersion;
     };
 }
 
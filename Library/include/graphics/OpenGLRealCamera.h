@@ -30,7 +30,8 @@
 
 namespace sf
 {
-    class ColorCamera;
+    class Camera;
+    class OpenGLOutputStage;
  
     //! A class implementing a real camera in OpenGL.
     class OpenGLRealCamera : public OpenGLCamera
@@ -99,16 +100,17 @@ namespace sf
         /*!
          \param cam a pointer to a camera sensor
          */
-        void setCamera(ColorCamera* cam);
+        void setCamera(Camera* cam);
          
         //! A method that informs if the camera needs update.
         bool needsUpdate() override;
         
-    private:
-        ColorCamera* camera;
+    protected:
+        Camera* camera;
         GLuint cameraFBO;
         GLuint cameraColorTex[2];
         GLuint cameraPBO;
+        OpenGLOutputStage* outputStage;
         
         glm::mat4 cameraTransform;
         glm::vec3 eye;
@@ -27,7 +27,7 @@
 #define __Stonefish_OpenGLRealOcean__
 
 #include "graphics/OpenGLOcean.h"
-#include <SDL2/SDL_mutex.h>
+#include <atomic>
 
 namespace sf
 {
@@ -49,9 +49,8 @@ namespace sf
         /*!
          \param size the size of the ocean surface mesh [m]
          \param state the state of the ocean, if >0 the ocean is rendered with geometric waves otherwise as a plane with wave texture
-         \param hydrodynamics a pointer to a mutex
          */
-        OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrodynamics);
+        OpenGLRealOcean(GLfloat size, GLfloat state);
         
         //! A destructor.
         ~OpenGLRealOcean();
@@ -105,6 +104,9 @@ namespace sf
          \return wave height [m]
          */
         GLfloat ComputeWaveHeight(GLfloat x, GLfloat y) override;
+        
+        //! A method making the latest wave data available to the wave height computation (called by the simulation thread).
+        void AcquireWaveData() override;
 
         //! A method do enable wireframe rendering.
         /*!
@@ -120,8 +122,10 @@ namespace sf
         GLuint oceanBuffers[2];
         GLuint fftPBO;
         std::map<OpenGLView*, OceanQT> oceanTrees; 
-        SDL_mutex* hydroMutex;
-        GLfloat* fftData;
+        GLfloat* fftData[3]; //Triple buffer of wave data: written by the renderer, published, read by the simulation
+        GLuint fftWrite;
+        std::atomic<GLuint> fftPublished; //Index of the published buffer (+4 if not acquired yet)
+        std::atomic<GLuint> fftRead;
         GLint qtGridTessFactor;
         GLint qtGPUTessFactor;
         GLint qtPatchIndexCount;
@@ -35,6 +35,7 @@ namespace sf
     class Camera;
     class SolidEntity;
     class Ocean;
+    class OpenGLOutputStage;
     
     //! A class representing a depth camera.
     class OpenGLSegmentationCamera : public OpenGLView
@@ -157,6 +158,7 @@ namespace sf
         GLuint displaySegTex;
         GLuint outputPBO;
         GLuint displayPBO;
+        OpenGLOutputStage* outputStage[2];
         GLuint displayFBO;
         GLuint displayVAO;
         GLuint displayVBO;
@@ -73,8 +73,17 @@ namespace sf
          */
         void GlueToMoving(MovingEntity* ent);
         
+        //! A method returning the moving body the trackball is glued to.
+        MovingEntity* getHoldingEntity() const;
+        
         //! A method saving the new centre for update.
         void UpdateCenterPos();
+        
+        //! A method saving a shift of the world origin for update.
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const glm::vec3& shift);
 
         //! A method used to update the trasformation of the trackball.
         void UpdateTransform();
@@ -133,6 +142,7 @@ namespace sf
         MovingEntity* holdingEntity;
         
         glm::vec3 tempCenter;
+        glm::vec3 tempShift;
         glm::mat4 trackballTransform;
         glm::quat rotation;
         glm::vec3 center;
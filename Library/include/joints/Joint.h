@@ -88,11 +88,24 @@ namespace sf
         
         //! A method returning joint feedback in the world frame.
         /*!
+         If the feedback was never enabled or requested, it is enabled by the first call, which returns zero.
          \param dof degree of freedom for which the feedback is desired
          \return value of force/torque for the specified degree of freedom
          */
         Scalar getFeedback(unsigned int dof);
         
+        //! A method used to compute the joint feedback in every simulation step (by default it is only computed for the force-torque sensors).
+        /*!
+         \param enabled a flag indicating if the feedback should be computed in every step
+         */
+        void setFeedbackEnabled(bool enabled);
+        
+        //! A method used to request the computation of the joint feedback in the next simulation step.
+        void RequestFeedback();
+        
+        //! A method used to stop the computation of the joint feedback (requests are renewed before every step).
+        void ClearFeedbackRequest();
+        
         //! A method that informs if the joint is of multibody type.
         bool isMultibodyJoint();
 
@@ -113,6 +126,8 @@ namespace sf
     private:
         std::string name;
         bool collisionEnabled;
+        btJointFeedback* feedback;
+        bool feedbackEnabled;
     };
 }
 
@@ -116,6 +116,9 @@ namespace sf
         //! A method returning the angular velocity of the joint [rad*s^-1]/
         Scalar getAngularVelocity();
         
+        //! A method returning the effective inertia of the connected bodies about the joint axis [kg*m^2].
+        Scalar getEffectiveInertia();
+        
         //! A method returning the type of the joint.
         JointType getType() const;
         
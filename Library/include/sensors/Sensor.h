@@ -63,6 +63,13 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        //! A method informing if the sensor will produce a new sample in the next update.
+        /*!
+         \param dt a time step of the simulation [s]
+         \return true if the next update will run the internal update of the sensor
+         */
+        bool isUpdateDue(Scalar dt) const;
+        
         //! A method used to mark data as old.
         void MarkDataOld();
 
@@ -116,11 +123,20 @@ namespace sf
         virtual void getSensorVelocity(Vector3& linear, Vector3& angular) const = 0;
         
     protected:
+        //! A method preparing a renderable that draws the cached visualisation geometry of the sensor.
+        /*!
+         \param item a reference to the renderable to be prepared
+         \return true if the cached geometry is outdated and its points have to be generated (in the sensor frame)
+         */
+        bool PrepareVisualisation(Renderable& item);
+        
+        //! A method used to mark the cached visualisation geometry as outdated.
+        void InvalidateVisualisation();
+        
         Scalar freq;
         SDL_mutex* updateMutex;
         
-        static std::random_device randomDevice;
-        static std::mt19937 randomGenerator;
+        std::mt19937 randomGenerator; //Independent stream of each sensor (reseeded on reset)
         
     private:
         std::string name;
@@ -130,6 +146,10 @@ namespace sf
         bool enabled;
         int lookId;
         int graObjectId;
+        int visualisationId;
+        bool visualisationOutdated;
+        
+        static int nextVisualisationId;
     };
 }
 
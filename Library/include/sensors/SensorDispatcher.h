@@ -0,0 +1,182 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SensorDispatcher.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_SensorDispatcher__
+#define __Stonefish_SensorDispatcher__
+
+#include <SDL2/SDL_mutex.h>
+#include <SDL2/SDL_thread.h>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace sf
+{
+    //! An enum defining what happens when a new sample arrives to a full dispatch queue.
+    enum class QueueOverflowPolicy {DROP_OLDEST, DROP_NEWEST, BLOCK};
+    
+    //! A structure holding the statistics of a sensor dispatch queue.
+    struct DispatchQueueStats
+    {
+        size_t depth; //!< Number of samples waiting for the callback.
+        size_t maxDepth; //!< Highest number of samples waiting for the callback.
+        uint64_t dispatched; //!< Number of callbacks executed.
+        uint64_t dropped; //!< Number of samples dropped because the queue was full.
+        
+        //! A constructor.
+        DispatchQueueStats() : depth(0), maxDepth(0), dispatched(0), dropped(0) {}
+    };
+    
+    //! A type describing a data segment of a sample (pointer and size [B]).
+    typedef std::pair<const void*, size_t> DispatchSegment;
+    
+    //! A structure representing a sample waiting for the callback.
+    struct DispatchSample
+    {
+        std::vector<uint8_t> data; //!< Copy of all data segments.
+        std::vector<size_t> sizes; //!< Sizes of the data segments [B].
+        std::function<void(void*)> callback; //!< Function exposing the data and running the user callback (single segment).
+        std::function<void(const std::vector<void*>&)> multiCallback; //!< Function exposing the data and running the user callback (many segments).
+    };
+    
+    //! A structure representing a bounded queue of samples of a single sensor.
+    /*!
+     The queue is a ring buffer of the queue capacity and the samples are recycled, so queuing stops allocating memory
+     once the number of samples in use (at most the capacity plus two) and their buffers reached their peak.
+     */
+    struct DispatchChannel
+    {
+        size_t capacity; //!< Maximum number of samples waiting for the callback.
+        QueueOverflowPolicy policy; //!< Behaviour when the queue is full.
+        std::vector<DispatchSample*> queue; //!< Samples waiting for the callback (ring buffer).
+        size_t head; //!< Index of the oldest waiting sample.
+        size_t depth; //!< Number of waiting samples.
+        std::vector<DispatchSample*> pool; //!< Recycled samples (reused buffers).
+        DispatchQueueStats stats; //!< Queue statistics.
+        bool attached; //!< Is the channel served by the dispatcher?
+        bool busy; //!< Is a callback of the channel being executed?
+        bool scheduled; //!< Is the channel waiting for a worker?
+        
+        //! A constructor.
+        DispatchChannel() : capacity(1), policy(QueueOverflowPolicy::DROP_OLDEST), queue(1, nullptr), head(0), depth(0), attached(false), busy(false), scheduled(false) {}
+        
+        //! A destructor.
+        ~DispatchChannel();
+        
+        //! A method changing the capacity of the queue (the oldest samples are recycled if they do not fit).
+        void Resize(size_t newCapacity);
+        
+        //! A method adding a sample at the end of the queue (the queue has to have space).
+        void PushBack(DispatchSample* s);
+        
+        //! A method taking the oldest sample from the queue (the queue has to be non-empty).
+        DispatchSample* PopFront();
+        
+        //! A method moving all waiting samples to the pool.
+        void Clear();
+    };
+    
+    //! A class implementing a pool of worker threads running sensor callbacks outside of the simulation and rendering threads.
+    /*!
+     Callbacks of a single channel are executed in order and never concurrently, so a sensor can expose the dispatched
+     data through its usual interface for the duration of the callback.
+     */
+    class SensorDispatcher
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param workers the number of worker threads
+         */
+        SensorDispatcher(unsigned int workers);
+        
+        //! A destructor.
+        ~SensorDispatcher();
+        
+        //! A method attaching a channel to the dispatcher.
+        /*!
+         \param ch a pointer to the channel
+         \param capacity the maximum number of samples waiting for the callback
+         \param policy the behaviour when a new sample arrives to a full queue
+         */
+        void Attach(DispatchChannel* ch, size_t capacity, QueueOverflowPolicy policy);
+        
+        //! A method detaching a channel from the dispatcher (waits for the running callback and discards waiting samples).
+        /*!
+         \param ch a pointer to the channel
+         */
+        void Detach(DispatchChannel* ch);
+        
+        //! A method detaching all channels from the dispatcher.
+        void DetachAll();
+        
+        //! A method copying a sample with a single data segment and placing it in the queue of a channel.
+        /*!
+         \param ch a pointer to the channel
+         \param segment the data of the sample (pointer and size [B])
+         \param callback a function exposing the data and running the user callback
+         \return true if the sample was queued
+         */
+        bool Push(DispatchChannel* ch, const DispatchSegment& segment, const std::function<void(void*)>& callback);
+        
+        //! A method copying a sample and placing it in the queue of a channel.
+        /*!
+         \param ch a pointer to the channel
+         \param segments an array of data segments of the sample (pointer and size [B])
+         \param count the number of data segments
+         \param callback a function exposing the data and running the user callback
+         \return true if the sample was queued
+         */
+        bool Push(DispatchChannel* ch, const DispatchSegment* segments, size_t count, 
+                  const std::function<void(const std::vector<void*>&)>& callback);
+        
+        //! A method returning the statistics of a channel.
+        /*!
+         \param ch a pointer to the channel
+         \return statistics of the queue
+         */
+        DispatchQueueStats getStats(DispatchChannel* ch);
+        
+        //! A method returning the number of worker threads.
+        unsigned int getNumOfWorkers() const;
+        
+    private:
+        DispatchSample* Acquire(DispatchChannel* ch);
+        void Fill(DispatchSample* s, const DispatchSegment* segments, size_t count);
+        bool Enqueue(DispatchChannel* ch, DispatchSample* s);
+        static int WorkerLoop(void* data);
+        
+        std::vector<SDL_Thread*> threads;
+        std::vector<DispatchChannel*> channels;
+        std::vector<DispatchChannel*> ready; //Channels waiting for a worker, in order (reserved for all channels)
+        SDL_mutex* mutex;
+        SDL_cond* workAvailable;
+        SDL_cond* workDone;
+        bool stopping;
+    };
+}
+
+#endif
@@ -27,12 +27,13 @@
 #define __Stonefish_VisionSensor__
 
 #include "sensors/Sensor.h"
+#include "sensors/SensorDispatcher.h"
 
 namespace sf
 {
     //! An enum defining types of vision sensors.
     enum class VisionSensorType {COLOR_CAMERA, DEPTH_CAMERA, THERMAL_CAMERA, EVENT_BASED_CAMERA, 
-                                    OPTICAL_FLOW_CAMERA, SEGMENTATION_CAMERA, MULTIBEAM2, FLS, SSS, MSIS};
+                                    OPTICAL_FLOW_CAMERA, SEGMENTATION_CAMERA, MULTIBEAM2, FLS, SSS, MSIS, MULTI_CAMERA, CAMERA_RIG};
     
     class Entity;
     class StaticEntity;
@@ -82,6 +83,12 @@ namespace sf
          */
         void AttachToSolid(MovingEntity* body, const Transform& origin);
         
+        //! A method used to move the device when the simulation world is re-centred (only affects devices attached to the world).
+        /*!
+         \param shift the position of the new world origin in the old world frame [m]
+         */
+        void ShiftOrigin(const Vector3& shift);
+        
         //! A method used to set the sensor frame in the body frame.
         /*!
          \param origin a tranformation from the body frame to the sensor frame
@@ -107,12 +114,51 @@ namespace sf
         //! A method returning a pointer to the underlaying OpenGLView object.
         virtual OpenGLView* getOpenGLView() const = 0;
         
+        //! A method used to run the new data callback on a worker thread, instead of the rendering thread.
+        /*!
+         \param queueDepth the maximum number of samples waiting for the callback (0 restores direct calls)
+         \param policy the behaviour when a new sample arrives to a full queue
+         */
+        void setAsyncDispatch(unsigned int queueDepth, QueueOverflowPolicy policy = QueueOverflowPolicy::DROP_OLDEST);
+        
+        //! A method informing if the new data callback runs on a worker thread.
+        bool isAsyncDispatch() const;
+        
+        //! A method returning the statistics of the callback queue.
+        DispatchQueueStats getDispatchQueueStats() const;
+        
     protected:
         virtual void InitGraphics() = 0;
         
+        //! A method running the new data callback, directly or through the asynchronous dispatcher.
+        /*!
+         \param data a pointer to the sensor data (valid only during the call)
+         \param size the size of the data [B]
+         \param callback a function exposing the data through the sensor interface and running the user callback
+         */
+        void DispatchNewData(void* data, size_t size, const std::function<void(void*)>& callback);
+        
+        //! A method running the new data callback, directly or through the asynchronous dispatcher.
+        /*!
+         \param segments an array of pointers to the data segments and their sizes [B] (valid only during the call)
+         \param count the number of data segments
+         \param callback a function exposing the data through the sensor interface and running the user callback
+         */
+        void DispatchNewData(const DispatchSegment* segments, size_t count, 
+                             const std::function<void(const std::vector<void*>&)>& callback);
+        
+        //! A method stopping the asynchronous dispatch and waiting for the running callback.
+        /*!
+         Has to be called at the beginning of the destructor of every sensor using DispatchNewData,
+         because the dispatched callbacks access the members of the derived class.
+         */
+        void StopDispatch();
+        
     private:
         Entity* attach;
         Transform o2s;
+        mutable DispatchChannel dispatch;
+        std::vector<void*> segmentPtrs;
     };
 }
 
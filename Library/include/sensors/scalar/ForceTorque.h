@@ -61,6 +61,12 @@ namespace sf
          */
         void InternalUpdate(Scalar dt) override;
         
+        //! A method requesting the joint feedback for the simulation steps that are sampled.
+        /*!
+         \param dt a time step of the simulation [s]
+         */
+        void PrepareUpdate(Scalar dt) override;
+        
         //! A method used to set the range of the sensor.
         /*!
          \param forceMax a vector representing the maximum measured forces [N]
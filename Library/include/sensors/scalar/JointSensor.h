@@ -58,6 +58,12 @@ namespace sf
          */
         virtual void AttachToJoint(Joint* joint);
         
+        //! A method called before every simulation step, used to request the joint data needed by the next update.
+        /*!
+         \param dt a time step of the simulation [s]
+         */
+        virtual void PrepareUpdate(Scalar dt);
+        
         //! A method returning the type of the sensor.
         SensorType getType() const;
         
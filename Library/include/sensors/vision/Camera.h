@@ -27,6 +27,7 @@
 #define __Stonefish_Camera__
 
 #include "sensors/VisionSensor.h"
+#include "graphics/OpenGLDataStructs.h"
 
 namespace sf
 {
@@ -96,6 +97,22 @@ namespace sf
          */
         void getResolution(unsigned int& x, unsigned int& y) const;
         
+        //! A method used to define the output stage of the camera (has to be called before adding the sensor to the simulation).
+        /*!
+         \param settings the region of interest, binning and format of the output image
+         */
+        virtual void setOutputSettings(const CameraOutputSettings& settings);
+        
+        //! A method returning the settings of the output stage.
+        CameraOutputSettings getOutputSettings() const;
+        
+        //! A method returning the resolution of the image delivered to the user (after cropping and binning).
+        /*!
+         \param x a reference to a variable that will store the horizontal resolution [pix]
+         \param y a reference to a variable that will store the vertical resolution [pix]
+         */
+        void getOutputResolution(unsigned int& x, unsigned int& y) const;
+        
         //! A method returning the pointer to the image data.
         /*!
          \param index the id of the OpenGL camera for which the data pointer is requested
@@ -104,9 +121,17 @@ namespace sf
         virtual void* getImageDataPointer(unsigned int index = 0) = 0;
         
     protected:
+        //! A method returning the size of the image data delivered to the user.
+        /*!
+         \param nativePixelSize the size of a pixel in the native format [B]
+         \return the size of the image data after cropping, binning and format conversion [B]
+         */
+        size_t getOutputDataSize(size_t nativePixelSize) const;
+        
         Scalar fovH;
         unsigned int resX;
         unsigned int resY;
+        CameraOutputSettings outputSettings;
         unsigned int screenX;
         unsigned int screenY;
         float screenScale;
@@ -0,0 +1,133 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  CameraRig.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_CameraRig__
+#define __Stonefish_CameraRig__
+
+#include <functional>
+#include "sensors/vision/Camera.h"
+
+namespace sf
+{
+    class OpenGLCameraRig;
+    
+    //! A class representing a rig of identical color cameras (stereo pair, multi-camera head) rendered and read back together.
+    class CameraRig : public Camera
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param uniqueName a name for the sensor
+         \param resolutionX the horizontal resolution of each camera [pix]
+         \param resolutionY the vertical resolution of each camera [pix]
+         \param hFOVDeg the horizontal field of view of each camera [deg]
+         \param frequency the sampling frequency of the sensor [Hz] (-1 if updated every simulation step)
+         \param minDistance the minimum drawing distance [m]
+         \param maxDistance the maximum drawing distance [m]
+         */
+        CameraRig(std::string uniqueName, unsigned int resolutionX, unsigned int resolutionY, Scalar hFOVDeg, Scalar frequency = Scalar(-1),
+           Scalar minDistance = Scalar(STD_NEAR_PLANE_DISTANCE), Scalar maxDistance = Scalar(STD_FAR_PLANE_DISTANCE));
+        
+        //! A destructor.
+        ~CameraRig();
+
+        //! A method used to add a camera to the rig (has to be called before adding the sensor to the simulation).
+        /*!
+         \param origin the pose of the camera with respect to the rig frame (z axis along the optical axis, y axis pointing down the image)
+         */
+        void AddEye(const Transform& origin);
+        
+        //! A method performing internal sensor state update.
+        /*!
+         \param dt the step time of the simulation [s]
+         */
+        void InternalUpdate(Scalar dt) override;
+        
+        //! A method used to setup the OpenGL camera transformations.
+        /*!
+         \param eye the position of the rig origin [m]
+         \param dir a unit vector parallel to the z axis of the rig
+         \param up a unit vector opposite to the y axis of the rig
+         */
+        void SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up) override;
+        
+        //! A method used to inform about new data.
+        /*!
+         \param data a pointer to the images of all cameras, stored one after another
+         \param index unused
+         */
+        void NewDataReady(void* data, unsigned int index = 0) override;
+        
+        //! A method used to set a callback function called when the images of all cameras are available.
+        /*!
+         \param callback a function to be called
+         */
+        void InstallNewDataHandler(std::function<void(CameraRig*)> callback);
+        
+        //! A method used to set the exposure compensation factor (common for all cameras).
+        /*!
+         \param comp the exposure compensation value [EV]
+         */
+        void setExposureCompensation(Scalar comp);
+        
+        //! A method returning the exposure compensation factor [EV].
+        Scalar getExposureCompensation() const;
+        
+        //! A method returning the pose of a camera with respect to the rig frame.
+        /*!
+         \param index the id of the camera
+         \return the pose of the camera
+         */
+        Transform getEyeOrigin(unsigned int index) const;
+        
+        //! A method returning the number of cameras in the rig.
+        unsigned int getNumOfEyes() const;
+    
+        //! A method returning the pointer to the image data of one camera (valid only inside the callback).
+        /*!
+         \param index the id of the camera
+         \return pointer to the image data buffer (RGB8)
+         */
+        void* getImageDataPointer(unsigned int index = 0) override;
+        
+        //! A method returning the type of the vision sensor.
+        VisionSensorType getVisionSensorType() const override;
+        
+        //! A method returning a pointer to the underlaying OpenGLView object.
+        OpenGLView* getOpenGLView() const override;
+
+    private:
+        void InitGraphics();
+        
+        OpenGLCameraRig* glCamera;
+        glm::vec2 depthRange;
+        std::vector<Transform> eyeOrigins;
+        std::vector<void*> imageData;
+        std::vector<DispatchSegment> segments; //Reused for every frame
+        std::function<void(CameraRig*)> newDataCallback;
+    };
+}
+
+#endif
@@ -91,6 +91,12 @@ namespace sf
          */
         void setNoise(float sigmaCp, float sigmaCm);
         
+        //! A method used to define the output stage of the camera (not supported, full event arrays are always delivered).
+        /*!
+         \param settings the region of interest, binning and format of the output image
+         */
+        void setOutputSettings(const CameraOutputSettings& settings) override;
+        
         //! A method returning the pointer to the image data.
         /*!
          \param index the id of the OpenGL camera for which the data pointer is requested
@@ -0,0 +1,135 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  MultiCamera.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_MultiCamera__
+#define __Stonefish_MultiCamera__
+
+#include <functional>
+#include "sensors/vision/Camera.h"
+#include "graphics/OpenGLDataStructs.h"
+
+namespace sf
+{
+    //! An enum defining the outputs of a multi-output camera.
+    enum class MultiCameraOutput {COLOR = 0, DEPTH, SEGMENTATION, OPTICAL_FLOW};
+
+    class OpenGLMultiCamera;
+    
+    //! A class representing a camera producing colour, depth, segmentation and optical flow images from one view.
+    class MultiCamera : public Camera
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param uniqueName a name for the sensor
+         \param resolutionX the horizontal resolution [pix]
+         \param resolutionY the vertical resolution[pix]
+         \param hFOVDeg the horizontal field of view [deg]
+         \param frequency the sampling frequency of the sensor [Hz] (-1 if updated every simulation step)
+         \param minDistance the minimum drawing distance [m]
+         \param maxDistance the maximum drawing distance [m]
+         */
+        MultiCamera(std::string uniqueName, unsigned int resolutionX, unsigned int resolutionY, Scalar hFOVDeg, Scalar frequency = Scalar(-1),
+           Scalar minDistance = Scalar(STD_NEAR_PLANE_DISTANCE), Scalar maxDistance = Scalar(STD_FAR_PLANE_DISTANCE));
+        
+        //! A destructor.
+        ~MultiCamera();
+        
+        //! A method performing internal sensor state update.
+        /*!
+         \param dt the step time of the simulation [s]
+         */
+        void InternalUpdate(Scalar dt) override;
+        
+        //! A method used to setup the OpenGL camera transformation.
+        /*!
+         \param eye the position of the camera eye [m]
+         \param dir a unit vector parallel to the optical axis of the camera
+         \param up a unit vector pointing up (from center of image to the top edge of the image)
+         */
+        void SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up) override;
+        
+        //! A method used to inform about new data.
+        /*!
+         \param data a pointer to the OpenGL texture data
+         \param index the id of the output (see MultiCameraOutput)
+         */
+        void NewDataReady(void* data, unsigned int index = 0) override;
+        
+        //! A method used to set a callback function called when all enabled outputs are available.
+        /*!
+         \param callback a function to be called
+         */
+        void InstallNewDataHandler(std::function<void(MultiCamera*)> callback);
+
+        //! A method used to enable or disable an output (has to be called before adding the sensor to the simulation).
+        /*!
+         \param output the output type
+         \param enabled a flag indicating if the output should be rendered
+         */
+        void setOutputEnabled(MultiCameraOutput output, bool enabled);
+
+        //! A method informing if an output is enabled.
+        /*!
+         \param output the output type
+         \return a flag indicating if the output is rendered
+         */
+        bool isOutputEnabled(MultiCameraOutput output) const;
+        
+        //! A method used to set the exposure compensation factor.
+        /*!
+         \param comp the exposure compensation value [EV]
+         */
+        void setExposureCompensation(Scalar comp);
+        
+        //! A method returning the exposure compensation factor [EV].
+        Scalar getExposureCompensation() const;
+    
+        //! A method returning the pointer to the image data (valid only inside the callback).
+        /*!
+         \param index the id of the output (see MultiCameraOutput)
+         \return pointer to the image data buffer (RGB8, 32-bit float depth [m], 16-bit object id or 2x32-bit float flow [px/s])
+         */
+        void* getImageDataPointer(unsigned int index = 0);
+        
+        //! A method returning the type of the vision sensor.
+        VisionSensorType getVisionSensorType() const override;
+        
+        //! A method returning a pointer to the underlaying OpenGLView object.
+        OpenGLView* getOpenGLView() const override;
+
+    private:
+        void InitGraphics();
+        
+        OpenGLMultiCamera* glCamera;
+        glm::vec2 depthRange;
+        bool enabled[4];
+        void* imageData[4];
+        void* stagedData[4];
+        std::function<void(MultiCamera*)> newDataCallback;
+    };
+}
+
+#endif
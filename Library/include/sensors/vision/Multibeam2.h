@@ -135,6 +135,7 @@ namespace sf
         std::vector<CamData> cameras;
         GLfloat* imageData;
         GLfloat* rangeData;
+        GLfloat* dispatchedData;
         Scalar fovV;
         glm::vec2 range;
         std::function<void(Multibeam2*)> newDataCallback;
@@ -28,7 +28,6 @@
 
 #include <SDL2/SDL_mutex.h>
 #include <chrono>
-#include <deque>
 #include <vector>
 
 namespace sf
@@ -59,15 +58,26 @@ namespace sf
         template<typename T> std::vector<T> getHydrodynamicsTimeHistory(size_t len) { return getHistory<T>(hydroTime, len); };
 
     private:
-        void Update(const std::chrono::high_resolution_clock::time_point& start, std::deque<double>& times, double& average);
-        template<typename T> std::vector<T> getHistory(std::deque<double>& data, size_t len)
+        // Ring buffer of samples (updated without allocation).
+        struct History
+        {
+            std::vector<double> samples;
+            size_t next;
+            size_t count;
+            double sum;
+        };
+        
+        void Update(const std::chrono::high_resolution_clock::time_point& start, History& h);
+        void Clear(History& h);
+        double getLast(const History& h);
+        template<typename T> std::vector<T> getHistory(const History& h, size_t len)
         { 
             std::vector<T> dataOut; 
-            dataOut.resize(data.size() < len ? data.size() : len);
             SDL_LockMutex(updateMtx);
-            size_t offset = data.size() - dataOut.size();
-            for(size_t i=data.size()-dataOut.size(); i<data.size(); ++i) 
-                dataOut[i-offset] = (T)(data[i]);
+            dataOut.resize(h.count < len ? h.count : len);
+            size_t cap = h.samples.size();
+            for(size_t i=0; i<dataOut.size(); ++i) 
+                dataOut[i] = (T)(h.samples[(h.next + cap - dataOut.size() + i) % cap]);
             SDL_UnlockMutex(updateMtx);   
             return dataOut;
         };
@@ -78,10 +88,8 @@ namespace sf
         std::chrono::high_resolution_clock::time_point hydroStart;
         double simTime;
         bool simFinished;
-        std::deque<double> phyTime;
-        std::deque<double> hydroTime;
-        double phyTimeAvg;
-        double hydroTimeAvg;
+        History phyTime;
+        History hydroTime;
         SDL_mutex* updateMtx;
     };
 }
@@ -0,0 +1,92 @@
+/*    
+    Copyright (c) 2026 agent. All rights reserved.
+
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//Version and source type (COLOR_SOURCE, DEPTH_SOURCE or ID_SOURCE) defined in the header
+
+#ifdef ID_SOURCE
+uniform usampler2D texSource;
+#else
+uniform sampler2D texSource;
+#endif
+
+#if defined(ID_SOURCE) || defined(UINT_OUTPUT)
+layout(location = 0) out uvec4 fragColor;
+#else
+layout(location = 0) out vec4 fragColor;
+#endif
+
+uniform ivec2 roiOrigin;
+uniform int binning;
+uniform int flipHeight; //Source height if it has to be flipped, 0 otherwise
+uniform int outputFormat; //CameraOutputFormat
+uniform float depthScale;
+
+ivec2 sourceTexel(ivec2 p)
+{
+    return flipHeight > 0 ? ivec2(p.x, flipHeight - 1 - p.y) : p;
+}
+
+void main()
+{
+    ivec2 outPix = ivec2(gl_FragCoord.xy);
+    ivec2 base = roiOrigin + outPix * binning;
+
+#if defined(ID_SOURCE)
+    //Object ids can not be averaged
+    fragColor = uvec4(texelFetch(texSource, sourceTexel(base), 0).r, 0u, 0u, 0u);
+#elif defined(DEPTH_SOURCE)
+    //Average only valid samples (zero means out of range)
+    float sum = 0.0;
+    int n = 0;
+    for(int j=0; j<binning; ++j)
+        for(int i=0; i<binning; ++i)
+        {
+            float d = texelFetch(texSource, sourceTexel(base + ivec2(i, j)), 0).r;
+            if(d > 0.0)
+            {
+                sum += d;
+                ++n;
+            }
+        }
+    float depth = n > 0 ? sum/float(n) : 0.0;
+#ifdef UINT_OUTPUT
+    fragColor = uvec4(uint(clamp(round(depth * depthScale), 0.0, 65535.0)), 0u, 0u, 0u);
+#else
+    fragColor = vec4(depth, 0.0, 0.0, 1.0);
+#endif
+#else
+    vec3 color = vec3(0.0);
+    for(int j=0; j<binning; ++j)
+        for(int i=0; i<binning; ++i)
+            color += texelFetch(texSource, sourceTexel(base + ivec2(i, j)), 0).rgb;
+    color /= float(binning * binning);
+    
+    if(outputFormat == 1) //Mono
+        fragColor = vec4(vec3(dot(color, vec3(0.299, 0.587, 0.114))), 1.0);
+    else if(outputFormat >= 2 && outputFormat <= 5) //Bayer mosaic
+    {
+        //Channel of each pixel in the 2x2 cell (top-left, top-right, bottom-left, bottom-right)
+        const ivec4 patterns[4] = ivec4[4](ivec4(0,1,1,2), ivec4(2,1,1,0), ivec4(1,0,2,1), ivec4(1,2,0,1));
+        int cell = (outPix.x & 1) + 2 * (outPix.y & 1);
+        fragColor = vec4(vec3(color[patterns[outputFormat-2][cell]]), 1.0);
+    }
+    else
+        fragColor = vec4(color, 1.0);
+#endif
+}
@@ -17,7 +17,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#version 330
+#version 430
 
 in vec3 normal;
 in vec2 texCoord;
@@ -42,6 +42,7 @@ vec3 GetSkyLuminanceToPoint(vec3 camera, vec3 point, float shadow_length, vec3 s
 vec3 GetSunAndSkyIlluminance(vec3 p, vec3 normal, vec3 sun_direction, out vec3 sky_irradiance);
 float SpotShadow(int id);
 float SunShadow();
+uint LightCluster(vec3 P);
 vec4 PointLightContribution(int id, vec3 P, vec3 N, vec3 toEye, vec3 albedo);
 vec4 SpotLightContribution(int id, vec3 P, vec3 N, vec3 toEye, vec3 albedo);
 vec3 SunContribution(vec3 P, vec3 N, vec3 toEye, vec3 albedo, vec3 illuminance);
@@ -68,34 +69,21 @@ void main()
 	
 	fragColor = fragColor/whitePoint; //Color correction and normalization
 	
-	//Point lights
-    if(lightId.x == 0)
-	{
-        for(int i=0; i<numPointLights; ++i)
-        {
-            if(lightId.y == i) continue;
-		    fragColor += PointLightContribution(i, P, N, toEye, color).rgb;
-        }
-    }
-    else
-    {
-        for(int i=0; i<numPointLights; ++i)
-		    fragColor += PointLightContribution(i, P, N, toEye, color).rgb;
-    }
-
-    //Spot lights
-    if(lightId.x == 1)
+	//Point and spot lights affecting the cluster of the fragment (excluding the light itself)
+    uint cluster = LightCluster(P);
+    uint nPoint = clusterData[cluster];
+    uint nSpot = clusterData[cluster+1u];
+    for(uint i=0u; i<nPoint; ++i)
     {
-        for(int i=0; i<numSpotLights; ++i)
-        {
-            if(lightId.y == i) continue;
-            fragColor += SpotLightContribution(i, P, N, toEye, color).rgb;
-        }
+        int id = int(clusterData[cluster+2u+i]);
+        if(lightId.x == 0 && lightId.y == id) continue;
+        fragColor += PointLightContribution(id, P, N, toEye, color).rgb;
     }
-    else
+    for(uint i=0u; i<nSpot; ++i)
     {
-        for(int i=0; i<numSpotLights; ++i)
-            fragColor += SpotLightContribution(i, P, N, toEye, color).rgb;
+        int id = int(clusterData[cluster+2u+nPoint+i]);
+        if(lightId.x == 1 && lightId.y == id) continue;
+        fragColor += SpotLightContribution(id, P, N, toEye, color).rgb;
     }
 
     //Light itself
@@ -17,7 +17,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#version 330
+#version 430
 
 in vec3 normal;
 in vec2 texCoord;
@@ -44,6 +44,7 @@ vec3 GetSkyLuminanceToPoint(vec3 camera, vec3 point, float shadow_length, vec3 s
 vec3 GetSunAndSkyIlluminance(vec3 p, vec3 normal, vec3 sun_direction, out vec3 sky_irradiance);
 float SpotShadow(int id);
 float SunShadow();
+uint LightCluster(vec3 P);
 vec4 PointLightContribution(int id, vec3 P, vec3 N, vec3 toEye, vec3 albedo);
 vec4 SpotLightContribution(int id, vec3 P, vec3 N, vec3 toEye, vec3 albedo);
 vec3 SunContribution(vec3 P, vec3 N, vec3 toEye, vec3 albedo, vec3 illuminance);
@@ -85,42 +86,23 @@ void main()
 	
 	fragColor = fragColor/whitePoint; //Color correction and normalization
 	
-	//Point lights
-    if(lightId.x == 0)
+	//Point and spot lights affecting the cluster of the fragment (excluding the light itself)
+    uint cluster = LightCluster(P);
+    uint nPoint = clusterData[cluster];
+    uint nSpot = clusterData[cluster+1u];
+    for(uint i=0u; i<nPoint; ++i)
     {
-        for(int i=0; i<numPointLights; ++i)
-        {
-            if(lightId.y == i) continue;
-            vec4 Ld = PointLightContribution(i, P, N, V, color);
-            fragColor += Ld.rgb * BeerLambert(dw + Ld.a);
-        }
+        int id = int(clusterData[cluster+2u+i]);
+        if(lightId.x == 0 && lightId.y == id) continue;
+        vec4 Ld = PointLightContribution(id, P, N, V, color);
+        fragColor += Ld.rgb * BeerLambert(dw + Ld.a);
     }
-    else
+    for(uint i=0u; i<nSpot; ++i)
     {
-        for(int i=0; i<numPointLights; ++i)
-        {
-            vec4 Ld = PointLightContribution(i, P, N, V, color);
-            fragColor += Ld.rgb * BeerLambert(dw + Ld.a);
-        }
-    }
-
-    //Spot lights
-	if(lightId.x == 1)
-    {
-        for(int i=0; i<numSpotLights; ++i)
-        {
-            if(lightId.y == i) continue;
-            vec4 Ld = SpotLightContribution(i, P, N, V, color);
-            fragColor += Ld.rgb * BeerLambert(dw + Ld.a);
-        }
-    }
-    else
-    {
-        for(int i=0; i<numSpotLights; ++i)
-        {
-            vec4 Ld = SpotLightContribution(i, P, N, V, color);
-            fragColor += Ld.rgb * BeerLambert(dw + Ld.a);
-        }
+        int id = int(clusterData[cluster+2u+nPoint+i]);
+        if(lightId.x == 1 && lightId.y == id) continue;
+        vec4 Ld = SpotLightContribution(id, P, N, V, color);
+        fragColor += Ld.rgb * BeerLambert(dw + Ld.a);
     }
 
 	//2. In-scattering from Sun/Sky
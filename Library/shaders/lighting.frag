@@ -52,7 +52,7 @@
     OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-#version 330
+#version 430
 
 //Constants
 const float sunLightRadius = 0.05;
@@ -645,6 +645,16 @@ float SunShadow(vec3 P)
                smoothstep(sunFrustumFar.w * 0.8, sunFrustumFar.w, depth));
 }
 
+//Find the offset of the light cluster containing the fragment
+uint LightCluster(vec3 P)
+{
+	float depth = max(dot(P - clusterEye.xyz, clusterDir.xyz), 1e-6);
+	ivec3 c;
+	c.xy = clamp(ivec2(gl_FragCoord.xy * clusterDepth.zw * vec2(clusterGrid.xy)), ivec2(0), clusterGrid.xy - 1);
+	c.z = clamp(int(log(depth) * clusterDepth.x + clusterDepth.y), 0, clusterGrid.z - 1);
+	return uint((c.z * clusterGrid.y + c.y) * clusterGrid.x + c.x) * uint(clusterGrid.w + 2);
+}
+
 //Calculate contribution of different light types
 vec4 PointLightContribution(int id, vec3 P, vec3 N, vec3 toEye, vec3 albedo)
 {
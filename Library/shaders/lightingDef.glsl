@@ -1,6 +1,3 @@
-#define MAX_POINT_LIGHTS 32
-#define MAX_SPOT_LIGHTS 32
-
 struct PointLight 
 {
 	vec3 position;
@@ -22,12 +19,31 @@ struct SpotLight
 
 layout (std140) uniform Lights
 {
-    PointLight pointLights[MAX_POINT_LIGHTS];
-    SpotLight spotLights[MAX_SPOT_LIGHTS];
+    vec4 clusterEye;    //Eye position of the current view
+    vec4 clusterDir;    //Looking direction of the current view
+    vec4 clusterDepth;  //Depth slicing scale and bias, inverse viewport size
+    ivec4 clusterGrid;  //Number of clusters in x, y, z and max number of lights in a cluster
     int numPointLights;
     int numSpotLights;
 };
 
+//Bindings correspond to SSBO_POINT_LIGHTS, SSBO_SPOT_LIGHTS and SSBO_LIGHT_CLUSTERS
+layout (std430, binding = 11) readonly buffer PointLights
+{
+    PointLight pointLights[];
+};
+
+layout (std430, binding = 12) readonly buffer SpotLights
+{
+    SpotLight spotLights[];
+};
+
+//Each cluster stores the number of point lights, the number of spot lights and the light indices
+layout (std430, binding = 13) buffer LightClusters
+{
+    uint clusterData[];
+};
+
 layout (std140) uniform SunSky
 {
     mat4 sunClipSpace[4];
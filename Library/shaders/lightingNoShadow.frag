@@ -17,7 +17,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#version 330
+#version 430
 
 //Constants
 const float sunLightRadius = 0.03;
@@ -30,6 +30,16 @@ uniform vec3 viewDir;
 
 vec3 ShadingModel(vec3 N, vec3 V, vec3 L, vec3 Lcolor, vec3 albedo);
 
+//Find the offset of the light cluster containing the fragment
+uint LightCluster(vec3 P)
+{
+	float depth = max(dot(P - clusterEye.xyz, clusterDir.xyz), 1e-6);
+	ivec3 c;
+	c.xy = clamp(ivec2(gl_FragCoord.xy * clusterDepth.zw * vec2(clusterGrid.xy)), ivec2(0), clusterGrid.xy - 1);
+	c.z = clamp(int(log(depth) * clusterDepth.x + clusterDepth.y), 0, clusterGrid.z - 1);
+	return uint((c.z * clusterGrid.y + c.y) * clusterGrid.x + c.x) * uint(clusterGrid.w + 2);
+}
+
 //Calculate contribution of different light types
 vec4 PointLightContribution(int id, vec3 P, vec3 N, vec3 toEye, vec3 albedo)
 {
@@ -21,6 +21,7 @@
 
 layout(location = 0) in vec3 vt;
 layout(location = 1) in vec3 n;
+layout(location = 4) in mat4 instance; //Identity unless the object is drawn instanced
 
 out vec3 normal;
 out vec4 fragPos;
@@ -35,10 +36,11 @@ uniform float FC;
 
 void main()
 {
-	normal = normalize(N * n);
-	eyeSpaceNormal = normalize(MV * n);
-	fragPos = M * vec4(vt, 1.0);
-	gl_Position = MVP * vec4(vt, 1.0); 
+    vec4 vP = instance * vec4(vt, 1.0);
+	normal = normalize(N * (mat3(instance) * n));
+	eyeSpaceNormal = normalize(MV * (mat3(instance) * n));
+	fragPos = M * vP;
+	gl_Position = MVP * vP; 
     gl_Position.z = log2(max(1e-6, 1.0 + gl_Position.w)) * 2.0 * FC - 1.0;
     logz = 1.0 + gl_Position.w;
 }
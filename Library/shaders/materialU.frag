@@ -17,7 +17,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#version 330
+#version 430
 
 in vec3 normal;
 in vec4 fragPos;
@@ -42,6 +42,7 @@ vec3 GetSolarLuminance();
 vec3 GetSkyLuminance(vec3 camera, vec3 view_ray, float shadow_length, vec3 sun_direction, out vec3 transmittance);
 vec3 GetSkyLuminanceToPoint(vec3 camera, vec3 point, float shadow_length, vec3 sun_direction, out vec3 transmittance);
 vec3 GetSunAndSkyIlluminance(vec3 p, vec3 normal, vec3 sun_direction, out vec3 sky_irradiance);
+uint LightCluster(vec3 P);
 vec4 PointLightContribution(int id, vec3 P, vec3 N, vec3 toEye, vec3 albedo);
 vec4 SpotLightContribution(int id, vec3 P, vec3 N, vec3 toEye, vec3 albedo);
 vec3 SunContribution(vec3 P, vec3 N, vec3 toEye, vec3 albedo, vec3 illuminance);
@@ -94,17 +95,18 @@ void main()
 	
 	fragColor.rgb = fragColor.rgb/whitePoint; //Color correction and normalization
 	
-	//Point lights
-	for(int i=0; i<numPointLights; ++i)
+	//Point and spot lights affecting the cluster of the fragment
+	uint cluster = LightCluster(P);
+	uint nPoint = clusterData[cluster];
+	uint nSpot = clusterData[cluster+1u];
+	for(uint i=0u; i<nPoint; ++i)
 	{
-		vec4 Ld = PointLightContribution(i, P, N, V, albedo.rgb);
+		vec4 Ld = PointLightContribution(int(clusterData[cluster+2u+i]), P, N, V, albedo.rgb);
 		fragColor.rgb += Ld.rgb * BeerLambert(dw + Ld.a);
 	}
-
-	//Spot lights
-	for(int i=0; i<numSpotLights; ++i)
+	for(uint i=0u; i<nSpot; ++i)
 	{
-		vec4 Ld = SpotLightContribution(i, P, N, V, albedo.rgb);
+		vec4 Ld = SpotLightContribution(int(clusterData[cluster+2u+nPoint+i]), P, N, V, albedo.rgb);
 		fragColor.rgb += Ld.rgb * BeerLambert(dw + Ld.a);
 	}
 
@@ -23,6 +23,7 @@ layout(location = 0) in vec3 vt;
 layout(location = 1) in vec3 n;
 layout(location = 2) in vec2 uv;
 layout(location = 3) in vec3 t;
+layout(location = 4) in mat4 instance; //Identity unless the object is drawn instanced
 
 out vec3 normal;
 out mat3 TBN;
@@ -39,14 +40,15 @@ uniform float FC;
 
 void main()
 {
-	normal = normalize(N * n);
-    vec3 tangent = normalize(N * t);
+    vec4 vP = instance * vec4(vt, 1.0);
+	normal = normalize(N * (mat3(instance) * n));
+    vec3 tangent = normalize(N * (mat3(instance) * t));
     vec3 bitangent = cross(normal, tangent);
     TBN = mat3(tangent, bitangent, normal);
-	eyeSpaceNormal = normalize(MV * n);
+	eyeSpaceNormal = normalize(MV * (mat3(instance) * n));
 	texCoord = uv;
-	fragPos = M * vec4(vt, 1.0);
-	gl_Position = MVP * vec4(vt, 1.0); 
+	fragPos = M * vP;
+	gl_Position = MVP * vP; 
     gl_Position.z = log2(max(1e-6, 1.0 + gl_Position.w)) * 2.0 * FC - 1.0;
     logz = 1.0 + gl_Position.w;
 }
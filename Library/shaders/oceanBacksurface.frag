@@ -23,7 +23,7 @@
     https://github.com/jdupuy/whitecaps
 */
 
-#version 330
+#version 430
 
 in vec4 fragPos;
 in float logz;
@@ -35,6 +35,7 @@ uniform sampler2DArray texWaveFFT;
 uniform sampler3D texSlopeVariance;
 uniform vec2 viewport;
 uniform vec4 gridSizes;
+uniform vec2 waveOrigin;
 uniform vec3 eyePos;
 uniform mat3 MV;
 uniform float FC;
@@ -130,7 +131,7 @@ void main()
 		dw = max(P.z, 0.0)/dot(V, waterSurfaceN);
 	
 	//Wave slope (layers 1,2)
-    vec2 waveCoord = P.xy;
+    vec2 waveCoord = P.xy + waveOrigin;
 	vec2 slopes = texture(texWaveFFT, vec3(waveCoord/gridSizes.x, 1.0)).xy;
 	slopes += texture(texWaveFFT, vec3(waveCoord/gridSizes.y, 1.0)).zw;
 	slopes += texture(texWaveFFT, vec3(waveCoord/gridSizes.z, 2.0)).xy;
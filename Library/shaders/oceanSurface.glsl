@@ -27,9 +27,11 @@
 
 uniform sampler2DArray texWaveFFT;
 uniform vec4 gridSizes;
+uniform vec2 waveOrigin; //Waves are sampled in the original world frame
 
 float displace(vec2 p)
 {
+    p += waveOrigin;
 	float dz = 0.0;
     dz -= texture(texWaveFFT, vec3(p/gridSizes.x, 0.0)).x;
     dz -= texture(texWaveFFT, vec3(p/gridSizes.y, 0.0)).y;
@@ -40,6 +42,7 @@ float displace(vec2 p)
 
 float displaceGrad(vec2 p, vec2 dx, vec2 dy)
 {
+    p += waveOrigin;
     float dz = 0.0;
     dz -= textureGrad(texWaveFFT, vec3(p/gridSizes.x, 0.0), dx/gridSizes.x, dy/gridSizes.x).x;
     dz -= textureGrad(texWaveFFT, vec3(p/gridSizes.y, 0.0), dx/gridSizes.y, dy/gridSizes.y).y;
@@ -23,7 +23,7 @@
     https://github.com/jdupuy/whitecaps
 */
 
-#version 330
+#version 430
 
 in vec4 fragPos;
 in float logz;
@@ -34,6 +34,7 @@ uniform sampler2DArray texWaveFFT;
 uniform sampler3D texSlopeVariance; 
 uniform vec2 viewport;
 uniform vec4 gridSizes;
+uniform vec2 waveOrigin;
 uniform vec3 eyePos;
 uniform mat3 MV;
 uniform float FC;
@@ -118,7 +119,7 @@ void main()
 	vec3 Psky = vec3(P.xy/atmLengthUnitInMeters, clamp(P.z/atmLengthUnitInMeters, -100000.0/atmLengthUnitInMeters, -0.5/atmLengthUnitInMeters));
 	
 	//Wave slope (layers 1,2)
-    vec2 waveCoord = P.xy;
+    vec2 waveCoord = P.xy + waveOrigin;
 	vec2 slopes = vec2(0.0);
     slopes += texture(texWaveFFT, vec3(waveCoord/gridSizes.x, 1.0)).xy;
 	slopes += texture(texWaveFFT, vec3(waveCoord/gridSizes.y, 1.0)).zw;
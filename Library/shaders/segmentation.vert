@@ -20,6 +20,7 @@
 #version 330
 
 layout(location = 0) in vec3 vt;
+layout(location = 4) in mat4 instance; //Identity unless the object is drawn instanced
 
 out vec4 fragPos;
 out float logz;
@@ -30,8 +31,9 @@ uniform float FC;
 
 void main()
 {
-	fragPos = M * vec4(vt, 1.0);
-	gl_Position = MVP * vec4(vt, 1.0); 
+    vec4 vP = instance * vec4(vt, 1.0);
+	fragPos = M * vP;
+	gl_Position = MVP * vP; 
     gl_Position.z = log2(max(1e-6, 1.0 + gl_Position.w)) * 2.0 * FC - 1.0;
     logz = 1.0 + gl_Position.w;
 }
\ No newline at end of file
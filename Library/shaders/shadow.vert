@@ -20,9 +20,11 @@
 #version 330
 
 layout(location = 0) in vec3 vertex;
+layout(location = 4) in mat4 instance; //Identity unless the object is drawn instanced
 uniform mat4 MVP;
 
 void main()
 {
-	gl_Position = MVP * vec4(vertex, 1.0);
+    vec4 vP = instance * vec4(vertex, 1.0);
+	gl_Position = MVP * vP;
 }
@@ -0,0 +1,29 @@
+/*    
+    Copyright (c) 2026 agent. All rights reserved.
+
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#version 330
+
+layout(location = 0) in vec3 vertex;
+layout(location = 4) in mat4 instance; //Identity unless the object is drawn instanced
+uniform mat4 M;
+
+void main()
+{
+    gl_Position = M * instance * vec4(vertex, 1.0); //World space, projected per cascade
+}
@@ -21,6 +21,7 @@
 
 layout(location = 0) in vec3 vt;
 layout(location = 1) in vec3 n;
+layout(location = 4) in mat4 instance; //Identity unless the object is drawn instanced
 
 out vec3 normal;
 out vec3 fragPos;
@@ -31,7 +32,8 @@ uniform mat3 N;
 
 void main()
 {
-	normal = normalize(N * n);
-	fragPos = (M * vec4(vt, 1.0)).xyz;
-    gl_Position = MVP * vec4(vt, 1.0); 
+    vec4 vP = instance * vec4(vt, 1.0);
+	normal = normalize(N * (mat3(instance) * n));
+	fragPos = (M * vP).xyz;
+    gl_Position = MVP * vP; 
 }
@@ -23,6 +23,7 @@ layout(location = 0) in vec3 vt;
 layout(location = 1) in vec3 n;
 layout(location = 2) in vec2 uv;
 layout(location = 3) in vec3 t;
+layout(location = 4) in mat4 instance; //Identity unless the object is drawn instanced
 
 out mat3 TBN;
 out vec2 texCoord;
@@ -34,11 +35,12 @@ uniform mat3 N;
 
 void main()
 {
-	vec3 normal = normalize(N * n);
-    vec3 tangent = normalize(N * t);
+    vec4 vP = instance * vec4(vt, 1.0);
+	vec3 normal = normalize(N * (mat3(instance) * n));
+    vec3 tangent = normalize(N * (mat3(instance) * t));
     vec3 bitangent = cross(normal, tangent);
     TBN = mat3(tangent, bitangent, normal);
 	texCoord = uv;
-	fragPos = (M * vec4(vt, 1.0)).xyz;
-    gl_Position = MVP * vec4(vt, 1.0); 
+	fragPos = (M * vP).xyz;
+    gl_Position = MVP * vP; 
 }
@@ -25,6 +25,9 @@
 
 #include "actuators/DCMotor.h"
 
+#include "joints/RevoluteJoint.h"
+#include "entities/FeatherstoneEntity.h"
+
 namespace sf
 {
 
@@ -39,11 +42,12 @@ DCMotor::DCMotor(std::string uniqueName, Scalar motorR, Scalar motorL, Scalar mo
     gearEnabled = false;
     gearEff = Scalar(1.);
     gearRatio = Scalar(1.);
+    implicit = false;
     
     //Internal states
     I = Scalar(0.);
     V = Scalar(0.);
-    lastVoverL = Scalar(0.);
+    stepped = false;
 }
 
 Scalar DCMotor::getKe() const
@@ -71,6 +75,26 @@ Scalar DCMotor::getGearRatio() const
     return gearRatio;
 }
 
+void DCMotor::setImplicitCoupling(bool enable)
+{
+    implicit = enable;
+}
+
+bool DCMotor::isImplicitCoupling() const
+{
+    return implicit;
+}
+
+Scalar DCMotor::getJointInertia() const
+{
+    if(j != nullptr && j->getType() == JointType::REVOLUTE)
+        return ((RevoluteJoint*)j)->getEffectiveInertia();
+    else if(fe != nullptr)
+        return fe->getJointInertia(jId);
+    else
+        return Scalar(0);
+}
+
 void DCMotor::setIntensity(Scalar volt)
 {
     V = volt;
@@ -105,20 +129,53 @@ Scalar DCMotor::getAngularVelocity() const
 
 void DCMotor::Update(Scalar dt)
 {
-    //Get joint angular velocity in radians
+    //Get motor angular velocity in radians (joint velocity times gear ratio)
     Scalar aVelocity = getAngularVelocity();
+    Scalar KeRad = Ke * Scalar(9.5493); //[V/rpm] -> [V/(rad/s)]
+    
+    if(R <= Scalar(0) || dt <= Scalar(0)) //Purely inductive (degenerate) case
+    {
+        Scalar I0 = I;
+        if(L > Scalar(0))
+            I += (V - aVelocity * KeRad)/L * dt;
+        torque = (Scalar(0.5) * (I0 + I) * Kt - aVelocity * B) * gearRatio * gearEff;
+        Motor::Update(dt);
+        return;
+    }
+
+    /* Exact zero-order-hold discretization of the armature circuit L dI/dt = V - Ke w - R I,
+       with the back EMF held over the step:
+       I(dt) = Iss + (I0 - Iss) a, where Iss = (V - Ke w)/R and a = exp(-R dt/L).
+       The torque uses the mean current over the step: Imean = Iss + (I0 - Iss) k, k = (1-a) L/(R dt). */
+    Scalar a = Scalar(0);
+    Scalar k = Scalar(0);
+    if(L > Scalar(0))
+    {
+        Scalar x = R * dt / L;
+        a = btExp(-x);
+        k = x > Scalar(1e-6) ? (Scalar(1) - a)/x : Scalar(1) - Scalar(0.5) * x;
+    }
+    Scalar G = gearRatio * gearEff;
+    Scalar Ipart = I * k + V/R * (Scalar(1) - k); //Mean current without back EMF
+    Scalar Iw = KeRad/R * (Scalar(1) - k); //Mean current drop per unit of motor velocity
+    
+    /* Implicit coupling with the motor velocity (torque = T0 - D * w_end).
+       The torque and the inertia J are on the joint side, so the motor velocity at the end
+       of the step is w_end = w + gearRatio * dt * torque / J. */
+    Scalar J = implicit && stepped ? getJointInertia() : Scalar(0);
+    if(J > Scalar(0))
+    {
+        Scalar T0 = Ipart * Kt * G;
+        Scalar D = (Iw * Kt + B) * G;
+        torque = (T0 - D * aVelocity)/(Scalar(1) + D * gearRatio * dt / J);
+        aVelocity += gearRatio * dt * torque / J; //Predicted motor velocity at the end of the step
+    }
+    else
+        torque = ((Ipart - Iw * aVelocity) * Kt - aVelocity * B) * G;
     
-    //Calculate internal state and output
-    torque = (I * Kt - aVelocity * B) * gearRatio * gearEff;
-    Scalar VoverL = (V - aVelocity * Ke * 9.5493 - I * R)/L;
-	I += VoverL * dt;
-	
-	//Hack to avoid system blowup when the motor starts (shortcut)
-	if((btFabs(I) > btFabs(V/R)) && (I*V > Scalar(0)))
-		I = V/R;
-        
-	//I += Scalar(0.5) * (VoverL + lastVoverL) * dt; //Integration (mid-point)
-    //lastVoverL = VoverL;
+    Scalar Iss = (V - aVelocity * KeRad)/R;
+    I = Iss + (I - Iss) * a;
+    stepped = true;
     
 	//Drive the joint
     Motor::Update(dt);
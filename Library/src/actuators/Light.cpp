@@ -118,6 +118,12 @@ void Light::AttachToSolid(SolidEntity* body, const Transform& origin)
     }
 }
 
+void Light::ShiftOrigin(const Vector3& shift)
+{
+    if(attach == nullptr && attach2 == nullptr && attach3 == nullptr)
+        o2a.setOrigin(o2a.getOrigin() - shift);
+}
+
 void Light::InitGraphics()
 {
     if(coneAngle > Scalar(0)) //Spot light
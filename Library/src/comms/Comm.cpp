@@ -160,6 +160,12 @@ void Comm::AttachToWorld(const Transform& origin)
     o2c = origin;
 }
 
+void Comm::ShiftOrigin(const Vector3& shift)
+{
+    if(attach == nullptr)
+        o2c.setOrigin(o2c.getOrigin() - shift);
+}
+
 void Comm::AttachToStatic(StaticEntity* body, const Transform& origin)
 {
     if(body != nullptr)
@@ -25,17 +25,18 @@
 
 #include "comms/USBL.h"
 
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+
 namespace sf
 {
     
-std::random_device USBL::randomDevice;
-std::mt19937 USBL::randomGenerator(randomDevice());
-    
 USBL::USBL(std::string uniqueName, uint64_t deviceId, Scalar minVerticalFOVDeg, Scalar maxVerticalFOVDeg, Scalar operatingRange)
            : AcousticModem(uniqueName, deviceId, minVerticalFOVDeg, maxVerticalFOVDeg, operatingRange)
 {
     ping = false;
     noise = false;
+    randomGenerator.seed(SimulationApp::getApp()->getSimulationManager()->DeriveRandomSeed(getName()));
 }
     
 std::map<uint64_t, BeaconInfo>& USBL::getBeaconInfo()
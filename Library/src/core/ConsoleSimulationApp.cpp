@@ -65,6 +65,18 @@ void ConsoleSimulationApp::LoopInternal()
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 }
 
+void ConsoleSimulationApp::CleanUp()
+{
+    //The simulation thread leaves its loop once the application is finished
+    if(simulationThread != nullptr)
+    {
+        int status;
+        SDL_WaitThread(simulationThread, &status);
+        simulationThread = nullptr;
+    }
+    SimulationApp::CleanUp();
+}
+
 void ConsoleSimulationApp::StartSimulation()
 {
     SimulationApp::StartSimulation();
@@ -108,6 +120,7 @@ int ConsoleSimulationApp::RunSimulation(void* data)
 
     int maxThreads = std::max(omp_get_max_threads()/2, 1);
     omp_set_num_threads(maxThreads);
+    simManager->ConfigureRealtimeThread();
     
     while(simApp.getState() == SimulationState::RUNNING)
     {
@@ -1034,9 +1034,10 @@ void GraphicalSimulationApp::StepSimulation()
 {
     SimulationApp::StepSimulation();
         
-    if(getGLPipeline()->isDrawingQueueEmpty())
+    //Hand the state over to the renderer, without waiting if it is copying the previous one
+    if(getGLPipeline()->isDrawingQueueEmpty() 
+       && SDL_TryLockMutex(getGLPipeline()->getDrawingQueueMutex()) == 0)
     {
-        SDL_LockMutex(getGLPipeline()->getDrawingQueueMutex());
         getSimulationManager()->UpdateDrawingQueue();
         SDL_UnlockMutex(getGLPipeline()->getDrawingQueueMutex());
     }
@@ -1109,6 +1110,7 @@ int GraphicalSimulationApp::RunSimulation(void* data)
 
     int maxThreads = std::max(omp_get_max_threads()/2, 1);
     omp_set_num_threads(maxThreads);
+    simManager->ConfigureRealtimeThread();
     
     while(simApp.getState() == SimulationState::RUNNING)
     {
@@ -25,143 +25,186 @@
 
 #include "core/NED.h"
 
+#include <cmath>
+
 namespace sf
 {
 
 // WGS-84
-const Scalar NED::a = Scalar(6378137);
-const Scalar NED::b = Scalar(6356752.3142);
-const Scalar NED::esq = Scalar(6.69437999014 * 0.001);
-const Scalar NED::e1sq = Scalar(6.73949674228 * 0.001); 
-const Scalar NED::f = Scalar(1.0 / 298.257223563);
+const double NED::a = 6378137.0;
+const double NED::b = 6356752.3142;
+const double NED::esq = 6.69437999014 * 0.001;
+const double NED::e1sq = 6.73949674228 * 0.001; 
+const double NED::f = 1.0 / 298.257223563;
 
 NED::NED()
 {
     Init(50.0, 20.0, 0.0); //Krakow, Poland
 }
 
-void NED::Init(const Scalar lat, const Scalar lon, const Scalar height)
+void NED::Init(const double lat, const double lon, const double height)
 {
     // Save NED origin
-    _init_lat = lat/Scalar(180) * M_PI;
-    _init_lon = lon/Scalar(180) * M_PI;
+    _init_lat = lat/180.0 * M_PI;
+    _init_lon = lon/180.0 * M_PI;
     _init_h = height;
 
     // Compute ECEF of NED origin
-    Geodetic2Ecef(lat, lon, height, _init_ecef_x, _init_ecef_y, _init_ecef_z);
+    Geodetic2EcefD(lat, lon, height, _init_ecef_x, _init_ecef_y, _init_ecef_z);
 
     // Compute ECEF to NED and NED to ECEF matrices
-    Scalar phiP = btAtan2(_init_ecef_z, btSqrt(_init_ecef_x*_init_ecef_x + _init_ecef_y*_init_ecef_y));
-
-    _ecef_to_ned_matrix = __nRe__(phiP, _init_lon);
-    _ned_to_ecef_matrix = __nRe__(_init_lat, _init_lon).transpose();
+    double phiP = std::atan2(_init_ecef_z, std::sqrt(_init_ecef_x*_init_ecef_x + _init_ecef_y*_init_ecef_y));
+
+    __nRe__(phiP, _init_lon, _ecef_to_ned_matrix);
+    double nRe[3][3];
+    __nRe__(_init_lat, _init_lon, nRe);
+    for(unsigned int i=0; i<3; ++i)
+        for(unsigned int j=0; j<3; ++j)
+            _ned_to_ecef_matrix[i][j] = nRe[j][i];
 }
 
 void NED::Geodetic2Ecef(const Scalar lat, const Scalar lon, const Scalar height,
                         Scalar& x, Scalar& y, Scalar& z) const
 {
-    // Convert geodetic coordinates to ECEF.
-    // http://code.google.com/p/pysatel/source/browse/trunk/coord.py?r=22
-    Scalar lat_rad = lat/180.0 * M_PI;
-    Scalar lon_rad = lon/180.0 * M_PI;
-    Scalar xi = btSqrt(1 - esq * btSin(lat_rad) * btSin(lat_rad));
-    x = (a / xi + height) * btCos(lat_rad) * btCos(lon_rad);
-    y = (a / xi + height) * btCos(lat_rad) * btSin(lon_rad);
-    z = (a / xi * (1 - esq) + height) * btSin(lat_rad);
+    double dx, dy, dz;
+    Geodetic2EcefD(lat, lon, height, dx, dy, dz);
+    x = Scalar(dx);
+    y = Scalar(dy);
+    z = Scalar(dz);
 }
 
 void NED::Ecef2Geodetic(const Scalar x, const Scalar y, const Scalar z,
                         Scalar& lat, Scalar& lon, Scalar& height) const
 {
-    // Convert ECEF coordinates to geodetic.
-    // J. Zhu, "Conversion of Earth-centered Earth-fixed coordinates
-    // to geodetic coordinates," IEEE Transactions on Aerospace and
-    // Electronic Systems, vol. 30, pp. 957-961, 1994.
-    Scalar r = btSqrt(x * x + y * y);
-    Scalar Esq = a * a - b * b;
-    Scalar F = 54 * b * b * z * z;
-    Scalar G = r * r + (1 - esq) * z * z - esq * Esq;
-    Scalar C = (esq * esq * F * r * r) / btPow(G, 3);
-    Scalar S = __cbrt__(1 + C + btSqrt(C * C + 2 * C));
-    Scalar P = F / (3 * btPow((S + 1 / S + 1), 2) * G * G);
-    Scalar Q = btSqrt(1 + 2 * esq * esq * P);
-    Scalar r_0 = -(P * esq * r) / (1 + Q) + btSqrt(0.5 * a * a * (1 + 1.0 / Q) - P * (1 - esq) * z * z / (Q * (1 + Q)) - 0.5 * P * r * r);
-    Scalar U = btSqrt(btPow((r - esq * r_0), 2) + z * z);
-    Scalar V = btSqrt(btPow((r - esq * r_0), 2) + (1 - esq) * z * z);
-    Scalar Z_0 = b * b * z / (a * V);
-    height = U * (1 - b * b / (a * V));
-    lat = (btAtan((z + e1sq * Z_0) / r))/M_PI * 180.0;
-    lon = (btAtan2(y, x))/M_PI * 180.0;
+    double dlat, dlon, dh;
+    Ecef2GeodeticD(x, y, z, dlat, dlon, dh);
+    lat = Scalar(dlat);
+    lon = Scalar(dlon);
+    height = Scalar(dh);
 }
 
 void NED::Ecef2Ned(const Scalar x, const Scalar y, const Scalar z,
                    Scalar& north, Scalar& east, Scalar& depth) const
 {
-    // Converts ECEF coordinate pos into local-tangent-plane ENU
-    // coordinates relative to another ECEF coordinate ref. Returns a tuple
-    // (East, North, Up).
-    Vector3 vect, ret;
-    vect.setX(x - _init_ecef_x);
-    vect.setY(y - _init_ecef_y);
-    vect.setZ(z - _init_ecef_z);
-    ret = _ecef_to_ned_matrix * vect;
-    north = ret.getX();
-    east = ret.getY();
-    depth = -ret.getZ();
+    double dn, de, dd;
+    Ecef2NedD(x, y, z, dn, de, dd);
+    north = Scalar(dn);
+    east = Scalar(de);
+    depth = Scalar(dd);
 }
 
 void NED::Ned2Ecef(const Scalar north, const Scalar east, const Scalar depth,
                    Scalar& x, Scalar& y, Scalar& z) const
 {
-    // NED (north/east/down) to ECEF coordinate system conversion.
-    Vector3 ned, ret;
-    ned.setX(north);
-    ned.setY(east);
-    ned.setZ(-depth);
-    ret = _ned_to_ecef_matrix * ned;
-    x = ret.getX() + _init_ecef_x;
-    y = ret.getY() + _init_ecef_y;
-    z = ret.getZ() + _init_ecef_z;
+    double dx, dy, dz;
+    Ned2EcefD(north, east, depth, dx, dy, dz);
+    x = Scalar(dx);
+    y = Scalar(dy);
+    z = Scalar(dz);
 }
 
 void NED::Geodetic2Ned(const Scalar lat, const Scalar lon, const Scalar height,
                        Scalar& north, Scalar& east, Scalar& depth) const
 {
-    // Geodetic position to a local NED system """
-    Scalar x, y, z;
-    Geodetic2Ecef(lat, lon, height, x, y, z);
-    Ecef2Ned(x, y, z, north, east, depth);
+    // Geodetic position to a local NED system
+    double x, y, z, dn, de, dd;
+    Geodetic2EcefD(lat, lon, height, x, y, z);
+    Ecef2NedD(x, y, z, dn, de, dd);
+    north = Scalar(dn);
+    east = Scalar(de);
+    depth = Scalar(dd);
 }
 
 void NED::Ned2Geodetic(const Scalar north, const Scalar east, const Scalar depth,
                        Scalar& lat, Scalar& lon, Scalar& height) const
 {
     // Local NED position to geodetic
-    Scalar x, y, z;
-    Ned2Ecef(north, east, depth, x, y, z);
-    Ecef2Geodetic(x, y, z, lat, lon, height);
+    double x, y, z, dlat, dlon, dh;
+    Ned2EcefD(north, east, depth, x, y, z);
+    Ecef2GeodeticD(x, y, z, dlat, dlon, dh);
+    lat = Scalar(dlat);
+    lon = Scalar(dlon);
+    height = Scalar(dh);
 }
 
-Scalar NED::__cbrt__(const Scalar x) const
+void NED::Geodetic2EcefD(double lat, double lon, double height, double& x, double& y, double& z) const
 {
-    if(x >= 0.0)
-        return btPow(x, 1.0/3.0);
-    else
-        return -btPow(btFabs(x), 1.0/3.0);
+    // Convert geodetic coordinates to ECEF.
+    // http://code.google.com/p/pysatel/source/browse/trunk/coord.py?r=22
+    double lat_rad = lat/180.0 * M_PI;
+    double lon_rad = lon/180.0 * M_PI;
+    double xi = std::sqrt(1.0 - esq * std::sin(lat_rad) * std::sin(lat_rad));
+    x = (a / xi + height) * std::cos(lat_rad) * std::cos(lon_rad);
+    y = (a / xi + height) * std::cos(lat_rad) * std::sin(lon_rad);
+    z = (a / xi * (1.0 - esq) + height) * std::sin(lat_rad);
 }
 
-Matrix3 NED::__nRe__(const Scalar lat_rad, const Scalar lon_rad) const
+void NED::Ecef2GeodeticD(double x, double y, double z, double& lat, double& lon, double& height) const
 {
-    Scalar sLat = btSin(lat_rad);
-    Scalar sLon = btSin(lon_rad);
-    Scalar cLat = btCos(lat_rad);
-    Scalar cLon = btCos(lon_rad);
+    // Convert ECEF coordinates to geodetic.
+    // J. Zhu, "Conversion of Earth-centered Earth-fixed coordinates
+    // to geodetic coordinates," IEEE Transactions on Aerospace and
+    // Electronic Systems, vol. 30, pp. 957-961, 1994.
+    double r = std::sqrt(x * x + y * y);
+    double Esq = a * a - b * b;
+    double F = 54.0 * b * b * z * z;
+    double G = r * r + (1.0 - esq) * z * z - esq * Esq;
+    double C = (esq * esq * F * r * r) / std::pow(G, 3.0);
+    double S = __cbrt__(1.0 + C + std::sqrt(C * C + 2.0 * C));
+    double P = F / (3.0 * std::pow((S + 1.0 / S + 1.0), 2.0) * G * G);
+    double Q = std::sqrt(1.0 + 2.0 * esq * esq * P);
+    double r_0 = -(P * esq * r) / (1.0 + Q) + std::sqrt(0.5 * a * a * (1.0 + 1.0 / Q) - P * (1.0 - esq) * z * z / (Q * (1.0 + Q)) - 0.5 * P * r * r);
+    double U = std::sqrt(std::pow((r - esq * r_0), 2.0) + z * z);
+    double V = std::sqrt(std::pow((r - esq * r_0), 2.0) + (1.0 - esq) * z * z);
+    double Z_0 = b * b * z / (a * V);
+    height = U * (1.0 - b * b / (a * V));
+    lat = (std::atan((z + e1sq * Z_0) / r))/M_PI * 180.0;
+    lon = (std::atan2(y, x))/M_PI * 180.0;
+}
 
-    Matrix3 ret(-sLat*cLon, -sLat*sLon, cLat,
-                         -sLon,       cLon,    0,
-                     cLat*cLon,  cLat*sLon, sLat);
+void NED::Ecef2NedD(double x, double y, double z, double& north, double& east, double& depth) const
+{
+    // Converts ECEF coordinate pos into local-tangent-plane NED
+    // coordinates relative to the ECEF coordinate of the NED origin.
+    double v[3] = {x - _init_ecef_x, y - _init_ecef_y, z - _init_ecef_z};
+    double ret[3];
+    for(unsigned int i=0; i<3; ++i)
+        ret[i] = _ecef_to_ned_matrix[i][0] * v[0] + _ecef_to_ned_matrix[i][1] * v[1] + _ecef_to_ned_matrix[i][2] * v[2];
+    north = ret[0];
+    east = ret[1];
+    depth = -ret[2];
+}
 
-    return ret;
+void NED::Ned2EcefD(double north, double east, double depth, double& x, double& y, double& z) const
+{
+    // NED (north/east/down) to ECEF coordinate system conversion.
+    double ned[3] = {north, east, -depth};
+    double ret[3];
+    for(unsigned int i=0; i<3; ++i)
+        ret[i] = _ned_to_ecef_matrix[i][0] * ned[0] + _ned_to_ecef_matrix[i][1] * ned[1] + _ned_to_ecef_matrix[i][2] * ned[2];
+    x = ret[0] + _init_ecef_x;
+    y = ret[1] + _init_ecef_y;
+    z = ret[2] + _init_ecef_z;
 }
 
-}
\ No newline at end of file
+double NED::__cbrt__(const double x) const
+{
+    if(x >= 0.0)
+        return std::pow(x, 1.0/3.0);
+    else
+        return -std::pow(std::fabs(x), 1.0/3.0);
+}
+
+void NED::__nRe__(const double lat_rad, const double lon_rad, double m[3][3]) const
+{
+    double sLat = std::sin(lat_rad);
+    double sLon = std::sin(lon_rad);
+    double cLat = std::cos(lat_rad);
+    double cLon = std::cos(lon_rad);
+
+    m[0][0] = -sLat*cLon; m[0][1] = -sLat*sLon; m[0][2] = cLat;
+    m[1][0] =      -sLon; m[1][1] =       cLon; m[1][2] = 0.0;
+    m[2][0] =  cLat*cLon; m[2][1] =  cLat*sLon; m[2][2] = sLat;
+}
+
+}
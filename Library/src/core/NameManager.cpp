@@ -30,48 +30,69 @@ namespace sf
 
 NameManager::NameManager()
 {
-    names = std::vector<std::string>(0);
 }
 
 NameManager::~NameManager()
 {
-    names.clear();
+    ClearNames();
 }
 
 std::string NameManager::AddName(std::string proposedName)
 {
-    std::string goodName = proposedName;
-    int number = 1;
+    //Name reserved in advance -> hand it over
+    if(!reserved.empty() && reserved.erase(proposedName) > 0)
+        return proposedName;
     
-checkname:
-    for(unsigned int i = 0; i < names.size(); i++)
+    return UniqueName(proposedName);
+}
+
+std::string NameManager::UniqueName(const std::string& proposedName)
+{
+    if(names.insert(proposedName).second)
+        return proposedName;
+    
+    //Name taken -> continue numbering from the last suffix used for this name
+    unsigned int& number = suffixes.try_emplace(proposedName, 1).first->second;
+    std::string goodName;
+    do
     {
-        if(goodName == names[i])
-        {
-            goodName = proposedName + std::to_string(number);
-            number++;
-            goto checkname;
-        }
+        goodName = proposedName + std::to_string(number++);
     }
+    while(!names.insert(goodName).second);
     
-    names.push_back(goodName);
     return goodName;
 }
 
+void NameManager::Reserve(size_t count)
+{
+    names.reserve(names.size() + count);
+}
+
+std::vector<std::string> NameManager::ReserveNames(const std::string& proposedName, size_t count)
+{
+    std::vector<std::string> goodNames;
+    goodNames.reserve(count);
+    names.reserve(names.size() + count);
+    reserved.reserve(reserved.size() + count);
+    for(size_t i=0; i<count; ++i)
+    {
+        goodNames.push_back(UniqueName(proposedName));
+        reserved.insert(goodNames.back());
+    }
+    return goodNames;
+}
+
 void NameManager::RemoveName(std::string name)
 {
-    std::vector<std::string>::iterator it;
-    for(it = names.begin(); it < names.end(); it++)
-        if(*it == name)
-        {
-            names.erase(it);
-            break;
-        }
+    names.erase(name);
+    reserved.erase(name);
 }
 
 void NameManager::ClearNames()
 {
     names.clear();
+    reserved.clear();
+    suffixes.clear();
 }
 
 }
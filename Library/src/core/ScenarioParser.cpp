@@ -32,6 +32,7 @@
 #include "entities/statics/Plane.h"
 #include "entities/statics/Terrain.h"
 #include "entities/AnimatedEntity.h"
+#include "entities/Swarm.h"
 #include "entities/animation/ManualTrajectory.h"
 #include "entities/animation/PWLTrajectory.h"
 #include "entities/animation/CRTrajectory.h"
@@ -65,6 +66,8 @@
 #include "sensors/vision/ThermalCamera.h"
 #include "sensors/vision/OpticalFlowCamera.h"
 #include "sensors/vision/SegmentationCamera.h"
+#include "sensors/vision/MultiCamera.h"
+#include "sensors/vision/CameraRig.h"
 #include "sensors/vision/EventBasedCamera.h"
 #include "sensors/vision/Multibeam2.h"
 #include "sensors/vision/FLS.h"
@@ -88,9 +91,14 @@
 #include "comms/OpticalModem.h"
 #include "joints/FixedJoint.h"
 #include "graphics/OpenGLDataStructs.h"
+#include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLTrackball.h"
 #include "utils/SystemUtil.hpp"
 #include "tinyexpr.h"
 #include <sstream>
+#include <set>
+#include <cstdio>
 
 namespace sf
 {
@@ -98,6 +106,12 @@ namespace sf
 ScenarioParser::ScenarioParser(SimulationManager* sm) : log(false), sm(sm)
 {
     graphical = SimulationApp::getApp()->hasGraphics();
+    scenarioKey = 0;
+}
+
+ScenarioParser::~ScenarioParser()
+{
+    OpenGLContent::setMeshCaching(false);
 }
 
 std::vector<ConsoleMessage> ScenarioParser::getLog()
@@ -110,11 +124,8 @@ SimulationManager* ScenarioParser::getSimulationManager()
     return sm;
 }
 
-bool ScenarioParser::Parse(std::string filename)
+bool ScenarioParser::LoadDescription(const std::string& filename)
 {
-    cInfo("Scenario parser: Loading scenario from '%s'.", filename.c_str());
-    log.Print(MessageType::INFO, "Scenario file: %s", filename.c_str());
-    
     //Open file
     XMLError result = doc.LoadFile(filename.c_str());
     if(result != XML_SUCCESS)
@@ -158,6 +169,38 @@ bool ScenarioParser::Parse(std::string filename)
         log.Print(MessageType::ERROR, "Including files failed!");
         return false;
     }
+    
+    //Expand repeated content and include files referenced by it
+    if(!ExpandRepeats(root) || !IncludeFiles(root))
+    {
+        log.Print(MessageType::ERROR, "Expanding repeats failed!");
+        return false;
+    }
+    
+    //Hash the expanded description (identifies the scenario and its arguments)
+    XMLPrinter printer;
+    root->Accept(&printer);
+    description = std::string(printer.CStr());
+    scenarioKey = 14695981039346656037ull; //FNV-1a
+    for(const char* c = printer.CStr(); *c != '\0'; ++c)
+    {
+        scenarioKey ^= (uint8_t)*c;
+        scenarioKey *= 1099511628211ull;
+    }
+    return true;
+}
+
+bool ScenarioParser::Parse(std::string filename)
+{
+    cInfo("Scenario parser: Loading scenario from '%s'.", filename.c_str());
+    log.Print(MessageType::INFO, "Scenario file: %s", filename.c_str());
+    
+    if(!LoadDescription(filename))
+        return false;
+    XMLNode* root = doc.FirstChildElement("scenario");
+    
+    //Load each mesh file only once
+    OpenGLContent::setMeshCaching(true);
 
     //Load solver settings
     XMLElement* element = root->FirstChildElement("solver");
@@ -232,6 +275,18 @@ bool ScenarioParser::Parse(std::string filename)
         element = element->NextSiblingElement("animated");
     }
     
+    //Load swarms (optional)
+    element = root->FirstChildElement("swarm");
+    while(element != nullptr)
+    {
+        if(!ParseSwarm(element))
+        {
+            log.Print(MessageType::ERROR, "Swarm not properly defined!");
+            return false;
+        }
+        element = element->NextSiblingElement("swarm");
+    }
+    
     //Load dynamic objects (optional)
     element = root->FirstChildElement("dynamic");
     while(element != nullptr)
@@ -344,10 +399,299 @@ bool ScenarioParser::Parse(std::string filename)
         element = element->NextSiblingElement("contact");
     }
     
+    //Remember what was built (reference for hot-reloading)
+    sm->setScenarioDescription(description);
+    
     log.Print(MessageType::INFO, "Parsing finished normally.");
     return true;
 }
 
+bool ScenarioParser::HotReload(std::string filename)
+{
+    cInfo("Scenario parser: Hot-reloading scenario from '%s'.", filename.c_str());
+    log.Print(MessageType::INFO, "Scenario file (hot-reload): %s", filename.c_str());
+    
+    if(SimulationApp::getApp()->getState() == SimulationState::RUNNING)
+    {
+        log.Print(MessageType::ERROR, "Simulation running -> stop it before hot-reloading!");
+        return false;
+    }
+    
+    //The world is modified with the settings locked, as when stepping the simulation
+    SDL_LockMutex(sm->simSettingsMutex);
+    bool success = ApplyChanges(filename);
+    SDL_UnlockMutex(sm->simSettingsMutex);
+    return success;
+}
+
+bool ScenarioParser::ApplyChanges(std::string filename)
+{
+    //Recover the description of the live world
+    XMLDocument liveDoc;
+    XMLElement* liveRoot = nullptr;
+    if(sm->getScenarioDescription() != "" && liveDoc.Parse(sm->getScenarioDescription().c_str()) == XML_SUCCESS)
+        liveRoot = liveDoc.FirstChildElement("scenario");
+    if(liveRoot == nullptr)
+    {
+        log.Print(MessageType::ERROR, "Live scenario was not loaded from a file -> restart required!");
+        return false;
+    }
+    
+    //Load the new description
+    if(!LoadDescription(filename))
+        return false;
+    XMLElement* root = doc.FirstChildElement("scenario");
+    if(description == sm->getScenarioDescription())
+    {
+        log.Print(MessageType::INFO, "No changes found.");
+        return true;
+    }
+    
+    //---- Find changes (the world is not modified until all of them are known to be supported) ----
+    //Everything apart from materials, looks and bodies has to stay the same
+    auto isReloadable = [](const char* tag)
+    {
+        return strcmp(tag, "materials") == 0 || strcmp(tag, "looks") == 0
+               || strcmp(tag, "static") == 0 || strcmp(tag, "dynamic") == 0;
+    };
+    std::string liveFixed;
+    std::string fixed;
+    for(XMLElement* e = liveRoot->FirstChildElement(); e != nullptr; e = e->NextSiblingElement())
+        if(!isReloadable(e->Name()))
+            liveFixed += PrintNode(e);
+    for(XMLElement* e = root->FirstChildElement(); e != nullptr; e = e->NextSiblingElement())
+        if(!isReloadable(e->Name()))
+            fixed += PrintNode(e);
+    if(fixed != liveFixed)
+    {
+        log.Print(MessageType::ERROR, "Changes outside of materials, looks and static/dynamic bodies -> restart required!");
+        return false;
+    }
+    
+    //Elements are identified by their tag and name
+    auto collect = [](XMLElement* parent, const char* group, const char* tag)
+    {
+        std::vector<XMLElement*> groups;
+        if(group == nullptr)
+            groups.push_back(parent);
+        else
+            for(XMLElement* g = parent->FirstChildElement(group); g != nullptr; g = g->NextSiblingElement(group))
+                groups.push_back(g);
+        
+        std::map<std::string, XMLElement*> items;
+        for(size_t i=0; i<groups.size(); ++i)
+            for(XMLElement* e = groups[i]->FirstChildElement(tag); e != nullptr; e = e->NextSiblingElement(tag))
+            {
+                const char* name = e->Attribute("name");
+                if(name != nullptr)
+                    items[std::string(name)] = e;
+            }
+        return items;
+    };
+    
+    //Materials (entities keep a copy of their material, so only new materials and friction can be applied)
+    XMLElement* materials = root->FirstChildElement("materials");
+    if(materials == nullptr)
+    {
+        log.Print(MessageType::ERROR, "Materials not defined!");
+        return false;
+    }
+    std::map<std::string, XMLElement*> liveItems = collect(liveRoot, "materials", "material");
+    std::map<std::string, XMLElement*> items = collect(root, "materials", "material");
+    std::vector<XMLElement*> newMaterials;
+    for(auto it = items.begin(); it != items.end(); ++it)
+    {
+        auto lit = liveItems.find(it->first);
+        if(lit == liveItems.end())
+        {
+            if(it->second->Attribute("density") == nullptr || it->second->Attribute("restitution") == nullptr)
+            {
+                log.Print(MessageType::ERROR, "Material '%s' not properly defined!", it->first.c_str());
+                return false;
+            }
+            newMaterials.push_back(it->second);
+        }
+        else if(PrintNode(lit->second) != PrintNode(it->second))
+        {
+            log.Print(MessageType::ERROR, "Properties of material '%s' changed -> restart required!", it->first.c_str());
+            return false;
+        }
+    }
+    XMLElement* liveMaterials = liveRoot->FirstChildElement("materials");
+    bool frictionChanged = newMaterials.size() > 0 || liveMaterials == nullptr
+                           || PrintNode(liveMaterials->FirstChildElement("friction_table")) != PrintNode(materials->FirstChildElement("friction_table"));
+    
+    //Looks (updated in place, so that the look ids used by the entities stay valid)
+    std::vector<XMLElement*> newLooks;
+    std::vector<XMLElement*> changedLooks;
+    if(isGraphicalSim())
+    {
+        liveItems = collect(liveRoot, "looks", "look");
+        items = collect(root, "looks", "look");
+        for(auto it = items.begin(); it != items.end(); ++it)
+        {
+            Color color = Color::Gray(1.f);
+            if(!ParseColor(it->second, color) || it->second->Attribute("roughness") == nullptr)
+            {
+                log.Print(MessageType::ERROR, "Look '%s' not properly defined!", it->first.c_str());
+                return false;
+            }
+            
+            auto lit = liveItems.find(it->first);
+            if(lit == liveItems.end())
+                newLooks.push_back(it->second);
+            else if(PrintNode(lit->second) != PrintNode(it->second))
+                changedLooks.push_back(it->second);
+        }
+    }
+    
+    //Bodies (static bodies which changed only their pose are moved, other changed bodies are rebuilt)
+    std::vector<Entity*> removedBodies;
+    std::vector<std::pair<StaticEntity*, Transform>> movedBodies;
+    std::vector<XMLElement*> addedBodies;
+    const char* bodyTags[2] = {"static", "dynamic"};
+    for(unsigned int t=0; t<2; ++t)
+    {
+        liveItems = collect(liveRoot, nullptr, bodyTags[t]);
+        items = collect(root, nullptr, bodyTags[t]);
+        for(auto lit = liveItems.begin(); lit != liveItems.end(); ++lit)
+        {
+            auto it = items.find(lit->first);
+            if(it != items.end() && PrintNode(it->second) == PrintNode(lit->second))
+                continue;
+            
+            Entity* ent = sm->getEntity(lit->first);
+            if(ent == nullptr || ent->getType() != (t == 0 ? EntityType::STATIC : EntityType::SOLID))
+            {
+                log.Print(MessageType::ERROR, "Body '%s' not found in the live world -> restart required!", lit->first.c_str());
+                return false;
+            }
+            
+            if(t == 1 && isGraphicalSim() && sm->getTrackball() != nullptr
+               && (Entity*)sm->getTrackball()->getHoldingEntity() == ent)
+            {
+                log.Print(MessageType::ERROR, "Body '%s' is followed by the view and cannot be rebuilt -> restart required!", lit->first.c_str());
+                return false;
+            }
+            
+            if(t == 0 && it != items.end()
+               && PrintNode(it->second, "world_transform") == PrintNode(lit->second, "world_transform"))
+            {
+                XMLElement* item;
+                Transform trans;
+                if((item = it->second->FirstChildElement("world_transform")) == nullptr || !ParseTransform(item, trans))
+                {
+                    log.Print(MessageType::ERROR, "Initial pose of static body '%s', in the world frame, missing!", lit->first.c_str());
+                    return false;
+                }
+                movedBodies.push_back(std::make_pair((StaticEntity*)ent, trans));
+                continue;
+            }
+            
+            if(lit->second->FirstChildElement("sensor") != nullptr
+               || lit->second->FirstChildElement("light") != nullptr
+               || lit->second->FirstChildElement("comm") != nullptr)
+            {
+                log.Print(MessageType::ERROR, "Body '%s' carries devices and cannot be rebuilt -> restart required!", lit->first.c_str());
+                return false;
+            }
+            for(unsigned int i=0; sm->getContact(i) != nullptr; ++i)
+                if(sm->getContact(i)->getEntityA() == ent || sm->getContact(i)->getEntityB() == ent)
+                {
+                    log.Print(MessageType::ERROR, "Body '%s' is used by a contact and cannot be rebuilt -> restart required!", lit->first.c_str());
+                    return false;
+                }
+            for(unsigned int i=0; sm->getJoint(i) != nullptr; ++i)
+                if((Entity*)sm->getJoint(i)->getSolidA() == ent || (Entity*)sm->getJoint(i)->getSolidB() == ent)
+                {
+                    log.Print(MessageType::ERROR, "Body '%s' is used by a joint and cannot be rebuilt -> restart required!", lit->first.c_str());
+                    return false;
+                }
+            
+            removedBodies.push_back(ent);
+            if(it != items.end())
+                addedBodies.push_back(it->second);
+        }
+        for(auto it = items.begin(); it != items.end(); ++it)
+            if(liveItems.find(it->first) == liveItems.end())
+                addedBodies.push_back(it->second);
+    }
+    
+    //---- Apply changes ----
+    //Only updating the textures of looks and building bodies can fail from here on, leaving the world partially updated (restart required)
+    OpenGLContent::setMeshCaching(true);
+    Polyhedron::ClearHullCache(); //Rebuilt bodies may use edited mesh files
+    
+    for(size_t i=0; i<newMaterials.size(); ++i)
+        ParseMaterial(newMaterials[i]);
+    if(frictionChanged)
+        ParseFrictionTable(materials);
+    
+    for(size_t i=0; i<newLooks.size(); ++i)
+        if(!ParseLook(newLooks[i]))
+        {
+            log.Print(MessageType::ERROR, "Hot-reload interrupted, world partially updated -> restart required!");
+            return false;
+        }
+    for(size_t i=0; i<changedLooks.size(); ++i)
+        if(!ParseLook(changedLooks[i], true))
+        {
+            log.Print(MessageType::ERROR, "Hot-reload interrupted, world partially updated -> restart required!");
+            return false;
+        }
+    
+    //Poses in the file are defined with respect to the original world origin
+    Vector3 origin = sm->getWorldOrigin();
+    for(size_t i=0; i<movedBodies.size(); ++i)
+    {
+        Transform trans = movedBodies[i].second;
+        trans.setOrigin(trans.getOrigin() - origin);
+        movedBodies[i].first->setTransform(trans);
+    }
+    
+    //Removal first, so that the rebuilt bodies get their original names
+    for(size_t i=0; i<removedBodies.size(); ++i)
+    {
+        if(removedBodies[i]->getType() == EntityType::STATIC)
+        {
+            sm->RemoveStaticEntity((StaticEntity*)removedBodies[i]);
+            if(isGraphicalSim())
+                ((StaticEntity*)removedBodies[i])->DestroyGraphicalObject();
+        }
+        else
+        {
+            sm->RemoveSolidEntity((SolidEntity*)removedBodies[i]);
+            if(isGraphicalSim())
+                ((SolidEntity*)removedBodies[i])->DestroyGraphicalObject();
+        }
+        delete removedBodies[i];
+    }
+    
+    for(size_t i=0; i<addedBodies.size(); ++i)
+    {
+        XMLElement* item = addedBodies[i]->FirstChildElement("world_transform");
+        Transform trans;
+        if(!origin.isZero() && item != nullptr && ParseTransform(item, trans))
+        {
+            trans.setOrigin(trans.getOrigin() - origin);
+            SetTransform(item, trans);
+        }
+        
+        if(strcmp(addedBodies[i]->Name(), "static") == 0 ? !ParseStatic(addedBodies[i]) : !ParseDynamic(addedBodies[i]))
+        {
+            log.Print(MessageType::ERROR, "Body not properly defined!");
+            log.Print(MessageType::ERROR, "Hot-reload interrupted, world partially updated -> restart required!");
+            return false;
+        }
+    }
+    
+    sm->setScenarioDescription(description);
+    
+    log.Print(MessageType::INFO, "Hot-reload finished: %zu bodies added, %zu removed, %zu moved; %zu looks added, %zu updated.",
+              addedBodies.size(), removedBodies.size(), movedBodies.size(), newLooks.size(), changedLooks.size());
+    return true;
+}
+
 bool ScenarioParser::SaveLog(std::string filename)
 {
     if(log.SaveToFile(filename))
@@ -380,6 +724,10 @@ bool ScenarioParser::ReplaceArguments(XMLNode* node, const std::map<std::string,
     XMLElement* element = node->ToElement();
     if(element != nullptr)
     {
+        //Repeat templates get arguments of their instances
+        if(std::string(element->Name()) == "template")
+            return true;
+        
         for(const XMLAttribute* attr = element->FirstAttribute(); attr != nullptr; attr = attr->Next())
         {
             std::string value = std::string(attr->Value());
@@ -431,6 +779,10 @@ bool ScenarioParser::EvaluateMath(XMLNode* node)
     XMLElement* element = node->ToElement();
     if(element != nullptr)
     {
+        //Repeat templates are evaluated per instance, after replacing arguments
+        if(std::string(element->Name()) == "template")
+            return true;
+        
         for(const XMLAttribute* attr = element->FirstAttribute(); attr != nullptr; attr = attr->Next())
         {
             std::string value = std::string(attr->Value());
@@ -492,22 +844,12 @@ bool ScenarioParser::IncludeFiles(XMLNode* node)
         }
         
         //Read optional arguments
-        std::map<std::string, std::string> args;	
-		XMLElement* argElement = element->FirstChildElement("arg");
-		while(argElement != nullptr)
-        {
-			const char* name = argElement->Attribute("name");
-			const char* value = argElement->Attribute("value");
-			
-			if(value == nullptr || name == nullptr)
-			{
-			    log.Print(MessageType::ERROR, "Include file argument not properly defined!");
-				return false;
-			}
-
-			args.insert(std::make_pair(std::string(name), std::string(value)));
-			argElement = argElement->NextSiblingElement("arg");
-		}
+        std::map<std::string, std::string> args;
+        if(!ParseArguments(element, args))
+        {
+            log.Print(MessageType::ERROR, "Include file argument not properly defined!");
+            return false;
+        }
 
         //Load file
         std::string includedPath = GetFullPath(std::string(path));
@@ -564,6 +906,169 @@ bool ScenarioParser::IncludeFiles(XMLNode* node)
     return true;
 }
 
+bool ScenarioParser::ExpandRepeats(XMLNode* node)
+{
+    XMLElement* element = node->FirstChildElement("repeat");
+    while(element != nullptr)
+    {
+        //Get template (loaded once for all instances)
+        XMLDocument templateDoc;
+        const XMLElement* templateRoot = nullptr;
+        const char* path = nullptr;
+        if(element->QueryStringAttribute("file", &path) == XML_SUCCESS)
+        {
+            std::string templatePath = GetFullPath(std::string(path));
+            if(templateDoc.LoadFile(templatePath.c_str()) != XML_SUCCESS 
+               || (templateRoot = templateDoc.FirstChildElement("scenario")) == nullptr)
+            {
+                log.Print(MessageType::ERROR, "Repeat template '%s' could not be loaded!", templatePath.c_str());
+                return false;
+            }
+        }
+        else if((templateRoot = element->FirstChildElement("template")) == nullptr)
+        {
+            log.Print(MessageType::ERROR, "Repeat template not defined!");
+            return false;
+        }
+        
+        //Read arguments common to all instances
+        std::map<std::string, std::string> commonArgs;
+        if(!ParseArguments(element, commonArgs))
+        {
+            log.Print(MessageType::ERROR, "Repeat argument not properly defined!");
+            return false;
+        }
+        
+        //Read instances (explicit or a number of copies with a constant offset)
+        std::vector<std::pair<std::map<std::string, std::string>, Transform>> instances;
+        XMLElement* item;
+        XMLElement* instElement = element->FirstChildElement("instance");
+        if(instElement != nullptr)
+        {
+            while(instElement != nullptr)
+            {
+                std::map<std::string, std::string> args;
+                Transform T = I4();
+                if(!ParseArguments(instElement, args)
+                   || ((item = instElement->FirstChildElement("world_transform")) != nullptr && !ParseTransform(item, T)))
+                {
+                    log.Print(MessageType::ERROR, "Repeat instance not properly defined!");
+                    return false;
+                }
+                instances.push_back(std::make_pair(args, T));
+                instElement = instElement->NextSiblingElement("instance");
+            }
+        }
+        else
+        {
+            unsigned int count;
+            Transform offset = I4();
+            if(element->QueryAttribute("count", &count) != XML_SUCCESS
+               || ((item = element->FirstChildElement("offset")) != nullptr && !ParseTransform(item, offset)))
+            {
+                log.Print(MessageType::ERROR, "Repeat instances not properly defined!");
+                return false;
+            }
+            Transform T = I4();
+            for(unsigned int i=0; i<count; ++i)
+            {
+                instances.push_back(std::make_pair(std::map<std::string, std::string>(), T));
+                T = T * offset;
+            }
+        }
+        
+        //Find arguments used by the template (instances resolving them in the same way share one pre-processed copy)
+        std::set<std::string> usedArgs;
+        std::string templateText = PrintNode(templateRoot);
+        size_t startPos, endPos;
+        for(startPos = templateText.find("$(arg "); startPos != std::string::npos 
+            && (endPos = templateText.find(")", startPos+6)) != std::string::npos; startPos = templateText.find("$(arg ", endPos))
+            usedArgs.insert(templateText.substr(startPos+6, endPos-startPos-6));
+        std::map<std::string, XMLElement*> processed;
+        auto releaseProcessed = [&]()
+        {
+            for(auto it = processed.begin(); it != processed.end(); ++it)
+                if(it->second != nullptr)
+                    doc.DeleteNode(it->second);
+        };
+        
+        //Create instances
+        for(size_t i=0; i<instances.size(); ++i)
+        {
+            std::map<std::string, std::string> args = instances[i].first;
+            args.insert(commonArgs.begin(), commonArgs.end()); //Instance arguments take precedence
+            args.insert(std::make_pair(std::string("instance"), std::to_string(i)));
+            
+            //Copy and pre-process the template only for a new combination of the used arguments
+            std::string key;
+            for(auto it = usedArgs.begin(); it != usedArgs.end(); ++it)
+            {
+                auto arg = args.find(*it);
+                key += *it + (arg != args.end() ? "=" + arg->second : std::string("")) + "\n";
+            }
+            XMLElement*& source = processed[key];
+            if(source == nullptr)
+            {
+                source = doc.NewElement("scenario");
+                bool ok = true;
+                for(const XMLNode* child = templateRoot->FirstChild(); child != nullptr && ok; child = child->NextSibling())
+                    ok = CopyNode(source, child);
+                if(!ok)
+                {
+                    releaseProcessed();
+                    log.Print(MessageType::ERROR, "Could not copy repeat template!");
+                    return false;
+                }
+                if(!PreProcess(source, args))
+                {
+                    releaseProcessed();
+                    log.Print(MessageType::ERROR, "Pre-processing of repeat instance %zu failed!", i);
+                    return false;
+                }
+            }
+            
+            XMLElement* instance = doc.NewElement("scenario");
+            for(const XMLNode* child = source->FirstChild(); child != nullptr; child = child->NextSibling())
+            {
+                if(!CopyNode(instance, child))
+                {
+                    doc.DeleteNode(instance);
+                    releaseProcessed();
+                    log.Print(MessageType::ERROR, "Could not copy repeat template!");
+                    return false;
+                }
+            }
+            
+            //Place top-level objects of the instance
+            for(XMLElement* obj = instance->FirstChildElement(); obj != nullptr; obj = obj->NextSiblingElement())
+            {
+                Transform T;
+                if((item = obj->FirstChildElement("world_transform")) != nullptr)
+                {
+                    if(!ParseTransform(item, T))
+                    {
+                        doc.DeleteNode(instance);
+                        releaseProcessed();
+                        return false;
+                    }
+                    SetTransform(item, instances[i].second * T);
+                }
+            }
+            
+            //Move content to the scenario
+            for(XMLNode* child = instance->FirstChild(); child != nullptr; child = instance->FirstChild())
+                node->InsertEndChild(child);
+            doc.DeleteNode(instance);
+        }
+        
+        releaseProcessed();
+        log.Print(MessageType::INFO, "Repeated template %zu times (%zu pre-processed).", instances.size(), processed.size());
+        node->DeleteChild(element); //Delete "repeat" element
+        element = node->FirstChildElement("repeat");
+    }
+    return true;
+}
+
 bool ScenarioParser::ParseSolver(XMLElement* element)
 {
     XMLElement* item;
@@ -597,6 +1102,52 @@ bool ScenarioParser::ParseSolver(XMLElement* element)
         && item->QueryAttribute("prescaler", &presc) == XML_SUCCESS)
             sm->setFluidDynamicsPrescaler(presc);
 
+    if((item = element->FirstChildElement("multirate")) != nullptr)
+    {
+        unsigned int divider;
+        Scalar promotionDistance;
+        sm->getMultiRateParams(divider, promotionDistance);
+        item->QueryAttribute("divider", &divider);
+        item->QueryAttribute("promotion_distance", &promotionDistance);
+        sm->setMultiRateParams(divider, promotionDistance);
+    }
+
+    Scalar foDistance;
+    if((item = element->FirstChildElement("floating_origin")) != nullptr
+        && item->QueryAttribute("distance", &foDistance) == XML_SUCCESS)
+            sm->setFloatingOrigin(foDistance);
+
+    unsigned int seed;
+    if((item = element->FirstChildElement("random_seed")) != nullptr
+        && item->QueryAttribute("value", &seed) == XML_SUCCESS)
+            sm->setRandomSeed(seed);
+
+    if((item = element->FirstChildElement("realtime")) != nullptr)
+    {
+        unsigned int maxCatchUp = 2;
+        Scalar deadline(0);
+        int priority = 0;
+        int cpu = -1;
+        bool lockMemory = false;
+        item->QueryAttribute("max_catch_up", &maxCatchUp);
+        item->QueryAttribute("deadline", &deadline);
+        item->QueryAttribute("priority", &priority);
+        item->QueryAttribute("cpu", &cpu);
+        item->QueryAttribute("lock_memory", &lockMemory);
+        sm->setRealtimeMode(true, maxCatchUp, deadline, priority, cpu, lockMemory);
+    }
+
+    if((item = element->FirstChildElement("settling")) != nullptr)
+    {
+        Scalar kinetic(0), impulse(0);
+        const char* cache = nullptr;
+        item->QueryAttribute("kinetic_energy", &kinetic);
+        item->QueryAttribute("contact_impulse", &impulse);
+        sm->setSettlingThresholds(kinetic, impulse);
+        if(item->QueryStringAttribute("cache", &cache) == XML_SUCCESS)
+            sm->setSettledStateCache(GetFullPath(std::string(cache)), scenarioKey);
+    }
+
     return true;
 }
 
@@ -612,14 +1163,14 @@ bool ScenarioParser::ParseEnvironment(XMLElement* element)
         return false;
     }
     
-    Scalar lat, lon;
+    double lat, lon;
     if(ned->QueryAttribute("latitude", &lat) != XML_SUCCESS
        || ned->QueryAttribute("longitude", &lon) != XML_SUCCESS)
     {
         log.Print(MessageType::ERROR, "NED definition incorrect!");
         return false;
     }
-    sm->getNED()->Init(lat, lon, Scalar(0));
+    sm->getNED()->Init(lat, lon, 0.0);
     
     //Setup ocean
     XMLElement* ocean = element->FirstChildElement("ocean");
@@ -732,31 +1283,43 @@ bool ScenarioParser::ParseMaterials(XMLElement* element)
     //Iterate through all materials
     while(mat != nullptr)
     {
-        const char* name = nullptr;
-        Scalar density, restitution;
-        Scalar magnetic(0);
-        if(mat->QueryStringAttribute("name", &name) != XML_SUCCESS)
-        {
-            log.Print(MessageType::ERROR, "Material name missing!");
-            return false;
-        }
-        std::string materialName(name);
-        if(mat->QueryAttribute("density", &density) != XML_SUCCESS)
-        {
-            log.Print(MessageType::ERROR, "Density of material '%s' missing!", materialName.c_str());
-            return false;
-        }
-        if(mat->QueryAttribute("restitution", &restitution) != XML_SUCCESS)
-        {
-            log.Print(MessageType::ERROR, "Restitution of material '%s' missing!", materialName.c_str());
+        if(!ParseMaterial(mat))
             return false;
-        }
-        mat->QueryAttribute("magnetic", &magnetic);
-        sm->getMaterialManager()->CreateMaterial(materialName, density, restitution, magnetic);
         mat = mat->NextSiblingElement("material");
     }
     
-    //Read friction table
+    ParseFrictionTable(element);
+    return true;
+}
+
+bool ScenarioParser::ParseMaterial(XMLElement* element)
+{
+    const char* name = nullptr;
+    Scalar density, restitution;
+    Scalar magnetic(0);
+    if(element->QueryStringAttribute("name", &name) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Material name missing!");
+        return false;
+    }
+    std::string materialName(name);
+    if(element->QueryAttribute("density", &density) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Density of material '%s' missing!", materialName.c_str());
+        return false;
+    }
+    if(element->QueryAttribute("restitution", &restitution) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Restitution of material '%s' missing!", materialName.c_str());
+        return false;
+    }
+    element->QueryAttribute("magnetic", &magnetic);
+    sm->getMaterialManager()->CreateMaterial(materialName, density, restitution, magnetic);
+    return true;
+}
+
+void ScenarioParser::ParseFrictionTable(XMLElement* element)
+{
     XMLElement* table = element->FirstChildElement("friction_table");
     if(table == nullptr) //Optional
     {
@@ -786,7 +1349,6 @@ bool ScenarioParser::ParseMaterials(XMLElement* element)
             friction = friction->NextSiblingElement("friction");
         }
     }
-    return true;
 }
         
 bool ScenarioParser::ParseLooks(XMLElement* element)
@@ -803,65 +1365,78 @@ bool ScenarioParser::ParseLooks(XMLElement* element)
     //Iterate through all looks
     while(look != nullptr)
     {
-        const char* name = nullptr;
-        Color color = Color::Gray(1.f);
-        Scalar roughness;
-        Scalar metalness;
-        Scalar reflectivity;
-        std::pair<Scalar, Scalar> tempRange;
-        const char* texture = nullptr;
-        std::string textureStr = "";
-        const char* normalMap = nullptr;
-        std::string normalMapStr = "";
-        const char* tempMap = nullptr;
-        std::string tempMapStr = "";
-        
-        if(look->QueryStringAttribute("name", &name) != XML_SUCCESS)
-        {
-            log.Print(MessageType::ERROR, "Look name missing!");
+        if(!ParseLook(look))
             return false;
-        }
-        std::string lookName(name);
-
-        if(!ParseColor(look, color))
-        {
-            log.Print(MessageType::ERROR, "Color of look '%s' missing!", lookName.c_str());
-            return false;    
-        }
-        if(look->QueryAttribute("roughness", &roughness) != XML_SUCCESS)
-        {
-            log.Print(MessageType::ERROR, "Roughness of look '%s' missing!", lookName.c_str());
-            return false;
-        }
-        if(look->QueryAttribute("metalness", &metalness) != XML_SUCCESS)
-            metalness = Scalar(0);
-        if(look->QueryAttribute("reflectivity", &reflectivity) != XML_SUCCESS)
-            reflectivity = Scalar(0);
-        if(look->QueryStringAttribute("texture", &texture) == XML_SUCCESS)
-            textureStr = GetFullPath(std::string(texture));
-        if(look->QueryStringAttribute("normal_map", &normalMap) == XML_SUCCESS)
-            normalMapStr = GetFullPath(std::string(normalMap));
-        
-        if(look->QueryAttribute("temperature", &tempRange.first) == XML_SUCCESS)
-        {
-            tempRange.second = tempRange.first;
-            sm->CreateLook(lookName, color, roughness, metalness, reflectivity, textureStr, normalMapStr, "", tempRange);
-        }
-        else if(look->QueryStringAttribute("temperature_map", &tempMap) == XML_SUCCESS
-                && look->QueryAttribute("temperature_min", &tempRange.first) == XML_SUCCESS
-                && look->QueryAttribute("temperature_max", &tempRange.second) == XML_SUCCESS)
-        {
-            tempMapStr = GetFullPath(std::string(tempMap));
-            sm->CreateLook(lookName, color, roughness, metalness, reflectivity, textureStr, normalMapStr, tempMapStr, tempRange);
-        }
-        else
-        sm->CreateLook(lookName, color, roughness, metalness, reflectivity, textureStr, normalMapStr);
         look = look->NextSiblingElement("look");
     }
     
     return true;
 }
 
+bool ScenarioParser::ParseLook(XMLElement* look, bool update)
+{
+    const char* name = nullptr;
+    Color color = Color::Gray(1.f);
+    Scalar roughness;
+    Scalar metalness;
+    Scalar reflectivity;
+    std::pair<Scalar, Scalar> tempRange;
+    const char* texture = nullptr;
+    std::string textureStr = "";
+    const char* normalMap = nullptr;
+    std::string normalMapStr = "";
+    const char* tempMap = nullptr;
+    std::string tempMapStr = "";
+    
+    if(look->QueryStringAttribute("name", &name) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Look name missing!");
+        return false;
+    }
+    std::string lookName(name);
+
+    if(!ParseColor(look, color))
+    {
+        log.Print(MessageType::ERROR, "Color of look '%s' missing!", lookName.c_str());
+        return false;    
+    }
+    if(look->QueryAttribute("roughness", &roughness) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Roughness of look '%s' missing!", lookName.c_str());
+        return false;
+    }
+    if(look->QueryAttribute("metalness", &metalness) != XML_SUCCESS)
+        metalness = Scalar(0);
+    if(look->QueryAttribute("reflectivity", &reflectivity) != XML_SUCCESS)
+        reflectivity = Scalar(0);
+    if(look->QueryStringAttribute("texture", &texture) == XML_SUCCESS)
+        textureStr = GetFullPath(std::string(texture));
+    if(look->QueryStringAttribute("normal_map", &normalMap) == XML_SUCCESS)
+        normalMapStr = GetFullPath(std::string(normalMap));
+    
+    if(look->QueryAttribute("temperature", &tempRange.first) == XML_SUCCESS)
+    {
+        tempRange.second = tempRange.first;
+    }
+    else if(look->QueryStringAttribute("temperature_map", &tempMap) == XML_SUCCESS
+            && look->QueryAttribute("temperature_min", &tempRange.first) == XML_SUCCESS
+            && look->QueryAttribute("temperature_max", &tempRange.second) == XML_SUCCESS)
+    {
+        tempMapStr = GetFullPath(std::string(tempMap));
+    }
+    else
+        tempRange = std::make_pair(Scalar(20), Scalar(20));
+    
+    if(!update)
+        sm->CreateLook(lookName, color, roughness, metalness, reflectivity, textureStr, normalMapStr, tempMapStr, tempRange);
+    else if(!sm->UpdateLook(lookName, color, roughness, metalness, reflectivity, textureStr, normalMapStr, tempMapStr, tempRange))
+    {
+        log.Print(MessageType::ERROR, "Look '%s' could not be updated!", lookName.c_str());
+        return false;
+    }
+    return true;
+}
+
 VelocityField* ScenarioParser::ParseVelocityField(XMLElement* element)
 {
     //Get type of current
@@ -1518,6 +2093,120 @@ bool ScenarioParser::ParseAnimated(XMLElement* element)
     return true;
 }
 
+bool ScenarioParser::ParseSwarm(XMLElement* element)
+{
+    //---- Basic ----
+    const char* name = nullptr;
+    const char* behaviour = nullptr;
+    unsigned int agents;
+    if(element->QueryStringAttribute("name", &name) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Name of swarm missing!");
+        return false;
+    }
+    std::string swarmName(name);
+
+    if(element->QueryAttribute("agents", &agents) != XML_SUCCESS || agents == 0)
+    {
+        log.Print(MessageType::ERROR, "Number of agents of swarm '%s' missing!", swarmName.c_str());
+        return false;
+    }
+    
+    SwarmBehaviour sb = SwarmBehaviour::BOIDS;
+    if(element->QueryStringAttribute("behaviour", &behaviour) == XML_SUCCESS) //Optional
+    {
+        std::string behaviourStr(behaviour);
+        if(behaviourStr == "boids")
+            sb = SwarmBehaviour::BOIDS;
+        else if(behaviourStr == "drift")
+            sb = SwarmBehaviour::DRIFT;
+        else
+        {
+            log.Print(MessageType::ERROR, "Unknown behaviour of swarm '%s'!", swarmName.c_str());
+            return false;
+        }
+    }
+
+    //---- Common ----
+    XMLElement* item;
+    const char* mesh = nullptr;
+    const char* mat = nullptr;
+    const char* look = nullptr;
+    Scalar scale;
+    
+    if((item = element->FirstChildElement("mesh")) == nullptr
+       || item->QueryStringAttribute("filename", &mesh) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Mesh of swarm '%s' not properly defined!", swarmName.c_str());
+        return false;
+    }
+    if(item->QueryAttribute("scale", &scale) != XML_SUCCESS)
+        scale = Scalar(1);
+    if((item = element->FirstChildElement("material")) == nullptr
+       || item->QueryStringAttribute("name", &mat) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Material definition for swarm '%s' missing!", swarmName.c_str());
+        return false;
+    }
+    if((item = element->FirstChildElement("look")) == nullptr
+       || item->QueryStringAttribute("name", &look) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Look definition for swarm '%s' missing!", swarmName.c_str());
+        return false;
+    }
+    
+    Swarm* swarm = new Swarm(swarmName, agents, GetFullPath(std::string(mesh)), scale, std::string(mat), std::string(look), sb);
+    
+    //---- Behaviour ----
+    if((item = element->FirstChildElement("region")) != nullptr)
+    {
+        const char* ext = nullptr;
+        Transform origin;
+        Vector3 halfExtents;
+        if(!ParseTransform(item, origin)
+           || item->QueryStringAttribute("half_extents", &ext) != XML_SUCCESS
+           || !ParseVector(ext, halfExtents))
+        {
+            log.Print(MessageType::ERROR, "Region of swarm '%s' not properly defined!", swarmName.c_str());
+            delete swarm;
+            return false;
+        }
+        swarm->setRegion(origin, halfExtents);
+    }
+    if((item = element->FirstChildElement("speed")) != nullptr)
+    {
+        Scalar cruise, max;
+        if(item->QueryAttribute("cruise", &cruise) != XML_SUCCESS
+           || item->QueryAttribute("max", &max) != XML_SUCCESS)
+        {
+            log.Print(MessageType::ERROR, "Speed of swarm '%s' not properly defined!", swarmName.c_str());
+            delete swarm;
+            return false;
+        }
+        swarm->setSpeed(cruise, max);
+    }
+    if((item = element->FirstChildElement("boids")) != nullptr)
+    {
+        Scalar radius, sepDist, cohesion, alignment, separation;
+        if(item->QueryAttribute("radius", &radius) != XML_SUCCESS
+           || item->QueryAttribute("separation_distance", &sepDist) != XML_SUCCESS
+           || item->QueryAttribute("cohesion", &cohesion) != XML_SUCCESS
+           || item->QueryAttribute("alignment", &alignment) != XML_SUCCESS
+           || item->QueryAttribute("separation", &separation) != XML_SUCCESS)
+        {
+            log.Print(MessageType::ERROR, "Boids parameters of swarm '%s' not properly defined!", swarmName.c_str());
+            delete swarm;
+            return false;
+        }
+        swarm->setBoidsParameters(radius, sepDist, cohesion, alignment, separation);
+    }
+    
+    //---- Add to world ----
+    sm->AddEntity(swarm);
+    
+    return true;
+}
+
 bool ScenarioParser::ParseDynamic(XMLElement* element)
 {
     //---- Solid ----
@@ -1733,7 +2422,7 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
         Transform origin;
         Transform cg;
         Scalar mass;
-        Scalar ix, iy, iz;
+        double ix, iy, iz;
         Vector3 I;
         Vector3 Cf(-1,-1,-1);
         Vector3 Cd(-1,-1,-1);    
@@ -1900,6 +2589,7 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
                 log.Print(MessageType::ERROR, "Physical mesh of rigid body '%s' not properly defined!", solidName.c_str());
                 return false;
             }
+            XMLElement* hull = item->FirstChildElement("hull");
             
             if((item = element->FirstChildElement("visual")) != nullptr)
             {
@@ -1925,6 +2615,18 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
             {
                 solid = new Polyhedron(solidName, phy, GetFullPath(std::string(phyMesh)), phyScale, phyOrigin, std::string(mat), std::string(look), thickness); 
             }
+
+            //Optional collision hull settings
+            if(hull != nullptr)
+            {
+                unsigned int maxVertices(64);
+                Scalar volumeError(0.02);
+                Scalar margin(0);
+                hull->QueryAttribute("max_vertices", &maxVertices);
+                hull->QueryAttribute("volume_error", &volumeError);
+                hull->QueryAttribute("margin", &margin);
+                ((Polyhedron*)solid)->setCollisionHull(maxVertices, volumeError, margin);
+            }
         }
         else
         {
@@ -3845,6 +4547,16 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
         }
         else
             cam = new ColorCamera(sensorName, resX, resY, hFov, rate);
+        
+        //Optional output stage
+        if((item = element->FirstChildElement("output")) != nullptr)
+        {
+            CameraOutputSettings output;
+            if(ParseCameraOutput(item, output))
+                cam->setOutputSettings(output);
+            else
+                log.Print(MessageType::WARNING, "Output of camera '%s' not properly defined - using full image.", sensorName.c_str());
+        }
         sens = cam;
     }
     else if(typeStr == "depthcamera")
@@ -3880,6 +4592,16 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
             else
                 log.Print(MessageType::WARNING, "Noise of depth camera '%s' not properly defined - using defaults.", sensorName.c_str());
         }
+        
+        //Optional output stage
+        if((item = element->FirstChildElement("output")) != nullptr)
+        {
+            CameraOutputSettings output;
+            if(ParseCameraOutput(item, output))
+                dcam->setOutputSettings(output);
+            else
+                log.Print(MessageType::WARNING, "Output of depth camera '%s' not properly defined - using full image.", sensorName.c_str());
+        }
         sens = dcam;
     }
     else if(typeStr == "thermalcamera")
@@ -4060,8 +4782,120 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
         else
             scam = new SegmentationCamera(sensorName, resX, resY, hFov, rate);
 
+        //Optional output stage
+        if((item = element->FirstChildElement("output")) != nullptr)
+        {
+            CameraOutputSettings output;
+            if(ParseCameraOutput(item, output))
+                scam->setOutputSettings(output);
+            else
+                log.Print(MessageType::WARNING, "Output of segmentation camera '%s' not properly defined - using full image.", sensorName.c_str());
+        }
         sens = scam;
     }
+    else if(typeStr == "multicamera")
+    {
+        if(!isGraphicalSim())
+        {
+            log.Print(MessageType::ERROR, "Multi-output cameras not supported in console mode!");
+            return nullptr;
+        }
+
+        int resX, resY;
+        Scalar hFov;
+        if((item = element->FirstChildElement("specs")) == nullptr 
+            || item->QueryAttribute("resolution_x", &resX) != XML_SUCCESS 
+            || item->QueryAttribute("resolution_y", &resY) != XML_SUCCESS
+            || item->QueryAttribute("horizontal_fov", &hFov) != XML_SUCCESS)
+        {
+            log.Print(MessageType::ERROR, "Specs of multi-output camera '%s' not properly defined!", sensorName.c_str());
+            return nullptr;
+        }
+
+        Scalar minDist(STD_NEAR_PLANE_DISTANCE);
+        Scalar maxDist(STD_FAR_PLANE_DISTANCE);
+        if((item = element->FirstChildElement("rendering")) != nullptr) 
+        {
+            item->QueryAttribute("minimum_distance", &minDist);
+            item->QueryAttribute("maximum_distance", &maxDist);
+        }
+        MultiCamera* mcam = new MultiCamera(sensorName, resX, resY, hFov, rate, minDist, maxDist);
+
+        //Optional output selection (all enabled by default)
+        if((item = element->FirstChildElement("outputs")) != nullptr)
+        {
+            bool color = true, depth = true, segmentation = true, flow = true;
+            item->QueryBoolAttribute("color", &color);
+            item->QueryBoolAttribute("depth", &depth);
+            item->QueryBoolAttribute("segmentation", &segmentation);
+            item->QueryBoolAttribute("optical_flow", &flow);
+            mcam->setOutputEnabled(MultiCameraOutput::COLOR, color);
+            mcam->setOutputEnabled(MultiCameraOutput::DEPTH, depth);
+            mcam->setOutputEnabled(MultiCameraOutput::SEGMENTATION, segmentation);
+            mcam->setOutputEnabled(MultiCameraOutput::OPTICAL_FLOW, flow);
+        }
+
+        //Optional output stage (colour image)
+        if((item = element->FirstChildElement("output")) != nullptr)
+        {
+            CameraOutputSettings output;
+            if(ParseCameraOutput(item, output))
+                mcam->setOutputSettings(output);
+            else
+                log.Print(MessageType::WARNING, "Output of multi-output camera '%s' not properly defined - using full image.", sensorName.c_str());
+        }
+        sens = mcam;
+    }
+    else if(typeStr == "camerarig")
+    {
+        if(!isGraphicalSim())
+        {
+            log.Print(MessageType::ERROR, "Camera rigs not supported in console mode!");
+            return nullptr;
+        }
+
+        int resX, resY;
+        Scalar hFov;
+        if((item = element->FirstChildElement("specs")) == nullptr 
+            || item->QueryAttribute("resolution_x", &resX) != XML_SUCCESS 
+            || item->QueryAttribute("resolution_y", &resY) != XML_SUCCESS
+            || item->QueryAttribute("horizontal_fov", &hFov) != XML_SUCCESS)
+        {
+            log.Print(MessageType::ERROR, "Specs of camera rig '%s' not properly defined!", sensorName.c_str());
+            return nullptr;
+        }
+
+        Scalar minDist(STD_NEAR_PLANE_DISTANCE);
+        Scalar maxDist(STD_FAR_PLANE_DISTANCE);
+        if((item = element->FirstChildElement("rendering")) != nullptr) 
+        {
+            item->QueryAttribute("minimum_distance", &minDist);
+            item->QueryAttribute("maximum_distance", &maxDist);
+        }
+
+        //Cameras of the rig (at least one)
+        std::vector<Transform> eyes;
+        for(item = element->FirstChildElement("eye"); item != nullptr; item = item->NextSiblingElement("eye"))
+        {
+            Transform T;
+            if(!ParseTransform(item, T))
+            {
+                log.Print(MessageType::ERROR, "Camera of rig '%s' not properly defined!", sensorName.c_str());
+                return nullptr;
+            }
+            eyes.push_back(T);
+        }
+        if(eyes.size() == 0)
+        {
+            log.Print(MessageType::ERROR, "No cameras defined for rig '%s'!", sensorName.c_str());
+            return nullptr;
+        }
+
+        CameraRig* rig = new CameraRig(sensorName, resX, resY, hFov, rate, minDist, maxDist);
+        for(size_t i=0; i<eyes.size(); ++i)
+            rig->AddEye(eyes[i]);
+        sens = rig;
+    }
     else if(typeStr == "ebc" || typeStr == "eventbasedcamera")
     {
         if(!isGraphicalSim())
@@ -4365,6 +5199,32 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
         return nullptr;
     }
 
+    //---- Callback dispatch ----
+    if((item = element->FirstChildElement("dispatch")) != nullptr)
+    {
+        if(sens->getType() != SensorType::VISION)
+            log.Print(MessageType::WARNING, "Asynchronous callback dispatch not supported by sensor '%s'!", sensorName.c_str());
+        else
+        {
+            unsigned int queue = 4;
+            item->QueryAttribute("queue", &queue);
+            
+            QueueOverflowPolicy policy = QueueOverflowPolicy::DROP_OLDEST;
+            const char* overflow = nullptr;
+            if(item->QueryStringAttribute("overflow", &overflow) == XML_SUCCESS)
+            {
+                std::string overflowStr = std::string(overflow);
+                if(overflowStr == "drop_newest")
+                    policy = QueueOverflowPolicy::DROP_NEWEST;
+                else if(overflowStr == "block")
+                    policy = QueueOverflowPolicy::BLOCK;
+                else if(overflowStr != "drop_oldest")
+                    log.Print(MessageType::WARNING, "Unknown overflow policy of sensor '%s' - using 'drop_oldest'.", sensorName.c_str());
+            }
+            ((VisionSensor*)sens)->setAsyncDispatch(queue, policy);
+        }
+    }
+    
     //---- Visuals ----
     const char* visFile = nullptr;
     if((item = element->FirstChildElement("visual")) != nullptr && item->QueryStringAttribute("filename", &visFile) == XML_SUCCESS)
@@ -4897,6 +5757,27 @@ std::string ScenarioParser::GetFullPath(const std::string& path)
 }
 
 //Private
+std::string ScenarioParser::PrintNode(const XMLNode* node, const char* skipChild)
+{
+    if(node == nullptr)
+        return "";
+    
+    XMLPrinter printer(nullptr, true);
+    if(skipChild == nullptr)
+        node->Accept(&printer);
+    else
+    {
+        XMLDocument tmp;
+        XMLNode* copy = node->DeepClone(&tmp);
+        tmp.InsertEndChild(copy);
+        XMLElement* child;
+        while((child = copy->FirstChildElement(skipChild)) != nullptr)
+            copy->DeleteChild(child);
+        copy->Accept(&printer);
+    }
+    return std::string(printer.CStr());
+}
+
 bool ScenarioParser::CopyNode(XMLNode* destParent, const XMLNode* src)
 {
     //Should not happen, could maybe return false
@@ -4926,7 +5807,7 @@ bool ScenarioParser::CopyNode(XMLNode* destParent, const XMLNode* src)
 
 bool ScenarioParser::ParseVector(const char* components, Vector3& v)
 {
-    Scalar x, y, z;
+    double x, y, z;
     if(sscanf(components, "%lf %lf %lf", &x, &y, &z) != 3) 
         return false;
     v.setX(x);
@@ -4955,6 +5836,31 @@ bool ScenarioParser::ParseTransform(XMLElement* element, Transform& T)
     return true;
 }
 
+void ScenarioParser::SetTransform(XMLElement* element, const Transform& T)
+{
+    Scalar yaw, pitch, roll;
+    T.getBasis().getEulerYPR(yaw, pitch, roll);
+    char xyz[128];
+    char rpy[128];
+    std::snprintf(xyz, sizeof(xyz), "%.17g %.17g %.17g", (double)T.getOrigin().x(), (double)T.getOrigin().y(), (double)T.getOrigin().z()); //Full precision
+    std::snprintf(rpy, sizeof(rpy), "%.17g %.17g %.17g", (double)roll, (double)pitch, (double)yaw);
+    element->SetAttribute("xyz", xyz);
+    element->SetAttribute("rpy", rpy);
+}
+
+bool ScenarioParser::ParseArguments(XMLElement* element, std::map<std::string, std::string>& args)
+{
+    for(XMLElement* argElement = element->FirstChildElement("arg"); argElement != nullptr; argElement = argElement->NextSiblingElement("arg"))
+    {
+        const char* name = argElement->Attribute("name");
+        const char* value = argElement->Attribute("value");
+        if(value == nullptr || name == nullptr)
+            return false;
+        args.insert(std::make_pair(std::string(name), std::string(value)));
+    }
+    return true;
+}
+
 bool ScenarioParser::ParseColor(XMLElement* element, Color& c)
 {
     const char* components = nullptr;
@@ -5012,6 +5918,47 @@ bool ScenarioParser::ParseColorMap(XMLElement* element, ColorMap& cm)
     }
 }
 
+bool ScenarioParser::ParseCameraOutput(XMLElement* element, CameraOutputSettings& s)
+{
+    const char* roi = nullptr;
+    const char* format = nullptr;
+    
+    if(element->QueryStringAttribute("roi", &roi) == XML_SUCCESS
+       && sscanf(roi, "%u %u %u %u", &s.roiX, &s.roiY, &s.roiWidth, &s.roiHeight) != 4)
+        return false;
+    
+    if(element->QueryAttribute("binning", &s.binning) == XML_WRONG_ATTRIBUTE_TYPE)
+        return false;
+    
+    if(element->QueryAttribute("depth_scale", &s.depthScale) == XML_WRONG_ATTRIBUTE_TYPE)
+        return false;
+    
+    if(element->QueryStringAttribute("format", &format) == XML_SUCCESS)
+    {
+        std::string formatStr(format);
+        if(formatStr == "native")
+            s.format = CameraOutputFormat::NATIVE;
+        else if(formatStr == "mono8")
+            s.format = CameraOutputFormat::MONO8;
+        else if(formatStr == "bayer_rggb8")
+            s.format = CameraOutputFormat::BAYER_RGGB8;
+        else if(formatStr == "bayer_bggr8")
+            s.format = CameraOutputFormat::BAYER_BGGR8;
+        else if(formatStr == "bayer_grbg8")
+            s.format = CameraOutputFormat::BAYER_GRBG8;
+        else if(formatStr == "bayer_gbrg8")
+            s.format = CameraOutputFormat::BAYER_GBRG8;
+        else if(formatStr == "depth16")
+            s.format = CameraOutputFormat::DEPTH_UINT16;
+        else
+        {
+            log.Print(MessageType::ERROR, "Unknown camera output format '%s'!", formatStr.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ScenarioParser::isGraphicalSim()
 {
     return graphical;
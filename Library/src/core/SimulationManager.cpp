@@ -39,6 +39,18 @@
 #include <typeinfo>
 #include <omp.h>
 #include <algorithm>
+#include <unordered_set>
+#include <queue>
+#include <random>
+#include <fstream>
+#include <array>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <errno.h>
+#endif
 #include "core/FilteredCollisionDispatcher.h"
 #include "core/GraphicalSimulationApp.h"
 #include "core/NameManager.h"
@@ -57,19 +69,24 @@
 //#include "entities/CableEntity.h"
 #include "entities/FeatherstoneEntity.h"
 #include "entities/solids/Compound.h"
+#include "entities/solids/Polyhedron.h"
 #include "entities/StaticEntity.h"
 #include "entities/AnimatedEntity.h"
+#include "entities/Swarm.h"
 #include "entities/ForcefieldEntity.h"
 #include "entities/forcefields/Trigger.h"
 #include "entities/statics/Plane.h"
 #include "joints/Joint.h"
 #include "actuators/Actuator.h"
+#include "actuators/LinkActuator.h"
 #include "actuators/Light.h"
 #include "actuators/SuctionCup.h"
 #include "sensors/Sensor.h"
+#include "sensors/SensorDispatcher.h"
 #include "comms/Comm.h"
 #include "sensors/Contact.h"
 #include "sensors/VisionSensor.h"
+#include "sensors/scalar/JointSensor.h"
 
 extern ContactAddedCallback gContactAddedCallback;
 extern ContactProcessedCallback gContactProcessedCallback;
@@ -90,6 +107,13 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
     jointLimitErp = Scalar(0.2);
     linSleepThreshold = Scalar(0);
     angSleepThreshold = Scalar(0);
+    mrDivider = 1;
+    mrCounter = 0;
+    mrDistance = Scalar(10);
+    foDistance = Scalar(0);
+    worldOrigin.setZero();
+    trackballShift.setZero();
+    randomSeed = std::random_device()();
     fdCounter = 0;
     currentTime = 0;
     timeOffset = 0;
@@ -105,8 +129,8 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
     ocean = nullptr;
     atmosphere = nullptr;
     trackball = nullptr;
+    sensorDispatcher = nullptr;
     sdm = DisplayMode::GRAPHICAL;
-    simHydroMutex = SDL_CreateMutex();
     simSettingsMutex = SDL_CreateMutex();
     simInfoMutex = SDL_CreateMutex();
     setStepsPerSecond(stepsPerSecond);
@@ -114,6 +138,20 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
     //Set IC solver params
     icProblemSolved = false;
     setICSolverParams(false);
+    icKinThreshold = Scalar(0);
+    icImpThreshold = Scalar(0);
+    icLastImpulse = Scalar(0);
+    icCacheKey = 0;
+    
+    //Real-time mode disabled
+    rtEnabled = false;
+    rtMaxCatchUp = 2;
+    rtDeadline = 0;
+    rtPriority = 0;
+    rtCpuCore = -1;
+    rtLockMemory = false;
+    rtTickStart = 0;
+    ResetRealtimeStats();
     simulationFresh = false;
     
     //Create managers
@@ -126,9 +164,9 @@ SimulationManager::~SimulationManager()
 {
     DestroyScenario();
     if(atmosphere != nullptr) delete atmosphere;
+    if(sensorDispatcher != nullptr) delete sensorDispatcher;
     SDL_DestroyMutex(simSettingsMutex);
     SDL_DestroyMutex(simInfoMutex);
-    SDL_DestroyMutex(simHydroMutex);
     delete materialManager;
     delete nameManager;
     delete ned;
@@ -179,6 +217,31 @@ void SimulationManager::AddSolidEntity(SolidEntity* ent, const Transform& origin
     }
 }
 
+void SimulationManager::AddSolidEntities(const std::vector<SolidEntity*>& ents, const std::vector<Transform>& origins)
+{
+    if(ents.size() != origins.size())
+    {
+        cError("Number of solids (%zu) does not match number of origins (%zu)!", ents.size(), origins.size());
+        return;
+    }
+    
+    entities.reserve(entities.size() + ents.size());
+    dynamicsWorld->getCollisionObjectArray().reserve(dynamicsWorld->getCollisionObjectArray().size() + (int)ents.size());
+    
+    //Insert proxies without querying for overlaps one by one
+    btDbvtBroadphase* bp = (btDbvtBroadphase*)dwBroadphase;
+    bool deferred = bp->m_deferedcollide;
+    bp->m_deferedcollide = true;
+    
+    for(size_t i=0; i<ents.size(); ++i)
+        AddSolidEntity(ents[i], origins[i]);
+    
+    //Rebuild the tree and find all new pairs in a single tree-tree pass
+    bp->optimize();
+    bp->calculateOverlappingPairs(dwDispatcher);
+    bp->m_deferedcollide = deferred;
+}
+
 void SimulationManager::RemoveSolidEntity(SolidEntity* ent)
 {
     if(ent != nullptr)
@@ -193,6 +256,20 @@ void SimulationManager::RemoveSolidEntity(SolidEntity* ent)
     }
 }
 
+void SimulationManager::RemoveStaticEntity(StaticEntity* ent)
+{
+    if(ent != nullptr)
+    {
+        auto it = std::find(entities.begin(), entities.end(), ent);
+        if(it != entities.end() && (*it)->getType() == EntityType::STATIC)
+        {
+            StaticEntity* stat = static_cast<StaticEntity*>(*it);
+            stat->RemoveFromSimulation(this);
+            entities.erase(it);
+        }
+    }
+}
+
 void SimulationManager::AddFeatherstoneEntity(FeatherstoneEntity* ent, const Transform& origin)
 {
     if(ent != nullptr)
@@ -215,6 +292,62 @@ void SimulationManager::RemoveFeatherstoneEntity(FeatherstoneEntity* ent)
         }
     }
 }
+
+void SimulationManager::AddFluidBody(btCollisionObject* co)
+{
+    if(co == nullptr || co->isStaticOrKinematicObject())
+        return;
+    
+    Entity* ent = (Entity*)co->getUserPointer();
+    if(ent == nullptr || ent->getType() != EntityType::SOLID)
+        return;
+    
+    BodyPhysicsMode mode = ((SolidEntity*)ent)->getBodyPhysicsMode();
+    fluidBodies[co] = mode;
+    
+    std::vector<btCollisionObject*>* list;
+    switch(mode)
+    {
+        case BodyPhysicsMode::FLOATING:
+        case BodyPhysicsMode::SUBMERGED:
+            list = &hydroBodies;
+            break;
+            
+        case BodyPhysicsMode::AERODYNAMIC:
+            list = &aeroBodies;
+            break;
+            
+        default:
+            return; //Registered but not interacting with fluids
+    }
+    
+    auto it = std::lower_bound(list->begin(), list->end(), co);
+    if(it == list->end() || *it != co)
+        list->insert(it, co);
+}
+
+void SimulationManager::UpdateFluidBody(btCollisionObject* co)
+{
+    if(fluidBodies.find(co) == fluidBodies.end())
+        return;
+    
+    RemoveFluidBody(co);
+    AddFluidBody(co);
+}
+
+void SimulationManager::RemoveFluidBody(btCollisionObject* co)
+{
+    if(fluidBodies.erase(co) == 0)
+        return;
+    
+    auto it = std::lower_bound(hydroBodies.begin(), hydroBodies.end(), co);
+    if(it != hydroBodies.end() && *it == co)
+        hydroBodies.erase(it);
+    
+    it = std::lower_bound(aeroBodies.begin(), aeroBodies.end(), co);
+    if(it != aeroBodies.end() && *it == co)
+        aeroBodies.erase(it);
+}
     
 void SimulationManager::EnableOcean(Scalar waves, Fluid f)
 {
@@ -234,7 +367,7 @@ void SimulationManager::EnableOcean(Scalar waves, Fluid f)
     
     if(hasGraphics)
     {
-        ocean->InitGraphics(simHydroMutex);
+        ocean->InitGraphics();
         ocean->setRenderable(true);
     }
 }
@@ -562,6 +695,13 @@ NameManager* SimulationManager::getNameManager()
     return nameManager;
 }
 
+SensorDispatcher* SimulationManager::getSensorDispatcher()
+{
+    if(sensorDispatcher == nullptr)
+        sensorDispatcher = new SensorDispatcher(std::max(1u, std::thread::hardware_concurrency()/4));
+    return sensorDispatcher;
+}
+
 PerformanceMonitor& SimulationManager::getPerformanceMonitor()
 {
     return perfMon;
@@ -592,6 +732,26 @@ void SimulationManager::setFluidDynamicsPrescaler(unsigned int presc)
         fdPrescaler = presc;
 }
 
+void SimulationManager::setMultiRateParams(unsigned int divider, Scalar promotionDistance)
+{
+    SDL_LockMutex(simSettingsMutex);
+    if(divider != mrDivider)
+    {
+        UpdateIntegrationRates(true);
+        mrDivider = divider > 0 ? divider : 1;
+        mrCounter = 0;
+    }
+    mrDistance = promotionDistance > Scalar(0) ? promotionDistance : Scalar(0);
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+void SimulationManager::setFloatingOrigin(Scalar distance)
+{
+    SDL_LockMutex(simSettingsMutex);
+    foDistance = distance > Scalar(0) ? distance : Scalar(0);
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
 void SimulationManager::setRealtimeFactor(Scalar f)
 {
     SDL_LockMutex(simInfoMutex);
@@ -616,6 +776,11 @@ Scalar SimulationManager::getStepsPerSecond() const
     return sps;
 }
 
+bool SimulationManager::isRealtimeMode() const
+{
+    return rtEnabled;
+}
+
 Scalar SimulationManager::getCpuUsage() const
 {
     SDL_LockMutex(simInfoMutex);
@@ -675,6 +840,136 @@ void SimulationManager::setICSolverParams(bool useGravity, Scalar timeStep, unsi
     icAngTolerance = angularTolerance > SIMD_EPSILON ? angularTolerance : Scalar(1e-6);
 }
 
+void SimulationManager::setRealtimeMode(bool enabled, unsigned int maxCatchUpSteps, Scalar deadline, int priority, int cpuCore, bool lockMemory)
+{
+    SDL_LockMutex(simSettingsMutex);
+    rtEnabled = enabled;
+    rtMaxCatchUp = maxCatchUpSteps > 0 ? maxCatchUpSteps : 1;
+    rtDeadline = deadline > Scalar(0) ? (uint64_t)(deadline * Scalar(1000000)) : 0;
+    rtPriority = priority > 0 ? priority : 0;
+    rtCpuCore = cpuCore;
+    rtLockMemory = lockMemory;
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+void SimulationManager::ConfigureRealtimeThread()
+{
+    if(!rtEnabled)
+        return;
+    
+#ifdef __linux__
+    if(rtPriority > 0)
+    {
+        sched_param param;
+        param.sched_priority = std::min(rtPriority, sched_get_priority_max(SCHED_FIFO));
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if(err != 0)
+            cWarning("Real-time mode: SCHED_FIFO priority could not be set (%s)!", strerror(err));
+    }
+    
+    if(rtCpuCore >= 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(rtCpuCore, &cpus);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if(err != 0)
+            cWarning("Real-time mode: simulation thread could not be pinned to core %d (%s)!", rtCpuCore, strerror(err));
+    }
+    
+    if(rtLockMemory)
+    {
+        //Keep the freed memory in the process, so that the pre-faulted pool is reused by later allocations
+        mallopt(M_TRIM_THRESHOLD, -1);
+        mallopt(M_MMAP_MAX, 0);
+        if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+            cWarning("Real-time mode: memory could not be locked (%s)!", strerror(errno));
+        
+        //Pre-fault the heap pool and the stack of the simulation thread
+        long page = sysconf(_SC_PAGESIZE);
+        char* pool = (char*)malloc(RT_PREFAULT_HEAP);
+        if(pool != nullptr)
+        {
+            for(size_t i=0; i<RT_PREFAULT_HEAP; i+=page)
+                ((volatile char*)pool)[i] = 0;
+            free(pool);
+        }
+        volatile char stack[RT_PREFAULT_STACK];
+        for(size_t i=0; i<RT_PREFAULT_STACK; i+=page)
+            stack[i] = 0;
+    }
+#else
+    if(rtPriority > 0 || rtCpuCore >= 0 || rtLockMemory)
+        cWarning("Real-time mode: thread priority, pinning and memory locking are only supported on Linux.");
+#endif
+}
+
+RealtimeStats SimulationManager::getRealtimeStats() const
+{
+    RealtimeStats stats;
+    stats.steps = rtSteps.load(std::memory_order_relaxed);
+    stats.deadlineMisses = rtMisses.load(std::memory_order_relaxed);
+    stats.droppedSteps = rtDropped.load(std::memory_order_relaxed);
+    stats.meanLatency = stats.steps > 0 ? (double)rtLatencySum.load(std::memory_order_relaxed)/(double)stats.steps : 0.0;
+    stats.maxLatency = rtMaxLatency.load(std::memory_order_relaxed);
+    uint64_t wakeups = rtWakeups.load(std::memory_order_relaxed);
+    stats.meanWakeupJitter = wakeups > 0 ? (double)rtJitterSum.load(std::memory_order_relaxed)/(double)wakeups : 0.0;
+    stats.maxWakeupJitter = rtMaxJitter.load(std::memory_order_relaxed);
+    stats.deadline = rtDeadline > 0 ? rtDeadline : ssus;
+    stats.binWidth = std::max(stats.deadline * 2 / RT_HISTOGRAM_BINS, (uint64_t)1);
+    stats.histogram.resize(RT_HISTOGRAM_BINS);
+    for(size_t i=0; i<RT_HISTOGRAM_BINS; ++i)
+        stats.histogram[i] = rtHistogram[i].load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SimulationManager::ResetRealtimeStats()
+{
+    //Read-modify-write operations on both sides, so that no update of the simulation thread resurrects old values
+    rtSteps.exchange(0, std::memory_order_relaxed);
+    rtMisses.exchange(0, std::memory_order_relaxed);
+    rtDropped.exchange(0, std::memory_order_relaxed);
+    rtLatencySum.exchange(0, std::memory_order_relaxed);
+    rtMaxLatency.exchange(0, std::memory_order_relaxed);
+    rtWakeups.exchange(0, std::memory_order_relaxed);
+    rtJitterSum.exchange(0, std::memory_order_relaxed);
+    rtMaxJitter.exchange(0, std::memory_order_relaxed);
+    for(size_t i=0; i<RT_HISTOGRAM_BINS; ++i)
+        rtHistogram[i].exchange(0, std::memory_order_relaxed);
+}
+
+void SimulationManager::UpdateMaximum(std::atomic<uint64_t>& maximum, uint64_t value)
+{
+    uint64_t current = maximum.load(std::memory_order_relaxed);
+    while(value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+void SimulationManager::RecordStepLatency(uint64_t latency)
+{
+    uint64_t deadline = rtDeadline > 0 ? rtDeadline : ssus;
+    uint64_t binWidth = std::max(deadline * 2 / RT_HISTOGRAM_BINS, (uint64_t)1);
+    size_t bin = std::min((size_t)(latency / binWidth), (size_t)RT_HISTOGRAM_BINS - 1);
+    rtHistogram[bin].fetch_add(1, std::memory_order_relaxed);
+    rtSteps.fetch_add(1, std::memory_order_relaxed);
+    rtLatencySum.fetch_add(latency, std::memory_order_relaxed);
+    UpdateMaximum(rtMaxLatency, latency);
+    if(latency > deadline)
+        rtMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SimulationManager::setSettlingThresholds(Scalar kineticEnergy, Scalar contactImpulse)
+{
+    icUseGravity = true;
+    icKinThreshold = kineticEnergy > Scalar(0) ? kineticEnergy : Scalar(0);
+    icImpThreshold = contactImpulse > Scalar(0) ? contactImpulse : Scalar(0);
+}
+
+void SimulationManager::setSettledStateCache(const std::string& filename, uint64_t scenarioKey)
+{
+    icCacheFile = filename;
+    icCacheKey = scenarioKey;
+}
+
 void SimulationManager::setSolverParams(Scalar erp, Scalar stopErp, Scalar erp2, Scalar globalDamping, Scalar globalFriction,
                                             Scalar linearSleepingThreshold, Scalar angularSleepingThreshold)
 {
@@ -734,6 +1029,204 @@ void SimulationManager::getJointErp(Scalar& erp, Scalar& stopErp) const
     stopErp = jointLimitErp;
 }
 
+void SimulationManager::getMultiRateParams(unsigned int& divider, Scalar& promotionDistance) const
+{
+    divider = mrDivider;
+    promotionDistance = mrDistance;
+}
+
+Scalar SimulationManager::getFloatingOriginDistance() const
+{
+    return foDistance;
+}
+
+Vector3 SimulationManager::getWorldOrigin() const
+{
+    return worldOrigin;
+}
+
+void SimulationManager::setRandomSeed(uint32_t seed)
+{
+    randomSeed = seed;
+}
+
+uint32_t SimulationManager::getRandomSeed() const
+{
+    return randomSeed;
+}
+
+uint32_t SimulationManager::DeriveRandomSeed(const std::string& streamName) const
+{
+    //FNV-1a hash of the name (stable across platforms, unlike std::hash)
+    uint32_t h = 2166136261u;
+    for(size_t i=0; i<streamName.size(); ++i)
+    {
+        h ^= (uint8_t)streamName[i];
+        h *= 16777619u;
+    }
+    std::seed_seq seq{randomSeed, h};
+    uint32_t seed;
+    seq.generate(&seed, &seed + 1);
+    return seed;
+}
+
+uint64_t SimulationManager::ComputeStateHash()
+{
+    uint64_t h = 14695981039346656037ull; //FNV-1a
+    auto mix = [&h](const Scalar* values, size_t count)
+    {
+        const uint8_t* bytes = (const uint8_t*)values;
+        for(size_t i=0; i<count * sizeof(Scalar); ++i)
+        {
+            h ^= bytes[i];
+            h *= 1099511628211ull;
+        }
+    };
+    
+    SDL_LockMutex(simSettingsMutex);
+    btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+    for(int i=0; i<objects.size(); ++i)
+    {
+        const Transform& trans = objects[i]->getWorldTransform();
+        Vector3 pos = trans.getOrigin();
+        Quaternion rot = trans.getRotation();
+        Scalar pose[7] = {pos.x(), pos.y(), pos.z(), rot.x(), rot.y(), rot.z(), rot.w()};
+        mix(pose, 7);
+        
+        btRigidBody* rb = btRigidBody::upcast(objects[i]);
+        if(rb != nullptr)
+        {
+            Vector3 v = rb->getLinearVelocity();
+            Vector3 w = rb->getAngularVelocity();
+            Scalar vel[6] = {v.x(), v.y(), v.z(), w.x(), w.y(), w.z()};
+            mix(vel, 6);
+        }
+    }
+    for(int i=0; i<dynamicsWorld->getNumMultibodies(); ++i)
+    {
+        btMultiBody* mb = dynamicsWorld->getMultiBody(i);
+        mix(mb->getVelocityVector(), 6 + mb->getNumDofs());
+    }
+    SDL_UnlockMutex(simSettingsMutex);
+    return h;
+}
+
+void SimulationManager::UpdateIntegrationRates(bool forceFull)
+{
+    std::unordered_set<const Entity*> pinned;
+    std::unordered_set<const btCollisionObject*> touching;
+    std::vector<std::pair<Vector3, Vector3>> zones;
+    
+    if(!forceFull)
+    {
+        //Bodies that are part of robots or connected by joints are always integrated at full rate
+        for(size_t i=0; i<robots.size(); ++i)
+        {
+            SolidEntity* link;
+            for(size_t h=0; (link = robots[i]->getLink(h)) != nullptr; ++h)
+                pinned.insert(link);
+        }
+        
+        for(size_t i=0; i<joints.size(); ++i)
+        {
+            pinned.insert(joints[i]->getSolidA());
+            pinned.insert(joints[i]->getSolidB());
+        }
+        
+        //Zones around high-rate objects
+        Vector3 margin(mrDistance, mrDistance, mrDistance);
+        Vector3 aabbMin, aabbMax;
+        
+        for(size_t i=0; i<entities.size(); ++i)
+        {
+            EntityType type = entities[i]->getType();
+            if(type == EntityType::FEATHERSTONE 
+               || type == EntityType::ANIMATED
+               || (type == EntityType::SOLID && (pinned.find(entities[i]) != pinned.end() || ((SolidEntity*)entities[i])->isFullRateOnly())))
+            {
+                entities[i]->getAABB(aabbMin, aabbMax);
+                zones.push_back(std::make_pair(aabbMin - margin, aabbMax + margin));
+            }
+        }
+        
+        for(size_t i=0; i<sensors.size(); ++i)
+        {
+            if(sensors[i]->getType() == SensorType::LINK || sensors[i]->getType() == SensorType::VISION)
+            {
+                Vector3 p = sensors[i]->getSensorFrame().getOrigin();
+                zones.push_back(std::make_pair(p - margin, p + margin));
+            }
+        }
+        
+        for(size_t i=0; i<actuators.size(); ++i)
+        {
+            if(actuators[i]->getType() != ActuatorType::MOTOR && actuators[i]->getType() != ActuatorType::SERVO)
+            {
+                Vector3 p = ((LinkActuator*)actuators[i])->getActuatorFrame().getOrigin();
+                zones.push_back(std::make_pair(p - margin, p + margin));
+            }
+        }
+        
+        //Bodies which may be in contact with other bodies
+        btBroadphasePairArray& pairArray = dynamicsWorld->getPairCache()->getOverlappingPairArray();
+        for(int i=0; i<pairArray.size(); ++i)
+        {
+            const btBroadphasePair& pair = pairArray[i];
+            if(pair.m_pProxy0->m_collisionFilterGroup == MASK_GHOST || pair.m_pProxy1->m_collisionFilterGroup == MASK_GHOST)
+                continue;
+            touching.insert((btCollisionObject*)pair.m_pProxy0->m_clientObject);
+            touching.insert((btCollisionObject*)pair.m_pProxy1->m_clientObject);
+        }
+    }
+    
+    //Classify bodies
+    SpatialQueryFilter overlapFilter;
+    overlapFilter.collisionGroups = ~MASK_GHOST;
+    std::vector<Entity*> overlapping;
+    
+    for(size_t i=0; i<entities.size(); ++i)
+    {
+        if(entities[i]->getType() != EntityType::SOLID)
+            continue;
+        
+        SolidEntity* solid = (SolidEntity*)entities[i];
+        btRigidBody* rb = solid->getRigidBody();
+        if(rb == nullptr)
+            continue;
+        
+        bool reduce = !forceFull 
+                      && !solid->isFullRateOnly()
+                      && pinned.find(solid) == pinned.end()
+                      && touching.find(rb) == touching.end()
+                      && (solid->getIntegrationRate() == IntegrationRate::REDUCED || rb->isActive());
+        
+        if(reduce)
+        {
+            //Test the volume swept until the next reclassification (no collision detection in between)
+            Vector3 aabbMin, aabbMax;
+            rb->getAabb(aabbMin, aabbMax);
+            Scalar sweep = rb->getLinearVelocity().length() * Scalar(mrDivider) / sps;
+            aabbMin -= Vector3(sweep, sweep, sweep);
+            aabbMax += Vector3(sweep, sweep, sweep);
+            
+            for(size_t h=0; h<zones.size(); ++h)
+                if(TestAabbAgainstAabb2(aabbMin, aabbMax, zones[h].first, zones[h].second))
+                {
+                    reduce = false;
+                    break;
+                }
+            
+            if(reduce)
+            {
+                overlapFilter.exclude = solid;
+                reduce = QueryAABB(aabbMin, aabbMax, overlapping, overlapFilter) == 0;
+            }
+        }
+        
+        solid->setIntegrationRate(reduce ? IntegrationRate::REDUCED : IntegrationRate::FULL);
+    }
+}
+
 void SimulationManager::InitializeSolver()
 {
     dwBroadphase = new btDbvtBroadphase(); //btAxisSweep3(Vector3(-50000.0, -50000.0, -10000.0), Vector3(50000.0, 50000.0, 10000.0));
@@ -884,6 +1377,10 @@ void SimulationManager::RestartScenario()
 
 void SimulationManager::DestroyScenario()
 {
+    //Stop running sensor callbacks before the sensors are destroyed
+    if(sensorDispatcher != nullptr)
+        sensorDispatcher->DetachAll();
+    
     if(dynamicsWorld != nullptr)
     {
         //remove objects from dynamic world
@@ -914,6 +1411,12 @@ void SimulationManager::DestroyScenario()
     }
     
     //remove sim manager objects
+    hydroPartition = FluidWorkPartition();
+    aeroPartition = FluidWorkPartition();
+    fluidBodies.clear();
+    hydroBodies.clear();
+    aeroBodies.clear();
+    
     for(size_t i=0; i<robots.size(); ++i)
         delete robots[i];
     robots.clear();
@@ -921,6 +1424,7 @@ void SimulationManager::DestroyScenario()
     for(size_t i=0; i<entities.size(); ++i)
         delete entities[i];
     entities.clear();
+    Polyhedron::ClearHullCache();
     
     if(ocean != nullptr)
     {
@@ -965,6 +1469,10 @@ void SimulationManager::DestroyScenario()
         ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DestroyContent();
 		trackball = nullptr;
 	}
+    
+    worldOrigin.setZero();
+    trackballShift.setZero();
+    scenarioDescription.clear();
 }
 
 bool SimulationManager::StartSimulation()
@@ -974,6 +1482,8 @@ bool SimulationManager::StartSimulation()
     simulationTime = 0;
     mlcpFallbacks = 0;
     fdCounter = 0;
+    mrCounter = 0;
+    UpdateIntegrationRates(true);
     
     //Solve initial conditions problem
     if(!SolveICProblem())
@@ -1009,6 +1519,19 @@ bool SimulationManager::SolveICProblem()
 {
     //Solve for joint positions
     icProblemSolved = false;
+    icLastImpulse = Scalar(0);
+    
+    //Load the state settled during one of the previous runs
+    if(LoadSettledState())
+    {
+        cInfo("IC problem solution loaded from '%s'.", icCacheFile.c_str());
+        icProblemSolved = true;
+        simulationTime = Scalar(0.);
+        dynamicsWorld->setGravity(Vector3(0,0,g));
+        dynamicsWorld->setInternalTickCallback(SimulationTickCallback, this, true); //Pre-tick
+        dynamicsWorld->setInternalTickCallback(SimulationPostTickCallback, this, false); //Post-tick
+        return true;
+    }
     
     //Should use gravity?
     if(icUseGravity)
@@ -1051,6 +1574,9 @@ bool SimulationManager::SolveICProblem()
     //Solving time
     cInfo("IC problem solved with %d iterations in %1.6lf s.", iterations, solveTime);
     
+    //Cache the settled state for the next runs
+    SaveSettledState();
+    
     //Set gravity
     dynamicsWorld->setGravity(Vector3(0,0,g));
     
@@ -1084,45 +1610,427 @@ void SimulationManager::AdvanceSimulation()
 
     if(deltaTime < ssus) //Sleep if clock did not tick one simulation step
     {
-        SimulationClockSleep(ssus - deltaTime);
+        uint64_t sleepTime = ssus - deltaTime;
+        int64_t sleepStart = GetTimeInMicroseconds();
+        SimulationClockSleep(sleepTime);
         timeInMicroseconds = getSimulationClock();
         deltaTime += timeInMicroseconds - currentTime;
         currentTime = timeInMicroseconds;
+        
+        if(rtEnabled) //Record how late the thread woke up
+        {
+            int64_t late = GetTimeInMicroseconds() - sleepStart - (int64_t)ceil((Scalar)sleepTime/realtimeFactor);
+            uint64_t jitter = late > 0 ? (uint64_t)late : 0;
+            rtWakeups.fetch_add(1, std::memory_order_relaxed);
+            rtJitterSum.fetch_add(jitter, std::memory_order_relaxed);
+            UpdateMaximum(rtMaxJitter, jitter);
+        }
     }
     
     StepSimulation((Scalar)deltaTime/Scalar(1000000.0));
     
-    SDL_LockMutex(simInfoMutex);
-    Scalar cpuUsageNow = (Scalar)perfMon.getPhysicsTime()/(Scalar)deltaTime * Scalar(100);
-    Scalar filter(0.001);
-    cpuUsage = filter * cpuUsageNow + (Scalar(1)-filter) * cpuUsage;   
-    SDL_UnlockMutex(simInfoMutex);
+    if(SDL_TryLockMutex(simInfoMutex) == 0) //Never wait for the readers
+    {
+        Scalar cpuUsageNow = (Scalar)perfMon.getPhysicsTime()/(Scalar)deltaTime * Scalar(100);
+        Scalar filter(0.001);
+        cpuUsage = filter * cpuUsageNow + (Scalar(1)-filter) * cpuUsage;   
+        SDL_UnlockMutex(simInfoMutex);
+    }
 }
 
 void SimulationManager::StepSimulation(Scalar timeStep)
 {
+    rtTickStart = GetTimeInMicroseconds(); //The first step also accounts for the wait for the settings
     SDL_LockMutex(simSettingsMutex);
     perfMon.PhysicsStarted();
-    dynamicsWorld->stepSimulation((Scalar)timeStep, 1000000, (Scalar)ssus/Scalar(1000000.0));
+    int maxSteps = rtEnabled ? (int)rtMaxCatchUp : 1000000; //Bounded catch-up in real-time mode (the remaining time is dropped)
+    int steps = dynamicsWorld->stepSimulation((Scalar)timeStep, maxSteps, (Scalar)ssus/Scalar(1000000.0));
     perfMon.PhysicsFinished();
+    
+    //Re-centre the world around the robots to keep coordinates small
+    if(foDistance > Scalar(0) && robots.size() > 0)
+    {
+        Vector3 centre(0,0,0);
+        for(size_t i=0; i<robots.size(); ++i)
+            centre += robots[i]->getTransform().getOrigin();
+        centre /= Scalar(robots.size());
+        centre.setZ(Scalar(0)); //Depth is kept for the ocean and pressure computations
+        if(centre.length() > foDistance)
+            ShiftWorldOrigin(centre);
+    }
     SDL_UnlockMutex(simSettingsMutex);
 
     //Inform about MLCP failures
     if(solver != SolverType::SOLVER_SI)
     {
-        SDL_LockMutex(simInfoMutex);
-        btMultiBodyMLCPConstraintSolver* mlcp = (btMultiBodyMLCPConstraintSolver*)mbSolver;
-        int numFallbacks = mlcp->getNumFallbacks();
-        if(numFallbacks)
+        if(SDL_TryLockMutex(simInfoMutex) == 0) //Fallbacks are kept by the solver until the next step if busy
         {
-            mlcpFallbacks += numFallbacks;
-            mlcp->setNumFallbacks(0);
+            btMultiBodyMLCPConstraintSolver* mlcp = (btMultiBodyMLCPConstraintSolver*)mbSolver;
+            int numFallbacks = mlcp->getNumFallbacks();
+            if(numFallbacks)
+            {
+                mlcpFallbacks += numFallbacks;
+                mlcp->setNumFallbacks(0);
 #ifdef DEBUG
-            cWarning("MLCP solver failed %d times.\n", mlcpFallbacks);
+                cWarning("MLCP solver failed %d times.\n", mlcpFallbacks);
 #endif
+            }
+            SDL_UnlockMutex(simInfoMutex);
         }
-        SDL_UnlockMutex(simInfoMutex);
     }
+    
+    //Timing statistics (latency of each step recorded in the post-tick callback)
+    if(rtEnabled && steps > maxSteps)
+        rtDropped.fetch_add((uint64_t)(steps - maxSteps), std::memory_order_relaxed);
+}
+
+void SimulationManager::ShiftWorldOrigin(const Vector3& shift)
+{
+    //Move all objects of the physics world
+    btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+    for(int i=0; i<objects.size(); ++i)
+    {
+        btCollisionObject* co = objects[i];
+        btSoftBody* sb = btSoftBody::upcast(co);
+        if(sb != nullptr)
+        {
+            sb->translate(-shift);
+            continue;
+        }
+
+        Transform trans = co->getWorldTransform();
+        trans.setOrigin(trans.getOrigin() - shift);
+        co->setWorldTransform(trans);
+        trans = co->getInterpolationWorldTransform();
+        trans.setOrigin(trans.getOrigin() - shift);
+        co->setInterpolationWorldTransform(trans);
+        
+        btRigidBody* rb = btRigidBody::upcast(co);
+        if(rb != nullptr && rb->getMotionState() != nullptr)
+        {
+            rb->getMotionState()->getWorldTransform(trans);
+            trans.setOrigin(trans.getOrigin() - shift);
+            rb->getMotionState()->setWorldTransform(trans);
+        }
+    }
+    for(int i=0; i<dynamicsWorld->getNumMultibodies(); ++i)
+    {
+        btMultiBody* mb = dynamicsWorld->getMultiBody(i);
+        mb->setBasePos(mb->getBasePos() - shift);
+        mb->setInterpolateBasePos(mb->getInterpolateBasePos() - shift);
+    }
+    dynamicsWorld->updateAabbs();
+    
+    //Move state kept outside of the physics world
+    for(size_t i=0; i<entities.size(); ++i)
+        entities[i]->ShiftOrigin(shift);
+    for(size_t i=0; i<sensors.size(); ++i)
+        if(sensors[i]->getType() == SensorType::VISION)
+            ((VisionSensor*)sensors[i])->ShiftOrigin(shift);
+    for(size_t i=0; i<actuators.size(); ++i)
+        if(actuators[i]->getType() == ActuatorType::LIGHT)
+            ((Light*)actuators[i])->ShiftOrigin(shift);
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->ShiftOrigin(shift);
+    if(ocean != nullptr)
+        ocean->ShiftOrigin(shift);
+    if(atmosphere != nullptr)
+        atmosphere->ShiftOrigin(shift);
+    trackballShift += shift; //Applied by the renderer, together with the drawing queue
+    
+    //Simulation frame origin expressed in the NED frame (used by sensors reporting global positions)
+    worldOrigin += shift;
+}
+
+Scalar SimulationManager::ComputeKineticEnergy()
+{
+    Scalar energy(0);
+    auto addSolid = [&energy](SolidEntity* solid)
+    {
+        Vector3 w = solid->getCGTransform().getBasis().transpose() * solid->getAngularVelocity(); //Principal axes
+        energy += Scalar(0.5) * (solid->getMass() * solid->getLinearVelocity().length2() + w.dot(solid->getInertia() * w));
+    };
+    
+    for(size_t i=0; i<entities.size(); ++i)
+    {
+        if(entities[i]->getType() == EntityType::SOLID)
+            addSolid((SolidEntity*)entities[i]);
+        else if(entities[i]->getType() == EntityType::FEATHERSTONE)
+        {
+            FeatherstoneEntity* multibody = (FeatherstoneEntity*)entities[i];
+            for(unsigned int h=0; h<multibody->getNumOfLinks(); ++h)
+                addSolid(multibody->getLink(h).solid);
+        }
+    }
+    return energy;
+}
+
+Scalar SimulationManager::ComputeContactImpulse()
+{
+    Scalar impulse(0);
+    btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+    for(int i=0; i<dispatcher->getNumManifolds(); ++i)
+    {
+        btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+        for(int h=0; h<manifold->getNumContacts(); ++h)
+            impulse += manifold->getContactPoint(h).getAppliedImpulse();
+    }
+    return impulse;
+}
+
+uint64_t SimulationManager::SettledStateKey() const
+{
+    uint64_t h = 14695981039346656037ull; //FNV-1a
+    auto mix = [&h](const void* data, size_t size)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+        for(size_t i=0; i<size; ++i)
+        {
+            h ^= bytes[i];
+            h *= 1099511628211ull;
+        }
+    };
+    
+    //Scenario, seed, solver settings and the layout of the physics world (also covers the precision of Scalar)
+    Scalar settings[8] = {sps, g, icTimeStep, icLinTolerance, icAngTolerance, icKinThreshold, icImpThreshold, Scalar(icUseGravity ? 1 : 0)};
+    int32_t layout[3] = {(int32_t)solver, dynamicsWorld->getNumCollisionObjects(), dynamicsWorld->getNumMultibodies()};
+    uint32_t format = 2; //Version of the file layout
+    mix(&format, sizeof(format));
+    mix(&icCacheKey, sizeof(icCacheKey));
+    mix(&randomSeed, sizeof(randomSeed));
+    mix(settings, sizeof(settings));
+    mix(layout, sizeof(layout));
+    return h;
+}
+
+bool SimulationManager::SaveSettledState()
+{
+    if(icCacheFile == "")
+        return false;
+    
+    std::ofstream file(icCacheFile, std::ios::out | std::ios::binary);
+    if(!file.is_open())
+    {
+        cWarning("Settled state could not be saved to '%s'!", icCacheFile.c_str());
+        return false;
+    }
+    
+    auto write = [&file](const void* data, size_t size) { file.write((const char*)data, size); };
+    auto writeTransform = [&write](const Transform& trans)
+    {
+        Vector3 pos = trans.getOrigin();
+        Quaternion rot = trans.getRotation();
+        Scalar pose[7] = {pos.x(), pos.y(), pos.z(), rot.x(), rot.y(), rot.z(), rot.w()};
+        write(pose, sizeof(pose));
+    };
+    auto writeVector = [&write](const Vector3& v)
+    {
+        Scalar xyz[3] = {v.x(), v.y(), v.z()};
+        write(xyz, sizeof(xyz));
+    };
+    
+    uint64_t key = SettledStateKey();
+    write(&key, sizeof(key));
+    
+    //Dynamic rigid bodies
+    btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+    for(int i=0; i<objects.size(); ++i)
+    {
+        btRigidBody* rb = btRigidBody::upcast(objects[i]);
+        if(rb == nullptr || rb->isStaticOrKinematicObject())
+            continue;
+        writeTransform(rb->getCenterOfMassTransform());
+        writeVector(rb->getLinearVelocity());
+        writeVector(rb->getAngularVelocity());
+    }
+    
+    //Multibodies (base pose, velocities and joint positions)
+    for(int i=0; i<dynamicsWorld->getNumMultibodies(); ++i)
+    {
+        btMultiBody* mb = dynamicsWorld->getMultiBody(i);
+        writeTransform(mb->getBaseWorldTransform());
+        write(mb->getVelocityVector(), sizeof(Scalar) * (6 + mb->getNumDofs()));
+        for(int h=0; h<mb->getNumLinks(); ++h)
+            write(mb->getJointPosMultiDof(h), sizeof(Scalar) * mb->getLink(h).m_posVarCount);
+    }
+    
+    //Contact impulses used to warm-start the solver (pairs of bodies in canonical order, as the manifold order may differ between runs)
+    btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+    int32_t numManifolds = dispatcher->getNumManifolds();
+    write(&numManifolds, sizeof(numManifolds));
+    for(int i=0; i<numManifolds; ++i)
+    {
+        btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+        int32_t index0 = manifold->getBody0()->getWorldArrayIndex();
+        int32_t index1 = manifold->getBody1()->getWorldArrayIndex();
+        bool swapped = index0 > index1;
+        int32_t header[4] = {swapped ? index1 : index0, swapped ? index0 : index1, manifold->getNumContacts(), swapped ? 1 : 0};
+        write(header, sizeof(header));
+        for(int h=0; h<manifold->getNumContacts(); ++h)
+        {
+            const btManifoldPoint& cp = manifold->getContactPoint(h);
+            const Vector3& local = swapped ? cp.m_localPointB : cp.m_localPointA; //On the body with the lower index
+            Scalar point[6] = {local.x(), local.y(), local.z(), 
+                               cp.m_appliedImpulse, cp.m_appliedImpulseLateral1, cp.m_appliedImpulseLateral2};
+            write(point, sizeof(point));
+        }
+    }
+    
+    if(!file.good())
+    {
+        cWarning("Settled state could not be saved to '%s'!", icCacheFile.c_str());
+        return false;
+    }
+    cInfo("Settled state saved to '%s'.", icCacheFile.c_str());
+    return true;
+}
+
+bool SimulationManager::LoadSettledState()
+{
+    if(icCacheFile == "")
+        return false;
+    
+    std::ifstream file(icCacheFile, std::ios::in | std::ios::binary);
+    if(!file.is_open())
+        return false;
+    
+    auto read = [&file](void* data, size_t size) { file.read((char*)data, size); return file.good(); };
+    
+    uint64_t key;
+    if(!read(&key, sizeof(key)) || key != SettledStateKey())
+    {
+        cInfo("Settled state cache '%s' does not match the scenario.", icCacheFile.c_str());
+        return false;
+    }
+    
+    //Read the whole state before modifying the world
+    btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+    std::vector<btRigidBody*> bodies;
+    for(int i=0; i<objects.size(); ++i)
+    {
+        btRigidBody* rb = btRigidBody::upcast(objects[i]);
+        if(rb != nullptr && !rb->isStaticOrKinematicObject())
+            bodies.push_back(rb);
+    }
+    std::vector<Scalar> bodyState(bodies.size() * 13);
+    bool ok = read(bodyState.data(), sizeof(Scalar) * bodyState.size());
+    
+    std::vector<std::vector<Scalar>> mbState(dynamicsWorld->getNumMultibodies());
+    for(size_t i=0; i<mbState.size() && ok; ++i)
+    {
+        btMultiBody* mb = dynamicsWorld->getMultiBody((int)i);
+        mbState[i].resize(7 + 6 + mb->getNumDofs() + mb->getNumPosVars());
+        ok = read(mbState[i].data(), sizeof(Scalar) * mbState[i].size());
+    }
+    
+    std::unordered_map<uint64_t, std::vector<std::array<Scalar, 7>>> contactCache; //Points indexed by the pair of bodies (lower index first)
+    int32_t numManifolds = 0;
+    ok = ok && read(&numManifolds, sizeof(numManifolds));
+    for(int32_t i=0; i<numManifolds && ok; ++i)
+    {
+        int32_t header[4];
+        ok = read(header, sizeof(header));
+        if(!ok || header[2] < 0)
+            break;
+        std::vector<std::array<Scalar, 7>>& points = contactCache[((uint64_t)(uint32_t)header[0] << 32) | (uint32_t)header[1]];
+        for(int32_t h=0; h<header[2] && ok; ++h)
+        {
+            std::array<Scalar, 7> p;
+            ok = read(p.data(), sizeof(Scalar) * 6);
+            p[6] = Scalar(header[3]); //Order of the bodies in the saved manifold
+            points.push_back(p);
+        }
+    }
+    
+    if(!ok)
+    {
+        cWarning("Settled state cache '%s' is corrupted!", icCacheFile.c_str());
+        return false;
+    }
+    
+    //Apply the state of rigid bodies
+    for(size_t i=0; i<bodies.size(); ++i)
+    {
+        const Scalar* st = &bodyState[i * 13];
+        Transform trans(Quaternion(st[3], st[4], st[5], st[6]), Vector3(st[0], st[1], st[2]));
+        bodies[i]->setLinearVelocity(Vector3(st[7], st[8], st[9]));
+        bodies[i]->setAngularVelocity(Vector3(st[10], st[11], st[12]));
+        bodies[i]->setCenterOfMassTransform(trans); //Also sets the interpolation transform and velocities
+        if(bodies[i]->getMotionState() != nullptr)
+            bodies[i]->getMotionState()->setWorldTransform(trans);
+        bodies[i]->activate(true);
+    }
+    
+    //Apply the state of multibodies
+    btAlignedObjectArray<Quaternion> scratchQ;
+    btAlignedObjectArray<Vector3> scratchM;
+    for(size_t i=0; i<mbState.size(); ++i)
+    {
+        btMultiBody* mb = dynamicsWorld->getMultiBody((int)i);
+        const Scalar* st = mbState[i].data();
+        Transform trans(Quaternion(st[3], st[4], st[5], st[6]), Vector3(st[0], st[1], st[2]));
+        mb->setBaseWorldTransform(trans);
+        mb->setInterpolateBaseWorldTransform(trans);
+        mb->setBaseOmega(Vector3(st[7], st[8], st[9]));
+        mb->setBaseVel(Vector3(st[10], st[11], st[12]));
+        
+        const Scalar* qdot = st + 13;
+        const Scalar* q = qdot + mb->getNumDofs();
+        for(int h=0; h<mb->getNumLinks(); ++h)
+        {
+            mb->setJointPosMultiDof(h, q);
+            mb->setJointVelMultiDof(h, qdot);
+            q += mb->getLink(h).m_posVarCount;
+            qdot += mb->getLink(h).m_dofCount;
+        }
+        mb->updateCollisionObjectWorldTransforms(scratchQ, scratchM);
+        mb->wakeUp();
+    }
+    
+    //Rebuild contact manifolds and restore the impulses of the matching points
+    dynamicsWorld->performDiscreteCollisionDetection();
+    btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+    for(int i=0; i<dispatcher->getNumManifolds(); ++i)
+    {
+        btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+        int32_t index0 = manifold->getBody0()->getWorldArrayIndex();
+        int32_t index1 = manifold->getBody1()->getWorldArrayIndex();
+        bool swapped = index0 > index1;
+        auto it = contactCache.find(swapped ? (((uint64_t)(uint32_t)index1 << 32) | (uint32_t)index0)
+                                            : (((uint64_t)(uint32_t)index0 << 32) | (uint32_t)index1));
+        if(it == contactCache.end())
+            continue;
+        
+        for(int h=0; h<manifold->getNumContacts(); ++h)
+        {
+            btManifoldPoint& cp = manifold->getContactPoint(h);
+            const Vector3& local = swapped ? cp.m_localPointB : cp.m_localPointA;
+            const std::array<Scalar, 7>* match = nullptr;
+            Scalar minDist2 = manifold->getContactBreakingThreshold() * manifold->getContactBreakingThreshold();
+            for(size_t k=0; k<it->second.size(); ++k)
+            {
+                const std::array<Scalar, 7>& p = it->second[k];
+                Scalar dist2 = (Vector3(p[0], p[1], p[2]) - local).length2();
+                if(dist2 < minDist2)
+                {
+                    minDist2 = dist2;
+                    match = &p;
+                }
+            }
+            if(match != nullptr)
+            {
+                cp.m_appliedImpulse = (*match)[3];
+                if(((*match)[6] != Scalar(0)) == swapped) //Friction directions depend on the order of the bodies
+                {
+                    cp.m_appliedImpulseLateral1 = (*match)[4];
+                    cp.m_appliedImpulseLateral2 = (*match)[5];
+                }
+            }
+        }
+    }
+    
+    dynamicsWorld->synchronizeMotionStates();
+    return true;
 }
 
 void SimulationManager::SimulationStepCompleted(Scalar timeStep)
@@ -1163,10 +2071,11 @@ void SimulationManager::UpdateDrawingQueue()
             ((Light*)actuators[i])->UpdateTransform();
     }
     
-    //Sensors
+    //Sensors (beams, fans and frustums only generated when shown)
+    bool sensorHelpers = glPipeline->getHelperSettings().showSensors;
     for(size_t i=0; i<sensors.size(); ++i)
     {
-        glPipeline->AddToDrawingQueue(sensors[i]->Render());
+        glPipeline->AddToDrawingQueue(sensorHelpers ? sensors[i]->Render() : sensors[i]->Sensor::Render());
         if(sensors[i]->getType() == SensorType::VISION)
             ((VisionSensor*)sensors[i])->UpdateTransform();
     }
@@ -1177,7 +2086,11 @@ void SimulationManager::UpdateDrawingQueue()
     
     //Trackball
     if(trackball != nullptr)
+    {
+        trackball->ShiftOrigin(glVectorFromVector(trackballShift));
         trackball->UpdateCenterPos();
+    }
+    trackballShift.setZero();
     
     //Contacts
     for(size_t i=0; i<contacts.size(); ++i)
@@ -1206,6 +2119,143 @@ std::pair<Entity*, int>  SimulationManager::PickEntity(Vector3 eye, Vector3 ray)
         return std::make_pair(nullptr, -1);
 }
 
+//Spatial queries
+static Entity* FilterQueryLeaf(const btDbvtNode* leaf, const SpatialQueryFilter& filter)
+{
+    btBroadphaseProxy* proxy = (btBroadphaseProxy*)leaf->data;
+    if((proxy->m_collisionFilterGroup & filter.collisionGroups) == 0)
+        return nullptr;
+    btCollisionObject* co = (btCollisionObject*)proxy->m_clientObject;
+    Entity* ent = co != nullptr ? (Entity*)co->getUserPointer() : nullptr;
+    if(ent == nullptr || ent == filter.exclude 
+       || (filter.entityTypes & SpatialQueryFilter::TypeBit(ent->getType())) == 0)
+        return nullptr;
+    return ent;
+}
+
+static Scalar AabbDistance2(const btDbvtVolume& vol, const Vector3& p)
+{
+    Vector3 d = vol.Mins() - p;
+    d.setMax(p - vol.Maxs());
+    d.setMax(V0());
+    return d.length2();
+}
+
+struct SpatialQueryCollector : public btDbvt::ICollide
+{
+    SpatialQueryCollector(const SpatialQueryFilter& f, std::vector<Entity*>& r) 
+        : filter(f), results(r), center(V0()), radius2(-1) {}
+    
+    void Process(const btDbvtNode* leaf) override
+    {
+        if(radius2 >= Scalar(0) && AabbDistance2(leaf->volume, center) > radius2)
+            return;
+        Entity* ent = FilterQueryLeaf(leaf, filter);
+        if(ent != nullptr)
+            results.push_back(ent);
+    }
+    
+    const SpatialQueryFilter& filter;
+    std::vector<Entity*>& results;
+    Vector3 center;
+    Scalar radius2;
+};
+
+size_t SimulationManager::QueryAABB(const Vector3& min, const Vector3& max, std::vector<Entity*>& results, const SpatialQueryFilter& filter)
+{
+    results.clear();
+    if(dwBroadphase == nullptr)
+        return 0;
+    
+    btDbvtBroadphase* bp = (btDbvtBroadphase*)dwBroadphase;
+    btDbvtVolume vol = btDbvtVolume::FromMM(min, max);
+    SpatialQueryCollector collector(filter, results);
+    bp->m_sets[0].collideTV(bp->m_sets[0].m_root, vol, collector); //Dynamic set
+    bp->m_sets[1].collideTV(bp->m_sets[1].m_root, vol, collector); //Fixed set
+    return results.size();
+}
+
+size_t SimulationManager::QuerySphere(const Vector3& center, Scalar radius, std::vector<Entity*>& results, const SpatialQueryFilter& filter)
+{
+    results.clear();
+    if(dwBroadphase == nullptr || radius < Scalar(0))
+        return 0;
+    
+    btDbvtBroadphase* bp = (btDbvtBroadphase*)dwBroadphase;
+    btDbvtVolume vol = btDbvtVolume::FromCR(center, radius);
+    SpatialQueryCollector collector(filter, results);
+    collector.center = center;
+    collector.radius2 = radius * radius;
+    bp->m_sets[0].collideTV(bp->m_sets[0].m_root, vol, collector);
+    bp->m_sets[1].collideTV(bp->m_sets[1].m_root, vol, collector);
+    return results.size();
+}
+
+size_t SimulationManager::QueryNearest(const Vector3& point, unsigned int k, std::vector<Entity*>& results, const SpatialQueryFilter& filter, Scalar maxDistance)
+{
+    results.clear();
+    if(dwBroadphase == nullptr || k == 0)
+        return 0;
+    
+    //Best-first traversal of both trees, ordered by the distance to the node volumes
+    typedef std::pair<Scalar, const btDbvtNode*> QueueItem;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+    btDbvtBroadphase* bp = (btDbvtBroadphase*)dwBroadphase;
+    Scalar maxDist2 = maxDistance < BT_LARGE_FLOAT ? maxDistance * maxDistance : BT_LARGE_FLOAT;
+    
+    for(unsigned int i=0; i<2; ++i)
+        if(bp->m_sets[i].m_root != nullptr)
+            queue.push(std::make_pair(AabbDistance2(bp->m_sets[i].m_root->volume, point), bp->m_sets[i].m_root));
+    
+    while(!queue.empty() && results.size() < k)
+    {
+        QueueItem item = queue.top();
+        queue.pop();
+        if(item.first > maxDist2)
+            break;
+        
+        const btDbvtNode* node = item.second;
+        if(node->isleaf())
+        {
+            Entity* ent = FilterQueryLeaf(node, filter);
+            if(ent != nullptr && std::find(results.begin(), results.end(), ent) == results.end())
+                results.push_back(ent);
+        }
+        else
+        {
+            queue.push(std::make_pair(AabbDistance2(node->childs[0]->volume, point), node->childs[0]));
+            queue.push(std::make_pair(AabbDistance2(node->childs[1]->volume, point), node->childs[1]));
+        }
+    }
+    return results.size();
+}
+
+void SimulationManager::QueryBatch(const std::vector<SpatialQuery>& queries, std::vector<std::vector<Entity*>>& results)
+{
+    results.resize(queries.size());
+    
+    //Queries only read the broadphase trees, so they can run concurrently
+    #pragma omp parallel for schedule(dynamic)
+    for(int i=0; i<(int)queries.size(); ++i)
+    {
+        const SpatialQuery& q = queries[i];
+        switch(q.type)
+        {
+            case SpatialQueryType::AABB:
+                QueryAABB(q.p1, q.p2, results[i], q.filter);
+                break;
+                
+            case SpatialQueryType::SPHERE:
+                QuerySphere(q.p1, q.radius, results[i], q.filter);
+                break;
+                
+            case SpatialQueryType::NEAREST:
+                QueryNearest(q.p1, q.k, results[i], q.filter, q.radius);
+                break;
+        }
+    }
+}
+
 void SimulationManager::RenderBulletDebug()
 {
     dynamicsWorld->debugDrawWorld();
@@ -1232,6 +2282,26 @@ std::string SimulationManager::CreateLook(const std::string& name, Color color,
         return "";
 }
 
+bool SimulationManager::UpdateLook(const std::string& name, Color color, float roughness, float metalness, float reflectivity, 
+    const std::string& albedoTexturePath, const std::string& normalTexturePath, const std::string& temperatureTexturePath, const std::pair<float, float>& temperatureRange)
+{
+    if(SimulationApp::getApp()->hasGraphics())
+        return ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->UpdatePhysicalLook(name, color.rgb, roughness, metalness, reflectivity, 
+            albedoTexturePath, normalTexturePath, temperatureTexturePath, glm::vec2(temperatureRange.first, temperatureRange.second));
+    else
+        return false;
+}
+
+void SimulationManager::setScenarioDescription(const std::string& description)
+{
+    scenarioDescription = description;
+}
+
+const std::string& SimulationManager::getScenarioDescription() const
+{
+    return scenarioDescription;
+}
+
 bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	const btCollisionObjectWrapper* colObj0Wrap,int partId0,int index0,const btCollisionObjectWrapper* colObj1Wrap,int partId1,int index1)
 {
     //Retrieve entities associated with colliding objects
@@ -1404,9 +2474,17 @@ void SimulationManager::SolveICTickCallback(btDynamicsWorld* world, Scalar timeS
             {
                 FeatherstoneEntity* feather = (FeatherstoneEntity*)simManager->entities[i];
                 feather->ApplyGravity(world->getGravity());
+                feather->ApplyDamping();
             }
         }
         
+        //Apply the other forces acting during the simulation, so that the bodies settle in the same equilibrium
+        for(size_t i = 0; i < simManager->actuators.size(); ++i)
+            simManager->actuators[i]->Update(timeStep);
+        for(size_t i = 0; i < simManager->joints.size(); ++i)
+            simManager->joints[i]->ApplyDamping();
+        UpdateFluidForces(simManager, world, true, false);
+        
         if(simManager->simulationTime < Scalar(0.01)) //Wait for a few cycles to ensure bodies started moving
             objectsSettled = false;
         else
@@ -1465,6 +2543,20 @@ void SimulationManager::SolveICTickCallback(btDynamicsWorld* world, Scalar timeS
                     }
                 }
             }
+            
+            //Check if the kinetic energy dissipated
+            if(objectsSettled && simManager->icKinThreshold > Scalar(0) 
+               && simManager->ComputeKineticEnergy() > simManager->icKinThreshold)
+                objectsSettled = false;
+        }
+        
+        //Check if the contact impulses stopped changing
+        if(simManager->icImpThreshold > Scalar(0))
+        {
+            Scalar impulse = simManager->ComputeContactImpulse();
+            if(btFabs(impulse - simManager->icLastImpulse) > simManager->icImpThreshold)
+                objectsSettled = false;
+            simManager->icLastImpulse = impulse;
         }
     }
     
@@ -1498,7 +2590,13 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
     
     //loop through all joints -> apply damping forces to bodies connected by joints
     for(size_t i = 0; i < simManager->joints.size(); ++i)
+    {
         simManager->joints[i]->ApplyDamping();
+        simManager->joints[i]->ClearFeedbackRequest();
+    }
+    
+    //Check if bodies running at reduced rate should be integrated in this step
+    bool mrUpdate = simManager->mrDivider > 1 && simManager->mrCounter % simManager->mrDivider == 0;
     
     //loop through all entities that may need special actions
     for(size_t i = 0; i < simManager->entities.size(); ++i)
@@ -1508,6 +2606,12 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
         if(ent->getType() == EntityType::SOLID)
         {
             SolidEntity* solid = (SolidEntity*)ent;
+            if(solid->getIntegrationRate() == IntegrationRate::REDUCED)
+            {
+                if(!mrUpdate)
+                    continue;
+                solid->WakeReducedRate();
+            }
             solid->ApplyGravity(mbDynamicsWorld->getGravity());
         }
         else if(ent->getType() == EntityType::FEATHERSTONE)
@@ -1515,6 +2619,7 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
             FeatherstoneEntity* multibody = (FeatherstoneEntity*)ent;
             multibody->ApplyGravity(mbDynamicsWorld->getGravity());
             multibody->ApplyDamping();
+            multibody->ClearJointFeedbackRequests();
         }
         /*else if(ent->getType() == EntityType::CABLE)
         {
@@ -1550,33 +2655,57 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
         }
     }
     
+    //loop through all joint sensors -> request joint feedback only for the steps that will be sampled
+    for(size_t i = 0; i < simManager->sensors.size(); ++i)
+        if(simManager->sensors[i]->getType() == SensorType::JOINT)
+            ((JointSensor*)simManager->sensors[i])->PrepareUpdate(timeStep);
+    
     //Geometry-based forces
     bool recompute = simManager->fdCounter % simManager->fdPrescaler == 0;
     ++simManager->fdCounter;
     
+    UpdateFluidForces(simManager, world, recompute, mrUpdate);
+    
+    //Integrate bodies running at reduced rate (Bullet skips them)
+    if(mrUpdate)
+    {
+        Scalar mrTimeStep = timeStep * Scalar(simManager->mrDivider);
+        for(size_t i = 0; i < simManager->entities.size(); ++i)
+            if(simManager->entities[i]->getType() == EntityType::SOLID)
+                ((SolidEntity*)simManager->entities[i])->IntegrateReducedRate(mrTimeStep);
+    }
+}
+
+//Used to apply the aerodynamic and hydrodynamic forces to the bodies reaching the fluids
+void SimulationManager::UpdateFluidForces(SimulationManager* simManager, btDynamicsWorld* world, bool recompute, bool mrUpdate)
+{
     //Aerodynamic forces
     if(simManager->atmosphere != nullptr)
     {
-        btBroadphasePairArray& pairArray = simManager->atmosphere->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-        int numPairs = pairArray.size();
+        //Classify registered bodies against the ground and ocean surface level
+        std::vector<btCollisionObject*>& bodies = simManager->aeroPartition.reaching;
+        bodies.clear();
+        for(size_t i=0; i<simManager->aeroBodies.size(); ++i)
+        {
+            btCollisionObject* co = simManager->aeroBodies[i];
+            btBroadphaseProxy* proxy = co->getBroadphaseHandle();
+            if(proxy != nullptr && simManager->atmosphere->IsReachingFluid(proxy->m_aabbMin, proxy->m_aabbMax))
+                bodies.push_back(co);
+        }
         
-        if(numPairs > 0)
+        FluidWorkPartition& part = simManager->aeroPartition;
+        UpdateFluidWorkPartition(bodies, part, false); //Aerodynamics is cheap, no splitting
+        
+        if(part.bodies.size() > 0)
         {
-            #pragma omp parallel for schedule(dynamic)
-            for(int h=0; h<numPairs; ++h)
+            #pragma omp parallel num_threads((int)part.workers.size())
             {
-                const btBroadphasePair& pair = pairArray[h];
-                btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                if (!colPair)
-                    continue;
-                    
-                btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                
-                if(co1 == simManager->atmosphere->getGhost())
-                    simManager->atmosphere->ApplyFluidForces(world, co2, recompute);
-                else if(co2 == simManager->ocean->getGhost())
-                    simManager->atmosphere->ApplyFluidForces(world, co1, recompute);
+                for(size_t w=omp_get_thread_num(); w<part.workers.size(); w+=omp_get_num_threads()) //Team can be smaller than requested
+                {
+                    std::vector<btCollisionObject*>& work = part.workers[w];
+                    for(size_t i=0; i<work.size(); ++i)
+                        simManager->atmosphere->ApplyFluidForces(world, work[i], recompute);
+                }
             }
         }
     }
@@ -1584,34 +2713,109 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
     //Hydrodynamic forces
     if(simManager->ocean != nullptr)
     {
-        if(recompute) SDL_LockMutex(simManager->simHydroMutex);
+        if(recompute || mrUpdate) simManager->ocean->AcquireWaveData(); //Latest wave data published by the renderer
         simManager->perfMon.HydrodynamicsStarted();
         
-        btBroadphasePairArray& pairArray = simManager->ocean->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-        int numPairs = pairArray.size();
+        //Classify registered bodies against the ocean surface
+        std::vector<btCollisionObject*>& bodies = simManager->hydroPartition.reaching;
+        bodies.clear();
+        for(size_t i=0; i<simManager->hydroBodies.size(); ++i)
+        {
+            btCollisionObject* co = simManager->hydroBodies[i];
+            btBroadphaseProxy* proxy = co->getBroadphaseHandle();
+            if(proxy != nullptr && simManager->ocean->IsReachingFluid(proxy->m_aabbMin, proxy->m_aabbMax))
+                bodies.push_back(co);
+        }
+        
+        FluidWorkPartition& part = simManager->hydroPartition;
+        UpdateFluidWorkPartition(bodies, part, true);
         
-        if(numPairs > 0)
+        //Large bodies first, with faces processed by all worker threads
+        for(size_t i=0; i<part.split.size(); ++i)
         {
-            #pragma omp parallel for schedule(dynamic)
-            for(int h=0; h<numPairs; ++h)
+            double t0 = omp_get_wtime();
+            simManager->ocean->ApplyFluidForces(world, part.split[i], recompute, true);
+            if(recompute)
+                MeasureFluidWork(part, part.split[i], (omp_get_wtime() - t0) * (double)part.workers.size());
+        }
+        
+        //Remaining bodies, statically partitioned between worker threads
+        if(part.bodies.size() > part.split.size())
+        {
+            #pragma omp parallel num_threads((int)part.workers.size())
             {
-                const btBroadphasePair& pair = pairArray[h];
-                btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                if (!colPair)
-                    continue;
-                    
-                btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                
-                if(co1 == simManager->ocean->getGhost())
-                    simManager->ocean->ApplyFluidForces(world, co2, recompute);
-                else if(co2 == simManager->ocean->getGhost())
-                    simManager->ocean->ApplyFluidForces(world, co1, recompute);
+                for(size_t w=omp_get_thread_num(); w<part.workers.size(); w+=omp_get_num_threads()) //Team can be smaller than requested
+                {
+                    std::vector<btCollisionObject*>& work = part.workers[w];
+                    for(size_t i=0; i<work.size(); ++i)
+                    {
+                        double t0 = omp_get_wtime();
+                        simManager->ocean->ApplyFluidForces(world, work[i], recompute);
+                        if(recompute)
+                        {
+                            double t = omp_get_wtime() - t0;
+                            #pragma omp critical(fluidWorkCost)
+                            MeasureFluidWork(part, work[i], t);
+                        }
+                    }
+                }
             }
         }
         
         simManager->perfMon.HydrodynamicsFinished();
-        if(recompute) SDL_UnlockMutex(simManager->simHydroMutex);
+    }
+}
+
+void SimulationManager::UpdateFluidWorkPartition(const std::vector<btCollisionObject*>& bodies, FluidWorkPartition& part, bool allowSplit)
+{
+    size_t nWorkers = (size_t)omp_get_max_threads();
+    if(bodies == part.bodies && part.workers.size() == nWorkers)
+        return; //Set of bodies did not change
+    
+    //Estimate cost of each body (measured time or face count)
+    std::vector<std::pair<double, btCollisionObject*>> items(bodies.size());
+    std::unordered_map<btCollisionObject*, size_t> faces;
+    double total = 0.0;
+    for(size_t i=0; i<bodies.size(); ++i)
+    {
+        Entity* ent = (Entity*)bodies[i]->getUserPointer();
+        faces[bodies[i]] = (ent != nullptr && ent->getType() == EntityType::SOLID) ? ((SolidEntity*)ent)->getPhysicsFaceCount() : 0;
+        auto it = part.cost.find(bodies[i]);
+        double c = it != part.cost.end() ? it->second : (double)faces[bodies[i]] * part.faceCost;
+        items[i] = std::make_pair(c, bodies[i]);
+        total += c;
+    }
+    std::sort(items.begin(), items.end(), std::greater<std::pair<double, btCollisionObject*>>());
+    
+    //Build partition (longest processing time first)
+    part.bodies = bodies;
+    part.workers.assign(nWorkers, std::vector<btCollisionObject*>(0));
+    part.split.clear();
+    std::vector<double> load(nWorkers, 0.0);
+    
+    for(size_t i=0; i<items.size(); ++i)
+    {
+        if(allowSplit && nWorkers > 1 && items[i].first > total/(double)nWorkers //Would dominate any worker
+           && faces[items[i].second] >= FLUID_SPLIT_MIN_FACES)
+        {
+            part.split.push_back(items[i].second);
+            continue;
+        }
+        size_t w = std::min_element(load.begin(), load.end()) - load.begin();
+        part.workers[w].push_back(items[i].second);
+        load[w] += items[i].first;
+    }
+}
+
+void SimulationManager::MeasureFluidWork(FluidWorkPartition& part, btCollisionObject* co, double time)
+{
+    part.cost[co] = time;
+    Entity* ent = (Entity*)co->getUserPointer();
+    if(ent != nullptr && ent->getType() == EntityType::SOLID)
+    {
+        size_t faces = ((SolidEntity*)ent)->getPhysicsFaceCount();
+        if(faces > 0)
+            part.faceCost = 0.9 * part.faceCost + 0.1 * time/(double)faces;
     }
 }
 
@@ -1620,6 +2824,14 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
 {
     SimulationManager* simManager = (SimulationManager*)world->getWorldUserInfo();
     
+    //Multi-rate integration phase
+    unsigned int mrPhase = 0;
+    if(simManager->mrDivider > 1)
+    {
+        ++simManager->mrCounter;
+        mrPhase = simManager->mrCounter % simManager->mrDivider;
+    }
+    
     //Update motion data
     for(size_t i = 0; i < simManager->entities.size(); ++i)
     {
@@ -1628,7 +2840,14 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
         if(ent->getType() == EntityType::SOLID)
         {
             SolidEntity* solid = (SolidEntity*)ent;
-            solid->UpdateAcceleration(timeStep);
+            if(solid->getIntegrationRate() == IntegrationRate::REDUCED)
+            {
+                solid->InterpolateReducedRate(mrPhase == 0 ? Scalar(1) : Scalar(mrPhase)/Scalar(simManager->mrDivider));
+                if(mrPhase == 1) //Integrated in this step
+                    solid->UpdateAcceleration(timeStep * Scalar(simManager->mrDivider));
+            }
+            else
+                solid->UpdateAcceleration(timeStep);
         }
         else if(ent->getType() == EntityType::FEATHERSTONE)
         {
@@ -1640,8 +2859,17 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
             AnimatedEntity* anim = (AnimatedEntity*)ent;
             anim->Update(timeStep);
         }
+        else if(ent->getType() == EntityType::SWARM)
+        {
+            Swarm* swarm = (Swarm*)ent;
+            swarm->Update(timeStep);
+        }
     }
 
+    //Reclassify bodies when all reduced rate bodies are synchronized
+    if(simManager->mrDivider > 1 && mrPhase == 0)
+        simManager->UpdateIntegrationRates();
+
     //Special treatment of suction cup actuator
     for(size_t i = 0; i < simManager->actuators.size(); ++i)
         if(simManager->actuators[i]->getType() == ActuatorType::SUCTION_CUP)
@@ -1682,6 +2910,14 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
     //Optional method to update some post simulation data (like ROS messages...)
     if (simManager->getCallSimulationStepCompleted())
         simManager->SimulationStepCompleted(timeStep);
+    
+    //Latency of this step, measured from the end of the previous step of the same call
+    if(simManager->rtEnabled)
+    {
+        int64_t now = GetTimeInMicroseconds();
+        simManager->RecordStepLatency((uint64_t)(now - simManager->rtTickStart));
+        simManager->rtTickStart = now;
+    }
 }
 
 //Used to save contact information, including contact forces
@@ -35,6 +35,7 @@ namespace sf
 
 AnimatedEntity::AnimatedEntity(std::string uniqueName, Trajectory* traj) : MovingEntity(uniqueName, "", ""), tr(traj)
 {
+    trShift.setZero();
     if(traj == nullptr)
         return;        
 
@@ -52,6 +53,7 @@ AnimatedEntity::AnimatedEntity(std::string uniqueName, Trajectory* traj) : Movin
 AnimatedEntity::AnimatedEntity(std::string uniqueName, Trajectory* traj, Scalar sphereRadius, const Transform& origin, std::string material, std::string look, bool collides) 
     : MovingEntity(uniqueName, material, look), tr(traj)
 {   
+    trShift.setZero();
     if(traj == nullptr)
         return;
 
@@ -75,6 +77,7 @@ AnimatedEntity::AnimatedEntity(std::string uniqueName, Trajectory* traj, Scalar
 AnimatedEntity::AnimatedEntity(std::string uniqueName, Trajectory* traj, Scalar cylinderRadius, Scalar cylinderHeight, const Transform& origin, std::string material, std::string look, bool collides)
     : MovingEntity(uniqueName, material, look), tr(traj)
 {
+    trShift.setZero();
     if(traj == nullptr)
         return;
 
@@ -99,6 +102,7 @@ AnimatedEntity::AnimatedEntity(std::string uniqueName, Trajectory* traj, Scalar
 AnimatedEntity::AnimatedEntity(std::string uniqueName, Trajectory* traj, Vector3 boxDimensions, const Transform& origin, std::string material, std::string look, bool collides) 
     : MovingEntity(uniqueName, material, look), tr(traj)
 {
+    trShift.setZero();
     if(traj == nullptr)
         return;
 
@@ -128,6 +132,7 @@ AnimatedEntity::AnimatedEntity(std::string uniqueName, Trajectory* traj, std::st
                        std::string physicsFilename, Scalar physicsScale, const Transform& physicsOrigin, std::string material, std::string look, bool collides)
     : MovingEntity(uniqueName, material, look), tr(traj)
 {
+    trShift.setZero();
     if(traj == nullptr)
         return;
 
@@ -254,6 +259,11 @@ void AnimatedEntity::getAABB(Vector3& min, Vector3& max)
     }
 }
 
+void AnimatedEntity::ShiftOrigin(const Vector3& shift)
+{
+    trShift += shift;
+}
+
 void AnimatedEntity::BuildRigidBody(btCollisionShape* shape, bool collides)
 {
     btDefaultMotionState* motionState = new btDefaultMotionState(tr->getInterpolatedTransform());
@@ -296,7 +306,9 @@ void AnimatedEntity::Update(Scalar dt)
         return;
 
     tr->Play(dt);
-    rigidBody->getMotionState()->setWorldTransform(tr->getInterpolatedTransform() *  T_CG2O.inverse());
+    Transform trans = tr->getInterpolatedTransform();
+    trans.setOrigin(trans.getOrigin() - trShift); //Trajectory is defined in the original world frame
+    rigidBody->getMotionState()->setWorldTransform(trans *  T_CG2O.inverse());
     rigidBody->setLinearVelocity(tr->getInterpolatedLinearVelocity());
     rigidBody->setAngularVelocity(tr->getInterpolatedAngularVelocity());    
     setLinearAcceleration(tr->getInterpolatedLinearAcceleration());
@@ -326,6 +338,12 @@ std::vector<Renderable> AnimatedEntity::Render()
         }
         
         std::vector<Renderable> trajectoryItems = tr->Render();
+        if(!trShift.isZero())
+        {
+            glm::vec3 shift = glVectorFromVector(trShift);
+            for(size_t i=0; i<trajectoryItems.size(); ++i)
+                trajectoryItems[i].model[3] -= glm::vec4(shift, 0.f);
+        }
         items.insert(items.begin(), trajectoryItems.begin(), trajectoryItems.end());
     }
 
@@ -58,5 +58,9 @@ std::string Entity::getName() const
 {
     return name;
 }
+
+void Entity::ShiftOrigin(const Vector3& shift)
+{
+}
         
 }
@@ -60,6 +60,10 @@ FeatherstoneEntity::~FeatherstoneEntity()
     for(unsigned int i=0; i<links.size(); ++i)
         delete links[i].solid;
     
+    for(unsigned int i=0; i<joints.size(); ++i)
+        if(joints[i].feedback != NULL)
+            delete joints[i].feedback;
+    
     links.clear();
     joints.clear();
 }
@@ -124,10 +128,16 @@ void FeatherstoneEntity::AddToSimulation(SimulationManager* sm, const Transform&
     //Add multibody to the world
     Respawn(origin);
     sm->getDynamicsWorld()->addMultiBody(multiBody);
+    
+    //Register links for fluid forces computation
+    for(size_t i=0; i<links.size(); ++i)
+        sm->AddFluidBody(links[i].solid->multibodyCollider);
 }
 
 void FeatherstoneEntity::RemoveFromSimulation(SimulationManager* sm)
 {
+    for(size_t i=0; i<links.size(); ++i)
+        sm->RemoveFluidBody(links[i].solid->multibodyCollider);
     sm->getDynamicsWorld()->removeMultiBody(multiBody);
 }
 
@@ -310,6 +320,32 @@ Scalar FeatherstoneEntity::getJointTorque(unsigned int index)
         return multiBody->getJointTorque(joints[index].child - 1);
 }
 
+Scalar FeatherstoneEntity::getJointInertia(unsigned int index)
+{
+    if(index >= joints.size())
+        return Scalar(0);
+    
+    int link = joints[index].child - 1;
+    if(multiBody->getLink(link).m_dofCount != 1)
+        return Scalar(0);
+    
+    //Acceleration response to a unit generalized force (uses data cached during the last step)
+    int nDofs = multiBody->getNumDofs() + 6;
+    int dof = multiBody->getLink(link).m_dofOffset + 6;
+    btAlignedObjectArray<Scalar> force;
+    btAlignedObjectArray<Scalar> accel;
+    btAlignedObjectArray<Scalar> scratchR;
+    btAlignedObjectArray<Vector3> scratchV;
+    force.resize(nDofs, Scalar(0));
+    accel.resize(nDofs, Scalar(0));
+    force[dof] = Scalar(1);
+    multiBody->calcAccelerationDeltasMultiDof(&force[0], &accel[0], scratchR, scratchV);
+    
+    if(!std::isfinite(accel[dof]) || accel[dof] <= SIMD_EPSILON)
+        return Scalar(0);
+    return Scalar(1)/accel[dof];
+}
+
 void FeatherstoneEntity::setMaxMotorForceTorque(unsigned int index, Scalar maxT)
 {
     if(index >= joints.size())
@@ -337,6 +373,14 @@ unsigned int FeatherstoneEntity::getJointFeedback(unsigned int index, Vector3& f
         torque.setZero();
         return 0;
     }
+    else if(joints[index].feedback == NULL) //Never requested -> computed from now on
+    {
+        cInfo("Feedback of joint '%s' enabled on first read.", joints[index].name.c_str());
+        setJointFeedbackEnabled(index, true);
+        force.setZero();
+        torque.setZero();
+        return joints[index].child;
+    }
     else
     {
         force = Vector3(joints[index].feedback->m_reactionForces.m_topVec[0],
@@ -353,6 +397,35 @@ unsigned int FeatherstoneEntity::getJointFeedback(unsigned int index, Vector3& f
     }
 }
 
+void FeatherstoneEntity::setJointFeedbackEnabled(unsigned int index, bool enabled)
+{
+    if(index >= joints.size())
+        return;
+    
+    joints[index].feedbackEnabled = enabled;
+    if(enabled)
+        RequestJointFeedback(index);
+}
+
+void FeatherstoneEntity::RequestJointFeedback(unsigned int index)
+{
+    if(index >= joints.size())
+        return;
+    
+    //Allocated on first request, the reaction forces of a link are only computed when its feedback is connected
+    if(joints[index].feedback == NULL)
+        joints[index].feedback = new btMultiBodyJointFeedback();
+    multiBody->getLink((int)joints[index].child - 1).m_jointFeedback = joints[index].feedback;
+}
+
+void FeatherstoneEntity::ClearJointFeedbackRequests()
+{
+    //Values of the last computed step are kept
+    for(size_t i=0; i<joints.size(); ++i)
+        if(joints[i].feedback != NULL && !joints[i].feedbackEnabled)
+            multiBody->getLink((int)joints[i].child - 1).m_jointFeedback = NULL;
+}
+
 Vector3 FeatherstoneEntity::getJointAxis(unsigned int index)
 {
     if(index >= joints.size())
@@ -475,9 +548,6 @@ int FeatherstoneEntity::AddRevoluteJoint(std::string name, unsigned int parent,
     joint.pivotInChild = pivotToChildComOffset;
     multiBody->setupRevolute(child - 1, M, I, parent - 1, ornParentToChild, joint.axisInChild, parentComToPivotOffset, pivotToChildComOffset, !collisionBetweenJointLinks);
    
-    //Add feedback
-    joint.feedback = new btMultiBodyJointFeedback();
-    multiBody->getLink((int)child - 1).m_jointFeedback = joint.feedback;
     joints.push_back(joint);
     
     return ((int)joints.size() - 1);
@@ -511,9 +581,6 @@ int FeatherstoneEntity::AddPrismaticJoint(std::string name, unsigned int parent,
     joint.pivotInChild = pivotToChildComOffset;
     multiBody->setupPrismatic(child - 1, M, I, parent - 1, ornParentToChild, joint.axisInChild, parentComToPivotOffset, pivotToChildComOffset, !collisionBetweenJointLinks);
     
-    //Add feedback
-    joint.feedback = new btMultiBodyJointFeedback();
-    multiBody->getLink((int)child - 1).m_jointFeedback = joint.feedback;
     joints.push_back(joint);
     
     return ((int)joints.size() - 1);
@@ -546,9 +613,6 @@ int FeatherstoneEntity::AddFixedJoint(std::string name, unsigned int parent, uns
     joint.pivotInChild = pivotToChildComOffset;
     multiBody->setupFixed(child - 1, M, I, parent - 1, ornParentToChild, parentComToPivotOffset, pivotToChildComOffset);
     
-    //Add feedback
-    joint.feedback = new btMultiBodyJointFeedback();
-    multiBody->getLink((int)child - 1).m_jointFeedback = joint.feedback;
     joints.push_back(joint);
     
     return ((int)joints.size() - 1);
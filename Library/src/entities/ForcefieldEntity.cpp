@@ -53,7 +53,8 @@ btPairCachingGhostObject* ForcefieldEntity::getGhost()
 
 void ForcefieldEntity::AddToSimulation(SimulationManager* sm)
 {
-    sm->getDynamicsWorld()->addCollisionObject(ghost, MASK_GHOST, MASK_DYNAMIC);
+    if(ghost != nullptr)
+        sm->getDynamicsWorld()->addCollisionObject(ghost, MASK_GHOST, MASK_DYNAMIC);
 }
 
 std::vector<Renderable> ForcefieldEntity::Render()
@@ -34,10 +34,72 @@
 #include "entities/forcefields/Atmosphere.h"
 #include <iostream>
 #include <algorithm>
+#include <map>
+#include <tuple>
+
+#define HYDRO_FACE_BLOCK 256 //Number of faces accumulated together before the partial sums are combined
 
 namespace sf
 {
 
+//Partial sums of the fluid forces over a block of faces. The blocks do not depend on the number of threads
+//and are combined in a fixed order, so that the results are bitwise identical for any thread count.
+struct HydroFaceSums
+{
+    glm::vec3 Fb, Tb, Fdq, Tdq, Fdf, Tdf;
+    glm::vec3 CBsub, wetNormal, wetDetMoment;
+    glm::mat3 wetNormalMoment;
+    GLfloat Swet, Vsub, wetDet;
+
+    HydroFaceSums() : Fb(0.f), Tb(0.f), Fdq(0.f), Tdq(0.f), Fdf(0.f), Tdf(0.f), CBsub(0.f), wetNormal(0.f), wetDetMoment(0.f),
+                      wetNormalMoment(0.f), Swet(0.f), Vsub(0.f), wetDet(0.f) {}
+};
+
+HydroMesh::HydroMesh(const Mesh* mesh)
+{
+    //Weld vertices duplicated to carry different normals or texture coordinates
+    std::map<std::tuple<GLfloat, GLfloat, GLfloat>, GLuint> welded;
+    std::vector<GLuint> remap(mesh->getNumOfVertices());
+    for(size_t i=0; i<mesh->getNumOfVertices(); ++i)
+    {
+        glm::vec3 pos = mesh->getVertexPos(i);
+        auto key = std::make_tuple(pos.x, pos.y, pos.z);
+        auto it = welded.find(key);
+        if(it == welded.end())
+        {
+            remap[i] = (GLuint)vertices.size();
+            welded[key] = remap[i];
+            vertices.push_back(pos);
+        }
+        else
+            remap[i] = it->second;
+    }
+    
+    //Precompute face properties and volume integrals
+    faces.reserve(mesh->faces.size());
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+    {
+        glm::vec3 p1 = mesh->getVertexPos(i, 0);
+        glm::vec3 p2 = mesh->getVertexPos(i, 1);
+        glm::vec3 p3 = mesh->getVertexPos(i, 2);
+        glm::vec3 fn = glm::cross(p2-p1, p3-p1);
+        GLfloat len = glm::length2(fn);
+        if(len < 1e-12f) continue;
+        len = glm::sqrt(len);
+        
+        Face f;
+        for(unsigned short h=0; h<3; ++h)
+            f.vertexID[h] = remap[mesh->faces[i].vertexID[h]];
+        f.normal = fn/len;
+        f.area = len/2.f;
+        f.centroid = (p1+p2+p3)/3.f;
+        f.det = glm::dot(p1, glm::cross(p2, p3));
+        f.detMoment = (p1+p2+p3) * f.det;
+        f.normalMoment = glm::outerProduct(p1+p2+p3, fn);
+        faces.push_back(f);
+    }
+}
+
 SolidEntity::SolidEntity(std::string uniqueName, BodyPhysicsSettings phy, std::string material, std::string look, Scalar thickness) 
     : MovingEntity(uniqueName, material, look), thick(thickness), phy(phy)
 {
@@ -94,9 +156,16 @@ SolidEntity::SolidEntity(std::string uniqueName, BodyPhysicsSettings phy, std::s
     linearAcc.setZero();
     angularAcc.setZero();
     
+    //Multi-rate integration
+    intRate = IntegrationRate::FULL;
+    intFullRateOnly = false;
+    intActivationState = ACTIVE_TAG;
+    intLastTrans = I4();
+    
     //Set pointers
     multibodyCollider = nullptr;
     phyMesh = nullptr;
+    hydroMesh = nullptr;
     graObjectId = -1;
     phyObjectId = -1;
     dm = DisplayMode::GRAPHICAL;
@@ -108,6 +177,8 @@ SolidEntity::~SolidEntity()
 {
     if(phyMesh != nullptr) 
         delete phyMesh;
+    if(hydroMesh != nullptr)
+        delete hydroMesh;
 }
 
 EntityType SolidEntity::getType() const
@@ -206,6 +277,122 @@ BodyPhysicsMode SolidEntity::getBodyPhysicsMode() const
     return phy.mode;
 }
 
+void SolidEntity::setBodyPhysicsMode(BodyPhysicsMode m)
+{
+    SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+    if((m == BodyPhysicsMode::SUBMERGED || m == BodyPhysicsMode::FLOATING) && !sm->isOceanEnabled())
+        m = BodyPhysicsMode::SURFACE;
+    if(m == phy.mode)
+        return;
+    phy.mode = m;
+    
+    //Added mass depends on the mode
+    if(rigidBody != nullptr)
+    {
+        rigidBody->setMassProps(getAugmentedMass(), getAugmentedInertia());
+        rigidBody->updateInertiaTensor();
+        sm->UpdateFluidBody(rigidBody);
+    }
+    else if(multibodyCollider != nullptr)
+    {
+        btMultiBody* mb = multibodyCollider->m_multiBody;
+        if(multibodyCollider->m_link < 0)
+        {
+            mb->setBaseMass(getAugmentedMass());
+            mb->setBaseInertia(getAugmentedInertia());
+        }
+        else
+        {
+            mb->getLink(multibodyCollider->m_link).m_mass = getAugmentedMass();
+            mb->getLink(multibodyCollider->m_link).m_inertiaLocal = getAugmentedInertia();
+        }
+        sm->UpdateFluidBody(multibodyCollider);
+    }
+}
+
+void SolidEntity::setIntegrationRate(IntegrationRate rate)
+{
+    if(rigidBody == nullptr || rate == intRate)
+        return;
+    
+    if(rate == IntegrationRate::REDUCED)
+    {
+        intActivationState = rigidBody->getActivationState();
+        intLastTrans = rigidBody->getWorldTransform();
+        rigidBody->forceActivationState(DISABLE_SIMULATION); //Bullet skips the body until woken up
+    }
+    else
+    {
+        //Continue from the interpolated pose to avoid jumps
+        Transform trans;
+        rigidBody->getMotionState()->getWorldTransform(trans);
+        rigidBody->setWorldTransform(trans);
+        rigidBody->setInterpolationWorldTransform(trans);
+        rigidBody->forceActivationState(intActivationState);
+    }
+    intRate = rate;
+}
+
+IntegrationRate SolidEntity::getIntegrationRate() const
+{
+    return intRate;
+}
+
+void SolidEntity::setFullRateOnly(bool enabled)
+{
+    intFullRateOnly = enabled;
+    if(enabled)
+        setIntegrationRate(IntegrationRate::FULL);
+}
+
+bool SolidEntity::isFullRateOnly() const
+{
+    return intFullRateOnly;
+}
+
+void SolidEntity::WakeReducedRate()
+{
+    if(rigidBody == nullptr || intRate != IntegrationRate::REDUCED)
+        return;
+    
+    rigidBody->forceActivationState(intActivationState);
+}
+
+void SolidEntity::IntegrateReducedRate(Scalar dt)
+{
+    if(rigidBody == nullptr || intRate != IntegrationRate::REDUCED)
+        return;
+    
+    //Semi-implicit Euler step with the forces accumulated in this tick
+    intLastTrans = rigidBody->getWorldTransform();
+    rigidBody->integrateVelocities(dt);
+    rigidBody->applyDamping(dt);
+    Transform trans;
+    rigidBody->predictIntegratedTransform(dt, trans);
+    rigidBody->setWorldTransform(trans);
+    rigidBody->setInterpolationWorldTransform(trans);
+    rigidBody->updateInertiaTensor();
+    rigidBody->clearForces();
+    rigidBody->forceActivationState(DISABLE_SIMULATION);
+}
+
+void SolidEntity::InterpolateReducedRate(Scalar alpha)
+{
+    if(rigidBody == nullptr || intRate != IntegrationRate::REDUCED)
+        return;
+    
+    const Transform& next = rigidBody->getWorldTransform();
+    Transform trans;
+    trans.setOrigin(intLastTrans.getOrigin().lerp(next.getOrigin(), alpha));
+    trans.setRotation(intLastTrans.getRotation().slerp(next.getRotation(), alpha));
+    rigidBody->getMotionState()->setWorldTransform(trans);
+}
+
+void SolidEntity::ShiftOrigin(const Vector3& shift)
+{
+    intLastTrans.setOrigin(intLastTrans.getOrigin() - shift);
+}
+
 void SolidEntity::getAABB(Vector3& min, Vector3& max)
 {
     if(rigidBody != nullptr)
@@ -653,6 +840,18 @@ const Mesh* SolidEntity::getPhysicsMesh()
     return phyMesh;
 }
 
+const HydroMesh* SolidEntity::getHydroMesh()
+{
+    if(hydroMesh == nullptr && phyMesh != nullptr)
+        hydroMesh = new HydroMesh(phyMesh);
+    return hydroMesh;
+}
+
+size_t SolidEntity::getPhysicsFaceCount()
+{
+    return phyMesh != nullptr ? phyMesh->faces.size() : 0;
+}
+
 std::vector<Vector3>* SolidEntity::getMeshVertices() const
 {
     std::vector<Vector3>* vertices = new std::vector<Vector3>(0);
@@ -1022,6 +1221,19 @@ void SolidEntity::BuildGraphicalObject()
     phyObjectId = graObjectId;
 }
 
+void SolidEntity::DestroyGraphicalObject()
+{
+    if(!SimulationApp::getApp()->hasGraphics())
+        return;
+    
+    OpenGLPipeline* glPipeline = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline();
+    glPipeline->ReleaseObject(graObjectId);
+    if(phyObjectId != graObjectId)
+        glPipeline->ReleaseObject(phyObjectId);
+    graObjectId = -1;
+    phyObjectId = -1;
+}
+
 void SolidEntity::BuildRigidBody(btDynamicsWorld* world)
 {
     if(rigidBody == nullptr)
@@ -1149,11 +1361,14 @@ void SolidEntity::AddToSimulation(SimulationManager* sm, const Transform& origin
         Transform Tcg = origin * T_CG2O.inverse();
         rigidBody->setMotionState(new btDefaultMotionState(Tcg));
         sm->getDynamicsWorld()->addRigidBody(rigidBody, MASK_DYNAMIC, MASK_GHOST | MASK_STATIC | MASK_DYNAMIC | MASK_ANIMATED_COLLIDING);
+        sm->AddFluidBody(rigidBody);
     }
 }
 
 void SolidEntity::RemoveFromSimulation(SimulationManager* sm)
 {
+    setIntegrationRate(IntegrationRate::FULL);
+    sm->RemoveFluidBody(rigidBody);
     sm->getDynamicsWorld()->removeRigidBody(rigidBody);
     rigidBody = nullptr;
 }
@@ -1258,7 +1473,7 @@ void SolidEntity::CorrectHydrodynamicForces(Ocean* ocn, Vector3& _Fdq, Vector3&
     _Tdf = ocn->getLiquid().density * Tdfc * _Tdf; //rho*S*v from viscous drag equation
 }
 
-void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const Mesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
+void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const HydroMesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
                                             const Vector3& _v, const Vector3& _omega, Vector3& _Fb, Vector3& _Tb, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf, 
                                             Scalar& _Swet, Scalar& _Vsub, Renderable& debug)
 {
@@ -1303,60 +1518,74 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
     glm::vec3 p0 = p; //Point used as a center of mesh for volume calculation.
     p0.z = 0.f;       //When the robot is far from the world origin numerical erros would explode without translating the mesh data!
     
-    //Loop through all faces...
-    for(size_t i=0; i<mesh->faces.size(); ++i)
+#ifdef DEBUG_HYDRO
+    bool splitFaces = false; //Debug geometry has to be collected sequentially
+#else
+    bool splitFaces = settings.splitFaces;
+#endif
+
+    //Transform and check depth of each vertex only once
+    std::vector<glm::vec3> vertices(mesh->vertices.size());
+    std::vector<GLfloat> depths(mesh->vertices.size());
+    #pragma omp parallel for schedule(static) if(splitFaces)
+    for(size_t i=0; i<mesh->vertices.size(); ++i)
     {
-        //Global coordinates
-        glm::vec3 p1gl = mesh->getVertexPos(i, 0);
-        glm::vec3 p2gl = mesh->getVertexPos(i, 1);
-        glm::vec3 p3gl = mesh->getVertexPos(i, 2);
-        glm::vec3 p1 = glm::vec3(TC * glm::vec4(p1gl, 1.f));
-        glm::vec3 p2 = glm::vec3(TC * glm::vec4(p2gl, 1.f));
-        glm::vec3 p3 = glm::vec3(TC * glm::vec4(p3gl, 1.f));
+        vertices[i] = glm::vec3(TC * glm::vec4(mesh->vertices[i], 1.f));
+        depths[i] = ocn->GetDepth(vertices[i]);
+    }
+
+    //Volume integrals of completely submerged faces are accumulated in the mesh frame
+    glm::mat3 R = glm::mat3(TC);
+    glm::vec3 q0 = glm::transpose(R) * (p0 - glm::vec3(TC[3])); //Volume apex in the mesh frame
+    GLfloat wetDet(0.f);
+    glm::vec3 wetNormal(0.f);
+    glm::vec3 wetDetMoment(0.f);
+    glm::mat3 wetNormalMoment(0.f);
+
+    //Loop through all faces (in blocks summed in a fixed order)...
+    size_t nBlocks = (mesh->faces.size() + HYDRO_FACE_BLOCK - 1)/HYDRO_FACE_BLOCK;
+    std::vector<HydroFaceSums> blockSums(nBlocks);
+    #pragma omp parallel for schedule(static) if(splitFaces)
+    for(size_t k=0; k<nBlocks; ++k)
+    {
+        HydroFaceSums& s = blockSums[k];
+        size_t iEnd = std::min((k+1) * HYDRO_FACE_BLOCK, mesh->faces.size());
+        for(size_t i=k*HYDRO_FACE_BLOCK; i<iEnd; ++i)
+        {
+            const HydroMesh::Face& face = mesh->faces[i];
+
+            //Check if face underwater
+            GLfloat depth[3];
+            depth[0] = depths[face.vertexID[0]];
+            depth[1] = depths[face.vertexID[1]];
+            depth[2] = depths[face.vertexID[2]];
         
-        //Check if face underwater
-        GLfloat depth[3];
-        depth[0] = ocn->GetDepth(p1);
-        depth[1] = ocn->GetDepth(p2);
-        depth[2] = ocn->GetDepth(p3);
+            if(depth[0] < 0.f && depth[1] < 0.f && depth[2] < 0.f)
+                continue;
         
-        if(depth[0] < 0.f && depth[1] < 0.f && depth[2] < 0.f)
-            continue;
+            //Global coordinates
+            glm::vec3 p1 = vertices[face.vertexID[0]];
+            glm::vec3 p2 = vertices[face.vertexID[1]];
+            glm::vec3 p3 = vertices[face.vertexID[2]];
         
-        //Calculate face properties
-        glm::vec3 fc;
-        glm::vec3 fn;
-        glm::vec3 fn1;
-        GLfloat A;
+            //Calculate face properties
+            glm::vec3 fc;
+            glm::vec3 fn;
+            glm::vec3 fn1;
+            GLfloat A;
         
-        if(depth[0] < 0.f) //Vertex 1 above water
-        {
-            if(depth[1] < 0.f) //Two vertices above water (triangle)
+            if(depth[0] >= 0.f && depth[1] >= 0.f && depth[2] >= 0.f) //All underwater (precomputed, no clipping needed)
             {
-                p1 = p3 + (p1-p3) * (depth[2]/(fabsf(depth[0]) + depth[2]));
-                p2 = p3 + (p2-p3) * (depth[2]/(fabsf(depth[1]) + depth[2]));
-                //p3 without change
-                
                 //Volume properties
-                glm::vec3 p01 = p1-p0;
-                glm::vec3 p02 = p2-p0;
-                glm::vec3 p03 = p3-p0;
-                glm::vec3 tetraCG = (p01+p02+p03)/4.f;
-                GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
-                CBsub += tetraCG * tetraV6;
-                Vsub += tetraV6;
-                
+                s.wetDet += face.det;
+                s.wetNormal += face.normal * (2.f * face.area);
+                s.wetDetMoment += face.detMoment;
+                s.wetNormalMoment += face.normalMoment;
+
                 //Face properties
-                glm::vec3 fv1 = p2-p1; //One side of the face (triangle)
-                glm::vec3 fv2 = p3-p1; //Another side of the face (triangle)
+                fn1 = R * face.normal;
+                A = face.area;
                 fc = (p1+p2+p3)/3.f; //Face centroid
-        
-                fn = glm::cross(fv1, fv2); //Normal of the face (length != 1)
-                GLfloat len = glm::length2(fn); //Double area
-                if(len < 1e-12f) continue;
-                len = glm::sqrt(len);
-                fn1 = fn/len; //Normalised normal (length = 1)
-                A = len/2.f; //Area of the face (triangle)         
 #ifdef DEBUG_HYDRO
                 debug.points.push_back(p1);
                 debug.points.push_back(p2);
@@ -1366,135 +1595,221 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 debug.points.push_back(p1);
 #endif
             }
-            else if(depth[2] < 0.f) //Two vertices above water (triangle)
+            else if(depth[0] < 0.f) //Vertex 1 above water
             {
-                p1 = p2 + (p1-p2) * (depth[1]/(fabsf(depth[0]) + depth[1]));
-                //p2 without change
-                p3 = p2 + (p3-p2) * (depth[1]/(fabsf(depth[2]) + depth[1]));
+                if(depth[1] < 0.f) //Two vertices above water (triangle)
+                {
+                    p1 = p3 + (p1-p3) * (depth[2]/(fabsf(depth[0]) + depth[2]));
+                    p2 = p3 + (p2-p3) * (depth[2]/(fabsf(depth[1]) + depth[2]));
+                    //p3 without change
                 
-                //Volume properties
-                glm::vec3 p01 = p1-p0;
-                glm::vec3 p02 = p2-p0;
-                glm::vec3 p03 = p3-p0;
-                glm::vec3 tetraCG = (p01+p02+p03)/4.f;
-                GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
-                CBsub += tetraCG * tetraV6;
-                Vsub += tetraV6;
+                    //Volume properties
+                    glm::vec3 p01 = p1-p0;
+                    glm::vec3 p02 = p2-p0;
+                    glm::vec3 p03 = p3-p0;
+                    glm::vec3 tetraCG = (p01+p02+p03)/4.f;
+                    GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
+                    s.CBsub += tetraCG * tetraV6;
+                    s.Vsub += tetraV6;
                 
-                //Face properties
-                glm::vec3 fv1 = p2-p1; //One side of the face (triangle)
-                glm::vec3 fv2 = p3-p1; //Another side of the face (triangle)
-                fc = (p1+p2+p3)/3.f; //Face centroid
+                    //Face properties
+                    glm::vec3 fv1 = p2-p1; //One side of the face (triangle)
+                    glm::vec3 fv2 = p3-p1; //Another side of the face (triangle)
+                    fc = (p1+p2+p3)/3.f; //Face centroid
         
-                fn = glm::cross(fv1, fv2); //Normal of the face (length != 1)
-                GLfloat len = glm::length2(fn);
-                if(len < 1e-12f) continue;
-                len = glm::sqrt(len);
-                fn1 = fn/len; //Normalised normal (length = 1)
-                A = len/2.f; //Area of the face (triangle)         
+                    fn = glm::cross(fv1, fv2); //Normal of the face (length != 1)
+                    GLfloat len = glm::length2(fn); //Double area
+                    if(len < 1e-12f) continue;
+                    len = glm::sqrt(len);
+                    fn1 = fn/len; //Normalised normal (length = 1)
+                    A = len/2.f; //Area of the face (triangle)         
 #ifdef DEBUG_HYDRO
-                debug.points.push_back(p1);
-                debug.points.push_back(p2);
-                debug.points.push_back(p2);
-                debug.points.push_back(p3);
-                debug.points.push_back(p3);
-                debug.points.push_back(p1);
+                    debug.points.push_back(p1);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p1);
 #endif
-            }
-            else //depth[1] >= 0 && depth[2] >= 0 --> Two vertices under water (quad = two triangles)
-            {
-                //Quad!!!!
-                glm::vec3 p4 = p3 + (p1-p3) * (depth[2]/(fabsf(depth[0]) + depth[2]));
-                p1 = p2 + (p1-p2) * (depth[1]/(fabsf(depth[0]) + depth[1]));
-                //p2 without change
-                //p3 without change
+                }
+                else if(depth[2] < 0.f) //Two vertices above water (triangle)
+                {
+                    p1 = p2 + (p1-p2) * (depth[1]/(fabsf(depth[0]) + depth[1]));
+                    //p2 without change
+                    p3 = p2 + (p3-p2) * (depth[1]/(fabsf(depth[2]) + depth[1]));
                 
-                //Volume properties
-                //Tetra 1
-                glm::vec3 p01 = p1-p0;
-                glm::vec3 p02 = p2-p0;
-                glm::vec3 p03 = p3-p0;
-                glm::vec3 tetraCG = (p01+p02+p03)/4.f;
-                GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
-                CBsub += tetraCG * tetraV6;
-                Vsub += tetraV6;
-                //Tetra 2
-                glm::vec3 p04 = p4-p0;
-                tetraCG = (p01+p03+p04)/4.f;
-                tetraV6 = glm::dot(p01, glm::cross(p03, p04));
-                CBsub += tetraCG * tetraV6;
-                Vsub += tetraV6;
+                    //Volume properties
+                    glm::vec3 p01 = p1-p0;
+                    glm::vec3 p02 = p2-p0;
+                    glm::vec3 p03 = p3-p0;
+                    glm::vec3 tetraCG = (p01+p02+p03)/4.f;
+                    GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
+                    s.CBsub += tetraCG * tetraV6;
+                    s.Vsub += tetraV6;
                 
-                //Face properties
-                glm::vec3 fv1 = p2-p1;
-                glm::vec3 fv2 = p4-p1;
-                glm::vec3 fv3 = p2-p3;
-                glm::vec3 fv4 = p4-p3;
-                fc = (p1 + p2 + p3 + p4)/4.f;
+                    //Face properties
+                    glm::vec3 fv1 = p2-p1; //One side of the face (triangle)
+                    glm::vec3 fv2 = p3-p1; //Another side of the face (triangle)
+                    fc = (p1+p2+p3)/3.f; //Face centroid
+        
+                    fn = glm::cross(fv1, fv2); //Normal of the face (length != 1)
+                    GLfloat len = glm::length2(fn);
+                    if(len < 1e-12f) continue;
+                    len = glm::sqrt(len);
+                    fn1 = fn/len; //Normalised normal (length = 1)
+                    A = len/2.f; //Area of the face (triangle)         
+#ifdef DEBUG_HYDRO
+                    debug.points.push_back(p1);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p1);
+#endif
+                }
+                else //depth[1] >= 0 && depth[2] >= 0 --> Two vertices under water (quad = two triangles)
+                {
+                    //Quad!!!!
+                    glm::vec3 p4 = p3 + (p1-p3) * (depth[2]/(fabsf(depth[0]) + depth[2]));
+                    p1 = p2 + (p1-p2) * (depth[1]/(fabsf(depth[0]) + depth[1]));
+                    //p2 without change
+                    //p3 without change
                 
-                fn = glm::cross(fv1, fv2);
-                GLfloat len = glm::length2(fn);
-                if(len < 1e-12f) continue;
-                len = glm::sqrt(len);
-                fn1 = fn/len;
-                A = (len + glm::length(glm::cross(fv3, fv4)))/2.f; //Quad
-                fn = fn1 * A;
+                    //Volume properties
+                    //Tetra 1
+                    glm::vec3 p01 = p1-p0;
+                    glm::vec3 p02 = p2-p0;
+                    glm::vec3 p03 = p3-p0;
+                    glm::vec3 tetraCG = (p01+p02+p03)/4.f;
+                    GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
+                    s.CBsub += tetraCG * tetraV6;
+                    s.Vsub += tetraV6;
+                    //Tetra 2
+                    glm::vec3 p04 = p4-p0;
+                    tetraCG = (p01+p03+p04)/4.f;
+                    tetraV6 = glm::dot(p01, glm::cross(p03, p04));
+                    s.CBsub += tetraCG * tetraV6;
+                    s.Vsub += tetraV6;
+                
+                    //Face properties
+                    glm::vec3 fv1 = p2-p1;
+                    glm::vec3 fv2 = p4-p1;
+                    glm::vec3 fv3 = p2-p3;
+                    glm::vec3 fv4 = p4-p3;
+                    fc = (p1 + p2 + p3 + p4)/4.f;
+                
+                    fn = glm::cross(fv1, fv2);
+                    GLfloat len = glm::length2(fn);
+                    if(len < 1e-12f) continue;
+                    len = glm::sqrt(len);
+                    fn1 = fn/len;
+                    A = (len + glm::length(glm::cross(fv3, fv4)))/2.f; //Quad
+                    fn = fn1 * A;
 #ifdef DEBUG_HYDRO
-                debug.points.push_back(p1);
-                debug.points.push_back(p2);
-                debug.points.push_back(p2);
-                debug.points.push_back(p3);
-                debug.points.push_back(p3);
-                debug.points.push_back(p4);
-                debug.points.push_back(p4);
-                debug.points.push_back(p1);
+                    debug.points.push_back(p1);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p4);
+                    debug.points.push_back(p4);
+                    debug.points.push_back(p1);
 #endif  
+                }
             }
-        }
-        else if(depth[1] < 0.f)
-        {
-            if(depth[2] < 0.f)
+            else if(depth[1] < 0.f)
             {
-                //p1 without change
-                p2 = p1 + (p2-p1) * (depth[0]/(fabsf(depth[1]) + depth[0]));
-                p3 = p1 + (p3-p1) * (depth[0]/(fabsf(depth[2]) + depth[0]));
+                if(depth[2] < 0.f)
+                {
+                    //p1 without change
+                    p2 = p1 + (p2-p1) * (depth[0]/(fabsf(depth[1]) + depth[0]));
+                    p3 = p1 + (p3-p1) * (depth[0]/(fabsf(depth[2]) + depth[0]));
                 
-                //Volume properties
-                glm::vec3 p01 = p1-p0;
-                glm::vec3 p02 = p2-p0;
-                glm::vec3 p03 = p3-p0;
-                glm::vec3 tetraCG = (p01+p02+p03)/4.f;
-                GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
-                CBsub += tetraCG * tetraV6;
-                Vsub += tetraV6;
-
-                //Face properties
-                glm::vec3 fv1 = p2-p1; //One side of the face (triangle)
-                glm::vec3 fv2 = p3-p1; //Another side of the face (triangle)
-                fc = (p1+p2+p3)/3.f; //Face centroid
+                    //Volume properties
+                    glm::vec3 p01 = p1-p0;
+                    glm::vec3 p02 = p2-p0;
+                    glm::vec3 p03 = p3-p0;
+                    glm::vec3 tetraCG = (p01+p02+p03)/4.f;
+                    GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
+                    s.CBsub += tetraCG * tetraV6;
+                    s.Vsub += tetraV6;
+
+                    //Face properties
+                    glm::vec3 fv1 = p2-p1; //One side of the face (triangle)
+                    glm::vec3 fv2 = p3-p1; //Another side of the face (triangle)
+                    fc = (p1+p2+p3)/3.f; //Face centroid
         
-                fn = glm::cross(fv1, fv2); //Normal of the face (length != 1)
-                GLfloat len = glm::length2(fn);
-                if(len < 1e-12f) continue;
-                len = glm::sqrt(len);
-                fn1 = fn/len; //Normalised normal (length = 1)
-                A = len/2.f; //Area of the face (triangle)
+                    fn = glm::cross(fv1, fv2); //Normal of the face (length != 1)
+                    GLfloat len = glm::length2(fn);
+                    if(len < 1e-12f) continue;
+                    len = glm::sqrt(len);
+                    fn1 = fn/len; //Normalised normal (length = 1)
+                    A = len/2.f; //Area of the face (triangle)
 #ifdef DEBUG_HYDRO
-                debug.points.push_back(p1);
-                debug.points.push_back(p2);
-                debug.points.push_back(p2);
-                debug.points.push_back(p3);
-                debug.points.push_back(p3);
-                debug.points.push_back(p1);
+                    debug.points.push_back(p1);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p1);
 #endif                
+                }
+                else
+                {
+                    //Quad!!!!
+                    glm::vec3 p4 = p3 + (p2-p3) * (depth[2]/(fabsf(depth[1]) + depth[2]));
+                    //p1 without change
+                    p2 = p1 + (p2-p1) * (depth[0]/(fabsf(depth[1]) + depth[0]));
+                    //p3 without change
+                
+                    //Volume properties
+                    //Tetra 1
+                    glm::vec3 p01 = p1-p0;
+                    glm::vec3 p02 = p2-p0;
+                    glm::vec3 p03 = p3-p0;
+                    glm::vec3 tetraCG = (p01+p02+p03)/4.f;
+                    GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
+                    s.CBsub += tetraCG * tetraV6;
+                    s.Vsub += tetraV6;
+                    //Tetra 2
+                    glm::vec3 p04 = p4-p0;
+                    tetraCG = (p02+p04+p03)/4.f;
+                    tetraV6 = glm::dot(p02, glm::cross(p04, p03));
+                    s.CBsub += tetraCG * tetraV6;
+                    s.Vsub += tetraV6;              
+
+                    //Face properties
+                    glm::vec3 fv1 = p2-p1;
+                    glm::vec3 fv2 = p3-p1;
+                    glm::vec3 fv3 = p2-p3;
+                    glm::vec3 fv4 = p4-p3;
+                    fc = (p1 + p2 + p3 + p4)/4.f;
+                    fn = glm::cross(fv1, fv2); //Triangle 1
+                    GLfloat len = glm::length2(fn);
+                    if(len < 1e-12f) continue;    
+                    len = glm::sqrt(len);
+                    fn1 = fn/len;
+                    A = (len + glm::length(glm::cross(fv3, fv4)))/2.f; //Quad
+                    fn = fn1 * A;
+#ifdef DEBUG_HYDRO
+                    debug.points.push_back(p1);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p2);
+                    debug.points.push_back(p4);
+                    debug.points.push_back(p4);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p3);
+                    debug.points.push_back(p1);
+#endif                 
+                }
             }
-            else
+            else if(depth[2] < 0.f)
             {
                 //Quad!!!!
-                glm::vec3 p4 = p3 + (p2-p3) * (depth[2]/(fabsf(depth[1]) + depth[2]));
+                glm::vec3 p4 = p1 + (p3-p1) * (depth[0]/(fabsf(depth[2]) + depth[0]));
                 //p1 without change
-                p2 = p1 + (p2-p1) * (depth[0]/(fabsf(depth[1]) + depth[0]));
-                //p3 without change
+                //p2 without change
+                p3 = p2 + (p3-p2) * (depth[1]/(fabsf(depth[2]) + depth[1]));
                 
                 //Volume properties
                 //Tetra 1
@@ -1503,24 +1818,24 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 glm::vec3 p03 = p3-p0;
                 glm::vec3 tetraCG = (p01+p02+p03)/4.f;
                 GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
-                CBsub += tetraCG * tetraV6;
-                Vsub += tetraV6;
+                s.CBsub += tetraCG * tetraV6;
+                s.Vsub += tetraV6;
                 //Tetra 2
                 glm::vec3 p04 = p4-p0;
-                tetraCG = (p02+p04+p03)/4.f;
-                tetraV6 = glm::dot(p02, glm::cross(p04, p03));
-                CBsub += tetraCG * tetraV6;
-                Vsub += tetraV6;              
-
+                tetraCG = (p01+p03+p04)/4.f;
+                tetraV6 = glm::dot(p01, glm::cross(p03, p04));
+                s.CBsub += tetraCG * tetraV6;
+                s.Vsub += tetraV6;
+            
                 //Face properties
                 glm::vec3 fv1 = p2-p1;
-                glm::vec3 fv2 = p3-p1;
+                glm::vec3 fv2 = p4-p1;
                 glm::vec3 fv3 = p2-p3;
                 glm::vec3 fv4 = p4-p3;
                 fc = (p1 + p2 + p3 + p4)/4.f;
-                fn = glm::cross(fv1, fv2); //Triangle 1
+                fn = glm::cross(fv1, fv2);
                 GLfloat len = glm::length2(fn);
-                if(len < 1e-12f) continue;    
+                if(len < 1e-12f) continue;
                 len = glm::sqrt(len);
                 fn1 = fn/len;
                 A = (len + glm::length(glm::cross(fv3, fv4)))/2.f; //Quad
@@ -1529,133 +1844,76 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 debug.points.push_back(p1);
                 debug.points.push_back(p2);
                 debug.points.push_back(p2);
-                debug.points.push_back(p4);
-                debug.points.push_back(p4);
                 debug.points.push_back(p3);
                 debug.points.push_back(p3);
+                debug.points.push_back(p4);
+                debug.points.push_back(p4);
                 debug.points.push_back(p1);
-#endif                 
-            }
-        }
-        else if(depth[2] < 0.f)
-        {
-            //Quad!!!!
-            glm::vec3 p4 = p1 + (p3-p1) * (depth[0]/(fabsf(depth[2]) + depth[0]));
-            //p1 without change
-            //p2 without change
-            p3 = p2 + (p3-p2) * (depth[1]/(fabsf(depth[2]) + depth[1]));
-                
-            //Volume properties
-            //Tetra 1
-            glm::vec3 p01 = p1-p0;
-            glm::vec3 p02 = p2-p0;
-            glm::vec3 p03 = p3-p0;
-            glm::vec3 tetraCG = (p01+p02+p03)/4.f;
-            GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
-            CBsub += tetraCG * tetraV6;
-            Vsub += tetraV6;
-            //Tetra 2
-            glm::vec3 p04 = p4-p0;
-            tetraCG = (p01+p03+p04)/4.f;
-            tetraV6 = glm::dot(p01, glm::cross(p03, p04));
-            CBsub += tetraCG * tetraV6;
-            Vsub += tetraV6;
-            
-            //Face properties
-            glm::vec3 fv1 = p2-p1;
-            glm::vec3 fv2 = p4-p1;
-            glm::vec3 fv3 = p2-p3;
-            glm::vec3 fv4 = p4-p3;
-            fc = (p1 + p2 + p3 + p4)/4.f;
-            fn = glm::cross(fv1, fv2);
-            GLfloat len = glm::length2(fn);
-            if(len < 1e-12f) continue;
-            len = glm::sqrt(len);
-            fn1 = fn/len;
-            A = (len + glm::length(glm::cross(fv3, fv4)))/2.f; //Quad
-            fn = fn1 * A;
-#ifdef DEBUG_HYDRO
-            debug.points.push_back(p1);
-            debug.points.push_back(p2);
-            debug.points.push_back(p2);
-            debug.points.push_back(p3);
-            debug.points.push_back(p3);
-            debug.points.push_back(p4);
-            debug.points.push_back(p4);
-            debug.points.push_back(p1);
 #endif             
-        }
-        else //All underwater
-        {
-            //Volume properties
-            glm::vec3 p01 = p1-p0;
-            glm::vec3 p02 = p2-p0;
-            glm::vec3 p03 = p3-p0;
-            glm::vec3 tetraCG = (p01+p02+p03)/4.f;
-            GLfloat tetraV6 = glm::dot(p01, glm::cross(p02, p03));
-            CBsub += tetraCG * tetraV6;
-            Vsub += tetraV6;
-
-            //Face properties
-            glm::vec3 fv1 = p2-p1; //One side of the face (triangle)
-            glm::vec3 fv2 = p3-p1; //Another side of the face (triangle)
-            fn = glm::cross(fv1, fv2); //Normal of the face (length != 1)
-            GLfloat len = glm::length2(fn);
-            if(len < 1e-12f) continue;
-            len = glm::sqrt(len);
-            fn1 = fn/len; //Normalised normal (length = 1)
-            A = len/2.f; //Area of the face (triangle)
-            fc = (p1+p2+p3)/3.f; //Face centroid
-#ifdef DEBUG_HYDRO
-            debug.points.push_back(p1);
-            debug.points.push_back(p2);
-            debug.points.push_back(p2);
-            debug.points.push_back(p3);
-            debug.points.push_back(p3);
-            debug.points.push_back(p1);
-#endif             
-        }
+            }
 
-        //Buoyancy force
-        if(settings.reallisticBuoyancy && ocn->hasWaves())
-        {
-            GLfloat depthc = ocn->GetDepth(fc);
-            glm::vec3 Fbi = -fn1 * A * depthc; //Buoyancy force per face (based on pressure)        
+            //Buoyancy force
+            if(settings.reallisticBuoyancy && ocn->hasWaves())
+            {
+                GLfloat depthc = ocn->GetDepth(fc);
+                glm::vec3 Fbi = -fn1 * A * depthc; //Buoyancy force per face (based on pressure)        
             
-            //Accumulate
-            Fb += Fbi;
-            Tb += glm::cross(fc-p, Fbi);
-        }
+                //Accumulate
+                s.Fb += Fbi;
+                s.Tb += glm::cross(fc-p, Fbi);
+            }
         
-        //Damping force
-        if(settings.dampingForces)
-        {
-            glm::vec3 vc = ocn->GetFluidVelocity(fc) - (v + glm::cross(omega, fc-p));
-            GLfloat vc_n = glm::dot(vc, fn1);
-            glm::vec3 vn = vc_n  * fn1; //Normal velocity
-            glm::vec3 vt = vc - vn; //Tangent velocity
-            
-            if(vc_n < -1e-12f) //If liquid is approaching the surface
+            //Damping force
+            if(settings.dampingForces)
             {
-                GLfloat vmag2 = glm::length2(vc);
-                glm::vec3 quadratic = vc * sqrtf(vmag2) * -vc_n * A;
-                Fdq += quadratic;
-                Tdq += glm::cross(fc - p, quadratic);
-            }
+                glm::vec3 vc = ocn->GetFluidVelocity(fc) - (v + glm::cross(omega, fc-p));
+                GLfloat vc_n = glm::dot(vc, fn1);
+                glm::vec3 vn = vc_n  * fn1; //Normal velocity
+                glm::vec3 vt = vc - vn; //Tangent velocity
+            
+                if(vc_n < -1e-12f) //If liquid is approaching the surface
+                {
+                    GLfloat vmag2 = glm::length2(vc);
+                    glm::vec3 quadratic = vc * sqrtf(vmag2) * -vc_n * A;
+                    s.Fdq += quadratic;
+                    s.Tdq += glm::cross(fc - p, quadratic);
+                }
 
-            GLfloat vmag2 = glm::length2(vt);
-            if(vmag2 > 1e-9f)
-            {
-                glm::vec3 skin = vt * A;
-                Fdf += skin;
-                Tdf += glm::cross(fc - p, skin);
+                GLfloat vmag2 = glm::length2(vt);
+                if(vmag2 > 1e-9f)
+                {
+                    glm::vec3 skin = vt * A;
+                    s.Fdf += skin;
+                    s.Tdf += glm::cross(fc - p, skin);
+                }
             }
-        }
 
-        //Wetted surface area
-        Swet += A;
+            //Wetted surface area
+            s.Swet += A;
+        }
+    }
+    for(size_t k=0; k<nBlocks; ++k)
+    {
+        const HydroFaceSums& s = blockSums[k];
+        Fb += s.Fb;
+        Tb += s.Tb;
+        Fdq += s.Fdq;
+        Tdq += s.Tdq;
+        Fdf += s.Fdf;
+        Tdf += s.Tdf;
+        CBsub += s.CBsub;
+        Swet += s.Swet;
+        Vsub += s.Vsub;
+        wetDet += s.wetDet;
+        wetNormal += s.wetNormal;
+        wetDetMoment += s.wetDetMoment;
+        wetNormalMoment += s.wetNormalMoment;
     }
 
+    //Add volume integrals of completely submerged faces, moved to the apex and rotated to the world frame
+    Vsub += wetDet - glm::dot(q0, wetNormal);
+    CBsub += R * ((wetDetMoment - wetNormalMoment * q0 - 3.f * q0 * wetDet + 3.f * q0 * glm::dot(q0, wetNormal))/4.f);
+
     //Buoyancy
     if(settings.reallisticBuoyancy && Vsub > 1e-9f)
     {
@@ -1690,8 +1948,9 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
     _Swet = Swet;
 }
 
-void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
-                                              const Vector3& _v, const Vector3& _omega, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf)
+void SolidEntity::ComputeHydrodynamicForcesSubmerged(const HydroMesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
+                                              const Vector3& _v, const Vector3& _omega, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf,
+                                              bool splitFaces)
 {
     if(mesh == nullptr)
     {
@@ -1715,50 +1974,54 @@ void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* oc
     //Calculate fluid dynamics forces and torques
     glm::vec3 p = glm::vec3(TCG[3]);
 
-    //Loop through all faces...
-    for(size_t i=0; i<mesh->faces.size(); ++i)
+    glm::mat3 R = glm::mat3(TC);
+
+    //Loop through all faces (in blocks summed in a fixed order)...
+    size_t nBlocks = (mesh->faces.size() + HYDRO_FACE_BLOCK - 1)/HYDRO_FACE_BLOCK;
+    std::vector<HydroFaceSums> blockSums(nBlocks);
+    #pragma omp parallel for schedule(static) if(splitFaces)
+    for(size_t k=0; k<nBlocks; ++k)
     {
-        //Global coordinates
-        glm::vec3 p1gl = mesh->getVertexPos(i, 0);
-        glm::vec3 p2gl = mesh->getVertexPos(i, 1);
-        glm::vec3 p3gl = mesh->getVertexPos(i, 2);
-        glm::vec3 p1 = glm::vec3(TC * glm::vec4(p1gl, 1.f));
-        glm::vec3 p2 = glm::vec3(TC * glm::vec4(p2gl, 1.f));
-        glm::vec3 p3 = glm::vec3(TC * glm::vec4(p3gl, 1.f));
-        
-        //Face properties
-        glm::vec3 fv1 = p2-p1; //One side of the face (triangle)
-        glm::vec3 fv2 = p3-p1; //Another side of the face (triangle)
-        glm::vec3 fn = glm::cross(fv1, fv2); //Normal of the face (length != 1)
-        GLfloat len = glm::length2(fn);
-        if(len < 1e-12f) continue;
-        len = glm::sqrt(len);
-        glm::vec3 fn1 = fn/len; //Normalised normal (length = 1)
-        GLfloat A = len/2.f; //Area of the face (triangle)
-        glm::vec3 fc = (p1+p2+p3)/3.f; //Face centroid
+        HydroFaceSums& s = blockSums[k];
+        size_t iEnd = std::min((k+1) * HYDRO_FACE_BLOCK, mesh->faces.size());
+        for(size_t i=k*HYDRO_FACE_BLOCK; i<iEnd; ++i)
+        {
+            //Face properties (precomputed in the mesh frame)
+            const HydroMesh::Face& face = mesh->faces[i];
+            glm::vec3 fn1 = R * face.normal; //Normalised normal (length = 1)
+            GLfloat A = face.area; //Area of the face (triangle)
+            glm::vec3 fc = glm::vec3(TC * glm::vec4(face.centroid, 1.f)); //Face centroid
      
-        //Forces
-        glm::vec3 vc = ocn->GetFluidVelocity(fc) - (v + glm::cross(omega, fc-p));
-        GLfloat vc_n = glm::dot(vc, fn1);
-        glm::vec3 vn = vc_n  * fn1; //Normal velocity
-        glm::vec3 vt = vc - vn; //Tangent velocity
+            //Forces
+            glm::vec3 vc = ocn->GetFluidVelocity(fc) - (v + glm::cross(omega, fc-p));
+            GLfloat vc_n = glm::dot(vc, fn1);
+            glm::vec3 vn = vc_n  * fn1; //Normal velocity
+            glm::vec3 vt = vc - vn; //Tangent velocity
         
-        if(vc_n < -1e-12f) //If liquid is approaching the surface
-        {
-            GLfloat vmag2 = glm::length2(vc);
-            glm::vec3 quadratic = vc * sqrtf(vmag2) * -vc_n * A;
-            Fdq += quadratic;
-            Tdq += glm::cross(fc - p, quadratic);
-        }
+            if(vc_n < -1e-12f) //If liquid is approaching the surface
+            {
+                GLfloat vmag2 = glm::length2(vc);
+                glm::vec3 quadratic = vc * sqrtf(vmag2) * -vc_n * A;
+                s.Fdq += quadratic;
+                s.Tdq += glm::cross(fc - p, quadratic);
+            }
 
-        GLfloat vmag2 = glm::length2(vt);
-        if(vmag2 > 1e-9f)
-        {
-            glm::vec3 skin = vt * A;
-            Fdf += skin;
-            Tdf += glm::cross(fc - p, skin);
+            GLfloat vmag2 = glm::length2(vt);
+            if(vmag2 > 1e-9f)
+            {
+                glm::vec3 skin = vt * A;
+                s.Fdf += skin;
+                s.Tdf += glm::cross(fc - p, skin);
+            }
         }
     }
+    for(size_t k=0; k<nBlocks; ++k)
+    {
+        Fdq += blockSums[k].Fdq;
+        Tdq += blockSums[k].Tdq;
+        Fdf += blockSums[k].Fdf;
+        Tdf += blockSums[k].Tdf;
+    }
 
     _Fdq = Vector3(Fdq.x, Fdq.y, Fdq.z);
     _Tdq = Vector3(Tdq.x, Tdq.y, Tdq.z);
@@ -1803,14 +2066,14 @@ void SolidEntity::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocea
         }
         
         if(settings.dampingForces)
-            ComputeHydrodynamicForcesSubmerged(getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fdq, Tdq, Fdf, Tdf);
+            ComputeHydrodynamicForcesSubmerged(getHydroMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fdq, Tdq, Fdf, Tdf, settings.splitFaces);
 
         Swet = surface;
     }
     else //CROSSING_FLUID_SURFACE
     {
         if(!isBuoyant()) settings.reallisticBuoyancy = false;
-        ComputeHydrodynamicForcesSurface(settings, getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fb, Tb, Fdq, Tdq, Fdf, Tdf, Swet, Vsub, submerged);
+        ComputeHydrodynamicForcesSurface(settings, getHydroMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fb, Tb, Fdq, Tdq, Fdf, Tdf, Swet, Vsub, submerged);
     }
     
     if(settings.dampingForces)
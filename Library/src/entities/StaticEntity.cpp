@@ -128,6 +128,15 @@ void StaticEntity::BuildGraphicalObject()
     phyObjectId = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->BuildObject(phyMesh);
 }
 
+void StaticEntity::DestroyGraphicalObject()
+{
+    if(!SimulationApp::getApp()->hasGraphics())
+        return;
+    
+    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->ReleaseObject(phyObjectId);
+    phyObjectId = -1;
+}
+
 void StaticEntity::BuildRigidBody(btCollisionShape* shape)
 {
     btDefaultMotionState* motionState = new btDefaultMotionState();
@@ -160,6 +169,17 @@ void StaticEntity::AddToSimulation(SimulationManager* sm, const Transform& origi
     }
 }
 
+void StaticEntity::RemoveFromSimulation(SimulationManager* sm)
+{
+    if(rigidBody != nullptr)
+    {
+        sm->getDynamicsWorld()->removeRigidBody(rigidBody);
+        delete rigidBody->getMotionState();
+        delete rigidBody;
+        rigidBody = nullptr;
+    }
+}
+
 //Static members
 void StaticEntity::GroupTransform(std::vector<StaticEntity*>& objects, const Transform& centre, const Transform& transform)
 {
@@ -0,0 +1,349 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  Swarm.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "entities/Swarm.h"
+
+#include <random>
+#include "core/GraphicalSimulationApp.h"
+#include "core/SimulationManager.h"
+#include "entities/forcefields/Ocean.h"
+#include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLContent.h"
+
+namespace sf
+{
+
+Swarm::Swarm(std::string uniqueName, unsigned int agentCount, std::string modelFilename, Scalar scale,
+             std::string material, std::string look, SwarmBehaviour behaviour) : Entity(uniqueName), behaviour(behaviour), materialName(material)
+{
+    objectId = -1;
+    lookId = -1;
+    regionOrigin = I4();
+    regionHalfExtents = Vector3(Scalar(10), Scalar(10), Scalar(5));
+    cruiseSpeed = Scalar(0.5);
+    maxSpeed = Scalar(1.5);
+    neighbourRadius = Scalar(2);
+    separationDistance = Scalar(0.5);
+    kCohesion = Scalar(0.5);
+    kAlignment = Scalar(1);
+    kSeparation = Scalar(2);
+    cellSize = neighbourRadius;
+    gridDim[0] = gridDim[1] = gridDim[2] = 1;
+
+    px.resize(agentCount); py.resize(agentCount); pz.resize(agentCount);
+    vx.resize(agentCount); vy.resize(agentCount); vz.resize(agentCount);
+    nvx.resize(agentCount); nvy.resize(agentCount); nvz.resize(agentCount);
+    hx.resize(agentCount); hy.resize(agentCount); hz.resize(agentCount);
+    agentCell.resize(agentCount);
+    cellAgents.resize(agentCount);
+    Scatter();
+
+    //One graphical object shared by all agents
+    if(SimulationApp::getApp()->hasGraphics())
+    {
+        OpenGLContent* content = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent();
+        Mesh* mesh = OpenGLContent::LoadMesh(modelFilename, (GLfloat)scale, false);
+        if(mesh != nullptr)
+        {
+            objectId = content->BuildObject(mesh);
+            delete mesh;
+        }
+        lookId = content->getLookId(look);
+    }
+}
+
+Swarm::~Swarm()
+{
+}
+
+EntityType Swarm::getType() const
+{
+    return EntityType::SWARM;
+}
+
+SwarmBehaviour Swarm::getBehaviour() const
+{
+    return behaviour;
+}
+
+unsigned int Swarm::getAgentCount() const
+{
+    return (unsigned int)px.size();
+}
+
+Vector3 Swarm::getAgentPosition(unsigned int index) const
+{
+    if(index >= px.size())
+        return V0();
+    return Vector3(px[index], py[index], pz[index]);
+}
+
+Vector3 Swarm::getAgentVelocity(unsigned int index) const
+{
+    if(index >= vx.size())
+        return V0();
+    return Vector3(vx[index], vy[index], vz[index]);
+}
+
+void Swarm::setRegion(const Transform& origin, const Vector3& halfExtents)
+{
+    regionOrigin = origin;
+    regionHalfExtents = halfExtents.absolute();
+    Scatter();
+}
+
+void Swarm::setSpeed(Scalar cruise, Scalar max)
+{
+    cruiseSpeed = btFabs(cruise);
+    maxSpeed = btMax(btFabs(max), cruiseSpeed);
+}
+
+void Swarm::setBoidsParameters(Scalar neighbourRadius, Scalar separationDistance, Scalar cohesion, Scalar alignment, Scalar separation)
+{
+    this->neighbourRadius = btMax(btFabs(neighbourRadius), Scalar(1e-3));
+    this->separationDistance = btFabs(separationDistance);
+    kCohesion = cohesion;
+    kAlignment = alignment;
+    kSeparation = separation;
+}
+
+void Swarm::AddToSimulation(SimulationManager* sm)
+{
+    //Agents do not exist in the physics world, only their initial state is set
+    //(settings changed after construction, e.g. the cruise speed, are taken into account)
+    Scatter();
+}
+
+void Swarm::getAABB(Vector3& min, Vector3& max)
+{
+    min.setValue(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+    max.setValue(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+    for(size_t i=0; i<px.size(); ++i)
+    {
+        Vector3 p(px[i], py[i], pz[i]);
+        min.setMin(p);
+        max.setMax(p);
+    }
+}
+
+void Swarm::ShiftOrigin(const Vector3& shift)
+{
+    regionOrigin.setOrigin(regionOrigin.getOrigin() - shift);
+    for(size_t i=0; i<px.size(); ++i)
+    {
+        px[i] -= shift.x();
+        py[i] -= shift.y();
+        pz[i] -= shift.z();
+    }
+}
+
+void Swarm::Scatter()
+{
+    std::mt19937 randGen((unsigned int)px.size()); //Repeatable initial state
+    std::uniform_real_distribution<Scalar> randDist(Scalar(-1), Scalar(1));
+
+    for(size_t i=0; i<px.size(); ++i)
+    {
+        Vector3 p = regionOrigin * Vector3(randDist(randGen) * regionHalfExtents.x(),
+                                           randDist(randGen) * regionHalfExtents.y(),
+                                           randDist(randGen) * regionHalfExtents.z());
+        Vector3 h(randDist(randGen), randDist(randGen), Scalar(0.1) * randDist(randGen));
+        h = h.fuzzyZero() ? Vector3(1,0,0) : h.normalized();
+        Vector3 v = behaviour == SwarmBehaviour::BOIDS ? h * cruiseSpeed : V0();
+        px[i] = p.x(); py[i] = p.y(); pz[i] = p.z();
+        vx[i] = v.x(); vy[i] = v.y(); vz[i] = v.z();
+        hx[i] = h.x(); hy[i] = h.y(); hz[i] = h.z();
+    }
+}
+
+void Swarm::BuildGrid()
+{
+    size_t n = px.size();
+    Vector3 min, max;
+    getAABB(min, max);
+
+    //Cells not smaller than the interaction radius, total number of cells proportional to the number of agents
+    size_t maxCells = 4 * n + 64;
+    Vector3 extent = max - min;
+    cellSize = neighbourRadius;
+    while(true)
+    {
+        for(short a=0; a<3; ++a)
+            gridDim[a] = (int)btFloor(extent[a]/cellSize) + 1;
+        if((size_t)gridDim[0] * (size_t)gridDim[1] * (size_t)gridDim[2] <= maxCells)
+            break;
+        cellSize *= Scalar(1.26);
+    }
+    gridMin = min;
+
+    //Counting sort of agents by cell
+    size_t nCells = (size_t)gridDim[0] * (size_t)gridDim[1] * (size_t)gridDim[2];
+    cellStart.assign(nCells + 1, 0);
+    for(size_t i=0; i<n; ++i)
+    {
+        int c[3];
+        c[0] = btMin((int)((px[i] - gridMin.x())/cellSize), gridDim[0]-1);
+        c[1] = btMin((int)((py[i] - gridMin.y())/cellSize), gridDim[1]-1);
+        c[2] = btMin((int)((pz[i] - gridMin.z())/cellSize), gridDim[2]-1);
+        agentCell[i] = (unsigned int)((c[2] * gridDim[1] + c[1]) * gridDim[0] + c[0]);
+        ++cellStart[agentCell[i] + 1];
+    }
+    for(size_t i=0; i<nCells; ++i)
+        cellStart[i+1] += cellStart[i];
+    std::vector<unsigned int> fill(cellStart.begin(), cellStart.end()-1);
+    for(size_t i=0; i<n; ++i)
+        cellAgents[fill[agentCell[i]]++] = (unsigned int)i;
+}
+
+void Swarm::Update(Scalar dt)
+{
+    int n = (int)px.size();
+    if(n == 0 || dt <= Scalar(0))
+        return;
+
+    Ocean* ocean = SimulationApp::getApp()->getSimulationManager()->getOcean();
+    bool boids = behaviour == SwarmBehaviour::BOIDS;
+    if(boids)
+        BuildGrid();
+
+    Transform toRegion = regionOrigin.inverse();
+    Scalar r2 = neighbourRadius * neighbourRadius;
+    Scalar s2 = separationDistance * separationDistance;
+
+    //Steering (each agent reads the old state and writes its own new velocity)
+    #pragma omp parallel for schedule(static)
+    for(int i=0; i<n; ++i)
+    {
+        Vector3 p(px[i], py[i], pz[i]);
+        Vector3 v(vx[i], vy[i], vz[i]);
+        Vector3 flow = ocean != nullptr ? ocean->GetFluidVelocity(p) : V0();
+        Vector3 swim = v - flow;
+        Vector3 acc = V0();
+
+        if(boids)
+        {
+            Scalar cx(0), cy(0), cz(0), ax(0), ay(0), az(0), sx(0), sy(0), sz(0);
+            unsigned int count = 0;
+            int c0 = (int)(agentCell[i] % (unsigned int)gridDim[0]);
+            int c1 = (int)((agentCell[i] / (unsigned int)gridDim[0]) % (unsigned int)gridDim[1]);
+            int c2 = (int)(agentCell[i] / (unsigned int)(gridDim[0] * gridDim[1]));
+
+            for(int k=btMax(c2-1, 0); k<=btMin(c2+1, gridDim[2]-1); ++k)
+                for(int h=btMax(c1-1, 0); h<=btMin(c1+1, gridDim[1]-1); ++h)
+                    for(int g=btMax(c0-1, 0); g<=btMin(c0+1, gridDim[0]-1); ++g)
+                    {
+                        unsigned int cell = (unsigned int)((k * gridDim[1] + h) * gridDim[0] + g);
+                        for(unsigned int m=cellStart[cell]; m<cellStart[cell+1]; ++m)
+                        {
+                            unsigned int j = cellAgents[m];
+                            Scalar dx = px[j] - px[i];
+                            Scalar dy = py[j] - py[i];
+                            Scalar dz = pz[j] - pz[i];
+                            Scalar d2 = dx*dx + dy*dy + dz*dz;
+                            if((int)j == i || d2 > r2)
+                                continue;
+                            cx += dx; cy += dy; cz += dz;
+                            ax += vx[j]; ay += vy[j]; az += vz[j];
+                            ++count;
+                            if(d2 < s2 && d2 > SIMD_EPSILON)
+                            {
+                                sx -= dx/d2; sy -= dy/d2; sz -= dz/d2;
+                            }
+                        }
+                    }
+
+            if(count > 0)
+            {
+                Scalar invCount = Scalar(1)/Scalar(count);
+                acc += kCohesion * Vector3(cx, cy, cz) * invCount;
+                acc += kAlignment * (Vector3(ax, ay, az) * invCount - v);
+            }
+            acc += kSeparation * Vector3(sx, sy, sz);
+
+            //Keep swimming at the cruise speed
+            Scalar speed = swim.length();
+            if(speed > SIMD_EPSILON)
+                acc += (cruiseSpeed - speed) * swim/speed;
+        }
+        else
+            acc -= swim; //Relax towards the local current
+
+        //Steer back into the region
+        Vector3 lp = toRegion * p;
+        Vector3 excess(lp.x() - btMax(btMin(lp.x(), regionHalfExtents.x()), -regionHalfExtents.x()),
+                       lp.y() - btMax(btMin(lp.y(), regionHalfExtents.y()), -regionHalfExtents.y()),
+                       lp.z() - btMax(btMin(lp.z(), regionHalfExtents.z()), -regionHalfExtents.z()));
+        acc -= regionOrigin.getBasis() * excess;
+
+        //Limit swimming speed
+        swim += acc * dt;
+        Scalar speed = swim.length();
+        if(speed > maxSpeed)
+            swim *= maxSpeed/speed;
+        v = flow + swim;
+        nvx[i] = v.x(); nvy[i] = v.y(); nvz[i] = v.z();
+
+        //Agents face the direction they swim in
+        if(speed > Scalar(1e-3))
+        {
+            hx[i] = swim.x()/speed; hy[i] = swim.y()/speed; hz[i] = swim.z()/speed;
+        }
+    }
+
+    //Integration
+    #pragma omp parallel for schedule(static)
+    for(int i=0; i<n; ++i)
+    {
+        vx[i] = nvx[i]; vy[i] = nvy[i]; vz[i] = nvz[i];
+        px[i] += vx[i] * dt; py[i] += vy[i] * dt; pz[i] += vz[i] * dt;
+    }
+}
+
+std::vector<Renderable> Swarm::Render()
+{
+    std::vector<Renderable> items(0);
+
+    if(objectId >= 0 && isRenderable() && px.size() > 0)
+    {
+        //A single instanced object (positions and headings are turned into transforms on the rendering thread)
+        Renderable item;
+        item.type = RenderableType::SOLID;
+        item.objectId = objectId;
+        item.lookId = lookId;
+        item.materialName = materialName;
+        item.model = glm::mat4(1.f);
+        item.points.resize(px.size() * 2);
+        for(size_t i=0; i<px.size(); ++i)
+        {
+            item.points[2*i] = glm::vec3((GLfloat)px[i], (GLfloat)py[i], (GLfloat)pz[i]);
+            item.points[2*i+1] = glm::vec3((GLfloat)hx[i], (GLfloat)hy[i], (GLfloat)hz[i]);
+        }
+        items.push_back(item);
+    }
+
+    return items;
+}
+
+}
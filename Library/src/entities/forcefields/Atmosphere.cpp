@@ -34,12 +34,9 @@ namespace sf
     
 Atmosphere::Atmosphere(std::string uniqueName, Fluid g) : ForcefieldEntity(uniqueName)
 {
-    ghost->setCollisionFlags(ghost->getCollisionFlags() | btCollisionObject::CF_STATIC_OBJECT);
-    
-    Scalar size(100000);
-    Vector3 halfExtents = Vector3(size/Scalar(2), size/Scalar(2), size/Scalar(2));
-    ghost->setWorldTransform(Transform(Quaternion::getIdentity(), Vector3(0,0,-size/Scalar(2)))); //Above ocean surface and ground (z=0)
-    ghost->setCollisionShape(new btBoxShape(halfExtents));
+    //Bodies interacting with the atmosphere are tracked by the simulation manager (no ghost object needed)
+    delete ghost;
+    ghost = nullptr;
     
     gas = g;
     wind = std::vector<VelocityField*>(0);
@@ -118,6 +115,12 @@ void Atmosphere::AddVelocityField(VelocityField* field)
 {
     wind.push_back(field);
 }
+
+void Atmosphere::ShiftOrigin(const Vector3& shift)
+{
+    for(size_t i=0; i<wind.size(); ++i)
+        wind[i]->ShiftOrigin(shift);
+}
     
 void Atmosphere::GetSunPosition(Scalar &azimuthDeg, Scalar &elevationDeg)
 {
@@ -161,6 +164,11 @@ bool Atmosphere::IsInsideFluid(const Vector3& point) const
     return true;
 }
 
+bool Atmosphere::IsReachingFluid(const Vector3& aabbMin, const Vector3& aabbMax) const
+{
+    return aabbMin.z() <= Scalar(0); //Above ocean surface and ground (z=0)
+}
+
 void Atmosphere::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute)
 {
     Entity* ent;
@@ -169,7 +177,7 @@ void Atmosphere::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co,
     
     if(rb != 0)
     {
-        if(rb->isStaticOrKinematicObject())
+        if(rb->isStaticOrKinematicObject() || rb->getActivationState() == DISABLE_SIMULATION) //Reduced rate bodies between updates
             return;
         else
             ent = (Entity*)rb->getUserPointer();
@@ -186,7 +194,7 @@ void Atmosphere::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co,
     
     if(ent->getType() == EntityType::SOLID)
     {
-        if(recompute)
+        if(recompute || ((SolidEntity*)ent)->getIntegrationRate() == IntegrationRate::REDUCED)
         {
             ((SolidEntity*)ent)->ComputeAerodynamicForces(this);
         }
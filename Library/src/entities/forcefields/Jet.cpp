@@ -46,6 +46,11 @@ VelocityFieldType Jet::getType() const
     return VelocityFieldType::JET;
 }
 
+void Jet::ShiftOrigin(const Vector3& shift)
+{
+    c -= shift;
+}
+
 Vector3 Jet::GetVelocityAtPoint(const Vector3& p) const
 {
     //Calculate distance to axis
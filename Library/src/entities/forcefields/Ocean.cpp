@@ -40,14 +40,12 @@ namespace sf
 
 Ocean::Ocean(std::string uniqueName, Scalar waves, Fluid l) : ForcefieldEntity(uniqueName)
 {
-    ghost->setCollisionFlags(ghost->getCollisionFlags() | btCollisionObject::CF_STATIC_OBJECT);
+    //Bodies interacting with the ocean are tracked by the simulation manager (no ghost object needed)
+    delete ghost;
+    ghost = nullptr;
+    
     oceanState = waves > Scalar(2.0) ? Scalar(2.0) : waves;
-     
-    Scalar size(100000);
-    depth = size;
-    Vector3 halfExtents = Vector3(size/Scalar(2), size/Scalar(2), size/Scalar(2));
-    ghost->setWorldTransform(Transform(Quaternion::getIdentity(), Vector3(0, 0, size/Scalar(2) - oceanState*Scalar(3)))); //Move ocean influence zone a bit up to account for waves
-    ghost->setCollisionShape(new btBoxShape(halfExtents));
+    depth = Scalar(100000);
     
     currents = std::vector<VelocityField*>(0);
     currentsEnabled = false;
@@ -57,6 +55,8 @@ Ocean::Ocean(std::string uniqueName, Scalar waves, Fluid l) : ForcefieldEntity(u
     wavesDebug.model = glm::mat4(1.f);
     waterType = Scalar(0.0);
     glOcean = nullptr;
+    waveOrigin = glm::dvec2(0.0);
+    glWaveOrigin = glm::dvec2(0.0);
 }
 
 Ocean::~Ocean()
@@ -139,16 +139,32 @@ void Ocean::AddVelocityField(VelocityField* field)
     currents.push_back(field);
 }
 
+void Ocean::ShiftOrigin(const Vector3& shift)
+{
+    for(size_t i=0; i<currents.size(); ++i)
+        currents[i]->ShiftOrigin(shift);
+    
+    //Waves are sampled in the original world frame, so that their phase does not jump
+    //(accumulated in double precision and handed over to the renderer with the drawing queue)
+    waveOrigin += glm::dvec2((double)shift.getX(), (double)shift.getY());
+}
+
 bool Ocean::IsInsideFluid(const Vector3& point)
 {
     return GetDepth(point) >= Scalar(0);
 }
 
+bool Ocean::IsReachingFluid(const Vector3& aabbMin, const Vector3& aabbMax) const
+{
+    return aabbMax.z() >= -oceanState*Scalar(3) && aabbMin.z() <= depth; //Influence zone moved a bit up to account for waves
+}
+
 float Ocean::GetDepth(const glm::vec3& point)
 {
     if(hasWaves()) //Geometric waves
     {
-        GLfloat waveHeight = glOcean->ComputeWaveHeight(point.x, point.y);
+        GLfloat waveHeight = glOcean->ComputeWaveHeight((GLfloat)((double)point.x + waveOrigin.x), 
+                                                        (GLfloat)((double)point.y + waveOrigin.y));
         glm::vec3 wavePoint(point.x, point.y, waveHeight);
 #ifdef DEBUG_WAVES
         wavesDebug.points.push_back(wavePoint);
@@ -211,10 +227,13 @@ void Ocean::DisableCurrents()
 void Ocean::UpdateCurrentsData()
 {
     if(glOcean != NULL)
+    {
         glOcean->UpdateOceanCurrentsData(glOceanCurrentsUBOData);
+        glOcean->setWaveOrigin(glm::vec2(glWaveOrigin));
+    }
 }
 
-void Ocean::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute)
+void Ocean::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute, bool splitFaces)
 {
     Entity* ent;
     btRigidBody* rb = btRigidBody::upcast(co);
@@ -222,7 +241,7 @@ void Ocean::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool
     
     if(rb != 0)
     {
-        if(rb->isStaticOrKinematicObject())
+        if(rb->isStaticOrKinematicObject() || rb->getActivationState() == DISABLE_SIMULATION) //Reduced rate bodies between updates
             return;
         else
             ent = (Entity*)rb->getUserPointer();
@@ -241,10 +260,11 @@ void Ocean::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool
     
     if(ent->getType() == EntityType::SOLID)
     {
-        if(recompute)
+        if(recompute || ((SolidEntity*)ent)->getIntegrationRate() == IntegrationRate::REDUCED)
         {
             settings.dampingForces = true;
             settings.reallisticBuoyancy = true;
+            settings.splitFaces = splitFaces;
             ((SolidEntity*)ent)->ComputeHydrodynamicForces(settings, this);
         }
         
@@ -252,15 +272,21 @@ void Ocean::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool
     }
 }
 
-void Ocean::InitGraphics(SDL_mutex* hydrodynamics)
+void Ocean::InitGraphics()
 {
     if(oceanState > 0.0)
-        glOcean = new OpenGLRealOcean(depth, oceanState, hydrodynamics);
+        glOcean = new OpenGLRealOcean(depth, oceanState);
     else
         glOcean = new OpenGLFlatOcean(depth);
     setWaterType(0.2);
 }
 
+void Ocean::AcquireWaveData()
+{
+    if(glOcean != nullptr)
+        glOcean->AcquireWaveData();
+}
+
 std::vector<Renderable> Ocean::Render()
 {
     std::vector<Actuator*> act;
@@ -271,6 +297,9 @@ std::vector<Renderable> Ocean::Render(const std::vector<Actuator*>& act)
 {
     std::vector<Renderable> items(0);
     
+    //Update wave origin (copied to the renderer together with the drawing queue)
+    glWaveOrigin = waveOrigin;
+    
     //Update currents data
     glOceanCurrentsUBOData.gravity = glm::vec3(0.f,0.f,9.81f);
     glOceanCurrentsUBOData.numCurrents = 0;
@@ -44,6 +44,11 @@ VelocityFieldType Pipe::getType() const
     return VelocityFieldType::PIPE;
 }
 
+void Pipe::ShiftOrigin(const Vector3& shift)
+{
+    p1 -= shift;
+}
+
 Vector3 Pipe::GetVelocityAtPoint(const Vector3& p) const
 {
     //Calculate distance to line
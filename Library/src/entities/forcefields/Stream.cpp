@@ -41,6 +41,12 @@ VelocityFieldType Stream::getType() const
     return VelocityFieldType::STREAM;
 }
 
+void Stream::ShiftOrigin(const Vector3& shift)
+{
+    for(size_t i=0; i<c.size(); ++i)
+        c[i] -= shift;
+}
+
 Vector3 Stream::GetVelocityAtPoint(const Vector3& p) const
 {
     return Vector3(0,0,0);
@@ -36,6 +36,10 @@ VelocityField::~VelocityField()
 {
 }
 
+void VelocityField::ShiftOrigin(const Vector3& shift)
+{
+}
+
 void VelocityField::setEnabled(bool en)
 {
     enabled = en;
@@ -107,6 +107,14 @@ SolidType Compound::getSolidType()
     return SolidType::COMPOUND;
 }
 
+size_t Compound::getPhysicsFaceCount()
+{
+    size_t count = 0;
+    for(size_t i=0; i<parts.size(); ++i)
+        count += parts[i].solid->getPhysicsFaceCount();
+    return count;
+}
+
 std::vector<Vector3>* Compound::getMeshVertices() const
 {
     std::vector<Vector3>* pVert = new std::vector<Vector3>(0);
@@ -345,7 +353,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
                     Transform T_C_part = getOTransform() * parts[i].origin * parts[i].solid->getO2CTransform();
                     Transform T_O_part = getOTransform() * parts[i].origin;
 
-                    ComputeHydrodynamicForcesSubmerged(parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fdqp, Tdqp, Fdfp, Tdfp);
+                    ComputeHydrodynamicForcesSubmerged(parts[i].solid->getHydroMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fdqp, Tdqp, Fdfp, Tdfp, settings.splitFaces);
                     Vector3 Cd, Cf;
                     parts[i].solid->getHydrodynamicCoefficients(Cd, Cf);
                     CorrectHydrodynamicForces(ocn, Fdqp, Tdqp, Fdfp, Tdfp, Cd, Cf, T_O_part);
@@ -408,7 +416,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
 
                 if(parts[i].isExternal) //Compute buoyancy and drag
                 {
-                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged);
+                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getHydroMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged);
                     Vector3 Cd, Cf;
                     parts[i].solid->getHydrodynamicCoefficients(Cd, Cf);
                     CorrectHydrodynamicForces(ocn, Fdqp, Tdqp, Fdfp, Tdfp, Cd, Cf, T_O_part);
@@ -424,7 +432,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
                 else if(pSettings.reallisticBuoyancy) //Compute only buoyancy
                 {
                     pSettings.dampingForces = false;
-                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged);
+                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getHydroMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged);
                     Fb += Fbp;
                     Tb += Tbp;
                     Vsub += Vsubp;
@@ -467,6 +475,13 @@ void Compound::BuildGraphicalObject()
         parts[i].solid->BuildGraphicalObject();
 }
 
+void Compound::DestroyGraphicalObject()
+{
+    for(unsigned int i=0; i<parts.size(); ++i)
+        parts[i].solid->DestroyGraphicalObject();
+    SolidEntity::DestroyGraphicalObject();
+}
+
 std::vector<Renderable> Compound::Render(size_t partId)
 {
     std::vector<Renderable> items(0);
@@ -25,14 +25,27 @@
 
 #include "entities/solids/Polyhedron.h"
 
+#include <algorithm>
+#include <cstdio>
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "utils/SystemUtil.hpp"
 #include "utils/GeometryFileUtil.h"
+#include "LinearMath/btConvexHullComputer.h"
 
 namespace sf
 {
 
+std::map<std::string, std::vector<Vector3>> Polyhedron::hullCache;
+
+//Exact text representation of a number (hexadecimal floating point), used to build cache keys
+static std::string ExactKey(Scalar value)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%a", (double)value);
+    return std::string(buf);
+}
+
 Polyhedron::Polyhedron(std::string uniqueName, BodyPhysicsSettings phy, 
                        std::string graphicsFilename, Scalar graphicsScale, const Transform& graphicsOrigin,
                        std::string physicsFilename, Scalar physicsScale, const Transform& physicsOrigin,
@@ -54,6 +67,19 @@ Polyhedron::Polyhedron(std::string uniqueName, BodyPhysicsSettings phy,
         T_O2C = T_O2G;
     }
     
+    //Collision hull is built from the original vertices (refinement only adds points on the faces)
+    hullInput.resize(phyMesh->getNumOfVertices());
+    for(size_t i=0; i<hullInput.size(); ++i)
+    {
+        glm::vec3 pos = phyMesh->getVertexPos(i);
+        hullInput[i] = Vector3(pos.x, pos.y, pos.z);
+    }
+    hullKey = (physicsFilename != "" ? physicsFilename + "@" + ExactKey(physicsScale) : graphicsFilename + "@" + ExactKey(graphicsScale));
+    hullMaxVertices = 0; //Simplification is opt-in, so that existing collision shapes do not change
+    hullMaxVolumeError = Scalar(0.02);
+    hullMargin = Scalar(0);
+    hullFeatures = false;
+    
     OpenGLContent::Refine(phyMesh, 3.f);
     
     //2. Compute physical properties
@@ -84,6 +110,24 @@ Polyhedron::~Polyhedron()
         delete graMesh;
 }
     
+void Polyhedron::ClearHullCache()
+{
+    hullCache.clear();
+}
+
+void Polyhedron::setCollisionHull(unsigned int maxVertices, Scalar maxVolumeError, Scalar margin)
+{
+    if(rigidBody != nullptr || multibodyCollider != nullptr)
+    {
+        cWarning("Collision hull of '%s' has to be defined before adding it to the simulation!", getName().c_str());
+        return;
+    }
+    hullMaxVertices = maxVertices;
+    hullMaxVolumeError = btMax(maxVolumeError, Scalar(0));
+    hullMargin = btMax(margin, Scalar(0));
+    hullFeatures = true;
+}
+
 SolidType Polyhedron::getSolidType()
 {
     return SolidType::POLYHEDRON;
@@ -91,18 +135,160 @@ SolidType Polyhedron::getSolidType()
 
 btCollisionShape* Polyhedron::BuildCollisionShape()
 {
-    btConvexHullShape* convex = new btConvexHullShape();
-    for(size_t i=0; i<phyMesh->getNumOfVertices(); ++i)
+    //Hulls are shared between bodies using the same mesh with the same settings
+    std::string key = hullKey + "#" + std::to_string(hullMaxVertices) + "#" + ExactKey(hullMaxVolumeError) + "#" + ExactKey(hullMargin);
+    auto it = hullCache.find(key);
+    if(it == hullCache.end())
     {
-        glm::vec3 pos = phyMesh->getVertexPos(i);
-        Vector3 v(pos.x, pos.y, pos.z);
-        convex->addPoint(v);
+        std::vector<Vector3> hull = ComputeHull(hullInput, hullMaxVertices, hullMaxVolumeError);
+        
+        //Shrink the hull by the margin so that the rounded shape matches the mesh
+        if(hullMargin > Scalar(0) && hull.size() > 3)
+        {
+            btConvexHullComputer hc;
+            if(hc.compute((const Scalar*)&hull[0], sizeof(Vector3), (int)hull.size(), hullMargin, Scalar(0.5)) >= Scalar(0) && hc.vertices.size() > 3)
+            {
+                hull.resize(hc.vertices.size());
+                for(int i=0; i<hc.vertices.size(); ++i)
+                    hull[i] = hc.vertices[i];
+            }
+        }
+        it = hullCache.insert(std::make_pair(key, hull)).first;
+        
+        if(hullInput.size() > it->second.size())
+            cInfo("Collision hull of '%s' reduced from %zu to %zu vertices.", getName().c_str(), hullInput.size(), it->second.size());
     }
-    //convex->optimizeConvexHull();
-    convex->setMargin(0);
+    
+    btConvexHullShape* convex = new btConvexHullShape((const Scalar*)&it->second[0], (int)it->second.size(), sizeof(Vector3));
+    convex->setMargin(hullMargin);
+    if(hullFeatures)
+        convex->initializePolyhedralFeatures(); //Faces and adjacency used for contact clipping
     return convex;
 }
 
+std::vector<Vector3> Polyhedron::ComputeHull(const std::vector<Vector3>& points, unsigned int maxVertices, Scalar maxVolumeError)
+{
+    std::vector<Vector3> current = points;
+    if(current.size() < 4)
+        return current;
+    
+    auto hullVolume = [](const btConvexHullComputer& h)
+    {
+        Scalar V(0);
+        for(int i=0; i<h.faces.size(); ++i)
+        {
+            const btConvexHullComputer::Edge* e0 = &h.edges[h.faces[i]];
+            const btConvexHullComputer::Edge* e = e0->getNextEdgeOfFace();
+            const Vector3& a = h.vertices[e0->getSourceVertex()];
+            while(e->getTargetVertex() != e0->getSourceVertex())
+            {
+                V += a.dot(h.vertices[e->getSourceVertex()].cross(h.vertices[e->getTargetVertex()]));
+                e = e->getNextEdgeOfFace();
+            }
+        }
+        return btFabs(V)/Scalar(6);
+    };
+    
+    //Exact hull (removes interior and coplanar points)
+    Scalar V0(0);
+    {
+        btConvexHullComputer hc;
+        hc.compute((const Scalar*)&current[0], sizeof(Vector3), (int)current.size(), Scalar(0), Scalar(0));
+        if(hc.vertices.size() < 4)
+            return current;
+        V0 = hullVolume(hc);
+        current.resize(hc.vertices.size());
+        for(int i=0; i<hc.vertices.size(); ++i)
+            current[i] = hc.vertices[i];
+    }
+    if(maxVertices < 4 || current.size() <= maxVertices || V0 <= SIMD_EPSILON)
+        return current;
+    
+    //Greedy simplification: remove the vertices cutting off the smallest caps, as long as the volume error is bounded
+    bool single = false;
+    while(current.size() > maxVertices)
+    {
+        btConvexHullComputer hc;
+        hc.compute((const Scalar*)&current[0], sizeof(Vector3), (int)current.size(), Scalar(0), Scalar(0));
+        
+        //First edge of each vertex
+        std::vector<int> vertexEdge(hc.vertices.size(), -1);
+        for(int i=0; i<hc.edges.size(); ++i)
+            if(vertexEdge[hc.edges[i].getSourceVertex()] < 0)
+                vertexEdge[hc.edges[i].getSourceVertex()] = i;
+        
+        //Estimated volume of the cap removed with each vertex (pyramid over the ring of neighbours)
+        std::vector<std::pair<Scalar, int>> cost(hc.vertices.size());
+        for(int i=0; i<hc.vertices.size(); ++i)
+        {
+            cost[i] = std::make_pair(BT_LARGE_FLOAT, i);
+            if(vertexEdge[i] < 0)
+                continue;
+            const btConvexHullComputer::Edge* e0 = &hc.edges[vertexEdge[i]];
+            const btConvexHullComputer::Edge* e = e0;
+            std::vector<Vector3> ring;
+            do
+            {
+                ring.push_back(hc.vertices[e->getTargetVertex()]);
+                e = e->getNextEdgeOfVertex();
+            }
+            while(e != e0);
+            
+            Vector3 c(0,0,0);
+            for(size_t h=0; h<ring.size(); ++h)
+                c += ring[h];
+            c /= Scalar(ring.size());
+            Vector3 N(0,0,0);
+            for(size_t h=0; h<ring.size(); ++h)
+                N += (ring[h]-c).cross(ring[(h+1)%ring.size()]-c);
+            cost[i].first = btFabs((hc.vertices[i]-c).dot(N))/Scalar(6);
+        }
+        std::sort(cost.begin(), cost.end());
+        
+        //Remove a batch of non-adjacent vertices
+        size_t batch = single ? 1 : btMax((size_t)1, btMin(current.size() - maxVertices, current.size()/8));
+        std::vector<bool> removed(hc.vertices.size(), false);
+        std::vector<bool> locked(hc.vertices.size(), false);
+        size_t n = 0;
+        for(size_t h=0; h<cost.size() && n<batch; ++h)
+        {
+            int v = cost[h].second;
+            if(locked[v] || vertexEdge[v] < 0)
+                continue;
+            removed[v] = true;
+            ++n;
+            const btConvexHullComputer::Edge* e0 = &hc.edges[vertexEdge[v]];
+            const btConvexHullComputer::Edge* e = e0;
+            do
+            {
+                locked[e->getTargetVertex()] = true;
+                e = e->getNextEdgeOfVertex();
+            }
+            while(e != e0);
+        }
+        
+        std::vector<Vector3> candidate;
+        for(int i=0; i<hc.vertices.size(); ++i)
+            if(!removed[i])
+                candidate.push_back(hc.vertices[i]);
+        
+        btConvexHullComputer hc2;
+        hc2.compute((const Scalar*)&candidate[0], sizeof(Vector3), (int)candidate.size(), Scalar(0), Scalar(0));
+        if(hc2.vertices.size() < 4 || V0 - hullVolume(hc2) > maxVolumeError * V0)
+        {
+            if(single)
+                break; //Cheapest vertex already exceeds the error bound
+            single = true;
+            continue;
+        }
+        
+        current.resize(hc2.vertices.size());
+        for(int i=0; i<hc2.vertices.size(); ++i)
+            current[i] = hc2.vertices[i];
+    }
+    return current;
+}
+
 void Polyhedron::BuildGraphicalObject()
 {
     if(graMesh == NULL || !SimulationApp::getApp()->hasGraphics())
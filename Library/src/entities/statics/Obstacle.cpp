@@ -176,6 +176,16 @@ void Obstacle::BuildGraphicalObject()
     phyObjectId = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->BuildObject(phyMesh);
 }
 
+void Obstacle::DestroyGraphicalObject()
+{
+    if(!SimulationApp::getApp()->hasGraphics())
+        return;
+    
+    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->ReleaseObject(graObjectId);
+    graObjectId = -1;
+    StaticEntity::DestroyGraphicalObject();
+}
+
 std::vector<Renderable> Obstacle::Render()
 {
     std::vector<Renderable> items(0);
@@ -29,11 +29,15 @@
 #include "core/SimulationApp.h"
 #include "graphics/OpenGLState.h"
 #include "utils/SystemUtil.hpp"
+#include <SDL2/SDL_video.h>
 #ifdef EMBEDDED_RESOURCES
 #include <sstream>
 #include "ResourceHandle.h"
 #endif
 
+//GL_KHR_parallel_shader_compile is not part of the loader
+typedef void (GLAD_API_PTR *PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
 namespace sf
 {
 
@@ -43,80 +47,207 @@ bool GLSLShader::verbose = true;
 GLSLShader::GLSLShader(const std::vector<GLSLSource>& sources, const std::vector<GLuint>& precompiled)
 {
     valid = false;
+    pending = false;
     program = 0;
 
     if(sources.size() > 0)
     {
-        valid = true;
-        
-        std::vector<GLuint> shaders = precompiled;
-        GLint compiled = 0;
-
+        std::vector<GLuint> shaders;
         for(size_t i=0; i<sources.size(); ++i)
         {
-            GLuint shader = LoadShader(sources[i].type, sources[i].filename, sources[i].header, &compiled);
-            if(compiled == 0)
+            GLuint shader = CompileShader(sources[i].type, sources[i].filename, sources[i].header);
+            if(shader == 0)
             {
-                valid = false;
-                break;
+                for(size_t h=0; h<shaders.size(); ++h)
+                    glDeleteShader(shaders[h]);
+                ownedFiles.clear();
+                return;
             }
             shaders.push_back(shader);
+            ownedFiles.push_back(sources[i].filename);
         }
-
-        if(valid)
-        {
-            program = CreateProgram(shaders, precompiled.size());
-            if(program == 0)
-                valid = false;
-        }
+        Link(precompiled, shaders);
     }
 }
 
 GLSLShader::GLSLShader(const std::vector<GLuint>& precompiled)
 {
-    program = CreateProgram(precompiled, precompiled.size());
-    if(program == 0)
-        valid = false;
-    else 
-        valid = true;
+    valid = false;
+    pending = false;
+    program = 0;
+    Link(precompiled, std::vector<GLuint>(0));
 }
 
 GLSLShader::GLSLShader(std::string fragment, std::string vertex)
 {
     valid = false;
-    GLint compiled = 0;
-    GLuint vs;
-    GLuint fs;
+    pending = false;
+    program = 0;
     std::string emptyHeader = "";
+    std::vector<GLuint> sharedShaders;
+    std::vector<GLuint> shaders;
     
     if(vertex == "")
-        vs = saqVertexShader;
+        sharedShaders.push_back(saqVertexShader);
     else
-        vs = LoadShader(GL_VERTEX_SHADER, vertex, emptyHeader, &compiled);
+    {
+        GLuint vs = CompileShader(GL_VERTEX_SHADER, vertex, emptyHeader);
+        if(vs == 0)
+            return;
+        shaders.push_back(vs);
+        ownedFiles.push_back(vertex);
+    }
     
-    fs = LoadShader(GL_FRAGMENT_SHADER, fragment, emptyHeader, &compiled);
-    program = CreateProgram({vs, fs}, vs == saqVertexShader ? 1 : 0);
-    valid = true;
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragment, emptyHeader);
+    if(fs == 0)
+    {
+        for(size_t h=0; h<shaders.size(); ++h)
+            glDeleteShader(shaders[h]);
+        ownedFiles.clear();
+        return;
+    }
+    shaders.push_back(fs);
+    ownedFiles.push_back(fragment);
+    Link(sharedShaders, shaders);
 }
     
 GLSLShader::~GLSLShader()
 {
-    if(valid)
+    for(size_t i=0; i<owned.size(); ++i)
+        glDeleteShader(owned[i]);
+    if(program != 0)
         glDeleteProgram(program);
 }
 
+void GLSLShader::Link(const std::vector<GLuint>& sharedShaders, const std::vector<GLuint>& ownedShaders)
+{
+    program = glCreateProgram();
+    for(size_t i=0; i<sharedShaders.size(); ++i)
+        if(sharedShaders[i] > 0)
+            glAttachShader(program, sharedShaders[i]);
+    for(size_t i=0; i<ownedShaders.size(); ++i)
+        glAttachShader(program, ownedShaders[i]);
+    glLinkProgram(program);
+    
+    //Status is not queried here, to let the driver compile and link in the background
+    shared = sharedShaders;
+    owned = ownedShaders;
+    valid = true;
+    pending = true;
+}
+
+void GLSLShader::Finalize()
+{
+    if(!pending)
+        return;
+    pending = false;
+    
+    for(size_t i=0; i<owned.size(); ++i)
+    {
+        GLint compiled = 0;
+        glGetShaderiv(owned[i], GL_COMPILE_STATUS, &compiled);
+        if(compiled == 0)
+        {
+            cError("Failed to compile shader: %s", (GetShaderPath() + ownedFiles[i]).c_str());
+            valid = false;
+        }
+#ifdef DEBUG
+        GLint infoLogLength = 0;
+        glGetShaderiv(owned[i], GL_INFO_LOG_LENGTH, &infoLogLength);
+        if(infoLogLength > 0)
+        {
+            std::vector<char> infoLog(infoLogLength+1);
+            glGetShaderInfoLog(owned[i], infoLogLength, NULL, &infoLog[0]);
+            cWarning("Shader compile log: %s", &infoLog[0]);
+        }
+#endif
+    }
+    
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+#ifdef DEBUG
+    GLint infoLogLength = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLogLength);
+    if(infoLogLength > 0)
+    {
+        std::vector<char> infoLog(infoLogLength+1);
+        glGetProgramInfoLog(program, infoLogLength, NULL, &infoLog[0]);
+        cWarning("Program link log: %s", &infoLog[0]);
+    }
+#endif
+    if(linked == 0)
+    {
+        if(valid)
+            cError("Failed to link program!");
+        valid = false;
+    }
+    
+    for(size_t i=0; i<shared.size(); ++i)
+        if(shared[i] > 0)
+            glDetachShader(program, shared[i]);
+    for(size_t i=0; i<owned.size(); ++i)
+    {
+        glDetachShader(program, owned[i]);
+        glDeleteShader(owned[i]);
+    }
+    shared.clear();
+    owned.clear();
+    ownedFiles.clear();
+    
+    if(!valid)
+    {
+        glDeleteProgram(program);
+        program = 0;
+        attributes.clear();
+        uniforms.clear();
+        uniformBlocks.clear();
+        storageBlocks.clear();
+        return;
+    }
+    
+    //Resolve variables defined before the program was ready
+    for(size_t i=0; i<attributes.size();)
+    {
+        attributes[i].index = glGetAttribLocation(program, attributes[i].name.c_str());
+        if(attributes[i].index < 0)
+            attributes.erase(attributes.begin() + i);
+        else
+            ++i;
+    }
+    
+    for(size_t i=0; i<uniforms.size();)
+    {
+        uniforms[i].location = glGetUniformLocation(program, uniforms[i].name.c_str());
+        if(uniforms[i].location < 0)
+            uniforms.erase(uniforms.begin() + i);
+        else
+            ++i;
+    }
+    
+    for(size_t i=0; i<uniformBlocks.size(); ++i)
+        BindUniformBlock(uniformBlocks[i].first, uniformBlocks[i].second);
+    uniformBlocks.clear();
+    
+    for(size_t i=0; i<storageBlocks.size(); ++i)
+        BindShaderStorageBlock(storageBlocks[i].first, storageBlocks[i].second);
+    storageBlocks.clear();
+}
+
 bool GLSLShader::isValid()
 {
+    Finalize();
     return valid;
 }
 
 GLuint GLSLShader::getProgramHandle()
 {
+    Finalize();
     return program;
 }
 
 void GLSLShader::Use()
 {
+    Finalize();
     if(valid)
         OpenGLState::UseProgram(program);
 #ifdef DEBUG
@@ -131,6 +262,13 @@ bool GLSLShader::AddAttribute(std::string name, ParameterType type)
     att.name = name;
     att.type = type;
     
+    if(pending)
+    {
+        att.index = -1;
+        attributes.push_back(att);
+        return true;
+    }
+    
     Use();
     att.index = glGetAttribLocation(program, name.c_str());
     OpenGLState::UseProgram(0);
@@ -148,6 +286,13 @@ bool GLSLShader::AddUniform(std::string name, ParameterType type)
     uni.name = name;
     uni.type = type;
     
+    if(pending)
+    {
+        uni.location = -1;
+        uniforms.push_back(uni);
+        return true;
+    }
+    
     Use();
     uni.location = glGetUniformLocation(program, name.c_str());
     OpenGLState::UseProgram(0);
@@ -342,6 +487,7 @@ bool GLSLShader::SetUniform(std::string name, glm::mat4 x)
 
 bool GLSLShader::GetUniform(std::string name, ParameterType type, GLint& location)
 {
+    Finalize();
     for(unsigned int i = 0; i < uniforms.size(); i++)
         if(uniforms[i].name == name)
         {
@@ -365,6 +511,7 @@ bool GLSLShader::GetUniform(std::string name, ParameterType type, GLint& locatio
 
 bool GLSLShader::GetAttribute(std::string name, ParameterType type, GLint& index)
 {
+    Finalize();
     for(unsigned int i = 0; i < attributes.size(); i++)
         if(attributes[i].name == name)
         {
@@ -382,6 +529,12 @@ bool GLSLShader::GetAttribute(std::string name, ParameterType type, GLint& index
 
 bool GLSLShader::BindUniformBlock(std::string name, GLuint bindingPoint)
 {
+    if(pending)
+    {
+        uniformBlocks.push_back(std::make_pair(name, bindingPoint));
+        return true;
+    }
+    
     GLuint blockIndex = glGetUniformBlockIndex(program, name.c_str());
     if(blockIndex != GL_INVALID_INDEX)
     {
@@ -399,6 +552,12 @@ bool GLSLShader::BindUniformBlock(std::string name, GLuint bindingPoint)
 
 bool GLSLShader::BindShaderStorageBlock(std::string name, GLuint bindingPoint)
 {
+    if(pending)
+    {
+        storageBlocks.push_back(std::make_pair(name, bindingPoint));
+        return true;
+    }
+    
     GLuint blockIndex = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, name.c_str());
     if(blockIndex != GL_INVALID_INDEX)
     {
@@ -417,6 +576,26 @@ bool GLSLShader::BindShaderStorageBlock(std::string name, GLuint bindingPoint)
 //// Statics
 bool GLSLShader::Init()
 {
+    //Allow the driver to use as many compiler threads as it wants
+    GLint nExtensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &nExtensions);
+    for(GLint i=0; i<nExtensions; ++i)
+    {
+        const char* ext = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+        if(ext != NULL 
+           && (std::string(ext) == "GL_KHR_parallel_shader_compile" || std::string(ext) == "GL_ARB_parallel_shader_compile"))
+        {
+            PFNGLMAXSHADERCOMPILERTHREADSKHRPROC maxThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)SDL_GL_GetProcAddress(
+                std::string(ext) == "GL_KHR_parallel_shader_compile" ? "glMaxShaderCompilerThreadsKHR" : "glMaxShaderCompilerThreadsARB");
+            if(maxThreads != NULL)
+            {
+                maxThreads(0xFFFFFFFF);
+                cInfo("Parallel shader compilation enabled.");
+                break;
+            }
+        }
+    }
+
     GLint compiled;
     std::string emptyHeader = "";
     saqVertexShader = LoadShader(GL_VERTEX_SHADER, "saq.vert", emptyHeader, &compiled);
@@ -426,7 +605,10 @@ bool GLSLShader::Init()
 void GLSLShader::Destroy()
 {
     if(saqVertexShader != 0)
-        glDeleteProgram(saqVertexShader);
+    {
+        glDeleteShader(saqVertexShader);
+        saqVertexShader = 0;
+    }
 }
 
 void GLSLShader::Silent()
@@ -439,7 +621,7 @@ void GLSLShader::Verbose()
     verbose = true;
 }
 
-GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, const std::string& header, GLint *shaderCompiled)
+GLuint GLSLShader::CompileShader(GLenum shaderType, const std::string& filename, const std::string& header)
 {
     GLuint shader = 0;
     std::string sourcePath = GetShaderPath() + filename;
@@ -520,74 +702,37 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
     sourceFile.close();
 #endif    
     const char* shaderSource = source.c_str();
-    if(shaderSource != NULL)
-    {
-        shader = glCreateShader(shaderType);
-        glShaderSource(shader, 1, (const GLchar**)&shaderSource, NULL);
-        glCompileShader(shader);
-        glGetShaderiv(shader, GL_COMPILE_STATUS, shaderCompiled);
-        if(*shaderCompiled == 0)
-        {
-            cError("Failed to compile shader: %s", sourcePath.c_str());
-            shader = 0;
-        }
-#ifdef DEBUG	
-        GLint infoLogLength = 0;	
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
-        if(infoLogLength > 0)
-        {
-            std::vector<char> infoLog(infoLogLength+1);
-            glGetShaderInfoLog(shader, infoLogLength, NULL, &infoLog[0]);
-            cWarning("Shader compile log: %s", &infoLog[0]);
-        }
-#endif
-    }
-    else
-        *shaderCompiled = 0;
-    
+    shader = glCreateShader(shaderType);
+    glShaderSource(shader, 1, (const GLchar**)&shaderSource, NULL);
+    glCompileShader(shader);
     return shader;
 }
 
-GLuint GLSLShader::CreateProgram(const std::vector<GLuint>& compiledShaders, unsigned int doNotDeleteNFirstShaders)
+GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, const std::string& header, GLint *shaderCompiled)
 {
-    GLint programLinked = 0;
-    GLuint program = glCreateProgram();
-    
-    for(unsigned int i=0; i<compiledShaders.size(); ++i)
-        if(compiledShaders[i] > 0)
-            glAttachShader(program, compiledShaders[i]);
+    *shaderCompiled = 0;
+    GLuint shader = CompileShader(shaderType, filename, header);
+    if(shader == 0)
+        return 0;
     
-    glLinkProgram(program);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, shaderCompiled);
 #ifdef DEBUG
     GLint infoLogLength = 0;
-    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLogLength);
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
     if(infoLogLength > 0)
     {
         std::vector<char> infoLog(infoLogLength+1);
-        glGetProgramInfoLog(program, infoLogLength, NULL, &infoLog[0]);
-        cWarning("Program link log: %s", &infoLog[0]);
+        glGetShaderInfoLog(shader, infoLogLength, NULL, &infoLog[0]);
+        cWarning("Shader compile log: %s", &infoLog[0]);
     }
 #endif
-    glGetProgramiv(program, GL_LINK_STATUS, &programLinked);
-    
-    for(unsigned int i=0; i<compiledShaders.size(); ++i)
-    {
-        if(compiledShaders[i] > 0)
-        {
-            glDetachShader(program, compiledShaders[i]);
-            if(i > doNotDeleteNFirstShaders-1)
-                glDeleteShader(compiledShaders[i]);
-        }
-    }
-    
-    if(programLinked == 0)
+    if(*shaderCompiled == 0)
     {
-        cError("Failed to link program!");
-        glDeleteProgram(program);
-        program = 0;
+        cError("Failed to compile shader: %s", (GetShaderPath() + filename).c_str());
+        glDeleteShader(shader);
+        shader = 0;
     }
-    
-    return program;
+    return shader;
 }
 
 }
@@ -59,6 +59,13 @@ OpenGLAtmosphere::OpenGLAtmosphere(const std::string& modelFilename, RenderQuali
     sunShadowmapSplits = 4;
     sunShadowmapSize = 4096;
     sunShadowFBO = 0;
+    sunShadowCasterShader = nullptr;
+    sunShadowValid = false;
+    sunShadowVersion = 0;
+    sunShadowSunDir = glm::vec3(0.f);
+    sunShadowFar = 0.f;
+    sunShadowBakes = 0;
+    sunShadowReuses = 0;
     sunSkyUBO = 0;
     sunDirection = glm::vec3(0,0,1.f);
     sunModelView = glm::mat4x4(0);
@@ -158,6 +165,18 @@ OpenGLAtmosphere::OpenGLAtmosphere(const std::string& modelFilename, RenderQuali
         sunShadowmapShader->AddUniform("shadowmapArray", ParameterType::INT);
         sunShadowmapShader->AddUniform("shadowmapLayer", ParameterType::FLOAT);
         
+        sources.clear();
+        sources.push_back(GLSLSource(GL_VERTEX_SHADER, "shadowCascades.vert"));
+        sources.push_back(GLSLSource(GL_GEOMETRY_SHADER, "shadowCascades.geom"));
+        sources.push_back(GLSLSource(GL_FRAGMENT_SHADER, "shadow.frag"));
+        sunShadowCasterShader = new GLSLShader(sources);
+        sunShadowCasterShader->AddUniform("M", ParameterType::MAT4);
+        sunShadowCasterShader->AddUniform("VP0", ParameterType::MAT4);
+        sunShadowCasterShader->AddUniform("VP1", ParameterType::MAT4);
+        sunShadowCasterShader->AddUniform("VP2", ParameterType::MAT4);
+        sunShadowCasterShader->AddUniform("VP3", ParameterType::MAT4);
+        sunShadowCasterShader->AddUniform("cascadeMask", ParameterType::UINT);
+        
         //Generate shadowmap array
         glGenTextures(1, &sunShadowmapArray);
         OpenGLState::BindTexture(TEX_BASE, GL_TEXTURE_2D_ARRAY, sunShadowmapArray);
@@ -182,7 +201,8 @@ OpenGLAtmosphere::OpenGLAtmosphere(const std::string& modelFilename, RenderQuali
         //Create shadowmap framebuffer
         glGenFramebuffers(1, &sunShadowFBO);
         OpenGLState::BindFramebuffer(sunShadowFBO);
-        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, sunShadowmapArray, 0, 0);
+        glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, sunShadowmapArray, 0); //Layered
+
         glDrawBuffer(GL_NONE);
         glReadBuffer(GL_NONE);
         
@@ -222,6 +242,7 @@ OpenGLAtmosphere::~OpenGLAtmosphere()
         glDeleteSamplers(1, &sunShadowSampler);
         glDeleteFramebuffers(1, &sunShadowFBO);
         delete sunShadowmapShader;
+        delete sunShadowCasterShader;
     }
 }
 
@@ -393,6 +414,13 @@ void OpenGLAtmosphere::BakeShadowmaps(OpenGLPipeline* pipe, OpenGLView* view)
     if(sunShadowmapSize == 0)
         return;
     
+    //Reuse the cascades of the previous view (stereo pairs, co-located sensors, static scene)
+    if(ShadowmapsCoverView(pipe, view))
+    {
+        ++sunShadowReuses;
+        return;
+    }
+
     //Pre-set splits
     for(unsigned int i = 0; i < sunShadowmapSplits; ++i)
     {
@@ -405,40 +433,113 @@ void OpenGLAtmosphere::BakeShadowmaps(OpenGLPipeline* pipe, OpenGLView* view)
     //Compute the z-distances for each split as seen in camera space
     UpdateSplitDist(view->GetNearClip(), view->GetFarClip());
 
-    //Render maps
-    glCullFace(GL_FRONT); //GL_FRONT -> no shadow acne but problems with filtering
-    glDisable(GL_DEPTH_CLAMP);
-
-    OpenGLState::BindFramebuffer(sunShadowFBO);
-    OpenGLState::Viewport(0, 0, sunShadowmapSize, sunShadowmapSize);
-
     glm::vec3 camPos = view->GetEyePosition();
     glm::vec3 camDir = view->GetLookingDirection();
     glm::vec3 camUp = view->GetUpDirection();
 
-    // for all shadow splits
+    //Compute the light crop matrices enclosing the camera frustum slices
     for(unsigned int i = 0; i < sunShadowmapSplits; ++i)
     {
-        //Compute the camera frustum slice boundary points in world space
         UpdateFrustumCorners(sunShadowFrustum[i], camPos, camDir, camUp);
-
-        //Adjust the view frustum of the light, so that it encloses the camera frustum slice fully.
-        //note that this function sets the projection matrix as it sees best fit
-        glm::mat4 cp = BuildCropProjMatrix(sunShadowFrustum[i]);
-        sunShadowCPM[i] =  cp * sunModelView;
-
-        ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetProjectionMatrix(cp);
-        ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetViewMatrix(sunModelView);
-        //Draw current depth map
-        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, sunShadowmapArray, 0, i);
-        glClear(GL_DEPTH_BUFFER_BIT);
-        pipe->DrawObjects();
+        sunShadowCPM[i] = BuildCropProjMatrix(sunShadowFrustum[i]) * sunModelView;
     }
 
+    //Render all cascades in one layered pass
+    glCullFace(GL_FRONT); //GL_FRONT -> no shadow acne but problems with filtering
+    glDisable(GL_DEPTH_CLAMP);
+
+    OpenGLState::BindFramebuffer(sunShadowFBO);
+    OpenGLState::Viewport(0, 0, sunShadowmapSize, sunShadowmapSize);
+    glClear(GL_DEPTH_BUFFER_BIT); //All layers
+
+    OpenGLContent* content = pipe->getContent();
+    content->SetDrawingMode(DrawingMode::RAW);
+    sunShadowCasterShader->Use();
+    for(unsigned int i = 0; i < 4; ++i)
+        sunShadowCasterShader->SetUniform("VP" + std::to_string(i), i < sunShadowmapSplits ? sunShadowCPM[i] : glm::mat4(1.f));
+    
+    const std::vector<Renderable>& objects = pipe->getDrawingQueue();
+    for(size_t h = 0; h < objects.size(); ++h)
+    {
+        if(objects[h].type != RenderableType::SOLID 
+           || objects[h].objectId < 0 || objects[h].objectId >= (int)content->getObjectsCount())
+            continue;
+
+        //Cull casters against the crop frustum of each cascade (orthographic -> box in clip space)
+        const Object& obj = content->getObject(objects[h].objectId);
+        glm::mat3 R(objects[h].model);
+        glm::vec3 he = (obj.aabbMax - obj.aabbMin) * 0.5f;
+        glm::vec3 c = glm::vec3(objects[h].model * glm::vec4((obj.aabbMin + obj.aabbMax) * 0.5f, 1.f));
+        glm::vec3 e = glm::abs(R[0]) * he.x + glm::abs(R[1]) * he.y + glm::abs(R[2]) * he.z;
+        
+        GLuint mask = 0;
+        for(unsigned int i = 0; i < sunShadowmapSplits; ++i)
+        {
+            glm::mat3 A(sunShadowCPM[i]);
+            glm::vec3 cc = glm::vec3(sunShadowCPM[i] * glm::vec4(c, 1.f));
+            glm::vec3 ee = glm::abs(A[0]) * e.x + glm::abs(A[1]) * e.y + glm::abs(A[2]) * e.z;
+            if(cc.x - ee.x <= 1.f && cc.x + ee.x >= -1.f && cc.y - ee.y <= 1.f && cc.y + ee.y >= -1.f)
+                mask |= (1u << i);
+        }
+        if(mask == 0)
+            continue;
+
+        sunShadowCasterShader->SetUniform("M", objects[h].model);
+        sunShadowCasterShader->SetUniform("cascadeMask", mask);
+        content->DrawObject(objects[h].objectId, -1, objects[h].model);
+    }
+    OpenGLState::UseProgram(0);
     OpenGLState::BindFramebuffer(0);
 
     glEnable(GL_DEPTH_CLAMP);
     glCullFace(GL_BACK);
+
+    sunShadowValid = true;
+    sunShadowVersion = pipe->getDrawingQueueVersion();
+    sunShadowSunDir = sunDirection;
+    sunShadowFar = sunShadowFrustum[sunShadowmapSplits-1].far;
+    ++sunShadowBakes;
+}
+
+bool OpenGLAtmosphere::ShadowmapsCoverView(OpenGLPipeline* pipe, OpenGLView* view)
+{
+    //Casters or sun moved
+    if(!sunShadowValid || sunShadowVersion != pipe->getDrawingQueueVersion() || sunShadowSunDir != sunDirection)
+        return false;
+
+    //Only share between views with similar range, to keep the resolution
+    GLfloat far = view->GetFarClip() > 250.f ? 250.f : view->GetFarClip();
+    if(fabsf(far - sunShadowFar) > 0.25f * sunShadowFar)
+        return false;
+
+    //All frustum slices of the view have to lie within the crop of the respective cascade
+    ViewFrustum f;
+    f.fov = view->GetFOVY();
+    GLint* viewport = view->GetViewport();
+    f.ratio = (GLfloat)viewport[2]/(GLfloat)viewport[3];
+    delete [] viewport;
+    
+    for(unsigned int i = 0; i < sunShadowmapSplits; ++i)
+    {
+        f.near = sunShadowFrustum[i].near;
+        f.far = sunShadowFrustum[i].far > far ? far : sunShadowFrustum[i].far;
+        if(f.near >= f.far)
+            break;
+        UpdateFrustumCorners(f, view->GetEyePosition(), view->GetLookingDirection(), view->GetUpDirection());
+        for(unsigned int h = 0; h < 8; ++h)
+        {
+            glm::vec4 p = sunShadowCPM[i] * glm::vec4(f.corners[h], 1.f);
+            if(fabsf(p.x) > 1.f || fabsf(p.y) > 1.f)
+                return false;
+        }
+    }
+    return true;
+}
+
+void OpenGLAtmosphere::getShadowmapStats(unsigned long& baked, unsigned long& reused) const
+{
+    baked = sunShadowBakes;
+    reused = sunShadowReuses;
 }
 
 void OpenGLAtmosphere::UpdateSkyEmissivity()
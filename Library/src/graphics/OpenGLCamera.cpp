@@ -48,6 +48,8 @@ GLSLShader* OpenGLCamera::fxaaShader = nullptr;
 GLSLShader* OpenGLCamera::flipShader = nullptr;
 GLSLShader* OpenGLCamera::ssrBlur = nullptr;
 GLSLShader* OpenGLCamera::bloomBlur = nullptr;
+GLSLShader* OpenGLCamera::hiZShader = nullptr;
+GLSLShader* OpenGLCamera::occlusionCullShader = nullptr;
 
 OpenGLCamera::OpenGLCamera(GLint x, GLint y, GLint width, GLint height, glm::vec2 range) : OpenGLView(x, y, width, height)
 {
@@ -64,6 +66,7 @@ OpenGLCamera::OpenGLCamera(GLint x, GLint y, GLint width, GLint height, glm::vec
         aoFactor = 1;
     if(((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getRenderSettings().aa != RenderQuality::DISABLED)
         antiAliasing = true;
+    occlusionCulling = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getRenderSettings().occlusionCulling;
     
     //----Geometry rendering----
     renderColorTex[0] = OpenGLContent::GenerateTexture(GL_TEXTURE_2D, glm::uvec3(viewportWidth, viewportHeight, 0), 
@@ -213,6 +216,42 @@ OpenGLCamera::OpenGLCamera(GLint x, GLint y, GLint width, GLint height, glm::vec
             aoData.float2Offsets[i] = glm::vec4((GLfloat)(i%4) + 0.5f, (GLfloat)(i/4) + 0.5f, 0.0, 0.0);
         }
     }
+
+    //----Occlusion culling----
+    hiZTex = 0;
+    hiZLevels = 0;
+    hiZSize = glm::ivec2(0);
+    hiZViewProjection = glm::mat4(1.f);
+    hiZValid = false;
+    cullBoundsSSBO = 0;
+    cullCommandsBuffer = 0;
+    cullCounterSSBO = 0;
+    cullPending = false;
+    memset(&pendingStats, 0, sizeof(CullingStats));
+    memset(&cullingStats, 0, sizeof(CullingStats));
+    
+    if(occlusionCulling)
+    {
+        //Hierarchical depth (max) pyramid starting at half resolution
+        hiZSize = glm::max(glm::ivec2(viewportWidth/2, viewportHeight/2), glm::ivec2(1));
+        hiZLevels = 1 + (GLuint)floorf(log2f((GLfloat)glm::max(hiZSize.x, hiZSize.y)));
+        glGenTextures(1, &hiZTex);
+        OpenGLState::BindTexture(TEX_BASE, GL_TEXTURE_2D, hiZTex);
+        glTexStorage2D(GL_TEXTURE_2D, hiZLevels, GL_R32F, hiZSize.x, hiZSize.y);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        OpenGLState::UnbindTexture(TEX_BASE);
+        
+        GLuint zero = 0;
+        glGenBuffers(1, &cullBoundsSSBO);
+        glGenBuffers(1, &cullCommandsBuffer);
+        glGenBuffers(1, &cullCounterSSBO);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, cullCounterSSBO);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), &zero, GL_DYNAMIC_READ);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
 }
 
 OpenGLCamera::~OpenGLCamera()
@@ -246,6 +285,14 @@ OpenGLCamera::~OpenGLCamera()
         
         glDeleteBuffers(1, &aoDataUBO);
     }
+
+    if(occlusionCulling)
+    {
+        glDeleteTextures(1, &hiZTex);
+        glDeleteBuffers(1, &cullBoundsSSBO);
+        glDeleteBuffers(1, &cullCommandsBuffer);
+        glDeleteBuffers(1, &cullCounterSSBO);
+    }
 }
 
 glm::mat4 OpenGLCamera::GetProjectionMatrix() const
@@ -379,6 +426,168 @@ bool OpenGLCamera::hasAO()
     return aoFactor > 0;
 }
 
+bool OpenGLCamera::usingOcclusionCulling()
+{
+    return occlusionCulling;
+}
+
+glm::mat4 OpenGLCamera::GetCullingViewProjection() const
+{
+    return GetProjectionMatrix() * GetViewMatrix();
+}
+
+GLint OpenGLCamera::getDrawCommand(size_t index) const
+{
+    return index < drawCommands.size() ? drawCommands[index] : -1;
+}
+
+CullingStats OpenGLCamera::getCullingStats() const
+{
+    return cullingStats;
+}
+
+void OpenGLCamera::CullObjects(const std::vector<Renderable>& objects)
+{
+    OpenGLContent* content = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent();
+
+    //Collect occlusion results of the previous frame (long finished, so reading does not stall)
+    if(cullPending)
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, cullCounterSSBO);
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &pendingStats.occlusionCulled);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        cullingStats = pendingStats;
+        cullingStats.drawn = cullingStats.submitted - cullingStats.frustumCulled - cullingStats.occlusionCulled;
+        cullPending = false;
+    }
+    
+    //Frustum culling of world-space bounding boxes
+    glm::vec4 frustum[6];
+    ExtractFrustumFromVP(frustum, GetCullingViewProjection());
+    bool occlusion = occlusionCulling && hiZValid;
+    std::vector<glm::vec4> bounds;
+    std::vector<DrawElementsIndirectCommand> commands;
+    drawCommands.assign(objects.size(), -2);
+    memset(&pendingStats, 0, sizeof(CullingStats));
+
+    for(size_t i=0; i<objects.size(); ++i)
+    {
+        if(objects[i].type != RenderableType::SOLID 
+           || objects[i].objectId < 0 || objects[i].objectId >= (int)content->getObjectsCount())
+            continue;
+
+        const Object& obj = content->getObject(objects[i].objectId);
+        glm::mat3 R(objects[i].model);
+        glm::vec3 h = (obj.aabbMax - obj.aabbMin) * 0.5f;
+        glm::vec3 c = glm::vec3(objects[i].model * glm::vec4((obj.aabbMin + obj.aabbMax) * 0.5f, 1.f));
+        glm::vec3 e = glm::abs(R[0]) * h.x + glm::abs(R[1]) * h.y + glm::abs(R[2]) * h.z;
+        ++pendingStats.submitted;
+        
+        bool inside = true;
+        for(short p=0; p<6; ++p)
+        {
+            glm::vec3 n(frustum[p]);
+            if(glm::dot(n, c) + glm::dot(glm::abs(n), e) + frustum[p].w < 0.f)
+            {
+                inside = false;
+                break;
+            }
+        }
+        if(!inside)
+        {
+            ++pendingStats.frustumCulled;
+            continue;
+        }
+        
+        if(occlusion && obj.vboInstance == 0) //Instanced objects are only frustum culled as a group
+        {
+            DrawElementsIndirectCommand cmd;
+            cmd.count = (GLuint)obj.faceCount * 3;
+            cmd.instanceCount = 1;
+            cmd.firstIndex = 0;
+            cmd.baseVertex = 0;
+            cmd.baseInstance = 0;
+            drawCommands[i] = (GLint)commands.size();
+            commands.push_back(cmd);
+            bounds.push_back(glm::vec4(c - e, 0.f));
+            bounds.push_back(glm::vec4(c + e, 0.f));
+        }
+        else
+            drawCommands[i] = -1;
+    }
+
+    if(commands.size() == 0)
+    {
+        cullingStats = pendingStats;
+        cullingStats.drawn = cullingStats.submitted - cullingStats.frustumCulled;
+        return;
+    }
+    
+    //Occlusion test against the depth pyramid of the previous frame
+    GLuint zero = 0;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, cullBoundsSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, bounds.size() * sizeof(glm::vec4), &bounds[0], GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, cullCommandsBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, commands.size() * sizeof(DrawElementsIndirectCommand), &commands[0], GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, cullCounterSSBO);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &zero);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_CULL_BOUNDS, cullBoundsSSBO);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_CULL_COMMANDS, cullCommandsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_CULL_COUNTER, cullCounterSSBO);
+    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, hiZTex);
+    occlusionCullShader->Use();
+    occlusionCullShader->SetUniform("VP", hiZViewProjection);
+    occlusionCullShader->SetUniform("FC", GetLogDepthConstant());
+    occlusionCullShader->SetUniform("hiZSize", hiZSize);
+    occlusionCullShader->SetUniform("hiZLevels", (GLint)hiZLevels);
+    occlusionCullShader->SetUniform("numObjects", (GLuint)commands.size());
+    occlusionCullShader->SetUniform("texHiZ", TEX_POSTPROCESS1);
+    glDispatchCompute((GLuint)ceilf(commands.size()/64.f), 1, 1);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+    OpenGLState::UseProgram(0);
+    cullPending = true;
+}
+
+void OpenGLCamera::BindDrawCommands()
+{
+    if(occlusionCulling)
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, cullCommandsBuffer);
+}
+
+void OpenGLCamera::BuildHiZ()
+{
+    if(!occlusionCulling)
+        return;
+
+    glm::ivec2 srcSize(viewportWidth, viewportHeight);
+    glm::ivec2 dstSize = hiZSize;
+    hiZShader->Use();
+    hiZShader->SetUniform("texSource", TEX_POSTPROCESS1);
+    hiZShader->SetUniform("imgDest", TEX_POSTPROCESS2);
+    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderDepthStencilTex);
+    
+    for(GLuint i=0; i<hiZLevels; ++i)
+    {
+        if(i == 1)
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, hiZTex);
+        hiZShader->SetUniform("srcLevel", i == 0 ? 0 : (GLint)i-1);
+        hiZShader->SetUniform("srcSize", srcSize);
+        glBindImageTexture(TEX_POSTPROCESS2, hiZTex, i, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((GLuint)ceilf(dstSize.x/16.f), (GLuint)ceilf(dstSize.y/16.f), 1);
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+        srcSize = dstSize;
+        dstSize = glm::max(dstSize/2, glm::ivec2(1));
+    }
+    
+    OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+    OpenGLState::UseProgram(0);
+    hiZViewProjection = GetProjectionMatrix() * GetViewMatrix();
+    hiZValid = true;
+}
+
 bool OpenGLCamera::usingToneMapping()
 {
 	return toneMapping;
@@ -945,6 +1154,31 @@ void OpenGLCamera::Init(const RenderSettings& rSettings)
     //Real camera
     flipShader = new GLSLShader("verticalFlip.frag");
     flipShader->AddUniform("texSource", ParameterType::INT);
+
+    //Occlusion culling
+    if(rSettings.occlusionCulling)
+    {
+        sources.clear();
+        sources.push_back(GLSLSource(GL_COMPUTE_SHADER, "hiZ.comp"));
+        hiZShader = new GLSLShader(sources);
+        hiZShader->AddUniform("texSource", ParameterType::INT);
+        hiZShader->AddUniform("imgDest", ParameterType::INT);
+        hiZShader->AddUniform("srcLevel", ParameterType::INT);
+        hiZShader->AddUniform("srcSize", ParameterType::IVEC2);
+
+        sources.clear();
+        sources.push_back(GLSLSource(GL_COMPUTE_SHADER, "occlusionCull.comp"));
+        occlusionCullShader = new GLSLShader(sources);
+        occlusionCullShader->AddUniform("VP", ParameterType::MAT4);
+        occlusionCullShader->AddUniform("FC", ParameterType::FLOAT);
+        occlusionCullShader->AddUniform("hiZSize", ParameterType::IVEC2);
+        occlusionCullShader->AddUniform("hiZLevels", ParameterType::INT);
+        occlusionCullShader->AddUniform("numObjects", ParameterType::UINT);
+        occlusionCullShader->AddUniform("texHiZ", ParameterType::INT);
+        occlusionCullShader->BindShaderStorageBlock("CullBounds", SSBO_CULL_BOUNDS);
+        occlusionCullShader->BindShaderStorageBlock("CullCommands", SSBO_CULL_COMMANDS);
+        occlusionCullShader->BindShaderStorageBlock("CullCounter", SSBO_CULL_COUNTER);
+    }
 }
 
 void OpenGLCamera::Destroy()
@@ -970,6 +1204,8 @@ void OpenGLCamera::Destroy()
     if(fxaaShader != nullptr) delete fxaaShader;
     if(flipShader != nullptr) delete flipShader;
     if(ssrBlur != nullptr) delete ssrBlur;
+    if(hiZShader != nullptr) delete hiZShader;
+    if(occlusionCullShader != nullptr) delete occlusionCullShader;
 }
 
 }
\ No newline at end of file
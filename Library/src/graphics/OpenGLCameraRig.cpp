@@ -0,0 +1,312 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLCameraRig.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "graphics/OpenGLCameraRig.h"
+
+#include "core/GraphicalSimulationApp.h"
+#include "sensors/vision/CameraRig.h"
+#include "graphics/OpenGLState.h"
+#include "graphics/GLSLShader.h"
+#include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLContent.h"
+
+namespace sf
+{
+
+OpenGLCameraRig::OpenGLCameraRig(unsigned int eyes, GLint x, GLint y, GLint width, GLint height,
+                                 GLfloat horizontalFovDeg, glm::vec2 range, bool continuousUpdate)
+                                 : OpenGLCamera(x, y, width, height, range)
+{
+    _needsUpdate = false;
+    newData = false;
+    continuous = continuousUpdate;
+    camera = nullptr;
+    rigFBO = 0;
+    rigColorArrayTex = 0;
+    rigPBO = 0;
+    activeEye = 0;
+    sharedCulling = false;
+    rigCullingVP = glm::mat4(1.f);
+    
+    //The depth pyramid is built from the last rendered camera, so it cannot be used to cull for the others
+    if(occlusionCulling)
+    {
+        glDeleteTextures(1, &hiZTex);
+        glDeleteBuffers(1, &cullBoundsSSBO);
+        glDeleteBuffers(1, &cullCommandsBuffer);
+        glDeleteBuffers(1, &cullCounterSSBO);
+        occlusionCulling = false;
+    }
+    
+    //Setup views
+    eyes = eyes > 0 ? eyes : 1;
+    eye.resize(eyes, glm::vec3(0.f));
+    dir.resize(eyes, glm::vec3(0.f,0.f,1.f));
+    up.resize(eyes, glm::vec3(0.f,-1.f,0.f));
+    tempEye = eye;
+    tempDir = dir;
+    tempUp = up;
+    eyeTransform.resize(eyes, glm::mat4(1.f));
+    //Setup projection (common for all cameras)
+    fovx = horizontalFovDeg/180.f * M_PI;
+    GLfloat fovy = 2.f * atanf( (GLfloat)viewportHeight/(GLfloat)viewportWidth * tanf(fovx/2.f) );
+    projection = glm::perspectiveFov(fovy, (GLfloat)viewportWidth, (GLfloat)viewportHeight, near, far);
+
+    UpdateTransform();
+}
+
+OpenGLCameraRig::~OpenGLCameraRig()
+{
+    if(camera != nullptr)
+    {
+        glDeleteFramebuffers(1, &rigFBO);
+        glDeleteBuffers(1, &rigPBO);
+        glDeleteTextures((GLsizei)eyeColorTex.size(), &eyeColorTex[0]);
+        glDeleteTextures(1, &rigColorArrayTex);
+    }
+}
+
+ViewType OpenGLCameraRig::getType() const
+{
+    return ViewType::CAMERA_RIG;
+}
+
+unsigned int OpenGLCameraRig::getNumOfEyes() const
+{
+    return (unsigned int)eye.size();
+}
+
+void OpenGLCameraRig::Update()
+{
+    _needsUpdate = true;
+}
+
+bool OpenGLCameraRig::needsUpdate()
+{
+    if(_needsUpdate)
+    {
+        _needsUpdate = false;
+        return enabled;
+    }
+    else
+        return false;
+}
+
+void OpenGLCameraRig::setCameraRig(CameraRig* rig)
+{
+    //Connect with camera rig sensor
+    camera = rig;
+    
+    //Generate buffers: one texture per camera for display and one layered texture holding the flipped images of all cameras
+    GLuint eyes = getNumOfEyes();
+    eyeColorTex.resize(eyes);
+    for(GLuint i=0; i<eyes; ++i)
+        eyeColorTex[i] = OpenGLContent::GenerateTexture(GL_TEXTURE_2D, glm::uvec3((GLuint)viewportWidth, (GLuint)viewportHeight, 0), 
+                                                        GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, NULL, sf::FilteringMode::NEAREST, false);
+    rigColorArrayTex = OpenGLContent::GenerateTexture(GL_TEXTURE_2D_ARRAY, glm::uvec3((GLuint)viewportWidth, (GLuint)viewportHeight, eyes), 
+                                                      GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, NULL, sf::FilteringMode::NEAREST, false);
+    std::vector<FBOTexture> textures;
+    textures.push_back(FBOTexture(GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, eyeColorTex[0]));
+    rigFBO = OpenGLContent::GenerateFramebuffer(textures);
+    OpenGLState::BindFramebuffer(rigFBO);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, rigColorArrayTex, 0, 0);
+    OpenGLState::BindFramebuffer(0);
+    
+    //Single buffer for the combined readback of all cameras
+    glGenBuffers(1, &rigPBO);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, rigPBO);
+    glBufferData(GL_PIXEL_PACK_BUFFER, viewportWidth * viewportHeight * 3 * eyes, 0, GL_STREAM_READ);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void OpenGLCameraRig::SetupEye(unsigned int i, glm::vec3 _eye, glm::vec3 _dir, glm::vec3 _up)
+{
+    if(i >= getNumOfEyes())
+        return;
+    tempEye[i] = _eye;
+    tempDir[i] = _dir;
+    tempUp[i] = _up;
+}
+
+void OpenGLCameraRig::setActiveEye(unsigned int i)
+{
+    activeEye = i < getNumOfEyes() ? i : 0;
+    viewUBOData.VP = GetProjectionMatrix() * GetViewMatrix();
+    viewUBOData.eye = GetEyePosition();
+    ExtractFrustumFromVP(viewUBOData.frustum, viewUBOData.VP);
+}
+
+void OpenGLCameraRig::UpdateTransform()
+{
+    eye = tempEye;
+    dir = tempDir;
+    up = tempUp;
+    for(size_t i=0; i<eye.size(); ++i)
+        eyeTransform[i] = glm::lookAt(eye[i], eye[i]+dir[i], up[i]);
+    
+    //Cameras looking in the same direction are culled together, with a frustum moved back along the optical axis
+    //until it encloses the frusta of all cameras (same field of view, so all of them fit inside)
+    sharedCulling = eye.size() > 1;
+    for(size_t i=1; i<eye.size() && sharedCulling; ++i)
+        sharedCulling = glm::dot(dir[i], dir[0]) > 0.9999f && glm::dot(up[i], up[0]) > 0.9999f;
+    
+    if(sharedCulling)
+    {
+        glm::vec3 right = glm::normalize(glm::cross(dir[0], up[0]));
+        glm::vec3 centre(0.f);
+        for(size_t i=0; i<eye.size(); ++i)
+            centre += eye[i];
+        centre /= (GLfloat)eye.size();
+        
+        GLfloat tanX = tanf(GetFOVX()/2.f);
+        GLfloat tanY = (GLfloat)viewportHeight/(GLfloat)viewportWidth * tanX;
+        GLfloat apex = 0.f;
+        GLfloat front = 0.f;
+        for(size_t i=0; i<eye.size(); ++i)
+        {
+            glm::vec3 d = eye[i] - centre;
+            GLfloat z = glm::dot(d, dir[0]);
+            GLfloat setback = glm::max(fabsf(glm::dot(d, right))/tanX, fabsf(glm::dot(d, up[0]))/tanY);
+            apex = i == 0 ? z - setback : glm::min(apex, z - setback);
+            front = i == 0 ? z : glm::max(front, z);
+        }
+        
+        GLfloat fovy = 2.f * atanf(tanY);
+        glm::vec3 rigEye = centre + apex * dir[0];
+        rigCullingVP = glm::perspectiveFov(fovy, (GLfloat)viewportWidth, (GLfloat)viewportHeight, near, far + front - apex)
+                       * glm::lookAt(rigEye, rigEye + dir[0], up[0]);
+    }
+    
+    setActiveEye(0);
+
+    //Inform rig to run callback with images of all cameras
+    if(newData)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, rigPBO);
+        GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+        if(src)
+        {
+            camera->NewDataReady(src);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        newData = false;
+    }
+}
+
+void OpenGLCameraRig::CullObjects(const std::vector<Renderable>& objects)
+{
+    if(sharedCulling && activeEye > 0) //Results of the first camera are valid for the whole rig
+        return;
+    OpenGLCamera::CullObjects(objects);
+}
+
+glm::mat4 OpenGLCameraRig::GetCullingViewProjection() const
+{
+    return sharedCulling ? rigCullingVP : OpenGLCamera::GetCullingViewProjection();
+}
+
+glm::mat4 OpenGLCameraRig::GetViewMatrix() const
+{
+    return eyeTransform[activeEye];
+}
+
+glm::vec3 OpenGLCameraRig::GetEyePosition() const
+{
+    return eye[activeEye];
+}
+
+glm::vec3 OpenGLCameraRig::GetLookingDirection() const
+{
+    return dir[activeEye];
+}
+
+glm::vec3 OpenGLCameraRig::GetUpDirection() const
+{
+    return up[activeEye];
+}
+
+void OpenGLCameraRig::DrawLDR(GLuint destinationFBO, bool updated)
+{
+    bool lastEye = activeEye == getNumOfEyes()-1;
+
+    if(camera != nullptr && updated)
+    {
+        //Tone map to the texture of the active camera and flip to its layer
+        OpenGLState::BindFramebuffer(rigFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, eyeColorTex[activeEye], 0);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, rigColorArrayTex, 0, activeEye);
+        OpenGLCamera::DrawLDR(rigFBO, updated);
+
+        OpenGLState::BindFramebuffer(rigFBO);
+        OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
+        glDrawBuffer(GL_COLOR_ATTACHMENT1);
+        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, eyeColorTex[activeEye]);
+        flipShader->Use();
+        flipShader->SetUniform("texSource", TEX_POSTPROCESS1);
+        ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawSAQ();
+        OpenGLState::UseProgram(0);
+        OpenGLState::BindFramebuffer(0);
+        OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+
+        //One transfer for all layers, once the last camera is rendered
+        if(lastEye)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D_ARRAY, rigColorArrayTex);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, rigPBO);
+            glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+            newData = true;
+        }
+    }
+    
+    //Display images of all cameras side by side, once per frame
+    if(updated && !lastEye)
+        return;
+    
+    bool display = true;
+    unsigned int dispX, dispY;
+    GLfloat dispScale;
+    if(camera != nullptr)
+        display = camera->getDisplayOnScreen(dispX, dispY, dispScale);
+    
+    if(display)
+    {
+        OpenGLContent* content = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent();
+        int windowHeight = ((GraphicalSimulationApp*)SimulationApp::getApp())->getWindowHeight();
+        int windowWidth = ((GraphicalSimulationApp*)SimulationApp::getApp())->getWindowWidth();
+        OpenGLState::BindFramebuffer(destinationFBO);
+        OpenGLState::DisableCullFace();
+        OpenGLState::Viewport(0, 0, windowWidth, windowHeight);
+        content->SetViewportSize(windowWidth, windowHeight);
+        for(size_t i=0; i<eyeColorTex.size(); ++i)
+            content->DrawTexturedQuad(dispX + i*viewportWidth*dispScale, dispY, viewportWidth*dispScale, viewportHeight*dispScale, eyeColorTex[i]);
+        OpenGLState::EnableCullFace();
+        OpenGLState::BindFramebuffer(0);
+    }
+}
+
+}
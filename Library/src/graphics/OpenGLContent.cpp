@@ -27,6 +27,7 @@
 
 #include <map>
 #include <algorithm>
+#include <cmath>
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLState.h"
@@ -52,12 +53,22 @@
 namespace sf
 {
 
+bool OpenGLContent::meshCaching = false;
+std::map<std::string, Mesh*> OpenGLContent::meshCache;
+
 OpenGLContent::OpenGLContent()
 {
     //Initialize members
     baseVertexArray = 0;
     cubeBuf = 0;
     lightsUBO = 0;
+    pointLightsSSBO = 0;
+    spotLightsSSBO = 0;
+    lightClustersSSBO = 0;
+    lightClustersReadback = 0;
+    lightClustersFence = 0;
+    lightClustersOverflow = false;
+    lightClusterShader = NULL;
     csBuf[0] = 0;
     csBuf[1] = 0;
     cylinder.vao = 0;
@@ -81,6 +92,7 @@ OpenGLContent::OpenGLContent()
 
     //Initialize shaders and buffers
     glGenVertexArrays(1, &baseVertexArray);
+    ResetInstanceAttributes();
      
     //Build cube croos VBO
     GLfloat cubeData[24][5] = {{-1.f,  0.333f, -1.f, 1.f, 1.f}, //LEFT
@@ -188,6 +200,27 @@ OpenGLContent::OpenGLContent()
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
     glBindBufferRange(GL_UNIFORM_BUFFER, UBO_LIGHTS, lightsUBO, 0, sizeof(LightsUBO));
     memset(&lightsUBOData, 0, sizeof(LightsUBO));
+    lightsUBOData.clusterGrid = glm::ivec4(LIGHT_CLUSTERS_X, LIGHT_CLUSTERS_Y, LIGHT_CLUSTERS_Z, MAX_CLUSTER_LIGHTS);
+
+    //Generate light SSBOs (light data buffers are reallocated in SetupLights)
+    glGenBuffers(1, &pointLightsSSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, pointLightsSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(PointLightUBO), NULL, GL_STREAM_DRAW);
+    glGenBuffers(1, &spotLightsSSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, spotLightsSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(SpotLightUBO), NULL, GL_STREAM_DRAW);
+    glGenBuffers(1, &lightClustersSSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, lightClustersSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * (LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z * (MAX_CLUSTER_LIGHTS + 2) + 1), NULL, GL_DYNAMIC_COPY); //Last element counts overflowing clusters
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glGenBuffers(1, &lightClustersReadback);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, lightClustersReadback);
+    glBufferData(GL_COPY_WRITE_BUFFER, sizeof(GLuint), NULL, GL_STREAM_READ);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_POINT_LIGHTS, pointLightsSSBO);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_SPOT_LIGHTS, spotLightsSSBO);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_LIGHT_CLUSTERS, lightClustersSSBO);
 
     ViewUBO viewZero;
     viewZero.eye = glm::vec4(0.f);
@@ -294,6 +327,7 @@ OpenGLContent::OpenGLContent()
         ms.shaders[2]->AddUniform("bWater", ParameterType::VEC3);
         ms.shaders[2]->AddUniform("texWaveFFT", ParameterType::INT);
         ms.shaders[2]->AddUniform("gridSizes", ParameterType::VEC4);
+        ms.shaders[2]->AddUniform("waveOrigin", ParameterType::VEC2);
         
         //Textured
         precompiled.clear();
@@ -341,6 +375,7 @@ OpenGLContent::OpenGLContent()
         ms.shaders[6]->AddUniform("bWater", ParameterType::VEC3);
         ms.shaders[6]->AddUniform("texWaveFFT", ParameterType::INT);
         ms.shaders[6]->AddUniform("gridSizes", ParameterType::VEC4);
+        ms.shaders[6]->AddUniform("waveOrigin", ParameterType::VEC2);
 
         //Add common uniforms
         for(size_t h = 0; h<ms.shaders.size(); ++h)
@@ -473,6 +508,16 @@ OpenGLContent::OpenGLContent()
         lightSourceShader[i]->SetUniform("irradiance_texture", TEX_ATM_IRRADIANCE);
     }
 
+    //Light clustering shader
+    sources.clear();
+    sources.push_back(GLSLSource(GL_COMPUTE_SHADER, "lightClusters.comp", 
+                      "#version 430\n#define LIGHT_CUTOFF_LUMINANCE " + std::to_string(LIGHT_CUTOFF_LUMINANCE) + "\n"));
+    lightClusterShader = new GLSLShader(sources);
+    lightClusterShader->AddUniform("invP", ParameterType::MAT4);
+    lightClusterShader->AddUniform("V", ParameterType::MAT4);
+    lightClusterShader->AddUniform("depthRange", ParameterType::VEC2);
+    lightClusterShader->BindUniformBlock("Lights", UBO_LIGHTS);
+
     OpenGLState::UseProgram(0);
 
     glDeleteShader(pcssFragment);
@@ -487,6 +532,11 @@ OpenGLContent::~OpenGLContent()
     if(cubeBuf != 0) glDeleteBuffers(1, &cubeBuf);
     if(csBuf[0] != 0) glDeleteBuffers(2, csBuf);
     if(lightsUBO != 0) glDeleteBuffers(1, &lightsUBO);
+    if(pointLightsSSBO != 0) glDeleteBuffers(1, &pointLightsSSBO);
+    if(spotLightsSSBO != 0) glDeleteBuffers(1, &spotLightsSSBO);
+    if(lightClustersSSBO != 0) glDeleteBuffers(1, &lightClustersSSBO);
+    if(lightClustersReadback != 0) glDeleteBuffers(1, &lightClustersReadback);
+    if(lightClustersFence != 0) glDeleteSync(lightClustersFence);
     if(viewUBO != 0) glDeleteBuffers(1, &viewUBO);
     delete basicShaders["helper"];
     delete basicShaders["tex_saq"];
@@ -498,6 +548,7 @@ OpenGLContent::~OpenGLContent()
     delete basicShaders["shadow"];
     if(lightSourceShader[0] != NULL) delete lightSourceShader[0];
     if(lightSourceShader[1] != NULL) delete lightSourceShader[1];
+    if(lightClusterShader != NULL) delete lightClusterShader;
     
     //Material shaders
     for(size_t i=0; i<materialShaders.size(); ++i)
@@ -538,9 +589,15 @@ void OpenGLContent::DestroyContent()
     {
         glDeleteBuffers(1, &objects[i].vboVertex);
         glDeleteBuffers(1, &objects[i].vboIndex);
+        if(objects[i].vboInstance != 0) glDeleteBuffers(1, &objects[i].vboInstance);
         glDeleteVertexArrays(1, &objects[i].vao);
     }	
     objects.clear();
+    scheduledObjects.clear();
+
+    for(auto it=helperGeometry.begin(); it!=helperGeometry.end(); ++it)
+        glDeleteBuffers(1, &it->second.vbo);
+    helperGeometry.clear();
 
     for(size_t i=0; i<views.size(); ++i)
 		delete views[i];
@@ -587,6 +644,74 @@ void OpenGLContent::SetCurrentView(OpenGLView* v)
     glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ViewUBO), v->getViewUBOData());
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
     glMemoryBarrier(GL_UNIFORM_BARRIER_BIT);
+
+    BuildLightClusters(v);
+}
+
+void OpenGLContent::BuildLightClusters(OpenGLView* v)
+{
+    //Clustering volume spans the near-far range of the view (exponential depth slices)
+    glm::mat4 invProjection = glm::inverse(projection);
+    glm::vec4 n = invProjection * glm::vec4(0.f, 0.f, -1.f, 1.f);
+    glm::vec4 f = invProjection * glm::vec4(0.f, 0.f, 1.f, 1.f);
+    GLfloat zNear = glm::max(-n.z/n.w, 0.001f);
+    GLfloat zFar = -f.z/f.w;
+    if(!std::isfinite(zFar) || zFar <= zNear)
+        zFar = zNear * 1e6f;
+    GLfloat depthScale = (GLfloat)LIGHT_CLUSTERS_Z/logf(zFar/zNear);
+    
+    GLint* viewport = v->GetViewport();
+    glm::mat4 invView = glm::inverse(view);
+    lightsUBOData.clusterEye = invView[3];
+    lightsUBOData.clusterDir = -invView[2];
+    lightsUBOData.clusterDepth = glm::vec4(depthScale, -depthScale * logf(zNear), 1.f/(GLfloat)viewport[2], 1.f/(GLfloat)viewport[3]);
+    delete [] viewport;
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, lightsUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightsUBO), &lightsUBOData);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    //Check if any cluster overflowed in an earlier build (the counter is read only when its copy is ready, never stalling)
+    if(lightClustersFence != 0)
+    {
+        GLenum status = glClientWaitSync(lightClustersFence, 0, 0);
+        if(status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        {
+            glDeleteSync(lightClustersFence);
+            lightClustersFence = 0;
+            GLuint overflow = 0;
+            glBindBuffer(GL_COPY_READ_BUFFER, lightClustersReadback);
+            glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(GLuint), &overflow);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            if(overflow > 0 && !lightClustersOverflow)
+                cWarning("More than %d lights affect a single light cluster - excess lights are not rendered there (spot lights first)!", MAX_CLUSTER_LIGHTS);
+            lightClustersOverflow = overflow > 0; //Warn again if the overflow disappears and comes back
+        }
+    }
+    
+    //Bin lights into clusters (overflow counted from zero in each build)
+    GLintptr overflowOffset = sizeof(GLuint) * LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z * (MAX_CLUSTER_LIGHTS + 2);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, lightClustersSSBO);
+    glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, overflowOffset, sizeof(GLuint), GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    lightClusterShader->Use();
+    lightClusterShader->SetUniform("invP", invProjection);
+    lightClusterShader->SetUniform("V", view);
+    lightClusterShader->SetUniform("depthRange", glm::vec2(zNear, zFar));
+    glDispatchCompute((GLuint)ceilf(LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z/64.f), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    OpenGLState::UseProgram(0);
+    
+    //Copy the counter on the GPU and fence it, if the previous copy was already read
+    if(lightClustersFence == 0)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, lightClustersSSBO);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, lightClustersReadback);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, overflowOffset, 0, sizeof(GLuint));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        lightClustersFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
 }
 
 void OpenGLContent::SetDrawingMode(DrawingMode m)
@@ -790,28 +915,151 @@ void OpenGLContent::DrawPrimitives(PrimitiveType type, std::vector<glm::vec3>& v
     glDeleteBuffers(1, &vbo);
 }
 
-void OpenGLContent::DrawObject(int objectId, int lookId, const glm::mat4& M)
+void OpenGLContent::UpdateHelperGeometry(int id, PrimitiveType type, const std::vector<glm::vec3>& vertices)
 {
-    if(objectId < 0 || objectId >= (int)objects.size())
+    auto it = helperGeometry.find(id);
+    if(it == helperGeometry.end())
+    {
+        HelperGeometry geom;
+        glGenBuffers(1, &geom.vbo);
+        it = helperGeometry.insert(std::make_pair(id, geom)).first;
+    }
+    it->second.type = type;
+    it->second.vertexCount = (GLsizei)vertices.size();
+    
+    glBindBuffer(GL_ARRAY_BUFFER, it->second.vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3)*vertices.size(), vertices.size() > 0 ? &vertices[0].x : NULL, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void OpenGLContent::UpdateInstances(int objectId, const std::vector<glm::vec3>& instances)
+{
+    if(objectId < 0 || objectId >= (int)objects.size() || objects[objectId].vao == 0)
         return;
     
-    switch(mode)
+    Object& obj = objects[objectId];
+    if(obj.vboInstance == 0) //Attach per-instance transforms to the vertex array (locations 4-7)
     {
-        case DrawingMode::RAW:
+        glGenBuffers(1, &obj.vboInstance);
+        OpenGLState::BindVertexArray(obj.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, obj.vboInstance);
+        for(GLuint i=0; i<4; ++i)
         {
-            OpenGLState::BindVertexArray(objects[objectId].vao);
-            glDrawElements(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
-            OpenGLState::BindVertexArray(0);
+            glEnableVertexAttribArray(4 + i);
+            glVertexAttribPointer(4 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * i));
+            glVertexAttribDivisor(4 + i, 1);
         }
-        break;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        OpenGLState::BindVertexArray(0);
+        obj.instanceAabbMin = obj.aabbMin; //Bounds of a single instance
+        obj.instanceAabbMax = obj.aabbMax;
+    }
+    
+    //Build transforms aligning the x axis of the object with the forward direction (z axis pointing down)
+    std::vector<glm::mat4> transforms(instances.size()/2);
+    glm::vec3 r = glm::max(glm::abs(obj.instanceAabbMin), glm::abs(obj.instanceAabbMax));
+    GLfloat radius = glm::length(r);
+    obj.aabbMin = glm::vec3(0.f);
+    obj.aabbMax = glm::vec3(0.f);
+    
+    for(size_t i=0; i<transforms.size(); ++i)
+    {
+        glm::vec3 p = instances[2*i];
+        glm::vec3 x = instances[2*i+1];
+        glm::vec3 y = glm::cross(glm::vec3(0.f,0.f,1.f), x);
+        if(glm::dot(y, y) < 1e-6f)
+            y = glm::vec3(0.f,1.f,0.f);
+        y = glm::normalize(y);
+        glm::vec3 z = glm::cross(x, y);
+        transforms[i] = glm::mat4(glm::vec4(x, 0.f), glm::vec4(y, 0.f), glm::vec4(z, 0.f), glm::vec4(p, 1.f));
+        
+        if(i == 0)
+        {
+            obj.aabbMin = p;
+            obj.aabbMax = p;
+        }
+        obj.aabbMin = glm::min(obj.aabbMin, p);
+        obj.aabbMax = glm::max(obj.aabbMax, p);
+    }
+    if(transforms.size() > 0) //Conservative bounds of the whole group, used for culling
+    {
+        obj.aabbMin -= glm::vec3(radius);
+        obj.aabbMax += glm::vec3(radius);
+    }
+    obj.instanceCount = (GLsizei)transforms.size();
+    
+    glBindBuffer(GL_ARRAY_BUFFER, obj.vboInstance);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4) * transforms.size(), NULL, GL_STREAM_DRAW); //Orphan
+    if(transforms.size() > 0)
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(glm::mat4) * transforms.size(), &transforms[0][0].x);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void OpenGLContent::ResetInstanceAttributes()
+{
+    //Objects drawn without instancing see an identity instance transform
+    glVertexAttrib4f(4, 1.f, 0.f, 0.f, 0.f);
+    glVertexAttrib4f(5, 0.f, 1.f, 0.f, 0.f);
+    glVertexAttrib4f(6, 0.f, 0.f, 1.f, 0.f);
+    glVertexAttrib4f(7, 0.f, 0.f, 0.f, 1.f);
+}
+
+void OpenGLContent::DrawHelperGeometry(int id, glm::vec4 color, glm::mat4 M)
+{
+    auto it = helperGeometry.find(id);
+    if(it == helperGeometry.end() || it->second.vertexCount == 0)
+        return;
+
+    basicShaders["helper"]->Use();
+    basicShaders["helper"]->SetUniform("MVP", viewProjection*M);
+    basicShaders["helper"]->SetUniform("scale", glm::vec3(1.f));
+    
+    OpenGLState::BindVertexArray(baseVertexArray);
+    glEnableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+    glBindBuffer(GL_ARRAY_BUFFER, it->second.vbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3*sizeof(GLfloat), (void*)0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glVertexAttrib4fv(1, &color.r);
+    
+    switch(it->second.type)
+    {
+        case PrimitiveType::LINES:
+            glDrawArrays(GL_LINES, 0, it->second.vertexCount);
+            break;
+        
+        case PrimitiveType::LINE_STRIP:
+            glDrawArrays(GL_LINE_STRIP, 0, it->second.vertexCount);
+            break;
+
+        case PrimitiveType::TRIANGLES:
+            glDrawArrays(GL_TRIANGLES, 0, it->second.vertexCount);
+            break;
+            
+        case PrimitiveType::POINTS:
+        default:
+            glDrawArrays(GL_POINTS, 0, it->second.vertexCount);
+            break;
+    }
+    OpenGLState::BindVertexArray(0);
+    glDisableVertexAttribArray(0);
+    OpenGLState::UseProgram(0);
+}
+
+void OpenGLContent::DrawObject(int objectId, int lookId, const glm::mat4& M, GLint drawCommand)
+{
+    if(objectId < 0 || objectId >= (int)objects.size() || objects[objectId].vao == 0)
+        return;
+    
+    switch(mode)
+    {
+        case DrawingMode::RAW:
+            break;
 
         case DrawingMode::SHADOW:
         {
             basicShaders["shadow"]->Use();
             basicShaders["shadow"]->SetUniform("MVP", viewProjection*M);
-            OpenGLState::BindVertexArray(objects[objectId].vao);
-            glDrawElements(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
-            OpenGLState::BindVertexArray(0);
         }
         break;
         
@@ -820,9 +1068,6 @@ void OpenGLContent::DrawObject(int objectId, int lookId, const glm::mat4& M)
             basicShaders["flat"]->Use();
             basicShaders["flat"]->SetUniform("MVP", viewProjection*M);
             basicShaders["flat"]->SetUniform("FC", FC);
-            OpenGLState::BindVertexArray(objects[objectId].vao);
-            glDrawElements(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
-            OpenGLState::BindVertexArray(0);
         }
         break;
 
@@ -834,13 +1079,24 @@ void OpenGLContent::DrawObject(int objectId, int lookId, const glm::mat4& M)
                 UseLook(getLook(looks.size()-1), false, M); // Use default look
             else
                 UseLook(getLook(lookId), objects[objectId].texturable, M); // Use user defined look
-                
-            OpenGLState::BindVertexArray(objects[objectId].vao);
-            glDrawElements(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
-            OpenGLState::BindVertexArray(0);
         }
         break;
     }
+
+    OpenGLState::BindVertexArray(objects[objectId].vao);
+    if(objects[objectId].vboInstance != 0)
+    {
+        if(objects[objectId].instanceCount > 0)
+            glDrawElementsInstanced(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0, objects[objectId].instanceCount);
+        OpenGLState::BindVertexArray(0);
+        ResetInstanceAttributes(); //Current attribute values are undefined after drawing enabled arrays
+        return;
+    }
+    else if(drawCommand < 0)
+        glDrawElements(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
+    else //Instance count written by the occlusion culling pass
+        glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)((size_t)drawCommand * sizeof(DrawElementsIndirectCommand)));
+    OpenGLState::BindVertexArray(0);
 }
 
 void OpenGLContent::DrawLightSource(unsigned int lightId)
@@ -893,8 +1149,8 @@ void OpenGLContent::DrawLightSource(unsigned int lightId)
 
 void OpenGLContent::SetupLights()
 {
-    int pointId = 0;
-    int spotId = 0;
+    pointLightsData.clear();
+    spotLightsData.clear();
     
     for(size_t i=0; i<lights.size(); ++i)
     {
@@ -903,18 +1159,29 @@ void OpenGLContent::SetupLights()
             
         if(lights[i]->getType() == LightType::POINT)
         {
-            lights[i]->SetupShader(&lightsUBOData.pointLights[pointId]);
-            ++pointId;
+            pointLightsData.push_back(PointLightUBO());
+            lights[i]->SetupShader(&pointLightsData.back());
         }
         else
         {
-            lights[i]->SetupShader(&lightsUBOData.spotLights[spotId]);
-            ++spotId;
+            spotLightsData.push_back(SpotLightUBO());
+            lights[i]->SetupShader(&spotLightsData.back());
         }
     }
     
-    lightsUBOData.numPointLights = pointId;
-    lightsUBOData.numSpotLights = spotId;
+    lightsUBOData.numPointLights = (GLint)pointLightsData.size();
+    lightsUBOData.numSpotLights = (GLint)spotLightsData.size();
+
+    //Light buffers are orphaned every frame (at least one element is kept to leave a valid binding)
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, pointLightsSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(PointLightUBO) * glm::max(pointLightsData.size(), (size_t)1), NULL, GL_STREAM_DRAW);
+    if(pointLightsData.size() > 0)
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(PointLightUBO) * pointLightsData.size(), pointLightsData.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, spotLightsSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(SpotLightUBO) * glm::max(spotLightsData.size(), (size_t)1), NULL, GL_STREAM_DRAW);
+    if(spotLightsData.size() > 0)
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(SpotLightUBO) * spotLightsData.size(), spotLightsData.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
     glBindBuffer(GL_UNIFORM_BUFFER, lightsUBO);
     glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightsUBO), &lightsUBOData);
@@ -1032,6 +1299,7 @@ void OpenGLContent::UseLook(const Look& look, bool texturable, const glm::mat4&
             OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D_ARRAY, ocean->getOpenGLOcean()->getWaveTexture());
             shader->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
             shader->SetUniform("gridSizes", ocean->getOpenGLOcean()->getWaveGridSizes());
+            shader->SetUniform("waveOrigin", ocean->getOpenGLOcean()->getWaveOrigin());
         }
     }
 }
@@ -1045,6 +1313,20 @@ unsigned int OpenGLContent::BuildObject(Mesh* mesh)
     glGenBuffers(1, &obj.vboIndex);
     obj.faceCount = (GLsizei)mesh->faces.size();
     obj.texturable = false;
+    obj.aabbMin = glm::vec3(0.f);
+    obj.aabbMax = glm::vec3(0.f);
+    obj.vboInstance = 0;
+    obj.instanceCount = 0;
+    if(mesh->getNumOfVertices() > 0)
+    {
+        obj.aabbMin = obj.aabbMax = mesh->getVertexPos(0);
+        for(size_t i=1; i<mesh->getNumOfVertices(); ++i)
+        {
+            glm::vec3 v = mesh->getVertexPos(i);
+            obj.aabbMin = glm::min(obj.aabbMin, v);
+            obj.aabbMax = glm::max(obj.aabbMax, v);
+        }
+    }
     
     OpenGLState::BindVertexArray(obj.vao);	
     glEnableVertexAttribArray(0); //Position
@@ -1075,6 +1357,42 @@ unsigned int OpenGLContent::BuildObject(Mesh* mesh)
     return (unsigned int)objects.size()-1;
 }
 
+void OpenGLContent::DestroyObject(int objectId)
+{
+    if(objectId < 0 || objectId >= (int)objects.size() || objects[objectId].vao == 0)
+        return;
+    
+    Object& obj = objects[objectId];
+    glDeleteBuffers(1, &obj.vboVertex);
+    glDeleteBuffers(1, &obj.vboIndex);
+    if(obj.vboInstance != 0) glDeleteBuffers(1, &obj.vboInstance);
+    glDeleteVertexArrays(1, &obj.vao);
+    obj.vao = obj.vboVertex = obj.vboIndex = obj.vboInstance = 0; //Slot kept, so that the indices do not change
+    obj.faceCount = 0;
+    obj.instanceCount = 0;
+}
+
+void OpenGLContent::DestroyObjectLater(int objectId, unsigned long queueVersion)
+{
+    if(objectId >= 0)
+        scheduledObjects.push_back(std::make_pair(objectId, queueVersion));
+}
+
+void OpenGLContent::DestroyScheduledObjects(unsigned long queueVersion)
+{
+    for(size_t i=0; i<scheduledObjects.size();)
+    {
+        if(scheduledObjects[i].second <= queueVersion)
+        {
+            DestroyObject(scheduledObjects[i].first);
+            scheduledObjects[i] = scheduledObjects.back();
+            scheduledObjects.pop_back();
+        }
+        else
+            ++i;
+    }
+}
+
 std::string OpenGLContent::CreateSimpleLook(const std::string& name, glm::vec3 rgbColor, GLfloat specular, GLfloat shininess, 
                                             GLfloat reflectivity, const std::string& albedoTexturePath)
 {
@@ -1086,6 +1404,7 @@ std::string OpenGLContent::CreateSimpleLook(const std::string& name, glm::vec3 r
     look.params.push_back(specular);
     look.params.push_back(shininess);
     if(albedoTexturePath != "") look.albedoTexture = LoadTexture(albedoTexturePath);
+    look.albedoTexturePath = albedoTexturePath;
     looks.push_back(look);
     return look.name;
 }
@@ -1105,10 +1424,51 @@ std::string OpenGLContent::CreatePhysicalLook(const std::string& name, glm::vec3
     if(normalMapPath != "") look.normalMap = LoadTexture(normalMapPath, false);
     if(temperatureMapPath != "") look.temperatureMap = LoadTexture(temperatureMapPath, false);
     look.temperatureRange = temperatureRange;
+    look.albedoTexturePath = albedoTexturePath;
+    look.normalMapPath = normalMapPath;
+    look.temperatureMapPath = temperatureMapPath;
     looks.push_back(look);
     return look.name;
 }
 
+bool OpenGLContent::UpdatePhysicalLook(const std::string& name, glm::vec3 rgbColor, GLfloat roughness, GLfloat metalness, 
+                                       GLfloat reflectivity, const std::string& albedoTexturePath, const std::string& normalMapPath, 
+                                       const std::string& temperatureMapPath, glm::vec2 temperatureRange)
+{
+    int id = getLookId(name);
+    if(id < 0 || looks[id].type != LookType::PHYSICAL)
+        return false;
+    
+    //Parameters are changed in place so that the look id used by the entities stays valid
+    Look& look = looks[id];
+    look.color.rgb = rgbColor;
+    look.reflectivity = reflectivity;
+    look.params[0] = roughness;
+    look.params[1] = metalness;
+    look.temperatureRange = temperatureRange;
+    
+    //Textures are reloaded only when the source file changed
+    if(albedoTexturePath != look.albedoTexturePath)
+    {
+        if(look.albedoTexture != 0) glDeleteTextures(1, &look.albedoTexture);
+        look.albedoTexture = albedoTexturePath != "" ? LoadTexture(albedoTexturePath, true, false, maxAnisotropy) : 0;
+        look.albedoTexturePath = albedoTexturePath;
+    }
+    if(normalMapPath != look.normalMapPath)
+    {
+        if(look.normalMap != 0) glDeleteTextures(1, &look.normalMap);
+        look.normalMap = normalMapPath != "" ? LoadTexture(normalMapPath, false) : 0;
+        look.normalMapPath = normalMapPath;
+    }
+    if(temperatureMapPath != look.temperatureMapPath)
+    {
+        if(look.temperatureMap != 0) glDeleteTextures(1, &look.temperatureMap);
+        look.temperatureMap = temperatureMapPath != "" ? LoadTexture(temperatureMapPath, false) : 0;
+        look.temperatureMapPath = temperatureMapPath;
+    }
+    return true;
+}
+
 void OpenGLContent::AddView(OpenGLView *view)
 {
     views.push_back(view);
@@ -1160,6 +1520,11 @@ const Object& OpenGLContent::getObject(size_t id)
     return objects[id];
 }
 
+size_t OpenGLContent::getObjectsCount()
+{
+    return objects.size();
+}
+
 const Look& OpenGLContent::getLook(size_t id)
 {
     if(id >= looks.size())
@@ -2291,6 +2656,15 @@ Mesh* OpenGLContent::BuildTerrain(GLfloat* heightfield, int sizeX, int sizeY, GL
 
 Mesh* OpenGLContent::LoadMesh(const std::string& filename, GLfloat scale, bool smooth)
 {
+    std::string key;
+    if(meshCaching)
+    {
+        key = filename + "|" + std::to_string(scale) + (smooth ? "|smooth" : "");
+        auto it = meshCache.find(key);
+        if(it != meshCache.end())
+            return CopyMesh(it->second);
+    }
+    
     Mesh* mesh = LoadGeometryFromFile(filename, scale);
     CheckAndRepairFaceVertexOrder(mesh);
 
@@ -2300,9 +2674,30 @@ Mesh* OpenGLContent::LoadMesh(const std::string& filename, GLfloat scale, bool s
         SmoothNormals(mesh);
     if(mesh->isTexturable())
         ComputeTangents((TexturableMesh*)mesh);
+    if(meshCaching)
+        meshCache[key] = CopyMesh(mesh);
     return mesh;
 }
 
+void OpenGLContent::setMeshCaching(bool enabled)
+{
+    meshCaching = enabled;
+    if(!enabled)
+    {
+        for(auto it = meshCache.begin(); it != meshCache.end(); ++it)
+            delete it->second;
+        meshCache.clear();
+    }
+}
+
+Mesh* OpenGLContent::CopyMesh(const Mesh* mesh)
+{
+    if(mesh->isTexturable())
+        return new TexturableMesh(*static_cast<const TexturableMesh*>(mesh));
+    else
+        return new PlainMesh(*static_cast<const PlainMesh*>(mesh));
+}
+
 void OpenGLContent::TransformMesh(Mesh* mesh, const Transform& T)
 {
     glm::mat4 gT = glMatrixFromTransform(T);
@@ -32,6 +32,7 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLOutputStage.h"
 
 namespace sf
 {
@@ -45,6 +46,7 @@ OpenGLDepthCamera::OpenGLDepthCamera(glm::vec3 eyePosition, glm::vec3 direction,
                                      bool continuousUpdate, bool useRanges, GLfloat verticalFOVDeg)
  : OpenGLView(originX, originY, width, height), randDist(0.f, 1.f)
 {
+    Init(); //Shaders are loaded on first use
     _needsUpdate = false;
     continuous = continuousUpdate;
     newData = false;
@@ -55,6 +57,7 @@ OpenGLDepthCamera::OpenGLDepthCamera(glm::vec3 eyePosition, glm::vec3 direction,
     range.y = maxDepth;
     usesRanges = useRanges;
     linearDepthPBO = 0;
+    outputStage = nullptr;
     
     SetupCamera(eyePosition, direction, cameraUp);
     UpdateTransform();
@@ -127,6 +130,8 @@ OpenGLDepthCamera::~OpenGLDepthCamera()
     {
         glDeleteBuffers(1, &linearDepthPBO);
     }
+    if(outputStage != nullptr)
+        delete outputStage;
 }
 
 void OpenGLDepthCamera::SetupCamera(glm::vec3 _eye, glm::vec3 _dir, glm::vec3 _up)
@@ -229,9 +234,16 @@ void OpenGLDepthCamera::setCamera(Camera* cam, unsigned int index)
     camera = cam;
     idx = index;
 
+    //Crop, bin and quantise on the GPU if needed
+    unsigned int resX, resY;
+    camera->getResolution(resX, resY);
+    CameraOutputSettings output = camera->getOutputSettings();
+    if(!output.isPassThrough(resX, resY))
+        outputStage = new OpenGLOutputStage(OutputStageSource::DEPTH, output);
+
     glGenBuffers(1, &linearDepthPBO);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, linearDepthPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, viewportWidth * viewportHeight * sizeof(GLfloat), 0, GL_STREAM_READ);
+    glBufferData(GL_PIXEL_PACK_BUFFER, outputStage != nullptr ? outputStage->getDataSize() : viewportWidth * viewportHeight * sizeof(GLfloat), 0, GL_STREAM_READ);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 
@@ -344,11 +356,16 @@ void OpenGLDepthCamera::DrawLDR(GLuint destinationFBO, bool updated)
             else LinearizeDepth();
         }
                 
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, linearDepthTex);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, linearDepthPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+        if(outputStage != nullptr)
+            outputStage->Process(linearDepthTex, 0, linearDepthPBO);
+        else
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, linearDepthTex);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, linearDepthPBO);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+        }
         newData = true;
     }
 }
@@ -356,6 +373,9 @@ void OpenGLDepthCamera::DrawLDR(GLuint destinationFBO, bool updated)
 ///////////////////////// Static /////////////////////////////
 void OpenGLDepthCamera::Init()
 {
+    if(depthCameraOutputShader != nullptr) //Already loaded
+        return;
+
     depthCameraOutputShader = new GLSLShader*[2];
     depthCameraOutputShader[0] = new GLSLShader("depthCameraOutput.frag");
     depthCameraOutputShader[0]->AddUniform("rangeInfo", ParameterType::VEC4);
@@ -382,6 +402,8 @@ void OpenGLDepthCamera::Destroy()
         delete [] depthCameraOutputShader;
     }
     if(depthVisualizeShader != nullptr) delete depthVisualizeShader;
+    depthCameraOutputShader = nullptr;
+    depthVisualizeShader = nullptr;
 }
 
 }
@@ -42,7 +42,8 @@ OpenGLEventBasedCamera::OpenGLEventBasedCamera(glm::vec3 eyePosition, glm::vec3
                                    GLint x, GLint y, GLint width, GLint height, GLfloat horizontalFovDeg, 
                                    glm::vec2 range, glm::vec2 C, uint32_t Tr, bool continuousUpdate) 
                                    : OpenGLCamera(x, y, width, height, range), randDist(0.f, 1.f)
-{  
+{
+    Init(); //Shaders are loaded on first use
     _needsUpdate = false;
     newData = false;
     initialized = false;
@@ -335,6 +336,9 @@ void OpenGLEventBasedCamera::DrawLDR(GLuint destinationFBO, bool updated)
 
 void OpenGLEventBasedCamera::Init()
 {
+    if(eventOutputShaders != nullptr) //Already loaded
+        return;
+
     glm::uvec3 maxTextureSize = OpenGLState::GetMaxTextureSize();
 
     eventOutputShaders = new GLSLShader*[2];
@@ -383,6 +387,9 @@ void OpenGLEventBasedCamera::Destroy()
 
     if(eventVisualizeShader != nullptr)
         delete eventVisualizeShader;
+
+    eventOutputShaders = nullptr;
+    eventVisualizeShader = nullptr;
 }
 
 }
\ No newline at end of file
@@ -57,6 +57,7 @@ OpenGLFlatOcean::OpenGLFlatOcean(GLfloat size) : OpenGLOcean(200000.f)
     oceanShaders["surface"]->AddUniform("texSlopeVariance", ParameterType::INT);
     oceanShaders["surface"]->AddUniform("MVP", ParameterType::MAT4);
     oceanShaders["surface"]->AddUniform("gridSizes", ParameterType::VEC4);
+    oceanShaders["surface"]->AddUniform("waveOrigin", ParameterType::VEC2);
     oceanShaders["surface"]->AddUniform("eyePos", ParameterType::VEC3);
     oceanShaders["surface"]->AddUniform("viewDir", ParameterType::VEC3);
     oceanShaders["surface"]->AddUniform("MV", ParameterType::MAT3);
@@ -86,6 +87,7 @@ OpenGLFlatOcean::OpenGLFlatOcean(GLfloat size) : OpenGLOcean(200000.f)
     oceanShaders["surfaceTemp"]->AddUniform("texSlopeVariance", ParameterType::INT);
     oceanShaders["surfaceTemp"]->AddUniform("MVP", ParameterType::MAT4);
     oceanShaders["surfaceTemp"]->AddUniform("gridSizes", ParameterType::VEC4);
+    oceanShaders["surfaceTemp"]->AddUniform("waveOrigin", ParameterType::VEC2);
     oceanShaders["surfaceTemp"]->AddUniform("eyePos", ParameterType::VEC3);
     oceanShaders["surfaceTemp"]->AddUniform("viewDir", ParameterType::VEC3);
     oceanShaders["surfaceTemp"]->AddUniform("MV", ParameterType::MAT3);
@@ -120,6 +122,7 @@ OpenGLFlatOcean::OpenGLFlatOcean(GLfloat size) : OpenGLOcean(200000.f)
     oceanShaders["backsurface"]->AddUniform("texSlopeVariance", ParameterType::INT);
     oceanShaders["backsurface"]->AddUniform("MVP", ParameterType::MAT4);
     oceanShaders["backsurface"]->AddUniform("gridSizes", ParameterType::VEC4);
+    oceanShaders["backsurface"]->AddUniform("waveOrigin", ParameterType::VEC2);
     oceanShaders["backsurface"]->AddUniform("eyePos", ParameterType::VEC3);
     oceanShaders["backsurface"]->AddUniform("MV", ParameterType::MAT3);
     oceanShaders["backsurface"]->AddUniform("FC", ParameterType::FLOAT);
@@ -202,6 +205,7 @@ void OpenGLFlatOcean::DrawSurface(OpenGLView* view)
     oceanShaders["surface"]->SetUniform("eyePos", view->GetEyePosition());
     oceanShaders["surface"]->SetUniform("viewDir", view->GetLookingDirection());
     oceanShaders["surface"]->SetUniform("gridSizes", params.gridSizes);
+    oceanShaders["surface"]->SetUniform("waveOrigin", waveOrigin);
     oceanShaders["surface"]->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
     oceanShaders["surface"]->SetUniform("texSlopeVariance", TEX_POSTPROCESS2);
     OpenGLState::BindVertexArray(vao);
@@ -229,6 +233,7 @@ void OpenGLFlatOcean::DrawSurfaceTemperature(OpenGLView* view)
     oceanShaders["surfaceTemp"]->SetUniform("eyePos", view->GetEyePosition());
     oceanShaders["surfaceTemp"]->SetUniform("viewDir", view->GetLookingDirection());
     oceanShaders["surfaceTemp"]->SetUniform("gridSizes", params.gridSizes);
+    oceanShaders["surfaceTemp"]->SetUniform("waveOrigin", waveOrigin);
     oceanShaders["surfaceTemp"]->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
     oceanShaders["surfaceTemp"]->SetUniform("texSlopeVariance", TEX_POSTPROCESS2);
     oceanShaders["surfaceTemp"]->SetUniform("waterTemperature", waterTemperature);
@@ -256,6 +261,7 @@ void OpenGLFlatOcean::DrawBacksurface(OpenGLView* view)
     oceanShaders["backsurface"]->SetUniform("size", oceanSize);
     oceanShaders["backsurface"]->SetUniform("eyePos", view->GetEyePosition());
     oceanShaders["backsurface"]->SetUniform("gridSizes", params.gridSizes);
+    oceanShaders["backsurface"]->SetUniform("waveOrigin", waveOrigin);
     oceanShaders["backsurface"]->SetUniform("cWater", getLightAttenuation());
     oceanShaders["backsurface"]->SetUniform("bWater", getLightScattering());
     oceanShaders["backsurface"]->SetUniform("viewport", glm::vec2((GLfloat)viewport[2], (GLfloat)viewport[3]));
@@ -0,0 +1,279 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLMultiCamera.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "graphics/OpenGLMultiCamera.h"
+
+#include "core/GraphicalSimulationApp.h"
+#include "sensors/vision/Camera.h"
+#include "graphics/OpenGLState.h"
+#include "graphics/GLSLShader.h"
+#include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLContent.h"
+
+namespace sf
+{
+
+GLSLShader* OpenGLMultiCamera::multiOutputShader = nullptr;
+
+OpenGLMultiCamera::OpenGLMultiCamera(glm::vec3 eyePosition, glm::vec3 direction, glm::vec3 cameraUp,
+                                     GLint x, GLint y, GLint width, GLint height,
+                                     GLfloat horizontalFovDeg, glm::vec2 range, bool continuousUpdate)
+ : OpenGLRealCamera(eyePosition, direction, cameraUp, x, y, width, height, horizontalFovDeg, range, continuousUpdate)
+{
+    Init(); //Shaders are loaded on first use
+    newAuxData = false;
+    for(unsigned int i=0; i<4; ++i)
+        outputEnabled[i] = true;
+    focalLength = ((GLfloat)viewportWidth/2.f)/tanf(fovx/2.f);
+
+    //Geometry pass targets: linear depth, object id and image velocity
+    glm::uvec3 size((GLuint)viewportWidth, (GLuint)viewportHeight, 0);
+    for(unsigned int i=0; i<2; ++i)
+    {
+        GLuint* tex = i == 0 ? auxTex : auxFlipTex;
+        tex[0] = OpenGLContent::GenerateTexture(GL_TEXTURE_2D, size, GL_R32F, GL_RED, GL_FLOAT, NULL, FilteringMode::NEAREST, false);
+        tex[1] = OpenGLContent::GenerateTexture(GL_TEXTURE_2D, size, GL_R16UI, GL_RED_INTEGER, GL_UNSIGNED_SHORT, NULL, FilteringMode::NEAREST, false);
+        tex[2] = OpenGLContent::GenerateTexture(GL_TEXTURE_2D, size, GL_RG32F, GL_RG, GL_FLOAT, NULL, FilteringMode::NEAREST, false);
+    }
+    auxDepthTex = OpenGLContent::GenerateTexture(GL_TEXTURE_2D, size, GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT, NULL, FilteringMode::NEAREST, false);
+    
+    std::vector<FBOTexture> fboTextures;
+    for(unsigned int i=0; i<3; ++i)
+    {
+        fboTextures.push_back(FBOTexture(GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, auxTex[i]));
+        fboTextures.push_back(FBOTexture(GL_COLOR_ATTACHMENT3 + i, GL_TEXTURE_2D, auxFlipTex[i]));
+    }
+    fboTextures.push_back(FBOTexture(GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, auxDepthTex));
+    auxFBO = OpenGLContent::GenerateFramebuffer(fboTextures);
+
+    //Readback buffers
+    GLsizeiptr pixels = (GLsizeiptr)viewportWidth * viewportHeight;
+    GLsizeiptr pboSize[3] = {pixels * (GLsizeiptr)sizeof(GLfloat), 
+                             pixels * (GLsizeiptr)sizeof(GLushort), 
+                             pixels * 2 * (GLsizeiptr)sizeof(GLfloat)};
+    glGenBuffers(3, auxPBO);
+    for(unsigned int i=0; i<3; ++i)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, auxPBO[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, pboSize[i], 0, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+OpenGLMultiCamera::~OpenGLMultiCamera()
+{
+    glDeleteFramebuffers(1, &auxFBO);
+    glDeleteTextures(1, &auxDepthTex);
+    glDeleteTextures(3, auxTex);
+    glDeleteTextures(3, auxFlipTex);
+    glDeleteBuffers(3, auxPBO);
+}
+
+ViewType OpenGLMultiCamera::getType() const
+{
+    return ViewType::MULTI_CAMERA;
+}
+
+void OpenGLMultiCamera::setOutputs(bool color, bool depth, bool segmentation, bool flow)
+{
+    outputEnabled[0] = color;
+    outputEnabled[1] = depth;
+    outputEnabled[2] = segmentation;
+    outputEnabled[3] = flow;
+}
+
+bool OpenGLMultiCamera::isColorEnabled() const
+{
+    return outputEnabled[0];
+}
+
+void OpenGLMultiCamera::ComputeOutput(std::vector<Renderable>& objects, bool culled)
+{
+    if(!outputEnabled[1] && !outputEnabled[2] && !outputEnabled[3])
+        return;
+
+    OpenGLContent* content = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent();
+    if(!culled)
+        CullObjects(objects);
+    content->SetCurrentView(this);
+    content->SetDrawingMode(DrawingMode::RAW);
+
+    //One geometry pass writing all enabled outputs
+    OpenGLState::BindFramebuffer(auxFBO);
+    OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
+    GLenum buffers[3];
+    for(unsigned int i=0; i<3; ++i)
+        buffers[i] = outputEnabled[i+1] ? GL_COLOR_ATTACHMENT0 + i : GL_NONE;
+    glDrawBuffers(3, buffers);
+    GLfloat clearDepth[4] = {GetFarClip(), 0.f, 0.f, 0.f};
+    GLuint clearId[4] = {0, 0, 0, 0};
+    GLfloat clearFlow[4] = {0.f, 0.f, 0.f, 0.f};
+    glClearBufferfv(GL_COLOR, 0, clearDepth);
+    glClearBufferuiv(GL_COLOR, 1, clearId);
+    glClearBufferfv(GL_COLOR, 2, clearFlow);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    
+    glm::mat4 VP = GetProjectionMatrix() * GetViewMatrix();
+    multiOutputShader->Use();
+    multiOutputShader->SetUniform("FC", GetLogDepthConstant());
+    multiOutputShader->SetUniform("VR", glm::mat3(GetViewMatrix()));
+    multiOutputShader->SetUniform("d", GetLookingDirection());
+    multiOutputShader->SetUniform("c", glm::vec2(viewportWidth/2.f, viewportHeight/2.f));
+    multiOutputShader->SetUniform("f", focalLength);
+    multiOutputShader->SetUniform("P_c", GetEyePosition());
+
+    if(camera != nullptr)
+    {
+        Vector3 linear, angular;
+        camera->getSensorVelocity(linear, angular);
+        multiOutputShader->SetUniform("v_c", glVectorFromVector(linear));
+        multiOutputShader->SetUniform("w_c", glVectorFromVector(angular));
+    }
+    else
+    {
+        multiOutputShader->SetUniform("v_c", glm::vec3(0.f));
+        multiOutputShader->SetUniform("w_c", glm::vec3(0.f));
+    }
+
+    BindDrawCommands();
+    for(size_t i=0; i<objects.size(); ++i)
+    {
+        GLint cmd = getDrawCommand(i);
+        if(objects[i].type != RenderableType::SOLID || cmd == -2)
+            continue;
+        multiOutputShader->SetUniform("MVP", VP * objects[i].model);
+        multiOutputShader->SetUniform("M", objects[i].model);
+        multiOutputShader->SetUniform("objectId", (GLuint)objects[i].objectId+1);
+        multiOutputShader->SetUniform("P_b", objects[i].cor);
+        multiOutputShader->SetUniform("v_b", objects[i].vel);
+        multiOutputShader->SetUniform("w_b", objects[i].avel);
+        content->DrawObject(objects[i].objectId, -1, objects[i].model, cmd);
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    OpenGLState::UseProgram(0);
+
+    //Flip images vertically (blitting works for integer formats too)
+    for(unsigned int i=0; i<3; ++i)
+    {
+        if(!outputEnabled[i+1])
+            continue;
+        glReadBuffer(GL_COLOR_ATTACHMENT0 + i);
+        glDrawBuffer(GL_COLOR_ATTACHMENT3 + i);
+        glBlitFramebuffer(0, 0, viewportWidth, viewportHeight, 0, viewportHeight, viewportWidth, 0, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    OpenGLState::BindFramebuffer(0);
+}
+
+void OpenGLMultiCamera::DrawLDR(GLuint destinationFBO, bool updated)
+{
+    //Lit image (with output stage and on-screen display)
+    if(outputEnabled[0])
+        OpenGLRealCamera::DrawLDR(destinationFBO, updated);
+
+    //Copy geometry outputs to camera buffers
+    if(camera != nullptr && updated)
+    {
+        static const GLenum formats[3] = {GL_RED, GL_RED_INTEGER, GL_RG};
+        static const GLenum types[3] = {GL_FLOAT, GL_UNSIGNED_SHORT, GL_FLOAT};
+        for(unsigned int i=0; i<3; ++i)
+        {
+            if(!outputEnabled[i+1])
+                continue;
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, auxFlipTex[i]);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, auxPBO[i]);
+            glGetTexImage(GL_TEXTURE_2D, 0, formats[i], types[i], NULL);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+        newAuxData = true;
+    }
+}
+
+void OpenGLMultiCamera::UpdateTransform()
+{
+    //Postpone the colour callback so that all outputs are delivered together
+    bool colorReady = newData;
+    newData = false;
+    OpenGLRealCamera::UpdateTransform();
+
+    if(!colorReady && !newAuxData)
+        return;
+    
+    GLuint pbos[4] = {cameraPBO, auxPBO[0], auxPBO[1], auxPBO[2]};
+    void* src[4] = {nullptr, nullptr, nullptr, nullptr};
+    for(unsigned int i=0; i<4; ++i)
+    {
+        if(!outputEnabled[i] || (i == 0 && !colorReady) || (i > 0 && !newAuxData))
+            continue;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[i]);
+        src[i] = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    }
+
+    for(unsigned int i=0; i<4; ++i)
+        if(src[i] != nullptr)
+            camera->NewDataReady(src[i], i);
+
+    for(unsigned int i=0; i<4; ++i)
+    {
+        if(src[i] == nullptr)
+            continue;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[i]);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    newAuxData = false;
+}
+
+///////////////////////// Static /////////////////////////////
+void OpenGLMultiCamera::Init()
+{
+    if(multiOutputShader != nullptr) //Already loaded
+        return;
+
+    multiOutputShader = new GLSLShader("multiOutput.frag", "opticalFlow.vert");
+    multiOutputShader->AddUniform("MVP", ParameterType::MAT4);
+    multiOutputShader->AddUniform("M", ParameterType::MAT4);
+    multiOutputShader->AddUniform("FC", ParameterType::FLOAT);
+    multiOutputShader->AddUniform("objectId", ParameterType::UINT);
+    multiOutputShader->AddUniform("VR", ParameterType::MAT3);
+    multiOutputShader->AddUniform("d", ParameterType::VEC3);
+    multiOutputShader->AddUniform("P_b", ParameterType::VEC3);
+    multiOutputShader->AddUniform("v_b", ParameterType::VEC3);
+    multiOutputShader->AddUniform("w_b", ParameterType::VEC3);
+    multiOutputShader->AddUniform("P_c", ParameterType::VEC3);
+    multiOutputShader->AddUniform("v_c", ParameterType::VEC3);
+    multiOutputShader->AddUniform("w_c", ParameterType::VEC3);
+    multiOutputShader->AddUniform("c", ParameterType::VEC2);
+    multiOutputShader->AddUniform("f", ParameterType::FLOAT);
+}
+
+void OpenGLMultiCamera::Destroy()
+{
+    if(multiOutputShader != nullptr) delete multiOutputShader;
+    multiOutputShader = nullptr;
+}
+
+}
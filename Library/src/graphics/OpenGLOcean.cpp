@@ -57,6 +57,7 @@ OpenGLOcean::OpenGLOcean(GLfloat size)
     //Initialization
     lightAbsorption = glm::vec3(0.f);
     lightScattering = glm::vec3(0.f);
+    waveOrigin = glm::vec2(0.f);
   
     //Params
     params.passes = 8;
@@ -396,6 +397,10 @@ GLfloat OpenGLOcean::ComputeWaveHeight(GLfloat x, GLfloat y)
     return 0.f;
 }
 
+void OpenGLOcean::AcquireWaveData()
+{
+}
+
 GLuint OpenGLOcean::getWaveTexture()
 {
     return oceanTextures[3];
@@ -406,6 +411,16 @@ glm::vec4 OpenGLOcean::getWaveGridSizes()
     return params.gridSizes;
 }
 
+void OpenGLOcean::setWaveOrigin(const glm::vec2& origin)
+{
+    waveOrigin = origin;
+}
+
+glm::vec2 OpenGLOcean::getWaveOrigin()
+{
+    return waveOrigin;
+}
+
 void OpenGLOcean::UpdateOceanCurrentsData(const OceanCurrentsUBO& data)
 {
     memcpy(&oceanCurrentsUBOData, &data, sizeof(OceanCurrentsUBO));
@@ -48,6 +48,7 @@ GLSLShader* OpenGLOceanParticles::updateShader = nullptr;
 
 OpenGLOceanParticles::OpenGLOceanParticles(size_t numOfParticles, GLfloat visibleRange) : OpenGLParticles(numOfParticles), uniformd(0, 1.f), normald(0, 1.f)
 {
+    Init(); //Shaders are loaded on first use
     initialised = false;
     range = fabsf(visibleRange);
     lastEyePos = glm::vec3(0);
@@ -150,6 +151,9 @@ void OpenGLOceanParticles::DrawId(OpenGLView* view, GLushort id)
     
 void OpenGLOceanParticles::Init()
 {
+    if(updateShader != nullptr) //Already loaded
+        return;
+
     //Load shaders
 	std::vector<GLuint> precompiled;
     precompiled.push_back(OpenGLAtmosphere::getAtmosphereAPI());
@@ -260,6 +264,11 @@ void OpenGLOceanParticles::Destroy()
     if(renderIdShader != nullptr) delete renderIdShader;
     if(flakeTexture != 0) glDeleteTextures(1, &flakeTexture);
     if(noiseTexture != 0) glDeleteTextures(1, &noiseTexture);
+    updateShader = nullptr;
+    renderShader = nullptr;
+    renderIdShader = nullptr;
+    flakeTexture = 0;
+    noiseTexture = 0;
 }
     
 }
@@ -45,6 +45,7 @@ OpenGLOpticalFlowCamera::OpenGLOpticalFlowCamera(glm::vec3 eyePosition, glm::vec
                           GLfloat horizontalFOVDeg, glm::vec2 range, bool continuousUpdate)
  : OpenGLView(originX, originY, width, height), randDist(0.f, 1.f)
 {
+    Init(); //Shaders are loaded on first use
     _needsUpdate = false;
     continuous = continuousUpdate;
     newData = false;
@@ -374,6 +375,9 @@ void OpenGLOpticalFlowCamera::DrawLDR(GLuint destinationFBO, bool updated)
 ///////////////////////// Static /////////////////////////////
 void OpenGLOpticalFlowCamera::Init()
 {
+    if(opticalFlowCameraOutputShader != nullptr) //Already loaded
+        return;
+
     opticalFlowCameraOutputShader = new GLSLShader("opticalFlow.frag", "opticalFlow.vert");
     opticalFlowCameraOutputShader->AddUniform("MVP", ParameterType::MAT4);
     opticalFlowCameraOutputShader->AddUniform("M", ParameterType::MAT4);
@@ -402,6 +406,9 @@ void OpenGLOpticalFlowCamera::Destroy()
     if(opticalFlowCameraOutputShader != nullptr) delete opticalFlowCameraOutputShader;
     if(opticalFlowVisualizeShader != nullptr) delete opticalFlowVisualizeShader;
     if(flipShader != nullptr) delete flipShader;
+    opticalFlowCameraOutputShader = nullptr;
+    opticalFlowVisualizeShader = nullptr;
+    flipShader = nullptr;
 }
 
 }
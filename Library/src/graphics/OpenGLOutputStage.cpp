@@ -0,0 +1,180 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLOutputStage.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "graphics/OpenGLOutputStage.h"
+
+#include "core/GraphicalSimulationApp.h"
+#include "graphics/OpenGLState.h"
+#include "graphics/GLSLShader.h"
+#include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLContent.h"
+
+namespace sf
+{
+
+GLSLShader* OpenGLOutputStage::outputShaders[4] = {nullptr, nullptr, nullptr, nullptr};
+
+OpenGLOutputStage::OpenGLOutputStage(OutputStageSource source, const CameraOutputSettings& outSettings) : settings(outSettings)
+{
+    Init(); //Shaders are loaded on first use
+    settings.binning = settings.binning < 1 ? 1 : settings.binning;
+    size = glm::uvec2(settings.roiWidth/settings.binning, settings.roiHeight/settings.binning);
+    size = glm::max(size, glm::uvec2(1));
+    
+    GLenum internalFormat;
+    switch(source)
+    {
+        default:
+        case OutputStageSource::COLOR:
+            if(settings.format == CameraOutputFormat::NATIVE)
+            {
+                internalFormat = GL_RGB8;
+                outputFormat = GL_RGB;
+                pixelSize = 3;
+            }
+            else //Monochrome and Bayer mosaics
+            {
+                internalFormat = GL_R8;
+                outputFormat = GL_RED;
+                pixelSize = 1;
+            }
+            outputType = GL_UNSIGNED_BYTE;
+            shader = outputShaders[0];
+            break;
+            
+        case OutputStageSource::DEPTH:
+            if(settings.format == CameraOutputFormat::DEPTH_UINT16)
+            {
+                internalFormat = GL_R16UI;
+                outputFormat = GL_RED_INTEGER;
+                outputType = GL_UNSIGNED_SHORT;
+                pixelSize = sizeof(GLushort);
+                shader = outputShaders[2];
+            }
+            else
+            {
+                internalFormat = GL_R32F;
+                outputFormat = GL_RED;
+                outputType = GL_FLOAT;
+                pixelSize = sizeof(GLfloat);
+                shader = outputShaders[1];
+            }
+            break;
+            
+        case OutputStageSource::ID:
+            internalFormat = GL_R16UI;
+            outputFormat = GL_RED_INTEGER;
+            outputType = GL_UNSIGNED_SHORT;
+            pixelSize = sizeof(GLushort);
+            shader = outputShaders[3];
+            break;
+    }
+    
+    outputTex = OpenGLContent::GenerateTexture(GL_TEXTURE_2D, glm::uvec3(size.x, size.y, 0), 
+                                               internalFormat, outputFormat, outputType, NULL, FilteringMode::NEAREST, false);
+    std::vector<FBOTexture> textures;
+    textures.push_back(FBOTexture(GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, outputTex));
+    outputFBO = OpenGLContent::GenerateFramebuffer(textures);
+}
+
+OpenGLOutputStage::~OpenGLOutputStage()
+{
+    glDeleteFramebuffers(1, &outputFBO);
+    glDeleteTextures(1, &outputTex);
+}
+
+glm::uvec2 OpenGLOutputStage::getOutputSize() const
+{
+    return size;
+}
+
+GLsizeiptr OpenGLOutputStage::getDataSize() const
+{
+    return (GLsizeiptr)size.x * (GLsizeiptr)size.y * (GLsizeiptr)pixelSize;
+}
+
+void OpenGLOutputStage::Process(GLuint sourceTexture, GLint flipHeight, GLuint destinationPBO)
+{
+    //Crop, bin and convert
+    OpenGLState::BindFramebuffer(outputFBO);
+    OpenGLState::Viewport(0, 0, size.x, size.y);
+    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, sourceTexture);
+    shader->Use();
+    shader->SetUniform("texSource", TEX_POSTPROCESS1);
+    shader->SetUniform("roiOrigin", glm::ivec2((GLint)settings.roiX, (GLint)settings.roiY));
+    shader->SetUniform("binning", (GLint)settings.binning);
+    shader->SetUniform("flipHeight", flipHeight);
+    shader->SetUniform("outputFormat", (GLint)settings.format);
+    shader->SetUniform("depthScale", settings.depthScale);
+    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawSAQ();
+    OpenGLState::UseProgram(0);
+    OpenGLState::BindFramebuffer(0);
+    
+    //Transfer only the processed data
+    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTex);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, destinationPBO);
+    glGetTexImage(GL_TEXTURE_2D, 0, outputFormat, outputType, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+}
+
+///////////////////////// Static /////////////////////////////
+void OpenGLOutputStage::Init()
+{
+    if(outputShaders[0] != nullptr) //Already loaded
+        return;
+
+    const char* headers[4] = {"#version 430\n#define COLOR_SOURCE\n",
+                              "#version 430\n#define DEPTH_SOURCE\n",
+                              "#version 430\n#define DEPTH_SOURCE\n#define UINT_OUTPUT\n",
+                              "#version 430\n#define ID_SOURCE\n"};
+    for(unsigned int i=0; i<4; ++i)
+    {
+        std::vector<GLSLSource> sources;
+        sources.push_back(GLSLSource(GL_VERTEX_SHADER, "saq.vert"));
+        sources.push_back(GLSLSource(GL_FRAGMENT_SHADER, "cameraOutput.frag", headers[i]));
+        outputShaders[i] = new GLSLShader(sources);
+        outputShaders[i]->AddUniform("texSource", ParameterType::INT);
+        outputShaders[i]->AddUniform("roiOrigin", ParameterType::IVEC2);
+        outputShaders[i]->AddUniform("binning", ParameterType::INT);
+        outputShaders[i]->AddUniform("flipHeight", ParameterType::INT);
+        outputShaders[i]->AddUniform("outputFormat", ParameterType::INT);
+        outputShaders[i]->AddUniform("depthScale", ParameterType::FLOAT);
+    }
+}
+
+void OpenGLOutputStage::Destroy()
+{
+    for(unsigned int i=0; i<4; ++i)
+        if(outputShaders[i] != nullptr) 
+        {
+            delete outputShaders[i];
+            outputShaders[i] = nullptr;
+        }
+}
+
+}
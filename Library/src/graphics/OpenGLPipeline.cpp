@@ -38,7 +38,10 @@
 #include "graphics/OpenGLThermalCamera.h"
 #include "graphics/OpenGLOpticalFlowCamera.h"
 #include "graphics/OpenGLSegmentationCamera.h"
+#include "graphics/OpenGLMultiCamera.h"
+#include "graphics/OpenGLCameraRig.h"
 #include "graphics/OpenGLEventBasedCamera.h"
+#include "graphics/OpenGLOutputStage.h"
 #include "graphics/OpenGLSonar.h"
 #include "graphics/OpenGLAtmosphere.h"
 #include "graphics/OpenGLLight.h"
@@ -54,6 +57,7 @@ namespace sf
 OpenGLPipeline::OpenGLPipeline(RenderSettings s, HelperSettings h) : rSettings(s), hSettings(h)
 {
     drawingQueueMutex = SDL_CreateMutex();
+    drawingQueueVersion = 0;
     
     //Set default OpenGL options
     cInfo("Initialising OpenGL rendering pipeline...");
@@ -62,13 +66,7 @@ OpenGLPipeline::OpenGLPipeline(RenderSettings s, HelperSettings h) : rSettings(s
     cInfo("Loading shaders...");
     OpenGLAtmosphere::Init();
     OpenGLCamera::Init(rSettings);
-    OpenGLDepthCamera::Init();
-    OpenGLThermalCamera::Init();
-    OpenGLOpticalFlowCamera::Init();
-    OpenGLSegmentationCamera::Init();
-    OpenGLEventBasedCamera::Init();
-    OpenGLSonar::Init();
-    OpenGLOceanParticles::Init();
+    //Shaders of specialised views are loaded when the first view of a given type is created
     content = new OpenGLContent();
     
     //Create display framebuffer
@@ -97,7 +95,9 @@ OpenGLPipeline::~OpenGLPipeline()
     OpenGLThermalCamera::Destroy();
     OpenGLOpticalFlowCamera::Destroy();
     OpenGLSegmentationCamera::Destroy();
+    OpenGLMultiCamera::Destroy();
     OpenGLEventBasedCamera::Destroy();
+    OpenGLOutputStage::Destroy();
     OpenGLSonar::Destroy();
     OpenGLOceanParticles::Destroy();
     OpenGLLight::Destroy();
@@ -133,6 +133,24 @@ OpenGLContent* OpenGLPipeline::getContent()
     return content;
 }
 
+const std::vector<Renderable>& OpenGLPipeline::getDrawingQueue() const
+{
+    return drawingQueueCopy;
+}
+
+unsigned long OpenGLPipeline::getDrawingQueueVersion() const
+{
+    return drawingQueueVersion;
+}
+
+void OpenGLPipeline::ReleaseObject(int objectId)
+{
+    SDL_LockMutex(drawingQueueMutex);
+    //A queue waiting for the copy may have been built before the release
+    content->DestroyObjectLater(objectId, drawingQueueVersion + (drawingQueue.empty() ? 1 : 2));
+    SDL_UnlockMutex(drawingQueueMutex);
+}
+
 void OpenGLPipeline::AddToDrawingQueue(const Renderable& r)
 {
     drawingQueue.push_back(r);
@@ -188,10 +206,28 @@ void OpenGLPipeline::PerformDrawingQueueCopy(SimulationManager* sim)
         //Enable update of drawing queue by clearing old queue
         drawingQueue.clear(); 
         selectedDrawingQueue.clear();
+        ++drawingQueueVersion;
     }
+    content->DestroyScheduledObjects(drawingQueueVersion);
 
     SDL_UnlockMutex(drawingQueueMutex);
 
+    //Upload helper geometry that was (re)generated for caching and instance transforms
+    for(size_t i=0; i<drawingQueueCopy.size(); ++i)
+    {
+        if(drawingQueueCopy[i].type == RenderableType::SENSOR_LINES 
+           && drawingQueueCopy[i].objectId >= 0 && drawingQueueCopy[i].points.size() > 0)
+        {
+            content->UpdateHelperGeometry(drawingQueueCopy[i].objectId, PrimitiveType::LINES, drawingQueueCopy[i].points);
+            drawingQueueCopy[i].points.clear();
+        }
+        else if(drawingQueueCopy[i].type == RenderableType::SOLID && drawingQueueCopy[i].points.size() > 0) //Instanced object
+        {
+            content->UpdateInstances(drawingQueueCopy[i].objectId, drawingQueueCopy[i].points);
+            drawingQueueCopy[i].points.clear();
+        }
+    }
+
     //Sort objects by material to reduce uniform/texture switching
     std::sort(drawingQueueCopy.begin(), drawingQueueCopy.end(), Renderable::SortByMaterial);
 }
@@ -203,13 +239,26 @@ void OpenGLPipeline::DrawDisplay()
     glBlitFramebuffer(0, 0, rSettings.windowW, rSettings.windowH, 0, 0, rSettings.windowW, rSettings.windowH, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 }
 
-void OpenGLPipeline::DrawObjects()
+void OpenGLPipeline::DrawObjects(OpenGLCamera* view)
 {
+    if(view == nullptr)
+    {
+        for(size_t i=0; i<drawingQueueCopy.size(); ++i)
+        {
+            if(drawingQueueCopy[i].type == RenderableType::SOLID)
+                content->DrawObject(drawingQueueCopy[i].objectId, drawingQueueCopy[i].lookId, drawingQueueCopy[i].model);
+        }
+        return;
+    }
+
+    view->BindDrawCommands();
     for(size_t i=0; i<drawingQueueCopy.size(); ++i)
     {
-		if(drawingQueueCopy[i].type == RenderableType::SOLID)
-			content->DrawObject(drawingQueueCopy[i].objectId, drawingQueueCopy[i].lookId, drawingQueueCopy[i].model);
+        GLint cmd = view->getDrawCommand(i);
+        if(drawingQueueCopy[i].type == RenderableType::SOLID && cmd > -2)
+            content->DrawObject(drawingQueueCopy[i].objectId, drawingQueueCopy[i].lookId, drawingQueueCopy[i].model, cmd);
     }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 }
 
 void OpenGLPipeline::DrawLights()
@@ -258,7 +307,12 @@ void OpenGLPipeline::DrawHelpers()
             else if(drawingQueueCopy[h].type == RenderableType::SENSOR_POINTS)
                 content->DrawPrimitives(PrimitiveType::POINTS, drawingQueueCopy[h].points, glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
             else if(drawingQueueCopy[h].type == RenderableType::SENSOR_LINES)
-                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].points, glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
+            {
+                if(drawingQueueCopy[h].objectId >= 0) //Cached geometry
+                    content->DrawHelperGeometry(drawingQueueCopy[h].objectId, glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
+                else
+                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].points, glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
+            }
             else if(drawingQueueCopy[h].type == RenderableType::SENSOR_LINE_STRIP)
                 content->DrawPrimitives(PrimitiveType::LINE_STRIP, drawingQueueCopy[h].points, glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
         }
@@ -341,6 +395,154 @@ void OpenGLPipeline::DrawHelpers()
     }
 }
 
+void OpenGLPipeline::DrawLitView(OpenGLCamera* camera, Ocean* ocean, Atmosphere* atm, unsigned int renderMode)
+{
+    //Apply view properties
+    OpenGLLight::SetCamera(camera);
+    GLint* viewport = camera->GetViewport();
+    content->SetViewportSize(viewport[2],viewport[3]);
+
+    //Bake parallel-split shadowmaps for sun
+    if(rSettings.shadows > RenderQuality::DISABLED)
+    {
+        content->SetDrawingMode(DrawingMode::SHADOW);
+        atm->getOpenGLAtmosphere()->BakeShadowmaps(this, camera);
+    }
+    atm->getOpenGLAtmosphere()->SetupMaterialShaders();
+
+    //Clear main framebuffer and setup camera
+    OpenGLState::BindFramebuffer(camera->getRenderFBO());
+    camera->SetRenderBuffers(0, true, false);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    
+    camera->SetViewport();
+    content->SetCurrentView(camera);
+    camera->CullObjects(drawingQueueCopy);
+    
+    //Draw scene
+    if(renderMode == 0) //NO OCEAN
+    {
+        //Render all objects
+        content->SetDrawingMode(DrawingMode::FULL);
+        DrawObjects(camera);
+        DrawLights();
+        camera->BuildHiZ();
+
+        //Ambient occlusion
+        if(rSettings.ao > RenderQuality::DISABLED)
+            camera->DrawAO(1.0f);
+        
+        //Render sky (at the end to take profit of early bailing)
+        atm->getOpenGLAtmosphere()->DrawSkyAndSun(camera);
+    }
+    else if(renderMode == 1) //OCEAN
+    {
+        OpenGLOcean* glOcean = ocean->getOpenGLOcean();
+        
+        //Update ocean for this camera
+        if(ocean->hasWaves())
+            glOcean->UpdateSurface(camera);
+
+        //Two separate rendering paths: above water and under water, 
+        //possible because camera near plane is (virtually) removed with logarithmic depth buffer.
+        glm::vec3 eye = camera->GetEyePosition();
+        if(ocean->GetDepth(eye) > 0.0) //Underwater
+        {  
+            content->SetDrawingMode(DrawingMode::UNDERWATER);
+            DrawObjects(camera);
+            camera->BuildHiZ();
+            glOcean->DrawBackground(camera);
+            glOcean->DrawBacksurface(camera);
+            //camera->GenerateBloom();
+            DrawLights();
+            
+            if(rSettings.ssr > RenderQuality::DISABLED)
+            {
+                //Linear depth front faces
+                camera->GenerateLinearDepth(true);
+                
+                //Linear depth back faces
+                OpenGLState::BindFramebuffer(camera->getPostprocessFBO());
+                glClear(GL_DEPTH_BUFFER_BIT);
+                glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+                glCullFace(GL_FRONT);
+                content->SetDrawingMode(DrawingMode::FLAT);
+                DrawObjects(camera);
+                glCullFace(GL_BACK);
+                glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                camera->GenerateLinearDepth(false);
+                
+                //Draw screen-space reflections
+                camera->DrawSSR();
+            }
+
+            //Draw bloom effect simulating scattering
+            //camera->DrawBloom((GLfloat)ocean->getWaterType());
+
+            //Suspended particles only below surface
+            glDepthMask(GL_FALSE);
+            glOcean->DrawParticles(camera);
+            glDepthMask(GL_TRUE);
+            
+        }
+        else //Above water
+        {
+            content->SetDrawingMode(DrawingMode::UNDERWATER);
+            DrawObjects(camera);
+            DrawLights();
+            camera->BuildHiZ();
+            glOcean->DrawBackground(camera);
+
+            //Draw surface to back buffer
+            camera->SetRenderBuffers(1, false, true); //Clearing color buffer
+            camera->SetRenderBuffers(1, true, false); //Color + Normal
+            glOcean->DrawSurface(camera);
+            camera->SetRenderBuffers(0, false, false); //Color only
+            
+            //Blend surface on top of scene
+            OpenGLState::DisableDepthTest();
+            OpenGLState::EnableBlend();
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            content->DrawTexturedSAQ(camera->getColorTexture(1));
+            OpenGLState::DisableBlend();
+            OpenGLState::EnableDepthTest();
+            
+            //Draw all objects as above surface 
+            //(depth testing will secure drawing only what is above water)
+            camera->SetRenderBuffers(0, true, false); //Color + Normal
+            content->SetDrawingMode(DrawingMode::FULL);
+            DrawObjects(camera);
+            DrawLights();
+        
+            //Render sky (left for the end to only fill empty spaces)
+            atm->getOpenGLAtmosphere()->DrawSkyAndSun(camera);    
+
+            //Postprocess
+            if(rSettings.ssr > RenderQuality::DISABLED)
+            {
+                //Linear depth front faces
+                camera->GenerateLinearDepth(true);
+            
+                //Linear depth back faces
+                OpenGLState::BindFramebuffer(camera->getPostprocessFBO());
+                glClear(GL_DEPTH_BUFFER_BIT);
+                glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+                glCullFace(GL_FRONT);
+                content->SetDrawingMode(DrawingMode::FLAT);
+                DrawObjects(camera);
+                glCullFace(GL_BACK);
+                glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                camera->GenerateLinearDepth(false);
+                
+                //Draw screen-space reflections
+                camera->DrawSSR();
+            }
+        }
+    }
+
+    delete [] viewport;
+}
+
 void OpenGLPipeline::Render(SimulationManager* sim)
 {	
     //Update time step for animation purposes
@@ -556,153 +758,33 @@ void OpenGLPipeline::Render(SimulationManager* sim)
             }
             break;
 
+            case ViewType::MULTI_CAMERA:
+            {
+                //Geometry outputs only -> skip the lit pass
+                OpenGLMultiCamera* camera = static_cast<OpenGLMultiCamera*>(view);
+                if(!camera->isColorEnabled())
+                {
+                    camera->ComputeOutput(drawingQueueCopy, false);
+                    camera->DrawLDR(screenFBO, true);
+                    break;
+                }
+            }
+            [[fallthrough]];
             case ViewType::CAMERA:
             case ViewType::TRACKBALL:
             case ViewType::EVENT_BASED_CAMERA:
             {
-                //Apply view properties
+                //Apply view properties and draw the scene
                 OpenGLCamera* camera = static_cast<OpenGLCamera*>(view);
-                OpenGLLight::SetCamera(camera);
-                GLint* viewport = camera->GetViewport();
-                content->SetViewportSize(viewport[2],viewport[3]);
-            
-                //Bake parallel-split shadowmaps for sun
-                if(rSettings.shadows > RenderQuality::DISABLED)
-                {
-                    content->SetDrawingMode(DrawingMode::SHADOW);
-                    atm->getOpenGLAtmosphere()->BakeShadowmaps(this, camera);
-                }
-                atm->getOpenGLAtmosphere()->SetupMaterialShaders();
-            
-                //Clear main framebuffer and setup camera
-                OpenGLState::BindFramebuffer(camera->getRenderFBO());
-                camera->SetRenderBuffers(0, true, false);
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-                
-                camera->SetViewport();
-                content->SetCurrentView(camera);
-                
-                //Draw scene
-                if(renderMode == 0) //NO OCEAN
-                {
-                    //Render all objects
-                    content->SetDrawingMode(DrawingMode::FULL);
-                    DrawObjects();
-                    DrawLights();
-
-                    //Ambient occlusion
-                    if(rSettings.ao > RenderQuality::DISABLED)
-                        camera->DrawAO(1.0f);
-                    
-                    //Render sky (at the end to take profit of early bailing)
-                    atm->getOpenGLAtmosphere()->DrawSkyAndSun(camera);
-                }
-                else if(renderMode == 1) //OCEAN
-                {
-                    OpenGLOcean* glOcean = ocean->getOpenGLOcean();
-                    
-                    //Update ocean for this camera
-                    if(ocean->hasWaves())
-                        glOcean->UpdateSurface(camera);
-
-                    //Two separate rendering paths: above water and under water, 
-                    //possible because camera near plane is (virtually) removed with logarithmic depth buffer.
-                    glm::vec3 eye = camera->GetEyePosition();
-                    if(ocean->GetDepth(eye) > 0.0) //Underwater
-                    {  
-                        content->SetDrawingMode(DrawingMode::UNDERWATER);
-                        DrawObjects();
-                        glOcean->DrawBackground(camera);
-                        glOcean->DrawBacksurface(camera);
-                        //camera->GenerateBloom();
-                        DrawLights();
-                        
-                        if(rSettings.ssr > RenderQuality::DISABLED)
-                        {
-                            //Linear depth front faces
-                            camera->GenerateLinearDepth(true);
-                            
-                            //Linear depth back faces
-                            OpenGLState::BindFramebuffer(camera->getPostprocessFBO());
-                            glClear(GL_DEPTH_BUFFER_BIT);
-                            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-                            glCullFace(GL_FRONT);
-                            content->SetDrawingMode(DrawingMode::FLAT);
-                            DrawObjects();
-                            glCullFace(GL_BACK);
-                            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-                            camera->GenerateLinearDepth(false);
-                            
-                            //Draw screen-space reflections
-                            camera->DrawSSR();
-                        }
-
-                        //Draw bloom effect simulating scattering
-                        //camera->DrawBloom((GLfloat)ocean->getWaterType());
-
-                        //Suspended particles only below surface
-                        glDepthMask(GL_FALSE);
-                        glOcean->DrawParticles(camera);
-                        glDepthMask(GL_TRUE);
-                        
-                    }
-                    else //Above water
-                    {
-                        content->SetDrawingMode(DrawingMode::UNDERWATER);
-                        DrawObjects();
-                        DrawLights();
-                        glOcean->DrawBackground(camera);
-
-                        //Draw surface to back buffer
-                        camera->SetRenderBuffers(1, false, true); //Clearing color buffer
-                        camera->SetRenderBuffers(1, true, false); //Color + Normal
-                        glOcean->DrawSurface(camera);
-                        camera->SetRenderBuffers(0, false, false); //Color only
-                        
-                        //Blend surface on top of scene
-                        OpenGLState::DisableDepthTest();
-                        OpenGLState::EnableBlend();
-                        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-                        content->DrawTexturedSAQ(camera->getColorTexture(1));
-                        OpenGLState::DisableBlend();
-                        OpenGLState::EnableDepthTest();
-                        
-                        //Draw all objects as above surface 
-                        //(depth testing will secure drawing only what is above water)
-                        camera->SetRenderBuffers(0, true, false); //Color + Normal
-                        content->SetDrawingMode(DrawingMode::FULL);
-                        DrawObjects();
-                        DrawLights();
-                    
-                        //Render sky (left for the end to only fill empty spaces)
-                        atm->getOpenGLAtmosphere()->DrawSkyAndSun(camera);    
-
-                        //Postprocess
-                        if(rSettings.ssr > RenderQuality::DISABLED)
-                        {
-                            //Linear depth front faces
-                            camera->GenerateLinearDepth(true);
-                        
-                            //Linear depth back faces
-                            OpenGLState::BindFramebuffer(camera->getPostprocessFBO());
-                            glClear(GL_DEPTH_BUFFER_BIT);
-                            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-                            glCullFace(GL_FRONT);
-                            content->SetDrawingMode(DrawingMode::FLAT);
-                            DrawObjects();
-                            glCullFace(GL_BACK);
-                            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-                            camera->GenerateLinearDepth(false);
-                            
-                            //Draw screen-space reflections
-                            camera->DrawSSR();
-                        }
-                    }
-                }
+                DrawLitView(camera, ocean, atm, renderMode);
 
                 //Special case for event-based cameras
                 if(camera->getType() == ViewType::EVENT_BASED_CAMERA)
                     static_cast<OpenGLEventBasedCamera*>(camera)->ComputeOutput(now);
+                
+                //Multi-output cameras reuse the culling of the lit pass
+                if(camera->getType() == ViewType::MULTI_CAMERA)
+                    static_cast<OpenGLMultiCamera*>(camera)->ComputeOutput(drawingQueueCopy, true);
 
                 //Drawing to the screen
                 camera->DrawLDR(screenFBO, true);
@@ -751,8 +833,22 @@ void OpenGLPipeline::Render(SimulationManager* sim)
                                     
                     OpenGLState::BindFramebuffer(0);
                 }
-            
-                delete [] viewport;
+            }
+            break;
+
+            case ViewType::CAMERA_RIG:
+            {
+                //All cameras of the rig rendered in the same frame, sharing culling, shadows and a single readback
+                OpenGLCameraRig* rig = static_cast<OpenGLCameraRig*>(view);
+                for(unsigned int e=0; e<rig->getNumOfEyes(); ++e)
+                {
+                    OpenGLState::EnableDepthTest();
+                    OpenGLState::EnableCullFace();
+                    OpenGLState::DisableBlend();
+                    rig->setActiveEye(e);
+                    DrawLitView(rig, ocean, atm, renderMode);
+                    rig->DrawLDR(screenFBO, true);
+                }
             }
             break;
         }
@@ -26,11 +26,12 @@
 #include "graphics/OpenGLRealCamera.h"
 
 #include "core/GraphicalSimulationApp.h"
-#include "sensors/vision/ColorCamera.h"
+#include "sensors/vision/Camera.h"
 #include "graphics/OpenGLState.h"
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLOutputStage.h"
 
 namespace sf
 {
@@ -45,6 +46,7 @@ OpenGLRealCamera::OpenGLRealCamera(glm::vec3 eyePosition, glm::vec3 direction, g
     continuous = continuousUpdate;
     camera = NULL;
     cameraFBO = 0;
+    outputStage = nullptr;
     
     //Setup view
     SetupCamera(eyePosition, direction, cameraUp);
@@ -64,6 +66,8 @@ OpenGLRealCamera::~OpenGLRealCamera()
         glDeleteBuffers(1, &cameraPBO);
         glDeleteTextures(2, cameraColorTex);
     }
+    if(outputStage != nullptr)
+        delete outputStage;
 }
 
 ViewType OpenGLRealCamera::getType() const
@@ -87,7 +91,7 @@ bool OpenGLRealCamera::needsUpdate()
         return false;
 }
 
-void OpenGLRealCamera::setCamera(ColorCamera* cam)
+void OpenGLRealCamera::setCamera(Camera* cam)
 {
     //Connect with camera sensor
     camera = cam;
@@ -102,9 +106,16 @@ void OpenGLRealCamera::setCamera(ColorCamera* cam)
     textures.push_back(FBOTexture(GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, cameraColorTex[1]));
     cameraFBO = OpenGLContent::GenerateFramebuffer(textures);
     
+    //Crop, bin and convert on the GPU if needed
+    unsigned int resX, resY;
+    camera->getResolution(resX, resY);
+    CameraOutputSettings output = camera->getOutputSettings();
+    if(!output.isPassThrough(resX, resY))
+        outputStage = new OpenGLOutputStage(OutputStageSource::COLOR, output);
+    
     glGenBuffers(1, &cameraPBO);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, cameraPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, viewportWidth * viewportHeight * 3, 0, GL_STREAM_READ);
+    glBufferData(GL_PIXEL_PACK_BUFFER, outputStage != nullptr ? outputStage->getDataSize() : viewportWidth * viewportHeight * 3, 0, GL_STREAM_READ);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 
@@ -172,22 +183,30 @@ void OpenGLRealCamera::DrawLDR(GLuint destinationFBO, bool updated)
     {
         OpenGLCamera::DrawLDR(cameraFBO, updated);
 
-        OpenGLState::BindFramebuffer(cameraFBO);
-        OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
-        glDrawBuffer(GL_COLOR_ATTACHMENT1);
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, cameraColorTex[0]);
-        flipShader->Use();
-        flipShader->SetUniform("texSource", TEX_POSTPROCESS1);
-        ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawSAQ();
-        OpenGLState::UseProgram(0);
-        OpenGLState::BindFramebuffer(0);
+        if(outputStage != nullptr)
+        {
+            outputStage->Process(cameraColorTex[0], viewportHeight, cameraPBO); //Flipped in the output stage
+            newData = true;
+        }
+        else
+        {
+            OpenGLState::BindFramebuffer(cameraFBO);
+            OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
+            glDrawBuffer(GL_COLOR_ATTACHMENT1);
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, cameraColorTex[0]);
+            flipShader->Use();
+            flipShader->SetUniform("texSource", TEX_POSTPROCESS1);
+            ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawSAQ();
+            OpenGLState::UseProgram(0);
+            OpenGLState::BindFramebuffer(0);
 
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, cameraColorTex[1]);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, cameraPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
-        newData = true;
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, cameraColorTex[1]);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, cameraPBO);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+            newData = true;
+        }
     }
     
     //Check if there is a need to display image on screen
@@ -37,9 +37,8 @@
 namespace sf
 {
 
-OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrodynamics) : OpenGLOcean(size)
+OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state) : OpenGLOcean(size)
 {
-    hydroMutex = hydrodynamics;
     params.wind = state*5.f + 2.f;
     params.A = 1.f;
     params.omega = 5.f*expf(-state) + 0.2f;
@@ -61,6 +60,7 @@ OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrody
 	oceanShaders["lod"]->BindShaderStorageBlock("QTreeCull", SSBO_QTREE_CULL);
     oceanShaders["lod"]->BindShaderStorageBlock("TreeSize", SSBO_QTREE_SIZE);
 	oceanShaders["lod"]->AddUniform("gridSizes", ParameterType::VEC4);
+	oceanShaders["lod"]->AddUniform("waveOrigin", ParameterType::VEC2);
     oceanShaders["lod"]->AddUniform("texWaveFFT", ParameterType::INT);
 
     sources.clear();
@@ -91,6 +91,7 @@ OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrody
     oceanShaders["surface"]->AddUniform("MV", ParameterType::MAT3);
     oceanShaders["surface"]->AddUniform("FC", ParameterType::FLOAT);
     oceanShaders["surface"]->AddUniform("gridSizes", ParameterType::VEC4);
+    oceanShaders["surface"]->AddUniform("waveOrigin", ParameterType::VEC2);
     oceanShaders["surface"]->AddUniform("u_gpu_tess_factor", ParameterType::FLOAT);
     oceanShaders["surface"]->AddUniform("texWaveFFT", ParameterType::INT);
 	oceanShaders["surface"]->AddUniform("texSlopeVariance", ParameterType::INT);
@@ -122,6 +123,7 @@ OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrody
     oceanShaders["surfaceTemp"]->AddUniform("MV", ParameterType::MAT3);
     oceanShaders["surfaceTemp"]->AddUniform("FC", ParameterType::FLOAT);
     oceanShaders["surfaceTemp"]->AddUniform("gridSizes", ParameterType::VEC4);
+    oceanShaders["surfaceTemp"]->AddUniform("waveOrigin", ParameterType::VEC2);
     oceanShaders["surfaceTemp"]->AddUniform("u_gpu_tess_factor", ParameterType::FLOAT);
     oceanShaders["surfaceTemp"]->AddUniform("texWaveFFT", ParameterType::INT);
 	oceanShaders["surfaceTemp"]->AddUniform("texSlopeVariance", ParameterType::INT);
@@ -155,6 +157,7 @@ OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrody
     oceanShaders["backsurface"]->AddUniform("MV", ParameterType::MAT3);
     oceanShaders["backsurface"]->AddUniform("FC", ParameterType::FLOAT);
     oceanShaders["backsurface"]->AddUniform("gridSizes", ParameterType::VEC4);
+    oceanShaders["backsurface"]->AddUniform("waveOrigin", ParameterType::VEC2);
     oceanShaders["backsurface"]->AddUniform("u_gpu_tess_factor", ParameterType::FLOAT);
     oceanShaders["backsurface"]->AddUniform("texWaveFFT", ParameterType::INT);
 	oceanShaders["backsurface"]->AddUniform("texSlopeVariance", ParameterType::INT);
@@ -182,6 +185,7 @@ OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrody
     oceanShaders["mask"]->AddUniform("eyePos", ParameterType::VEC3);
     oceanShaders["mask"]->AddUniform("texWaveFFT", ParameterType::INT);
     oceanShaders["mask"]->AddUniform("gridSizes", ParameterType::VEC4);
+    oceanShaders["mask"]->AddUniform("waveOrigin", ParameterType::VEC2);
     oceanShaders["mask"]->AddUniform("MVP", ParameterType::MAT4);
     oceanShaders["mask"]->AddUniform("FC", ParameterType::FLOAT);    
     oceanShaders["mask"]->AddUniform("u_gpu_tess_factor", ParameterType::FLOAT);
@@ -189,12 +193,18 @@ OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrody
 
     //FFT data transfer
     size_t fftDataSize = params.fftSize * params.fftSize * 4 * layers;
-    fftData = new GLfloat[fftDataSize];
-    memset(fftData, 0, sizeof(GLfloat) * fftDataSize);
+    for(size_t i=0; i<3; ++i)
+    {
+        fftData[i] = new GLfloat[fftDataSize];
+        memset(fftData[i], 0, sizeof(GLfloat) * fftDataSize);
+    }
+    fftWrite = 0;
+    fftPublished = 1;
+    fftRead = 2;
     
     glGenBuffers(1, &fftPBO);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, fftPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, params.fftSize * params.fftSize * 4 * layers * sizeof(GLfloat), fftData, GL_STREAM_READ);
+    glBufferData(GL_PIXEL_PACK_BUFFER, params.fftSize * params.fftSize * 4 * layers * sizeof(GLfloat), fftData[0], GL_STREAM_READ);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     //Quad tree buffers
@@ -264,7 +274,8 @@ OpenGLRealOcean::~OpenGLRealOcean()
         glDeleteBuffers(1, &it->second.patchAC);
     }
     oceanTrees.clear();
-    delete fftData;
+    for(size_t i=0; i<3; ++i)
+        delete [] fftData[i];
 }
 
 void OpenGLRealOcean::setWireframe(bool enabled)
@@ -307,10 +318,11 @@ GLfloat OpenGLRealOcean::ComputeInterpolatedWaveData(GLfloat x, GLfloat y, GLuin
     
     //Get texel values
     float t[4];
-    t[0] = fftData[(j0 * params.fftSize + i0) * 4 + channel];
-    t[1] = fftData[(j0 * params.fftSize + i1) * 4 + channel];
-    t[2] = fftData[(j1 * params.fftSize + i0) * 4 + channel];
-    t[3] = fftData[(j1 * params.fftSize + i1) * 4 + channel];
+    const GLfloat* data = fftData[fftRead.load(std::memory_order_relaxed)];
+    t[0] = data[(j0 * params.fftSize + i0) * 4 + channel];
+    t[1] = data[(j0 * params.fftSize + i1) * 4 + channel];
+    t[2] = data[(j1 * params.fftSize + i0) * 4 + channel];
+    t[3] = data[(j1 * params.fftSize + i1) * 4 + channel];
     
     //Interpolate
     float h = (1.f - alpha)*(1.f - beta)*t[0] + alpha*(1.f - beta)*t[1] + (1.f - alpha)*beta*t[2] + alpha*beta*t[3];
@@ -332,18 +344,16 @@ GLfloat OpenGLRealOcean::ComputeWaveHeight(GLfloat x, GLfloat y)
 
 void OpenGLRealOcean::Simulate(GLfloat dt)
 {
-    if(SDL_TryLockMutex(hydroMutex) == 0)
+    //Copy wave data of the previous frame and publish it, without waiting for the simulation thread
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, fftPBO);
+    GLfloat* src = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if(src)
     {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, fftPBO);
-        GLfloat* src = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
-        {
-            memcpy(fftData, src, params.fftSize * params.fftSize * 4 * 4 * sizeof(GLfloat));
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
-        }
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        SDL_UnlockMutex(hydroMutex);
+        memcpy(fftData[fftWrite], src, params.fftSize * params.fftSize * 4 * 4 * sizeof(GLfloat));
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+        fftWrite = fftPublished.exchange(fftWrite | 4u, std::memory_order_acq_rel) & 3u;
     }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     OpenGLOcean::Simulate(dt);
 
@@ -355,6 +365,15 @@ void OpenGLRealOcean::Simulate(GLfloat dt)
     OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
 }
 
+void OpenGLRealOcean::AcquireWaveData()
+{
+    if(fftPublished.load(std::memory_order_relaxed) & 4u) //New data published since the last call
+    {
+        GLuint published = fftPublished.exchange(fftRead.load(std::memory_order_relaxed), std::memory_order_acq_rel);
+        fftRead.store(published & 3u, std::memory_order_relaxed);
+    }
+}
+
 void OpenGLRealOcean::ResetSurface(OpenGLView* view)
 {
     auto it = oceanTrees.find(view); //Check if a quad tree exists for this camera
@@ -453,6 +472,7 @@ void OpenGLRealOcean::UpdateSurface(OpenGLView* view)
 	oceanShaders["lod"]->Use();
     oceanShaders["lod"]->SetUniform("sceneSize", oceanSize);
 	oceanShaders["lod"]->SetUniform("gridSizes", params.gridSizes);
+	oceanShaders["lod"]->SetUniform("waveOrigin", waveOrigin);
 	oceanShaders["lod"]->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
     glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, tree->patchDI);
     glDispatchComputeIndirect(0);
@@ -487,6 +507,7 @@ void OpenGLRealOcean::DrawSurface(OpenGLView* view)
     oceanShaders["surface"]->SetUniform("eyePos", view->GetEyePosition());
     oceanShaders["surface"]->SetUniform("viewDir", view->GetLookingDirection());
     oceanShaders["surface"]->SetUniform("gridSizes", params.gridSizes);
+    oceanShaders["surface"]->SetUniform("waveOrigin", waveOrigin);
     oceanShaders["surface"]->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
     oceanShaders["surface"]->SetUniform("texSlopeVariance", TEX_POSTPROCESS2);
     oceanShaders["surface"]->SetUniform("u_scene_size", oceanSize);
@@ -526,6 +547,7 @@ void OpenGLRealOcean::DrawSurfaceTemperature(OpenGLView* view)
     oceanShaders["surfaceTemp"]->SetUniform("eyePos", view->GetEyePosition());
     oceanShaders["surfaceTemp"]->SetUniform("viewDir", view->GetLookingDirection());
     oceanShaders["surfaceTemp"]->SetUniform("gridSizes", params.gridSizes);
+    oceanShaders["surfaceTemp"]->SetUniform("waveOrigin", waveOrigin);
     oceanShaders["surfaceTemp"]->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
     oceanShaders["surfaceTemp"]->SetUniform("texSlopeVariance", TEX_POSTPROCESS2);
     oceanShaders["surfaceTemp"]->SetUniform("u_scene_size", oceanSize);
@@ -556,6 +578,7 @@ void OpenGLRealOcean::DrawBacksurface(OpenGLView* view)
     oceanShaders["backsurface"]->SetUniform("viewport", glm::vec2((GLfloat)viewport[2], (GLfloat)viewport[3]));
     oceanShaders["backsurface"]->SetUniform("eyePos", view->GetEyePosition());
     oceanShaders["backsurface"]->SetUniform("gridSizes", params.gridSizes);
+    oceanShaders["backsurface"]->SetUniform("waveOrigin", waveOrigin);
     oceanShaders["backsurface"]->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
     oceanShaders["backsurface"]->SetUniform("texSlopeVariance", TEX_POSTPROCESS2);
     oceanShaders["backsurface"]->SetUniform("u_scene_size", oceanSize);
@@ -596,6 +619,7 @@ void OpenGLRealOcean::DrawUnderwaterMask(OpenGLView* view)
     oceanShaders["mask"]->SetUniform("MVP", view->GetProjectionMatrix() * view->GetViewMatrix());
     oceanShaders["mask"]->SetUniform("FC", view->GetLogDepthConstant());
     oceanShaders["mask"]->SetUniform("gridSizes", params.gridSizes);
+    oceanShaders["mask"]->SetUniform("waveOrigin", waveOrigin);
     oceanShaders["mask"]->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
     oceanShaders["mask"]->SetUniform("eyePos", view->GetEyePosition());
     oceanShaders["mask"]->SetUniform("u_scene_size", oceanSize);
@@ -32,6 +32,7 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLOutputStage.h"
 #include "entities/forcefields/Ocean.h"
 
 namespace sf
@@ -46,10 +47,13 @@ OpenGLSegmentationCamera::OpenGLSegmentationCamera(glm::vec3 eyePosition, glm::v
                           GLfloat horizontalFOVDeg, glm::vec2 range, bool continuousUpdate)
  : OpenGLView(originX, originY, width, height)
 {
+    Init(); //Shaders are loaded on first use
     _needsUpdate = false;
     continuous = continuousUpdate;
     newData = false;
     camera = nullptr;
+    outputStage[0] = nullptr;
+    outputStage[1] = nullptr;
     this->range = range;
     
     SetupCamera(eyePosition, direction, cameraUp);
@@ -125,6 +129,10 @@ OpenGLSegmentationCamera::~OpenGLSegmentationCamera()
         glDeleteBuffers(1, &outputPBO);
         glDeleteBuffers(1, &displayPBO);
     }
+    if(outputStage[0] != nullptr)
+        delete outputStage[0];
+    if(outputStage[1] != nullptr)
+        delete outputStage[1];
 }
 
 void OpenGLSegmentationCamera::SetupCamera(glm::vec3 _eye, glm::vec3 _dir, glm::vec3 _up)
@@ -234,14 +242,24 @@ void OpenGLSegmentationCamera::setCamera(Camera* cam, unsigned int index)
 {
     camera = cam;
 
+    //Crop and subsample on the GPU if needed (ids and their color map)
+    unsigned int resX, resY;
+    camera->getResolution(resX, resY);
+    CameraOutputSettings output = camera->getOutputSettings();
+    if(!output.isPassThrough(resX, resY))
+    {
+        outputStage[0] = new OpenGLOutputStage(OutputStageSource::ID, output);
+        outputStage[1] = new OpenGLOutputStage(OutputStageSource::COLOR, output);
+    }
+
     glGenBuffers(1, &outputPBO);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, viewportWidth * viewportHeight * sizeof(GLushort), 0, GL_STREAM_READ);
+    glBufferData(GL_PIXEL_PACK_BUFFER, outputStage[0] != nullptr ? outputStage[0]->getDataSize() : viewportWidth * viewportHeight * sizeof(GLushort), 0, GL_STREAM_READ);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     glGenBuffers(1, &displayPBO);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, viewportWidth * viewportHeight * 3 * sizeof(GLubyte), 0, GL_STREAM_READ);
+    glBufferData(GL_PIXEL_PACK_BUFFER, outputStage[1] != nullptr ? outputStage[1]->getDataSize() : viewportWidth * viewportHeight * 3 * sizeof(GLubyte), 0, GL_STREAM_READ);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 
@@ -330,7 +348,13 @@ void OpenGLSegmentationCamera::DrawLDR(GLuint destinationFBO, bool updated)
     }
 
     //Copy texture to camera buffer
-    if(camera != nullptr && updated)
+    if(camera != nullptr && updated && outputStage[0] != nullptr)
+    {
+        outputStage[0]->Process(renderSegTex[1], 0, outputPBO);
+        outputStage[1]->Process(displaySegTex, 0, displayPBO);
+        newData = true;
+    }
+    else if(camera != nullptr && updated)
     {
         OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderSegTex[1]);
         glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
@@ -348,6 +372,9 @@ void OpenGLSegmentationCamera::DrawLDR(GLuint destinationFBO, bool updated)
 ///////////////////////// Static /////////////////////////////
 void OpenGLSegmentationCamera::Init()
 {
+    if(segmentationCameraOutputShader != nullptr) //Already loaded
+        return;
+
     segmentationCameraOutputShader = new GLSLShader("segmentation.frag", "segmentation.vert");
     segmentationCameraOutputShader->AddUniform("MVP", ParameterType::MAT4);
     segmentationCameraOutputShader->AddUniform("M", ParameterType::MAT4);
@@ -366,6 +393,9 @@ void OpenGLSegmentationCamera::Destroy()
     if(segmentationCameraOutputShader != nullptr) delete segmentationCameraOutputShader;
     if(segmentationVisualizeShader != nullptr) delete segmentationVisualizeShader;
     if(flipShader != nullptr) delete flipShader;
+    segmentationCameraOutputShader = nullptr;
+    segmentationVisualizeShader = nullptr;
+    flipShader = nullptr;
 }
 
 }
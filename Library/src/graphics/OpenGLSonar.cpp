@@ -43,6 +43,7 @@ GLSLShader* OpenGLSonar::sonarVisualizeShader = nullptr;
 OpenGLSonar::OpenGLSonar(glm::vec3 eyePosition, glm::vec3 direction, glm::vec3 sonarUp, glm::uvec2 displayResolution, glm::vec2 range_)
     : OpenGLView(0, 0, displayResolution.x, displayResolution.y), randDist(0.f, 1.f)
 {
+    Init(); //Shaders are loaded on first use
     _needsUpdate = false;
     continuous = false;
     newData = false;
@@ -163,6 +164,9 @@ ViewType OpenGLSonar::getType() const
 ///////////////////////// Static /////////////////////////////
 void OpenGLSonar::Init()
 {
+    if(sonarInputShader[0] != nullptr) //Already loaded
+        return;
+
     sonarInputShader[0] = new GLSLShader("sonarInput.frag", "sonarInput.vert");
     sonarInputShader[0]->AddUniform("MVP", ParameterType::MAT4);
     sonarInputShader[0]->AddUniform("M", ParameterType::MAT4);
@@ -191,6 +195,9 @@ void OpenGLSonar::Destroy()
     if(sonarInputShader[0] != nullptr) delete sonarInputShader[0];
     if(sonarInputShader[1] != nullptr) delete sonarInputShader[1];
     if(sonarVisualizeShader != nullptr) delete sonarVisualizeShader;
+    sonarInputShader[0] = nullptr;
+    sonarInputShader[1] = nullptr;
+    sonarVisualizeShader = nullptr;
 }
 
 }
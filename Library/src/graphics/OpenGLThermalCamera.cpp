@@ -44,6 +44,7 @@ OpenGLThermalCamera::OpenGLThermalCamera(glm::vec3 eyePosition, glm::vec3 direct
                           glm::vec2 tempRange, glm::vec2 depthRange, bool continuousUpdate)
  : OpenGLView(originX, originY, width, height), camera(nullptr), _needsUpdate(false), newData(false), temperatureNoise(0.f), randDist(0.f, 1.f)
 {
+    Init(); //Shaders are loaded on first use
     continuous = continuousUpdate;
     this->depthRange = depthRange;
     temperatureRange = displayRange = tempRange;
@@ -334,7 +335,10 @@ void OpenGLThermalCamera::DrawLDR(GLuint destinationFBO, bool updated)
 
 ///////////////////////// Static /////////////////////////////
 void OpenGLThermalCamera::Init()
-{   
+{
+    if(thermalOutputShader != nullptr) //Already loaded
+        return;
+
     thermalOutputShader = new GLSLShader("thermalOutput.frag");
     thermalOutputShader->AddUniform("texSource", ParameterType::INT);
     thermalOutputShader->AddUniform("temperatureRange", ParameterType::VEC2);
@@ -351,6 +355,8 @@ void OpenGLThermalCamera::Destroy()
 {
     if(thermalOutputShader != nullptr) delete thermalOutputShader;
     if(thermalVisualizeShader != nullptr) delete thermalVisualizeShader;
+    thermalOutputShader = nullptr;
+    thermalVisualizeShader = nullptr;
 }
 
 }
@@ -51,6 +51,7 @@ OpenGLTrackball::OpenGLTrackball(glm::vec3 centerPosition, GLfloat orbitRadius,
     transMode = false;
     continuous = true;
     holdingEntity = nullptr;
+    tempShift = glm::vec3(0.f);
 
     outlineShader[0] = new GLSLShader("outline.frag");
     outlineShader[0]->AddUniform("color", ParameterType::VEC4);
@@ -107,9 +108,18 @@ void OpenGLTrackball::UpdateCenterPos()
     }
 }
 
+void OpenGLTrackball::ShiftOrigin(const glm::vec3& shift)
+{
+    tempShift += shift;
+}
+
 void OpenGLTrackball::UpdateTransform()
 {
-    if(holdingEntity != nullptr) center = tempCenter;
+    if(holdingEntity != nullptr)
+        center = tempCenter; //Already expressed in the shifted frame
+    else
+        center -= tempShift;
+    tempShift = glm::vec3(0.f);
     trackballTransform = glm::lookAt(GetEyePosition(), center, GetUpDirection());
     
     viewUBOData.VP = GetProjectionMatrix() * GetViewMatrix();
@@ -199,6 +209,11 @@ void OpenGLTrackball::GlueToMoving(MovingEntity* ent)
         ((OpenGLRealOcean*)ocean->getOpenGLOcean())->ResetSurface(this);
 }
 
+MovingEntity* OpenGLTrackball::getHoldingEntity() const
+{
+    return holdingEntity;
+}
+
 void OpenGLTrackball::DrawSelection(const std::vector<Renderable>& r, GLuint destinationFBO)
 {
     if(r.size() == 0) //No selection
@@ -40,12 +40,16 @@ Joint::Joint(std::string uniqueName, bool collideLinkedEntities)
     constraint = nullptr;
     jSolidA = nullptr;
     jSolidB = nullptr;
+    feedback = nullptr;
+    feedbackEnabled = false;
 }
 
 Joint::~Joint(void)
 {
     if(SimulationApp::getApp() != nullptr)
         SimulationApp::getApp()->getSimulationManager()->getNameManager()->RemoveName(name);
+    if(feedback != nullptr)
+        delete feedback;
 }
 
 bool Joint::isMultibodyJoint()
@@ -80,11 +84,16 @@ Scalar Joint::getFeedback(unsigned int dof)
     
     if(constraint != nullptr)
     {
-        btJointFeedback* fb = constraint->getJointFeedback();
-        if(dof < 3)
-            return fb->m_appliedForceBodyA[dof];
+        if(feedback == nullptr) //Never requested -> computed from now on
+        {
+            cInfo("Feedback of joint '%s' enabled on first read.", getName().c_str());
+            setFeedbackEnabled(true);
+            return Scalar(0);
+        }
+        else if(dof < 3)
+            return feedback->m_appliedForceBodyA[dof];
         else
-            return fb->m_appliedTorqueBodyA[dof-3];
+            return feedback->m_appliedTorqueBodyA[dof-3];
     }
     else if(mbConstraint != nullptr)
     {
@@ -94,6 +103,35 @@ Scalar Joint::getFeedback(unsigned int dof)
         return Scalar(0);
 }
 
+void Joint::setFeedbackEnabled(bool enabled)
+{
+    feedbackEnabled = enabled;
+    if(enabled)
+        RequestFeedback();
+}
+
+void Joint::RequestFeedback()
+{
+    if(constraint == nullptr)
+        return;
+    
+    //Allocated on first request, so that joints without consumers never compute feedback
+    if(feedback == nullptr)
+        feedback = new btJointFeedback();
+    constraint->enableFeedback(true);
+    constraint->setJointFeedback(feedback);
+}
+
+void Joint::ClearFeedbackRequest()
+{
+    if(constraint == nullptr || feedback == nullptr || feedbackEnabled)
+        return;
+    
+    //Values of the last computed step are kept
+    constraint->enableFeedback(false);
+    constraint->setJointFeedback(nullptr);
+}
+
 SolidEntity* Joint::getSolidA()
 {
     return jSolidA;
@@ -108,11 +146,6 @@ void Joint::AddToSimulation(SimulationManager* sm)
 {
     if(constraint != nullptr)
     {
-        //Force feedback
-        btJointFeedback* fb = new btJointFeedback();
-        constraint->enableFeedback(true);
-        constraint->setJointFeedback(fb);
-
         //Breaking
         constraint->setBreakingImpulseThreshold(BT_LARGE_FLOAT);
 
@@ -156,7 +189,8 @@ void Joint::RemoveFromSimulation(SimulationManager* sm)
 {
     if(constraint != nullptr)
     {
-        delete constraint->getJointFeedback();
+        feedbackEnabled = false;
+        ClearFeedbackRequest();
         sm->getDynamicsWorld()->removeConstraint(constraint);
     }
     else if(mbConstraint != nullptr)
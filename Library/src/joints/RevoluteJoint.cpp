@@ -119,6 +119,15 @@ Scalar RevoluteJoint::getAngularVelocity()
     return relativeAV.dot(axis);
 }
 
+Scalar RevoluteJoint::getEffectiveInertia()
+{
+    btRigidBody& bodyA = getConstraint()->getRigidBodyA();
+    btRigidBody& bodyB = getConstraint()->getRigidBodyB();
+    Vector3 axis = (bodyA.getCenterOfMassTransform().getBasis() * axisInA).normalized();
+    Scalar invI = axis.dot(bodyA.getInvInertiaTensorWorld() * axis) + axis.dot(bodyB.getInvInertiaTensorWorld() * axis);
+    return invI > SIMD_EPSILON ? Scalar(1)/invI : Scalar(0);
+}
+
 void RevoluteJoint::EnableMotor(bool enable, Scalar maxTorque)
 {
     btHingeConstraint* hinge = (btHingeConstraint*)getConstraint();
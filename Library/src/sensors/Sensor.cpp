@@ -34,8 +34,7 @@
 namespace sf
 {
 
-std::random_device Sensor::randomDevice;
-std::mt19937 Sensor::randomGenerator(randomDevice());
+int Sensor::nextVisualisationId = 0;
 
 Sensor::Sensor(std::string uniqueName, Scalar frequency)
 {
@@ -48,6 +47,9 @@ Sensor::Sensor(std::string uniqueName, Scalar frequency)
     updateMutex = SDL_CreateMutex();
     lookId = -1;
     graObjectId = -1;
+    visualisationId = nextVisualisationId++;
+    visualisationOutdated = true;
+    randomGenerator.seed(SimulationApp::getApp()->getSimulationManager()->DeriveRandomSeed(name));
 }
 
 Sensor::~Sensor()
@@ -119,6 +121,7 @@ void Sensor::setVisual(const std::string& meshFilename, Scalar scale, const std:
 void Sensor::Reset()
 {
     eleapsedTime = Scalar(0.);
+    randomGenerator.seed(SimulationApp::getApp()->getSimulationManager()->DeriveRandomSeed(name));
     InternalUpdate(1.); //time delta should not affect initial measurement!!!
 }
 
@@ -150,6 +153,29 @@ void Sensor::Update(Scalar dt)
     SDL_UnlockMutex(updateMutex);
 }
 
+bool Sensor::isUpdateDue(Scalar dt) const
+{
+    if(!enabled)
+        return false;
+    return freq <= Scalar(0) || eleapsedTime + dt >= Scalar(1)/freq; //Same test as in Update()
+}
+
+bool Sensor::PrepareVisualisation(Renderable& item)
+{
+    item.type = RenderableType::SENSOR_LINES;
+    item.objectId = visualisationId;
+    item.model = glMatrixFromTransform(getSensorFrame());
+    item.points.clear();
+    bool outdated = visualisationOutdated;
+    visualisationOutdated = false;
+    return outdated;
+}
+
+void Sensor::InvalidateVisualisation()
+{
+    visualisationOutdated = true;
+}
+
 std::vector<Renderable> Sensor::Render()
 {
     std::vector<Renderable> items(0);
@@ -0,0 +1,344 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SensorDispatcher.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/SensorDispatcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sf
+{
+
+DispatchChannel::~DispatchChannel()
+{
+    Clear();
+    for(size_t i=0; i<pool.size(); ++i)
+        delete pool[i];
+}
+
+void DispatchChannel::Resize(size_t newCapacity)
+{
+    while(depth > newCapacity)
+    {
+        pool.push_back(PopFront());
+        ++stats.dropped;
+    }
+    std::vector<DispatchSample*> samples(newCapacity, nullptr);
+    for(size_t i=0; i<depth; ++i)
+        samples[i] = queue[(head + i) % capacity];
+    queue.swap(samples);
+    head = 0;
+    capacity = newCapacity;
+}
+
+void DispatchChannel::PushBack(DispatchSample* s)
+{
+    queue[(head + depth) % capacity] = s;
+    ++depth;
+}
+
+DispatchSample* DispatchChannel::PopFront()
+{
+    DispatchSample* s = queue[head];
+    queue[head] = nullptr;
+    head = (head + 1) % capacity;
+    --depth;
+    return s;
+}
+
+void DispatchChannel::Clear()
+{
+    while(depth > 0)
+        pool.push_back(PopFront());
+}
+
+SensorDispatcher::SensorDispatcher(unsigned int workers)
+{
+    mutex = SDL_CreateMutex();
+    workAvailable = SDL_CreateCond();
+    workDone = SDL_CreateCond();
+    stopping = false;
+    
+    workers = workers < 1 ? 1 : workers;
+    for(unsigned int i=0; i<workers; ++i)
+        threads.push_back(SDL_CreateThread(SensorDispatcher::WorkerLoop, "sensorDispatch", this));
+}
+
+SensorDispatcher::~SensorDispatcher()
+{
+    SDL_LockMutex(mutex);
+    stopping = true;
+    SDL_CondBroadcast(workAvailable);
+    SDL_CondBroadcast(workDone);
+    SDL_UnlockMutex(mutex);
+    
+    for(size_t i=0; i<threads.size(); ++i)
+    {
+        int status;
+        SDL_WaitThread(threads[i], &status);
+    }
+    
+    for(size_t i=0; i<channels.size(); ++i)
+    {
+        DispatchChannel* ch = channels[i];
+        ch->attached = false;
+        ch->scheduled = false;
+        ch->Clear();
+    }
+    
+    SDL_DestroyCond(workDone);
+    SDL_DestroyCond(workAvailable);
+    SDL_DestroyMutex(mutex);
+}
+
+unsigned int SensorDispatcher::getNumOfWorkers() const
+{
+    return (unsigned int)threads.size();
+}
+
+void SensorDispatcher::Attach(DispatchChannel* ch, size_t capacity, QueueOverflowPolicy policy)
+{
+    SDL_LockMutex(mutex);
+    ch->Resize(capacity < 1 ? 1 : capacity);
+    ch->policy = policy;
+    if(!ch->attached)
+    {
+        ch->attached = true;
+        channels.push_back(ch);
+        ready.reserve(channels.size()); //Each channel is scheduled at most once
+    }
+    SDL_CondBroadcast(workDone); //Blocked producer may fit into the resized queue
+    SDL_UnlockMutex(mutex);
+}
+
+void SensorDispatcher::Detach(DispatchChannel* ch)
+{
+    SDL_LockMutex(mutex);
+    if(!ch->attached)
+    {
+        SDL_UnlockMutex(mutex);
+        return;
+    }
+    
+    ch->attached = false;
+    ch->scheduled = false;
+    ready.erase(std::remove(ready.begin(), ready.end(), ch), ready.end());
+    SDL_CondBroadcast(workDone); //Release blocked producer
+    
+    while(ch->busy)
+        SDL_CondWait(workDone, mutex);
+    
+    channels.erase(std::remove(channels.begin(), channels.end(), ch), channels.end());
+    ch->Clear();
+    SDL_UnlockMutex(mutex);
+}
+
+void SensorDispatcher::DetachAll()
+{
+    SDL_LockMutex(mutex);
+    std::vector<DispatchChannel*> chs = channels;
+    SDL_UnlockMutex(mutex);
+    
+    for(size_t i=0; i<chs.size(); ++i)
+        Detach(chs[i]);
+}
+
+bool SensorDispatcher::Push(DispatchChannel* ch, const DispatchSegment& segment, const std::function<void(void*)>& callback)
+{
+    DispatchSample* s = Acquire(ch);
+    if(s == nullptr)
+        return false;
+    Fill(s, &segment, 1);
+    s->callback = callback;
+    s->multiCallback = nullptr;
+    return Enqueue(ch, s);
+}
+
+bool SensorDispatcher::Push(DispatchChannel* ch, const DispatchSegment* segments, size_t count, 
+                            const std::function<void(const std::vector<void*>&)>& callback)
+{
+    DispatchSample* s = Acquire(ch);
+    if(s == nullptr)
+        return false;
+    Fill(s, segments, count);
+    s->callback = nullptr;
+    s->multiCallback = callback;
+    return Enqueue(ch, s);
+}
+
+DispatchSample* SensorDispatcher::Acquire(DispatchChannel* ch)
+{
+    SDL_LockMutex(mutex);
+    if(!ch->attached)
+    {
+        SDL_UnlockMutex(mutex);
+        return nullptr;
+    }
+    
+    if(ch->depth >= ch->capacity)
+    {
+        if(ch->policy == QueueOverflowPolicy::DROP_NEWEST)
+        {
+            ++ch->stats.dropped;
+            SDL_UnlockMutex(mutex);
+            return nullptr;
+        }
+        else if(ch->policy == QueueOverflowPolicy::BLOCK)
+        {
+            while(ch->attached && !stopping && ch->depth >= ch->capacity)
+                SDL_CondWait(workDone, mutex);
+            
+            if(!ch->attached || stopping)
+            {
+                SDL_UnlockMutex(mutex);
+                return nullptr;
+            }
+        }
+    }
+    
+    DispatchSample* s;
+    if(ch->pool.size() > 0)
+    {
+        s = ch->pool.back();
+        ch->pool.pop_back();
+    }
+    else
+        s = new DispatchSample();
+    SDL_UnlockMutex(mutex);
+    return s;
+}
+
+void SensorDispatcher::Fill(DispatchSample* s, const DispatchSegment* segments, size_t count)
+{
+    //Copy outside of the lock (buffers of recycled samples keep their capacity)
+    size_t total = 0;
+    s->sizes.resize(count);
+    for(size_t i=0; i<count; ++i)
+    {
+        s->sizes[i] = segments[i].first != nullptr ? segments[i].second : 0;
+        total += s->sizes[i];
+    }
+    s->data.resize(total);
+    size_t offset = 0;
+    for(size_t i=0; i<count; ++i)
+    {
+        if(s->sizes[i] > 0)
+            memcpy(&s->data[offset], segments[i].first, s->sizes[i]);
+        offset += s->sizes[i];
+    }
+}
+
+bool SensorDispatcher::Enqueue(DispatchChannel* ch, DispatchSample* s)
+{
+    SDL_LockMutex(mutex);
+    if(!ch->attached)
+    {
+        ch->pool.push_back(s);
+        SDL_UnlockMutex(mutex);
+        return false;
+    }
+    
+    if(ch->depth >= ch->capacity) //Drop oldest
+    {
+        ch->pool.push_back(ch->PopFront());
+        ++ch->stats.dropped;
+    }
+    ch->PushBack(s);
+    ch->stats.maxDepth = std::max(ch->stats.maxDepth, ch->depth);
+    
+    if(!ch->busy && !ch->scheduled)
+    {
+        ch->scheduled = true;
+        ready.push_back(ch);
+        SDL_CondSignal(workAvailable);
+    }
+    SDL_UnlockMutex(mutex);
+    return true;
+}
+
+DispatchQueueStats SensorDispatcher::getStats(DispatchChannel* ch)
+{
+    SDL_LockMutex(mutex);
+    DispatchQueueStats stats = ch->stats;
+    stats.depth = ch->depth;
+    SDL_UnlockMutex(mutex);
+    return stats;
+}
+
+int SensorDispatcher::WorkerLoop(void* data)
+{
+    SensorDispatcher* disp = (SensorDispatcher*)data;
+    std::vector<void*> ptrs;
+    
+    SDL_LockMutex(disp->mutex);
+    while(true)
+    {
+        while(!disp->stopping && disp->ready.empty())
+            SDL_CondWait(disp->workAvailable, disp->mutex);
+        if(disp->stopping)
+            break;
+        
+        DispatchChannel* ch = disp->ready.front();
+        disp->ready.erase(disp->ready.begin());
+        ch->scheduled = false;
+        if(!ch->attached || ch->depth == 0)
+            continue;
+        
+        DispatchSample* s = ch->PopFront();
+        ch->busy = true;
+        SDL_UnlockMutex(disp->mutex);
+        
+        //Run callback
+        if(s->callback)
+            s->callback(s->sizes[0] > 0 ? &s->data[0] : nullptr);
+        else
+        {
+            ptrs.resize(s->sizes.size());
+            size_t offset = 0;
+            for(size_t i=0; i<s->sizes.size(); ++i)
+            {
+                ptrs[i] = s->sizes[i] > 0 ? &s->data[offset] : nullptr;
+                offset += s->sizes[i];
+            }
+            s->multiCallback(ptrs);
+        }
+        
+        SDL_LockMutex(disp->mutex);
+        ch->busy = false;
+        ++ch->stats.dispatched;
+        ch->pool.push_back(s);
+        if(ch->attached && ch->depth > 0 && !ch->scheduled)
+        {
+            ch->scheduled = true;
+            disp->ready.push_back(ch);
+            SDL_CondSignal(disp->workAvailable);
+        }
+        SDL_CondBroadcast(disp->workDone);
+    }
+    SDL_UnlockMutex(disp->mutex);
+    return 0;
+}
+
+}
@@ -44,6 +44,62 @@ VisionSensor::VisionSensor(std::string uniqueName, Scalar frequency) : Sensor(un
 
 VisionSensor::~VisionSensor()
 {
+    StopDispatch(); //Derived classes should have done it already
+}
+
+void VisionSensor::StopDispatch()
+{
+    if(dispatch.attached)
+        SimulationApp::getApp()->getSimulationManager()->getSensorDispatcher()->Detach(&dispatch);
+}
+
+void VisionSensor::setAsyncDispatch(unsigned int queueDepth, QueueOverflowPolicy policy)
+{
+    SensorDispatcher* disp = SimulationApp::getApp()->getSimulationManager()->getSensorDispatcher();
+    if(queueDepth == 0)
+        disp->Detach(&dispatch);
+    else
+        disp->Attach(&dispatch, queueDepth, policy);
+}
+
+bool VisionSensor::isAsyncDispatch() const
+{
+    return dispatch.attached;
+}
+
+DispatchQueueStats VisionSensor::getDispatchQueueStats() const
+{
+    if(!dispatch.attached)
+        return dispatch.stats;
+    return SimulationApp::getApp()->getSimulationManager()->getSensorDispatcher()->getStats(&dispatch);
+}
+
+void VisionSensor::DispatchNewData(void* data, size_t size, const std::function<void(void*)>& callback)
+{
+    if(!dispatch.attached)
+        callback(data);
+    else
+        SimulationApp::getApp()->getSimulationManager()->getSensorDispatcher()->Push(&dispatch, DispatchSegment(data, size), callback);
+}
+
+void VisionSensor::DispatchNewData(const DispatchSegment* segments, size_t count, 
+                                   const std::function<void(const std::vector<void*>&)>& callback)
+{
+    if(!dispatch.attached)
+    {
+        segmentPtrs.resize(count);
+        for(size_t i=0; i<count; ++i)
+            segmentPtrs[i] = (void*)segments[i].first;
+        callback(segmentPtrs);
+    }
+    else
+        SimulationApp::getApp()->getSimulationManager()->getSensorDispatcher()->Push(&dispatch, segments, count, callback);
+}
+
+void VisionSensor::ShiftOrigin(const Vector3& shift)
+{
+    if(attach == nullptr)
+        o2s.setOrigin(o2s.getOrigin() - shift);
 }
 
 void VisionSensor::setRelativeSensorFrame(const Transform& origin)
@@ -93,6 +93,17 @@ void ForceTorque::InternalUpdate(Scalar dt)
     }
 }
 
+void ForceTorque::PrepareUpdate(Scalar dt)
+{
+    if(!isUpdateDue(dt))
+        return;
+    
+    if(j != NULL && attach != NULL)
+        j->RequestFeedback();
+    else if(fe != NULL)
+        fe->RequestJointFeedback(jId);
+}
+
 void ForceTorque::setRange(const Vector3& forceMax, const Vector3& torqueMax)
 {
     channels[0].rangeMin = -btClamped(forceMax.getX(), Scalar(0), Scalar(BT_LARGE_FLOAT));
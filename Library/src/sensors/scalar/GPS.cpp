@@ -57,7 +57,7 @@ void GPS::InternalUpdate(Scalar dt)
     }
     else
     {
-        Vector3 gpsPos = gpsTrans.getOrigin();
+        Vector3 gpsPos = gpsTrans.getOrigin() + SimulationApp::getApp()->getSimulationManager()->getWorldOrigin();
 		
         //add noise
         if(!btFuzzyZero(nedStdDev))
@@ -67,9 +67,9 @@ void GPS::InternalUpdate(Scalar dt)
         }
         
         //convert NED to geodetic coordinates
-        double latitude;
-        double longitude;
-        double height;
+        Scalar latitude;
+        Scalar longitude;
+        Scalar height;
         SimulationApp::getApp()->getSimulationManager()->getNED()->Ned2Geodetic(gpsPos.x(), gpsPos.y(), 0.0, latitude, longitude, height);
         
         //record sample
@@ -79,4 +79,9 @@ void JointSensor::AttachToJoint(Joint* joint)
         j = joint;
 }
 
+void JointSensor::PrepareUpdate(Scalar dt)
+{
+    //Most joint sensors read the joint state directly
+}
+
 }
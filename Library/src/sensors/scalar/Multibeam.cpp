@@ -91,6 +91,7 @@ std::vector<Renderable> Multibeam::Render()
         Renderable item;
         item.type = RenderableType::SENSOR_LINES;
         item.model = glMatrixFromTransform(getSensorFrame());    
+        item.points.reserve(2*(angSteps+1));
         for(unsigned int i=0; i <= angSteps; ++i)
         {
             Vector3 dir = Vector3(1, 0, 0) * btCos(angles[i]) + Vector3(0, 1, 0) * btSin(angles[i]);
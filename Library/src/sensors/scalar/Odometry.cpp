@@ -25,6 +25,8 @@
 
 #include "sensors/scalar/Odometry.h"
 
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
 #include "entities/MovingEntity.h"
 #include "sensors/Sample.h"
 
@@ -55,7 +57,7 @@ void Odometry::InternalUpdate(Scalar dt)
     //Calculate transformation from global to imu frame
     Transform odomTrans = getSensorFrame();
     
-    Vector3 pos = odomTrans.getOrigin();
+    Vector3 pos = odomTrans.getOrigin() + SimulationApp::getApp()->getSimulationManager()->getWorldOrigin();
     Vector3 v = odomTrans.getBasis().inverse() * attach->getLinearVelocityInLocalPoint(odomTrans.getOrigin() - attach->getCGTransform().getOrigin());
     
     Quaternion orn = odomTrans.getRotation();
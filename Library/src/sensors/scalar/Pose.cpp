@@ -25,6 +25,8 @@
 
 #include "sensors/scalar/Pose.h"
 
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
 #include "sensors/Sample.h"
 #include "graphics/OpenGLPipeline.h"
 
@@ -45,6 +47,7 @@ void Pose::InternalUpdate(Scalar dt)
 {
     //get angles
     Transform trajFrame = getSensorFrame();
+    trajFrame.setOrigin(trajFrame.getOrigin() + SimulationApp::getApp()->getSimulationManager()->getWorldOrigin());
     Scalar yaw, pitch, roll;
     trajFrame.getBasis().getEulerYPR(yaw, pitch, roll);
     
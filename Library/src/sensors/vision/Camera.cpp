@@ -25,6 +25,7 @@
 
 #include "sensors/vision/Camera.h"
 
+#include <algorithm>
 #include "entities/SolidEntity.h"
 
 namespace sf
@@ -36,6 +37,7 @@ Camera::Camera(std::string uniqueName, unsigned int resolutionX, unsigned int re
     resX = resolutionX > 0 ? (resolutionX + resolutionX % 2) : 2;
     resY = resolutionY > 0 ? (resolutionY + resolutionY % 2) : 2;
     setDisplayOnScreen(false, 0, 0, 1.f);
+    setOutputSettings(CameraOutputSettings());
 }
     
 Camera::~Camera()
@@ -53,6 +55,55 @@ void Camera::getResolution(unsigned int& x, unsigned int& y) const
     y = resY;
 }
 
+void Camera::setOutputSettings(const CameraOutputSettings& settings)
+{
+    //Clamp the region of interest to the image and make it a multiple of the bin size
+    outputSettings = settings;
+    outputSettings.binning = settings.binning < 1 ? 1 : settings.binning;
+    outputSettings.roiX = settings.roiX < resX ? settings.roiX : resX-1;
+    outputSettings.roiY = settings.roiY < resY ? settings.roiY : resY-1;
+    unsigned int maxW = resX - outputSettings.roiX;
+    unsigned int maxH = resY - outputSettings.roiY;
+    outputSettings.roiWidth = (settings.roiWidth == 0 || settings.roiWidth > maxW) ? maxW : settings.roiWidth;
+    outputSettings.roiHeight = (settings.roiHeight == 0 || settings.roiHeight > maxH) ? maxH : settings.roiHeight;
+    outputSettings.binning = std::min(outputSettings.binning, std::min(outputSettings.roiWidth, outputSettings.roiHeight));
+    outputSettings.roiWidth -= outputSettings.roiWidth % outputSettings.binning;
+    outputSettings.roiHeight -= outputSettings.roiHeight % outputSettings.binning;
+}
+
+CameraOutputSettings Camera::getOutputSettings() const
+{
+    return outputSettings;
+}
+
+void Camera::getOutputResolution(unsigned int& x, unsigned int& y) const
+{
+    x = outputSettings.roiWidth/outputSettings.binning;
+    y = outputSettings.roiHeight/outputSettings.binning;
+}
+
+size_t Camera::getOutputDataSize(size_t nativePixelSize) const
+{
+    unsigned int w, h;
+    getOutputResolution(w, h);
+    size_t pixelSize;
+    switch(outputSettings.format)
+    {
+        case CameraOutputFormat::NATIVE:
+            pixelSize = nativePixelSize;
+            break;
+            
+        case CameraOutputFormat::DEPTH_UINT16:
+            pixelSize = sizeof(GLushort);
+            break;
+            
+        default: //Monochrome and Bayer mosaics
+            pixelSize = 1;
+            break;
+    }
+    return (size_t)w * (size_t)h * pixelSize;
+}
+
 void Camera::setDisplayOnScreen(bool display, unsigned int x, unsigned int y, float scale)
 {
     screen = display;
@@ -84,38 +135,37 @@ std::vector<Renderable> Camera::Render()
     if(isRenderable())
     {
         Renderable item;
-        item.model = glMatrixFromTransform(getSensorFrame());
-        item.type = RenderableType::SENSOR_LINES;
-        
-        //Create camera dummy
-        GLfloat iconSize = 0.5f;
-        GLfloat x = iconSize*tanf(fovH/360.f*M_PI);
-        GLfloat aspect = (GLfloat)resX/(GLfloat)resY;
-        GLfloat y = x/aspect;
-        
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(x, -y, iconSize));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(x,  y, iconSize));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(-x, -y, iconSize));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(-x,  y, iconSize));
+        if(PrepareVisualisation(item))
+        {
+            //Create camera dummy
+            GLfloat iconSize = 0.5f;
+            GLfloat x = iconSize*tanf(fovH/360.f*M_PI);
+            GLfloat aspect = (GLfloat)resX/(GLfloat)resY;
+            GLfloat y = x/aspect;
         
-        item.points.push_back(glm::vec3(x, -y, iconSize));
-        item.points.push_back(glm::vec3(x, y, iconSize));
-        item.points.push_back(glm::vec3(x, y, iconSize));
-        item.points.push_back(glm::vec3(-x, y, iconSize));
-        item.points.push_back(glm::vec3(-x, y, iconSize));
-        item.points.push_back(glm::vec3(-x, -y, iconSize));
-        item.points.push_back(glm::vec3(-x, -y, iconSize));
-        item.points.push_back(glm::vec3(x, -y, iconSize));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(x, -y, iconSize));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(x,  y, iconSize));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(-x, -y, iconSize));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(-x,  y, iconSize));
         
-        item.points.push_back(glm::vec3(-0.5f*x, -y, iconSize));
-        item.points.push_back(glm::vec3(0.f, -1.5f*y, iconSize));
-        item.points.push_back(glm::vec3(0.f, -1.5f*y, iconSize));
-        item.points.push_back(glm::vec3(0.5f*x, -y, iconSize));
+            item.points.push_back(glm::vec3(x, -y, iconSize));
+            item.points.push_back(glm::vec3(x, y, iconSize));
+            item.points.push_back(glm::vec3(x, y, iconSize));
+            item.points.push_back(glm::vec3(-x, y, iconSize));
+            item.points.push_back(glm::vec3(-x, y, iconSize));
+            item.points.push_back(glm::vec3(-x, -y, iconSize));
+            item.points.push_back(glm::vec3(-x, -y, iconSize));
+            item.points.push_back(glm::vec3(x, -y, iconSize));
         
+            item.points.push_back(glm::vec3(-0.5f*x, -y, iconSize));
+            item.points.push_back(glm::vec3(0.f, -1.5f*y, iconSize));
+            item.points.push_back(glm::vec3(0.f, -1.5f*y, iconSize));
+            item.points.push_back(glm::vec3(0.5f*x, -y, iconSize));
+        }
         items.push_back(item);
     }
     return items;
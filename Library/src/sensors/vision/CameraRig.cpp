@@ -0,0 +1,169 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  CameraRig.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/vision/CameraRig.h"
+
+#include "core/GraphicalSimulationApp.h"
+#include "graphics/OpenGLCameraRig.h"
+#include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLContent.h"
+
+namespace sf
+{
+
+CameraRig::CameraRig(std::string uniqueName, unsigned int resolutionX, unsigned int resolutionY, Scalar hFOVDeg, Scalar frequency, 
+    Scalar minDistance, Scalar maxDistance) : Camera(uniqueName, resolutionX, resolutionY, hFOVDeg, frequency)
+{
+    depthRange = glm::vec2((GLfloat)minDistance, (GLfloat)maxDistance);
+    newDataCallback = nullptr;
+    glCamera = nullptr;
+}
+
+CameraRig::~CameraRig()
+{
+    StopDispatch();
+    glCamera = nullptr;
+}
+
+void CameraRig::AddEye(const Transform& origin)
+{
+    if(glCamera != nullptr)
+    {
+        cWarning("Cameras of rig '%s' have to be added before adding it to the simulation!", getName().c_str());
+        return;
+    }
+    eyeOrigins.push_back(origin);
+    imageData.push_back(nullptr);
+}
+
+Transform CameraRig::getEyeOrigin(unsigned int index) const
+{
+    return index < eyeOrigins.size() ? eyeOrigins[index] : Transform::getIdentity();
+}
+
+unsigned int CameraRig::getNumOfEyes() const
+{
+    return (unsigned int)eyeOrigins.size();
+}
+    
+void CameraRig::setExposureCompensation(Scalar comp)
+{
+    if(glCamera != nullptr)
+        glCamera->setExposureCompensation((GLfloat)comp);
+}
+    
+Scalar CameraRig::getExposureCompensation() const
+{
+    if(glCamera != nullptr)
+        return (Scalar)glCamera->getExposureCompensation();
+    else
+        return Scalar(0);
+}
+
+void* CameraRig::getImageDataPointer(unsigned int index)
+{
+    return index < imageData.size() ? imageData[index] : nullptr;
+}
+
+VisionSensorType CameraRig::getVisionSensorType() const
+{
+    return VisionSensorType::CAMERA_RIG;
+}
+
+OpenGLView* CameraRig::getOpenGLView() const
+{
+    return glCamera;
+}
+
+void CameraRig::InitGraphics()
+{
+    if(!outputSettings.isPassThrough(resX, resY))
+    {
+        cWarning("Output stage not supported by camera rig '%s' - using full images!", getName().c_str());
+        outputSettings = CameraOutputSettings();
+    }
+    if(eyeOrigins.size() == 0)
+    {
+        cWarning("No cameras defined for rig '%s' - adding one at the rig origin!", getName().c_str());
+        AddEye(Transform::getIdentity());
+    }
+    glCamera = new OpenGLCameraRig(getNumOfEyes(), 0, 0, resX, resY, (GLfloat)fovH, depthRange, freq < Scalar(0));
+    glCamera->setCameraRig(this);
+    UpdateTransform();
+    glCamera->UpdateTransform();
+    InternalUpdate(0);
+    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glCamera);
+}
+
+void CameraRig::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
+{
+    //Rebuild the rig frame (z along the optical axis, y pointing down the image)
+    Vector3 y = -up;
+    Vector3 x = y.cross(dir);
+    Transform rig(Matrix3(x.x(), y.x(), dir.x(),
+                          x.y(), y.y(), dir.y(),
+                          x.z(), y.z(), dir.z()), eye);
+    
+    for(unsigned int i=0; i<getNumOfEyes(); ++i)
+    {
+        Transform T = rig * eyeOrigins[i];
+        glCamera->SetupEye(i, glVectorFromVector(T.getOrigin()), 
+                              glVectorFromVector(T.getBasis().getColumn(2)), 
+                              glVectorFromVector(-T.getBasis().getColumn(1)));
+    }
+}
+
+void CameraRig::InstallNewDataHandler(std::function<void(CameraRig*)> callback)
+{
+    newDataCallback = callback;
+}
+
+void CameraRig::NewDataReady(void* data, unsigned int index)
+{
+    if(newDataCallback == nullptr)
+        return;
+    
+    //Images of all cameras arrive in one buffer, one after another
+    size_t imageSize = (size_t)resX * resY * 3;
+    segments.resize(getNumOfEyes());
+    for(unsigned int i=0; i<getNumOfEyes(); ++i)
+        segments[i] = DispatchSegment((const GLubyte*)data + i * imageSize, imageSize);
+    
+    DispatchNewData(segments.data(), segments.size(), [this](const std::vector<void*>& d)
+    {
+        for(size_t i=0; i<imageData.size(); ++i)
+            imageData[i] = d[i];
+        newDataCallback(this);
+        for(size_t i=0; i<imageData.size(); ++i)
+            imageData[i] = nullptr;
+    });
+}
+
+void CameraRig::InternalUpdate(Scalar dt)
+{
+    glCamera->Update();
+}
+
+}
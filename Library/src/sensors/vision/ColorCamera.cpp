@@ -43,6 +43,7 @@ ColorCamera::ColorCamera(std::string uniqueName, unsigned int resolutionX, unsig
 
 ColorCamera::~ColorCamera()
 {
+    StopDispatch();
     glCamera = nullptr;
 }
     
@@ -77,6 +78,11 @@ OpenGLView* ColorCamera::getOpenGLView() const
 
 void ColorCamera::InitGraphics()
 {
+    if(outputSettings.format == CameraOutputFormat::DEPTH_UINT16)
+    {
+        cWarning("Output format of camera '%s' not supported - using native format!", getName().c_str());
+        outputSettings.format = CameraOutputFormat::NATIVE;
+    }
     glCamera = new OpenGLRealCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0), 0, 0, resX, resY, (GLfloat)fovH, depthRange, freq < Scalar(0));
     glCamera->setCamera(this);
     UpdateTransform();
@@ -102,9 +108,12 @@ void ColorCamera::NewDataReady(void* data, unsigned int index)
 {
     if(newDataCallback != nullptr)
     {
-        imageData = (GLubyte*)data;
-        newDataCallback(this);
-        imageData = nullptr;
+        DispatchNewData(data, getOutputDataSize(3), [this](void* d)
+        {
+            imageData = (GLubyte*)d;
+            newDataCallback(this);
+            imageData = nullptr;
+        });
     }
 }
 
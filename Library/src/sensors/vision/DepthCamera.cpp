@@ -46,6 +46,7 @@ DepthCamera::DepthCamera(std::string uniqueName, unsigned int resolutionX, unsig
 
 DepthCamera::~DepthCamera()
 {
+    StopDispatch();
     glCamera = nullptr;
 }
 
@@ -81,6 +82,11 @@ OpenGLView* DepthCamera::getOpenGLView() const
 
 void DepthCamera::InitGraphics()
 {
+    if(outputSettings.format != CameraOutputFormat::NATIVE && outputSettings.format != CameraOutputFormat::DEPTH_UINT16)
+    {
+        cWarning("Output format of depth camera '%s' not supported - using native format!", getName().c_str());
+        outputSettings.format = CameraOutputFormat::NATIVE;
+    }
     glCamera = new OpenGLDepthCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0), 0, 0, resX, resY, (GLfloat)fovH, depthRange.x, depthRange.y, freq < Scalar(0));
     glCamera->setNoise(noiseStdDev);
     glCamera->setCamera(this);
@@ -107,9 +113,12 @@ void DepthCamera::NewDataReady(void* data, unsigned int index)
 {
     if(newDataCallback != nullptr)
     {
-        imageData = (GLfloat*)data;
-        newDataCallback(this);
-        imageData = nullptr;
+        DispatchNewData(data, getOutputDataSize(sizeof(GLfloat)), [this](void* d)
+        {
+            imageData = (GLfloat*)d;
+            newDataCallback(this);
+            imageData = nullptr;
+        });
     }
 }
 
@@ -49,6 +49,7 @@ EventBasedCamera::EventBasedCamera(std::string uniqueName, unsigned int resoluti
 
 EventBasedCamera::~EventBasedCamera()
 {
+    StopDispatch();
     glCamera = nullptr;
 }
 
@@ -80,6 +81,12 @@ OpenGLView* EventBasedCamera::getOpenGLView() const
     return glCamera;
 }
     
+void EventBasedCamera::setOutputSettings(const CameraOutputSettings& settings)
+{
+    if(!settings.isPassThrough(resX, resY))
+        cWarning("Output stage not supported by event-based camera '%s' - using full images!", getName().c_str());
+}
+
 void EventBasedCamera::InitGraphics()
 {
     glCamera = new OpenGLEventBasedCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0), 0, 0, resX, resY, (GLfloat)fovH, 
@@ -107,15 +114,13 @@ void EventBasedCamera::InstallNewDataHandler(std::function<void(EventBasedCamera
 
 void EventBasedCamera::NewDataReady(void* data, unsigned int index)
 {
-    lastEventCount = index;
-
 #ifdef DEBUG
-    if(lastEventCount > 0)
+    if(index > 0)
     {
         GLint* data_ = (GLint*)data;
         int firstTime = INT32_MAX;
         int lastTime = 0;
-        for(unsigned int i = 0; i < lastEventCount; ++i)
+        for(unsigned int i = 0; i < index; ++i)
         {
             if(abs(data_[i*2+1]) > lastTime)
                 lastTime = abs(data_[i*2+1]);
@@ -128,10 +133,16 @@ void EventBasedCamera::NewDataReady(void* data, unsigned int index)
 
     if(newDataCallback != nullptr)
     {
-        imageData = (GLint*)data;
-        newDataCallback(this);
-        imageData = nullptr;
+        DispatchNewData(data, (size_t)index * 2 * sizeof(GLint), [this, index](void* d)
+        {
+            lastEventCount = index;
+            imageData = (GLint*)d;
+            newDataCallback(this);
+            imageData = nullptr;
+        });
     }
+    else
+        lastEventCount = index;
 }
 
 void EventBasedCamera::InternalUpdate(Scalar dt)
@@ -53,6 +53,7 @@ FLS::FLS(std::string uniqueName, unsigned int numOfBeams, unsigned int numOfBins
 
 FLS::~FLS()
 {
+    StopDispatch();
     if(displayData != NULL) delete [] displayData;
     glFLS = nullptr;
 }
@@ -60,11 +61,13 @@ FLS::~FLS()
 void FLS::setRangeMin(Scalar r)
 {
     range.x = r < Scalar(0.02) ? 0.02f : (r < Scalar(range.y) ? (GLfloat)r : range.x);
+    InvalidateVisualisation();
 }
 
 void FLS::setRangeMax(Scalar r)
 {
     range.y = r > Scalar(range.x) ? (GLfloat)r : range.x;
+    InvalidateVisualisation();
     Scalar pulseTime = (Scalar(2)*range.y/SOUND_VELOCITY_WATER) * Scalar(1.1);
     if(freq <= 0.0 || freq > Scalar(1)/pulseTime) // Limit update frequency based on range (physical limit)
         freq = Scalar(1)/pulseTime;
@@ -174,9 +177,12 @@ void FLS::NewDataReady(void* data, unsigned int index)
         }
         else
         {
-            sonarData = (GLubyte*)data;
-            newDataCallback(this);
-            sonarData = NULL;
+            DispatchNewData(data, (size_t)resX * resY, [this](void* d)
+            {
+                sonarData = (GLubyte*)d;
+                newDataCallback(this);
+                sonarData = NULL;
+            });
         }
     }
 }
@@ -193,79 +199,78 @@ std::vector<Renderable> FLS::Render()
     if(isRenderable())
     {
         Renderable item;
-        item.model = glMatrixFromTransform(getSensorFrame());
-        item.type = RenderableType::SENSOR_LINES;    
-        
-        //Create sonar dummy
-        int div = 12;
-        GLfloat fovStep = glm::radians(fovH)/(GLfloat)div;
-        //Min Arcs
-        GLfloat cosVAngle = cosf(glm::radians(fovV)/2.f) * range.x;
-        GLfloat sinVAngle = sinf(glm::radians(fovV)/2.f) * range.x;
-        GLfloat hAngle = -fovStep*(div/2);
-        for(int i=0; i<=div; ++i)
+        if(PrepareVisualisation(item))
         {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, sinVAngle, z));
-            if(i > 0 && i < div)
+            //Create sonar dummy
+            int div = 12;
+            GLfloat fovStep = glm::radians(fovH)/(GLfloat)div;
+            //Min Arcs
+            GLfloat cosVAngle = cosf(glm::radians(fovV)/2.f) * range.x;
+            GLfloat sinVAngle = sinf(glm::radians(fovV)/2.f) * range.x;
+            GLfloat hAngle = -fovStep*(div/2);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, sinVAngle, z));
-            hAngle += fovStep;
-        }
-        hAngle = -fovStep*(div/2);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, sinVAngle, z));
+                hAngle += fovStep;
+            }
+            hAngle = -fovStep*(div/2);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            hAngle += fovStep;
-        }
-        //Max Arcs
-        cosVAngle = cosf(glm::radians(fovV)/2.f) * range.y;
-        sinVAngle = sinf(glm::radians(fovV)/2.f) * range.y;
-        hAngle = -fovStep*(div/2);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, -sinVAngle, z));
+                hAngle += fovStep;
+            }
+            //Max Arcs
+            cosVAngle = cosf(glm::radians(fovV)/2.f) * range.y;
+            sinVAngle = sinf(glm::radians(fovV)/2.f) * range.y;
+            hAngle = -fovStep*(div/2);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, sinVAngle, z));
-            hAngle += fovStep;
-        }
-        hAngle = -fovStep*(div/2);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, sinVAngle, z));
+                hAngle += fovStep;
+            }
+            hAngle = -fovStep*(div/2);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            hAngle += fovStep;
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, -sinVAngle, z));
+                hAngle += fovStep;
+            }
+            //Ends
+            hAngle = -fovStep*(div/2);
+            GLfloat zs = cosf(hAngle) * cosVAngle;
+            GLfloat xs = sinf(hAngle) * cosVAngle;
+            item.points.push_back(glm::vec3(xs, sinVAngle, zs));
+            item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
+            hAngle = fovStep*(div/2);
+            GLfloat ze = cosf(hAngle) * cosVAngle;
+            GLfloat xe = sinf(hAngle) * cosVAngle;
+            item.points.push_back(glm::vec3(xe, sinVAngle, ze));
+            item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
+            //Pyramid
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(xs, sinVAngle, zs));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(xe, sinVAngle, ze));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
         }
-        //Ends
-        hAngle = -fovStep*(div/2);
-        GLfloat zs = cosf(hAngle) * cosVAngle;
-        GLfloat xs = sinf(hAngle) * cosVAngle;
-        item.points.push_back(glm::vec3(xs, sinVAngle, zs));
-        item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
-        hAngle = fovStep*(div/2);
-        GLfloat ze = cosf(hAngle) * cosVAngle;
-        GLfloat xe = sinf(hAngle) * cosVAngle;
-        item.points.push_back(glm::vec3(xe, sinVAngle, ze));
-        item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
-        //Pyramid
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xs, sinVAngle, zs));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xe, sinVAngle, ze));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
-
         items.push_back(item);
     }
     return items;
@@ -56,6 +56,7 @@ MSIS::MSIS(std::string uniqueName, Scalar stepAngleDeg, unsigned int numOfBins,
 
 MSIS::~MSIS()
 {
+    StopDispatch();
     if(displayData != NULL) delete [] displayData;
     glMSIS = nullptr;
 }
@@ -82,16 +83,19 @@ void MSIS::setRotationLimits(Scalar l1Deg, Scalar l2Deg)
         --roi.y;
     currentStep = roi.x;
     cw = true;
+    InvalidateVisualisation();
 }
 
 void MSIS::setRangeMin(Scalar r)
 {
     range.x = r < Scalar(0.02) ? 0.02f : (r < Scalar(range.y) ? (GLfloat)r : range.x);
+    InvalidateVisualisation();
 }
 
 void MSIS::setRangeMax(Scalar r)
 {
     range.y = r > Scalar(range.x) ? (GLfloat)r : range.x;
+    InvalidateVisualisation();
     Scalar pulseTime = (Scalar(2)*range.y/SOUND_VELOCITY_WATER) * Scalar(1.1);
     if(freq <= 0.0 || freq > Scalar(1)/pulseTime) // Limit update frequency based on range (physical limit)
         freq = Scalar(1)/pulseTime;
@@ -216,9 +220,12 @@ void MSIS::NewDataReady(void* data, unsigned int index)
         }
         else
         {
-            sonarData = (GLubyte*)data;
-            newDataCallback(this);
-            sonarData = NULL;
+            DispatchNewData(data, (size_t)resX * resY, [this](void* d)
+            {
+                sonarData = (GLubyte*)d;
+                newDataCallback(this);
+                sonarData = NULL;
+            });
         }
     }
 
@@ -255,96 +262,102 @@ std::vector<Renderable> MSIS::Render()
     if(isRenderable())
     {
         Renderable item;
-        item.model = glMatrixFromTransform(getSensorFrame());
-        item.type = RenderableType::SENSOR_LINES;    
-        
-        //Create sonar dummy
-        int div = 24;
-        Scalar l1Deg, l2Deg;
-        getRotationLimits(l1Deg, l2Deg);
-        GLfloat fovStep = fullRotation ? 2.f*M_PI/(GLfloat)div : glm::radians(l2Deg-l1Deg)/(GLfloat)div;
-        //Arcs min
-        GLfloat cosVAngle = cosf(glm::radians(fovV)/2.f) * range.x;
-        GLfloat sinVAngle = sinf(glm::radians(fovV)/2.f) * range.x;
-        GLfloat hAngle = glm::radians(l1Deg);
-        for(int i=0; i<=div; ++i)
+        if(PrepareVisualisation(item))
         {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, sinVAngle, z));
-            if(i > 0 && i < div)
+            //Create sonar dummy
+            int div = 24;
+            Scalar l1Deg, l2Deg;
+            getRotationLimits(l1Deg, l2Deg);
+            GLfloat fovStep = fullRotation ? 2.f*M_PI/(GLfloat)div : glm::radians(l2Deg-l1Deg)/(GLfloat)div;
+            //Arcs min
+            GLfloat cosVAngle = cosf(glm::radians(fovV)/2.f) * range.x;
+            GLfloat sinVAngle = sinf(glm::radians(fovV)/2.f) * range.x;
+            GLfloat hAngle = glm::radians(l1Deg);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, sinVAngle, z));
-            hAngle += fovStep;
-        }
-        hAngle = glm::radians(l1Deg);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, sinVAngle, z));
+                hAngle += fovStep;
+            }
+            hAngle = glm::radians(l1Deg);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            hAngle += fovStep;
-        }
-        //Arcs max
-        cosVAngle = cosf(glm::radians(fovV)/2.f) * range.y;
-        sinVAngle = sinf(glm::radians(fovV)/2.f) * range.y;
-        hAngle = glm::radians(l1Deg);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, -sinVAngle, z));
+                hAngle += fovStep;
+            }
+            //Arcs max
+            cosVAngle = cosf(glm::radians(fovV)/2.f) * range.y;
+            sinVAngle = sinf(glm::radians(fovV)/2.f) * range.y;
+            hAngle = glm::radians(l1Deg);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, sinVAngle, z));
-            hAngle += fovStep;
-        }
-        hAngle = glm::radians(l1Deg);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, sinVAngle, z));
+                hAngle += fovStep;
+            }
+            hAngle = glm::radians(l1Deg);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            hAngle += fovStep;
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, -sinVAngle, z));
+                hAngle += fovStep;
+            }
+
+            if(!fullRotation)
+            {
+                //Ends
+                hAngle = glm::radians(l1Deg);
+                GLfloat zs = cosf(hAngle) * cosVAngle;
+                GLfloat xs = sinf(hAngle) * cosVAngle;
+                item.points.push_back(glm::vec3(xs, sinVAngle, zs));
+                item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
+                hAngle = glm::radians(l2Deg);
+                GLfloat ze = cosf(hAngle) * cosVAngle;
+                GLfloat xe = sinf(hAngle) * cosVAngle;
+                item.points.push_back(glm::vec3(xe, sinVAngle, ze));
+                item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
+                //Pyramid
+                item.points.push_back(glm::vec3(0,0,0));
+                item.points.push_back(glm::vec3(xs, sinVAngle, zs));
+                item.points.push_back(glm::vec3(0,0,0));
+                item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
+                item.points.push_back(glm::vec3(0,0,0));
+                item.points.push_back(glm::vec3(xe, sinVAngle, ze));
+                item.points.push_back(glm::vec3(0,0,0));
+                item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
+            }
         }
+        items.push_back(item);
+        
         //Current beam position
-        hAngle = currentStep * stepSize;
+        Renderable beam;
+        beam.model = item.model;
+        beam.type = RenderableType::SENSOR_LINES;
+        GLfloat cosVAngle = cosf(glm::radians(fovV)/2.f) * range.y;
+        GLfloat sinVAngle = sinf(glm::radians(fovV)/2.f) * range.y;
+        GLfloat hAngle = currentStep * stepSize;
         GLfloat zc = cosf(hAngle) * cosVAngle;
         GLfloat xc = sinf(hAngle) * cosVAngle;
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xc, sinVAngle, zc));
-        item.points.push_back(glm::vec3(xc, sinVAngle, zc));
-        item.points.push_back(glm::vec3(xc, -sinVAngle, zc));
-        item.points.push_back(glm::vec3(xc, -sinVAngle, zc));
-        item.points.push_back(glm::vec3(0,0,0));
-        
-        if(!fullRotation)
-        {
-            //Ends
-            hAngle = glm::radians(l1Deg);
-            GLfloat zs = cosf(hAngle) * cosVAngle;
-            GLfloat xs = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(xs, sinVAngle, zs));
-            item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
-            hAngle = glm::radians(l2Deg);
-            GLfloat ze = cosf(hAngle) * cosVAngle;
-            GLfloat xe = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(xe, sinVAngle, ze));
-            item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
-            //Pyramid
-            item.points.push_back(glm::vec3(0,0,0));
-            item.points.push_back(glm::vec3(xs, sinVAngle, zs));
-            item.points.push_back(glm::vec3(0,0,0));
-            item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
-            item.points.push_back(glm::vec3(0,0,0));
-            item.points.push_back(glm::vec3(xe, sinVAngle, ze));
-            item.points.push_back(glm::vec3(0,0,0));
-            item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
-        }
-
-        items.push_back(item);
+        beam.points.push_back(glm::vec3(0,0,0));
+        beam.points.push_back(glm::vec3(xc, sinVAngle, zc));
+        beam.points.push_back(glm::vec3(xc, sinVAngle, zc));
+        beam.points.push_back(glm::vec3(xc, -sinVAngle, zc));
+        beam.points.push_back(glm::vec3(xc, -sinVAngle, zc));
+        beam.points.push_back(glm::vec3(0,0,0));
+        items.push_back(beam);
     }
     return items;
 }
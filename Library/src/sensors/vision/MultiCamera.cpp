@@ -0,0 +1,173 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  MultiCamera.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/vision/MultiCamera.h"
+
+#include "core/GraphicalSimulationApp.h"
+#include "graphics/OpenGLMultiCamera.h"
+#include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLContent.h"
+
+namespace sf
+{
+
+MultiCamera::MultiCamera(std::string uniqueName, unsigned int resolutionX, unsigned int resolutionY, Scalar hFOVDeg, Scalar frequency, 
+    Scalar minDistance, Scalar maxDistance) : Camera(uniqueName, resolutionX, resolutionY, hFOVDeg, frequency)
+{
+    depthRange = glm::vec2((GLfloat)minDistance, (GLfloat)maxDistance);
+    newDataCallback = nullptr;
+    glCamera = nullptr;
+    for(unsigned int i=0; i<4; ++i)
+    {
+        enabled[i] = true;
+        imageData[i] = nullptr;
+        stagedData[i] = nullptr;
+    }
+}
+
+MultiCamera::~MultiCamera()
+{
+    StopDispatch();
+    glCamera = nullptr;
+}
+
+void MultiCamera::setOutputEnabled(MultiCameraOutput output, bool en)
+{
+    if(glCamera != nullptr)
+    {
+        cWarning("Outputs of camera '%s' have to be selected before adding it to the simulation!", getName().c_str());
+        return;
+    }
+    enabled[(unsigned int)output] = en;
+}
+
+bool MultiCamera::isOutputEnabled(MultiCameraOutput output) const
+{
+    return enabled[(unsigned int)output];
+}
+    
+void MultiCamera::setExposureCompensation(Scalar comp)
+{
+    if(glCamera != nullptr)
+        glCamera->setExposureCompensation((GLfloat)comp);
+}
+    
+Scalar MultiCamera::getExposureCompensation() const
+{
+    if(glCamera != nullptr)
+        return (Scalar)glCamera->getExposureCompensation();
+    else
+        return Scalar(0);
+}
+
+void* MultiCamera::getImageDataPointer(unsigned int index)
+{
+    return index < 4 ? imageData[index] : nullptr;
+}
+
+VisionSensorType MultiCamera::getVisionSensorType() const
+{
+    return VisionSensorType::MULTI_CAMERA;
+}
+
+OpenGLView* MultiCamera::getOpenGLView() const
+{
+    return glCamera;
+}
+
+void MultiCamera::InitGraphics()
+{
+    if(outputSettings.format == CameraOutputFormat::DEPTH_UINT16)
+    {
+        cWarning("Output format of camera '%s' not supported - using native format!", getName().c_str());
+        outputSettings.format = CameraOutputFormat::NATIVE;
+    }
+    if(!enabled[0] && !enabled[1] && !enabled[2] && !enabled[3])
+    {
+        cWarning("All outputs of camera '%s' disabled - enabling colour output!", getName().c_str());
+        enabled[0] = true;
+    }
+    glCamera = new OpenGLMultiCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0), 0, 0, resX, resY, (GLfloat)fovH, depthRange, freq < Scalar(0));
+    glCamera->setOutputs(enabled[0], enabled[1], enabled[2], enabled[3]);
+    glCamera->setCamera(this);
+    UpdateTransform();
+    glCamera->UpdateTransform();
+    InternalUpdate(0);
+    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glCamera);
+}
+
+void MultiCamera::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
+{
+    glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
+    glm::vec3 dir_ = glm::vec3((GLfloat)dir.x(), (GLfloat)dir.y(), (GLfloat)dir.z());
+    glm::vec3 up_ = glm::vec3((GLfloat)up.x(), (GLfloat)up.y(), (GLfloat)up.z());
+    glCamera->SetupCamera(eye_, dir_, up_);
+}
+
+void MultiCamera::InstallNewDataHandler(std::function<void(MultiCamera*)> callback)
+{
+    newDataCallback = callback;
+}
+
+void MultiCamera::NewDataReady(void* data, unsigned int index)
+{
+    if(newDataCallback == nullptr || index >= 4)
+        return;
+    
+    //Outputs arrive in order, the callback runs once the last enabled one is available
+    stagedData[index] = data;
+    unsigned int last = 3;
+    while(last > 0 && !enabled[last])
+        --last;
+    if(index == last)
+    {
+        unsigned int w, h;
+        getResolution(w, h);
+        size_t pixels = (size_t)w * h;
+        DispatchSegment segments[4];
+        segments[0] = DispatchSegment(stagedData[0], getOutputDataSize(3));
+        segments[1] = DispatchSegment(stagedData[1], pixels * sizeof(GLfloat));
+        segments[2] = DispatchSegment(stagedData[2], pixels * sizeof(GLushort));
+        segments[3] = DispatchSegment(stagedData[3], pixels * 2 * sizeof(GLfloat));
+        for(unsigned int i=0; i<4; ++i)
+            stagedData[i] = nullptr;
+        
+        DispatchNewData(segments, 4, [this](const std::vector<void*>& d)
+        {
+            for(unsigned int i=0; i<4; ++i)
+                imageData[i] = d[i];
+            newDataCallback(this);
+            for(unsigned int i=0; i<4; ++i)
+                imageData[i] = nullptr;
+        });
+    }
+}
+
+void MultiCamera::InternalUpdate(Scalar dt)
+{
+    glCamera->Update();
+}
+
+}
@@ -47,6 +47,7 @@ OpticalFlowCamera::OpticalFlowCamera(std::string uniqueName, unsigned int resolu
 
 OpticalFlowCamera::~OpticalFlowCamera()
 {
+    StopDispatch();
     glCamera = nullptr;
 }
 
@@ -58,6 +59,12 @@ void OpticalFlowCamera::setNoise(float velocityXStdDev, float velocityYStdDev)
         glCamera->setNoise(noiseStdDev);
 }
 
+void OpticalFlowCamera::setOutputSettings(const CameraOutputSettings& settings)
+{
+    if(!settings.isPassThrough(resX, resY))
+        cWarning("Output stage not supported by optical flow camera '%s' - using full images!", getName().c_str());
+}
+
 void OpticalFlowCamera::setDisplaySettings(GLfloat maxVelocity)
 {
     displayMaxVelocity = glm::abs(maxVelocity);
@@ -126,9 +133,12 @@ void OpticalFlowCamera::NewDataReady(void* data, unsigned int index)
         }
         else
         {
-            flowData = (GLfloat*)data;
-            newDataCallback(this);
-            flowData = nullptr;
+            DispatchNewData(data, (size_t)resX * resY * 2 * sizeof(GLfloat), [this](void* d)
+            {
+                flowData = (GLfloat*)d;
+                newDataCallback(this);
+                flowData = nullptr;
+            });
         }
     }
 }
@@ -54,6 +54,7 @@ SSS::SSS(std::string uniqueName, unsigned int numOfBins, unsigned int numOfLines
 
 SSS::~SSS()
 {
+    StopDispatch();
     if(displayData != NULL) delete [] displayData;
     glSSS = nullptr;
 }
@@ -61,11 +62,13 @@ SSS::~SSS()
 void SSS::setRangeMin(Scalar r)
 {
     range.x = r < Scalar(0.02) ? 0.02f : (r < Scalar(range.y) ? (GLfloat)r : range.x);
+    InvalidateVisualisation();
 }
 
 void SSS::setRangeMax(Scalar r)
 {
     range.y = r > Scalar(range.x) ? (GLfloat)r : range.x;
+    InvalidateVisualisation();
     Scalar pulseTime = (Scalar(2)*range.y/SOUND_VELOCITY_WATER) * Scalar(1.1);
     if(freq <= 0.0 || freq > Scalar(1)/pulseTime) // Limit update frequency based on range (physical limit)
         freq = Scalar(1)/pulseTime;
@@ -168,9 +171,12 @@ void SSS::NewDataReady(void* data, unsigned int index)
         }
         else
         {
-            sonarData = (GLubyte*)data;
-            newDataCallback(this);
-            sonarData = NULL;
+            DispatchNewData(data, (size_t)resX * resY, [this](void* d)
+            {
+                sonarData = (GLubyte*)d;
+                newDataCallback(this);
+                sonarData = NULL;
+            });
         }
     }
 }
@@ -187,79 +193,80 @@ std::vector<Renderable> SSS::Render()
     if(isRenderable())
     {
         Renderable item;
-        item.type = RenderableType::SENSOR_LINES;    
-        
-        //Create single transducer dummy
-        int div = 12;
-        GLfloat fovStep = glm::radians(fovH)/(GLfloat)div;
-        //Arcs min
-        GLfloat cosVAngle = cosf(glm::radians(fovV)/2.f) * range.x;
-        GLfloat sinVAngle = sinf(glm::radians(fovV)/2.f) * range.x;        
-        GLfloat hAngle = -fovStep*(div/2);
-        for(int i=0; i<=div; ++i)
+        if(PrepareVisualisation(item))
         {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, sinVAngle, z));
-            if(i > 0 && i < div)
+            //Create single transducer dummy
+            int div = 12;
+            GLfloat fovStep = glm::radians(fovH)/(GLfloat)div;
+            //Arcs min
+            GLfloat cosVAngle = cosf(glm::radians(fovV)/2.f) * range.x;
+            GLfloat sinVAngle = sinf(glm::radians(fovV)/2.f) * range.x;        
+            GLfloat hAngle = -fovStep*(div/2);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, sinVAngle, z));
-            hAngle += fovStep;
-        }
-        hAngle = -fovStep*(div/2);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, sinVAngle, z));
+                hAngle += fovStep;
+            }
+            hAngle = -fovStep*(div/2);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            hAngle += fovStep;
-        }
-        //Arcs max
-        cosVAngle = cosf(glm::radians(fovV)/2.f) * range.y;
-        sinVAngle = sinf(glm::radians(fovV)/2.f) * range.y;        
-        hAngle = -fovStep*(div/2);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, -sinVAngle, z));
+                hAngle += fovStep;
+            }
+            //Arcs max
+            cosVAngle = cosf(glm::radians(fovV)/2.f) * range.y;
+            sinVAngle = sinf(glm::radians(fovV)/2.f) * range.y;        
+            hAngle = -fovStep*(div/2);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, sinVAngle, z));
-            hAngle += fovStep;
-        }
-        hAngle = -fovStep*(div/2);
-        for(int i=0; i<=div; ++i)
-        {
-            GLfloat z = cosf(hAngle) * cosVAngle;
-            GLfloat x = sinf(hAngle) * cosVAngle;
-            item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            if(i > 0 && i < div)
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, sinVAngle, z));
+                hAngle += fovStep;
+            }
+            hAngle = -fovStep*(div/2);
+            for(int i=0; i<=div; ++i)
+            {
+                GLfloat z = cosf(hAngle) * cosVAngle;
+                GLfloat x = sinf(hAngle) * cosVAngle;
                 item.points.push_back(glm::vec3(x, -sinVAngle, z));
-            hAngle += fovStep;
+                if(i > 0 && i < div)
+                    item.points.push_back(glm::vec3(x, -sinVAngle, z));
+                hAngle += fovStep;
+            }
+            //Ends
+            hAngle = -fovStep*(div/2);
+            GLfloat zs = cosf(hAngle) * cosVAngle;
+            GLfloat xs = sinf(hAngle) * cosVAngle;
+            item.points.push_back(glm::vec3(xs, sinVAngle, zs));
+            item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
+            hAngle = fovStep*(div/2);
+            GLfloat ze = cosf(hAngle) * cosVAngle;
+            GLfloat xe = sinf(hAngle) * cosVAngle;
+            item.points.push_back(glm::vec3(xe, sinVAngle, ze));
+            item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
+            //Pyramid
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(xs, sinVAngle, zs));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(xe, sinVAngle, ze));
+            item.points.push_back(glm::vec3(0,0,0));
+            item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
         }
-        //Ends
-        hAngle = -fovStep*(div/2);
-        GLfloat zs = cosf(hAngle) * cosVAngle;
-        GLfloat xs = sinf(hAngle) * cosVAngle;
-        item.points.push_back(glm::vec3(xs, sinVAngle, zs));
-        item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
-        hAngle = fovStep*(div/2);
-        GLfloat ze = cosf(hAngle) * cosVAngle;
-        GLfloat xe = sinf(hAngle) * cosVAngle;
-        item.points.push_back(glm::vec3(xe, sinVAngle, ze));
-        item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
-        //Pyramid
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xs, sinVAngle, zs));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xs, -sinVAngle, zs));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xe, sinVAngle, ze));
-        item.points.push_back(glm::vec3(0,0,0));
-        item.points.push_back(glm::vec3(xe, -sinVAngle, ze));
 
-        //Add two transducer dummies
+        //Add two transducer dummies (sharing the cached geometry)
         GLfloat offsetAngle = M_PI_2 - glm::radians(tilt);
         glm::mat4 views[2];
         views[0] = glm::rotate(-offsetAngle, glm::vec3(0.f,1.f,0.f));
@@ -267,6 +274,7 @@ std::vector<Renderable> SSS::Render()
         item.model = glMatrixFromTransform(getSensorFrame()) * views[0];
         items.push_back(item);
         item.model = glMatrixFromTransform(getSensorFrame()) * views[1];
+        item.points.clear();
         items.push_back(item);
     }
     return items;
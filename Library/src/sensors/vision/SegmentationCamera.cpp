@@ -45,6 +45,7 @@ SegmentationCamera::SegmentationCamera(std::string uniqueName, unsigned int reso
 
 SegmentationCamera::~SegmentationCamera()
 {
+    StopDispatch();
     glCamera = nullptr;
 }
 
@@ -70,6 +71,11 @@ OpenGLView* SegmentationCamera::getOpenGLView() const
 
 void SegmentationCamera::InitGraphics()
 {
+    if(outputSettings.format != CameraOutputFormat::NATIVE)
+    {
+        cWarning("Output format of segmentation camera '%s' not supported - using native format!", getName().c_str());
+        outputSettings.format = CameraOutputFormat::NATIVE;
+    }
     glCamera = new OpenGLSegmentationCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0), 0, 0, resX, resY, (GLfloat)fovH, depthRange, freq < Scalar(0));
     glCamera->setCamera(this);
     UpdateTransform();
@@ -78,7 +84,7 @@ void SegmentationCamera::InitGraphics()
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glCamera);
 
     unsigned int w, h;
-    getResolution(w, h);
+    getOutputResolution(w, h);
     displayData = new GLubyte[w*h*3];
 }
 
@@ -102,14 +108,17 @@ void SegmentationCamera::NewDataReady(void* data, unsigned int index)
         if(index == 0)
         {
             unsigned int w, h;
-            getResolution(w, h);
+            getOutputResolution(w, h);
             memcpy(displayData, data, w*h*3);
         }
         else
         {
-            segmentationData = (GLushort*)data;
-            newDataCallback(this);
-            segmentationData = nullptr;
+            DispatchNewData(data, getOutputDataSize(sizeof(GLushort)), [this](void* d)
+            {
+                segmentationData = (GLushort*)d;
+                newDataCallback(this);
+                segmentationData = nullptr;
+            });
         }
     }
 }
@@ -49,6 +49,7 @@ ThermalCamera::ThermalCamera(std::string uniqueName, unsigned int resolutionX, u
 
 ThermalCamera::~ThermalCamera()
 {
+    StopDispatch();
     glCamera = nullptr;
 }
 
@@ -62,6 +63,12 @@ void ThermalCamera::setNoise(GLfloat tempStdDev)
     }
 }
 
+void ThermalCamera::setOutputSettings(const CameraOutputSettings& settings)
+{
+    if(!settings.isPassThrough(resX, resY))
+        cWarning("Output stage not supported by thermal camera '%s' - using full images!", getName().c_str());
+}
+
 void ThermalCamera:: setDisplaySettings(ColorMap cm, Scalar minTemp, Scalar maxTemp)
 {
     colorMap = cm;
@@ -143,9 +150,12 @@ void ThermalCamera::NewDataReady(void* data, unsigned int index)
         }
         else
         {
-            temperatureData = (GLfloat*)data;
-            newDataCallback(this);
-            temperatureData = nullptr;
+            DispatchNewData(data, (size_t)resX * resY * sizeof(GLfloat), [this](void* d)
+            {
+                temperatureData = (GLfloat*)d;
+                newDataCallback(this);
+                temperatureData = nullptr;
+            });
         }
     }
 }
@@ -24,21 +24,20 @@
 //
 
 #include "utils/PerformanceMonitor.h"
-#include <numeric>
 
 namespace sf
 {
 
 PerformanceMonitor::PerformanceMonitor(size_t averageMaxCount)
 {
-    maxCount = averageMaxCount;
+    maxCount = averageMaxCount > 0 ? averageMaxCount : 1;
     
     simTime = 0;
     simFinished = true;
-    phyTime = std::deque<double>(0);
-    phyTimeAvg = 0;
-    hydroTime = std::deque<double>(0);
-    hydroTimeAvg = 0;
+    phyTime.samples.resize(maxCount);
+    hydroTime.samples.resize(maxCount);
+    Clear(phyTime);
+    Clear(hydroTime);
     updateMtx = SDL_CreateMutex();
 }
 
@@ -53,10 +52,8 @@ void PerformanceMonitor::SimulationStarted()
     simStart = std::chrono::high_resolution_clock::now();
     simTime = 0;
     simFinished = false;
-    phyTime.clear();
-    phyTimeAvg = 0;
-    hydroTime.clear();
-    hydroTimeAvg = 0;
+    Clear(phyTime);
+    Clear(hydroTime);
     SDL_UnlockMutex(updateMtx);
 }
 
@@ -76,7 +73,7 @@ void PerformanceMonitor::PhysicsStarted()
 
 void PerformanceMonitor::PhysicsFinished()
 {
-    Update(phyStart, phyTime, phyTimeAvg);
+    Update(phyStart, phyTime);
 }
 
 void PerformanceMonitor::HydrodynamicsStarted()
@@ -86,7 +83,7 @@ void PerformanceMonitor::HydrodynamicsStarted()
 
 void PerformanceMonitor::HydrodynamicsFinished()
 {
-    Update(hydroStart, hydroTime, hydroTimeAvg);
+    Update(hydroStart, hydroTime);
 }
 
 double PerformanceMonitor::getSimulationTime()
@@ -105,7 +102,7 @@ double PerformanceMonitor::getSimulationTime()
 double PerformanceMonitor::getPhysicsTime()
 {
     SDL_LockMutex(updateMtx);
-    double t = phyTime.back();
+    double t = getLast(phyTime);
     SDL_UnlockMutex(updateMtx);
     return t;
 }
@@ -113,7 +110,7 @@ double PerformanceMonitor::getPhysicsTime()
 double PerformanceMonitor::getPhysicsTimeAverage()
 {
     SDL_LockMutex(updateMtx);
-    double t = phyTimeAvg;
+    double t = phyTime.count > 0 ? phyTime.sum / (double)phyTime.count : 0.0;
     SDL_UnlockMutex(updateMtx);
     return t;
 }
@@ -121,7 +118,7 @@ double PerformanceMonitor::getPhysicsTimeAverage()
 double PerformanceMonitor::getHydrodynamicsTime()
 {
     SDL_LockMutex(updateMtx);
-    double t = hydroTime.back();
+    double t = getLast(hydroTime);
     SDL_UnlockMutex(updateMtx);
     return t;
 }
@@ -129,24 +126,40 @@ double PerformanceMonitor::getHydrodynamicsTime()
 double PerformanceMonitor::getHydrodynamicsTimeAverage()
 {
     SDL_LockMutex(updateMtx);
-    double t = hydroTimeAvg;
+    double t = hydroTime.count > 0 ? hydroTime.sum / (double)hydroTime.count : 0.0;
     SDL_UnlockMutex(updateMtx);
     return t;
 }
 
-void PerformanceMonitor::Update(const std::chrono::high_resolution_clock::time_point& start, std::deque<double>& times, double& average)
+void PerformanceMonitor::Update(const std::chrono::high_resolution_clock::time_point& start, History& h)
 {
     // Compute elapsed time
     auto end = std::chrono::high_resolution_clock::now();
-    SDL_LockMutex(updateMtx);
     double elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-    // Update averaging queue
-    times.push_back(elapsed);
-    if(times.size() > maxCount)
-        times.pop_front();
-    // Update average
-    average = std::accumulate(times.begin(), times.end(), 0.0) / (double)times.size();
+    // Never wait for the readers (the sample is dropped)
+    if(SDL_TryLockMutex(updateMtx) != 0)
+        return;
+    // Update ring buffer and sum (exact, samples are whole microseconds)
+    if(h.count == h.samples.size())
+        h.sum -= h.samples[h.next];
+    else
+        ++h.count;
+    h.samples[h.next] = elapsed;
+    h.sum += elapsed;
+    h.next = (h.next + 1) % h.samples.size();
     SDL_UnlockMutex(updateMtx);
 }
 
+void PerformanceMonitor::Clear(History& h)
+{
+    h.next = 0;
+    h.count = 0;
+    h.sum = 0.0;
+}
+
+double PerformanceMonitor::getLast(const History& h)
+{
+    return h.count > 0 ? h.samples[(h.next + h.samples.size() - 1) % h.samples.size()] : 0.0;
+}
+
 }
\ No newline at end of file
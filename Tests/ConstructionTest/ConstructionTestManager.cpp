@@ -0,0 +1,128 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ConstructionTestManager.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include "ConstructionTestManager.h"
+
+#include <entities/statics/Plane.h>
+#include <entities/solids/Sphere.h>
+#include <core/NameManager.h>
+#include <core/SimulationApp.h>
+#include <utils/UnitSystem.h>
+#include <utils/SystemUtil.hpp>
+#include <core/Console.h>
+#include <cmath>
+#include <unordered_set>
+
+ConstructionTestManager::ConstructionTestManager(sf::Scalar stepsPerSecond, size_t bodyCount, bool bulkInsert)
+    : SimulationManager(stepsPerSecond, sf::SolverType::SOLVER_SI, sf::CollisionFilteringType::COLLISION_EXCLUSIVE),
+      count(bodyCount), bulk(bulkInsert), passed(true)
+{
+}
+
+void ConstructionTestManager::Check(bool condition, const char* what)
+{
+    if(!condition)
+    {
+        cError("Check failed: %s", what);
+        passed = false;
+    }
+}
+
+bool ConstructionTestManager::hasPassed() const
+{
+    return passed;
+}
+
+void ConstructionTestManager::BuildScenario()
+{
+    CreateMaterial("Rock", sf::UnitSystem::Density(sf::CGS, sf::MKS, 3.0), 0.8);
+    SetMaterialsInteraction("Rock", "Rock", 0.9, 0.7);
+    
+    sf::Plane* plane = new sf::Plane("Bottom", 1000.0, "Rock");
+    AddStaticEntity(plane, sf::I4());
+    
+    //Create bodies with identical names to stress the name registry
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = true;
+    
+    size_t side = (size_t)ceil(sqrt((double)count));
+    std::vector<sf::Transform> origins;
+    solids.clear();
+    solids.reserve(count);
+    origins.reserve(count);
+    
+    int64_t t0 = sf::GetTimeInMicroseconds();
+    std::vector<std::string> names;
+    if(bulk)
+        names = getNameManager()->ReserveNames("Sphere", count); //All names registered in one pass
+    int64_t t1 = sf::GetTimeInMicroseconds();
+    for(size_t i=0; i<count; ++i)
+    {
+        solids.push_back(new sf::Sphere(bulk ? names[i] : "Sphere", phy, 0.1, sf::I4(), "Rock", ""));
+        origins.push_back(sf::Transform(sf::IQ(), sf::Vector3(sf::Scalar(i % side) * 0.5, sf::Scalar(i / side) * 0.5, -0.2)));
+    }
+    int64_t t2 = sf::GetTimeInMicroseconds();
+    
+    if(bulk)
+        AddSolidEntities(solids, origins);
+    else
+        for(size_t i=0; i<count; ++i)
+            AddSolidEntity(solids[i], origins[i]);
+    int64_t t3 = sf::GetTimeInMicroseconds();
+    
+    cInfo("Registered %zu names in %1.3lf ms.", bulk ? count : (size_t)0, (t1-t0)/1000.0);
+    cInfo("Created %zu bodies in %1.3lf ms.", count, (t2-t1)/1000.0);
+    cInfo("Inserted %zu bodies (%s) in %1.3lf ms.", count, bulk ? "bulk" : "one by one", (t3-t2)/1000.0);
+    
+    //Every body has a unique name (the reserved one, when reserved)
+    std::unordered_set<std::string> unique;
+    bool reservedKept = true;
+    for(size_t i=0; i<count; ++i)
+    {
+        unique.insert(solids[i]->getName());
+        if(bulk && solids[i]->getName() != names[i])
+            reservedKept = false;
+    }
+    Check(unique.size() == count, "names of the bodies are unique");
+    Check(reservedKept, "bodies use the reserved names");
+    Check(getDynamicsWorld()->getNumCollisionObjects() == (int)count + 1, "all bodies inserted into the world");
+}
+
+void ConstructionTestManager::SimulationStepCompleted(sf::Scalar timeStep)
+{
+    //The bodies rest on the plane (z axis points down), none of them fell through or was pushed away
+    bool resting = true;
+    for(size_t i=0; i<solids.size(); ++i)
+    {
+        sf::Scalar z = solids[i]->getCGTransform().getOrigin().getZ();
+        resting &= z < sf::Scalar(0) && z > sf::Scalar(-0.3);
+    }
+    Check(resting, "bodies rest on the plane after the first step");
+    
+    cInfo("First step completed at simulation time: %1.3lf", getSimulationTime());
+    cInfo("Construction test %s.", passed ? "passed" : "failed");
+    sf::SimulationApp::getApp()->Quit();
+}
@@ -0,0 +1,50 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ConstructionTestManager.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__ConstructionTestManager__
+#define __Stonefish__ConstructionTestManager__
+
+#include <core/SimulationManager.h>
+
+//Builds a scene with many identically named bodies and checks their names and placement
+class ConstructionTestManager : public sf::SimulationManager
+{
+public:
+    ConstructionTestManager(sf::Scalar stepsPerSecond, size_t bodyCount, bool bulkInsert);
+    
+    void BuildScenario();
+    void SimulationStepCompleted(sf::Scalar timeStep);
+    bool hasPassed() const;
+    
+private:
+    void Check(bool condition, const char* what);
+    
+    size_t count;
+    bool bulk;
+    bool passed;
+    std::vector<sf::SolidEntity*> solids;
+};
+
+#endif
@@ -0,0 +1,49 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  ConstructionTest
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include <core/ConsoleSimulationApp.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "ConstructionTestManager.h"
+
+//Usage: ConstructionTest [number of bodies = 10000] [single]
+int main(int argc, const char * argv[])
+{
+    size_t count = argc > 1 ? (size_t)std::strtoul(argv[1], nullptr, 10) : 10000;
+    bool bulk = !(argc > 2 && std::strcmp(argv[2], "single") == 0);
+    if(count == 0)
+    {
+        std::printf("Usage: ConstructionTest [number of bodies > 0] [single]\n");
+        return 1;
+    }
+    
+    sf::Scalar sps(100.0);
+    ConstructionTestManager* simulationManager = new ConstructionTestManager(sps, count, bulk);
+    sf::ConsoleSimulationApp app("ConstructionTest", std::string(DATA_DIR_PATH), simulationManager);
+    app.Run(true, true, sf::Scalar(1)/sps);
+    
+    return simulationManager->hasPassed() ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  DeterminismTestApp.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include "DeterminismTestApp.h"
+
+#include <omp.h>
+
+DeterminismTestApp::DeterminismTestApp(std::string dataDirPath, DeterminismTestManager* sim, int numThreads)
+    : ConsoleSimulationApp("DeterminismTest", dataDirPath, sim), threads(numThreads)
+{
+}
+
+void DeterminismTestApp::StepSimulation()
+{
+    //Called on the simulation thread, which sets its own default before the first step
+    omp_set_num_threads(threads);
+    ConsoleSimulationApp::StepSimulation();
+}
@@ -0,0 +1,148 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  DeterminismTestManager.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include "DeterminismTestManager.h"
+
+#include <entities/statics/Plane.h>
+#include <entities/solids/Sphere.h>
+#include <entities/solids/Polyhedron.h>
+#include <sensors/Sample.h>
+#include <sensors/scalar/IMU.h>
+#include <sensors/scalar/Pressure.h>
+#include <sensors/scalar/Odometry.h>
+#include <core/SimulationApp.h>
+#include <utils/SystemUtil.hpp>
+#include <core/Console.h>
+
+DeterminismTestManager::DeterminismTestManager(sf::Scalar stepsPerSecond, unsigned int stepCount)
+    : SimulationManager(stepsPerSecond, sf::SolverType::SOLVER_SI, sf::CollisionFilteringType::COLLISION_EXCLUSIVE),
+      steps(stepCount), step(0), stateHash(0), sensorHash(0)
+{
+    setRandomSeed(12345);
+}
+
+void DeterminismTestManager::BuildScenario()
+{
+    CreateMaterial("Neutral", 1000.0, 0.5);
+    CreateMaterial("Rock", 3000.0, 0.8);
+    SetMaterialsInteraction("Neutral", "Neutral", 0.5, 0.2);
+    SetMaterialsInteraction("Neutral", "Rock", 0.2, 0.1);
+    SetMaterialsInteraction("Rock", "Rock", 0.9, 0.7);
+    
+    EnableOcean(0.0);
+    
+    sf::Plane* seabed = new sf::Plane("Seabed", 1000.0, "Rock");
+    AddStaticEntity(seabed, sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, 5.0)));
+    
+    sf::BodyPhysicsSettings phy;
+    phy.collisions = true;
+    phy.buoyancy = true;
+    
+    //Tori with enough faces to split their fluid forces between the worker threads
+    phy.mode = sf::BodyPhysicsMode::SUBMERGED;
+    for(unsigned int i=0; i<4; ++i)
+    {
+        sf::Polyhedron* torus = new sf::Polyhedron("Torus", phy, sf::GetDataPath() + "torus_R=1_r=025.obj", 0.5, sf::I4(), "Neutral", "");
+        AddSolidEntity(torus, sf::Transform(sf::Quaternion(0.3 * i, 0.5, 0.2 * i), sf::Vector3(1.5 * i, 0.0, 2.0)));
+        
+        //Noisy sensors, each drawing from its own random stream
+        sf::IMU* imu = new sf::IMU("IMU" + std::to_string(i));
+        imu->setNoise(sf::Vector3(0.01, 0.01, 0.01), sf::Vector3(0.05, 0.05, 0.05), 0.001, sf::Vector3(0.1, 0.1, 0.1));
+        imu->AttachToSolid(torus, sf::I4());
+        AddSensor(imu);
+        noisySensors.push_back(imu);
+        
+        sf::Pressure* press = new sf::Pressure("Pressure" + std::to_string(i));
+        press->setNoise(100.0);
+        press->AttachToSolid(torus, sf::I4());
+        AddSensor(press);
+        noisySensors.push_back(press);
+    }
+    
+    phy.mode = sf::BodyPhysicsMode::FLOATING;
+    for(unsigned int i=0; i<2; ++i)
+    {
+        sf::Polyhedron* torus = new sf::Polyhedron("Floater", phy, sf::GetDataPath() + "torus_R=1_r=025.obj", 0.5, sf::I4(), "Neutral", "");
+        AddSolidEntity(torus, sf::Transform(sf::Quaternion(0.0, 0.2, 0.4 * i), sf::Vector3(1.5 * i, 3.0, -0.5)));
+        
+        sf::Odometry* odom = new sf::Odometry("Odometry" + std::to_string(i));
+        odom->setNoise(0.05, 0.01, 0.01, 0.01);
+        odom->AttachToSolid(torus, sf::I4());
+        AddSensor(odom);
+        noisySensors.push_back(odom);
+    }
+    
+    //Rocks falling on the seabed
+    for(unsigned int i=0; i<20; ++i)
+    {
+        sf::Sphere* rock = new sf::Sphere("Rock", phy, 0.1, sf::I4(), "Rock", "");
+        AddSolidEntity(rock, sf::Transform(sf::IQ(), sf::Vector3(-2.0 + 0.05 * (i % 4), 0.05 * (i / 4), 1.0 + 0.25 * i)));
+    }
+}
+
+uint64_t DeterminismTestManager::ComputeSensorHash() const
+{
+    uint64_t h = 14695981039346656037ull; //FNV-1a
+    for(size_t i=0; i<noisySensors.size(); ++i)
+    {
+        sf::Sample s = noisySensors[i]->getLastSample();
+        for(unsigned short k=0; k<noisySensors[i]->getNumOfChannels(); ++k)
+        {
+            sf::Scalar value = s.getValue(k);
+            const uint8_t* bytes = (const uint8_t*)&value;
+            for(size_t b=0; b<sizeof(sf::Scalar); ++b)
+            {
+                h ^= bytes[b];
+                h *= 1099511628211ull;
+            }
+        }
+    }
+    return h;
+}
+
+void DeterminismTestManager::SimulationStepCompleted(sf::Scalar timeStep)
+{
+    if(++step != steps)
+        return;
+    
+    stateHash = ComputeStateHash();
+    sensorHash = ComputeSensorHash();
+    sf::SimulationApp::getApp()->Quit();
+}
+
+bool DeterminismTestManager::isFinished() const
+{
+    return step >= steps;
+}
+
+uint64_t DeterminismTestManager::getStateHash() const
+{
+    return stateHash;
+}
+
+uint64_t DeterminismTestManager::getSensorHash() const
+{
+    return sensorHash;
+}
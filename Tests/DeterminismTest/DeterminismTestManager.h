@@ -0,0 +1,58 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  DeterminismTestManager.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__DeterminismTestManager__
+#define __Stonefish__DeterminismTestManager__
+
+#include <core/SimulationManager.h>
+
+namespace sf
+{
+    class ScalarSensor;
+}
+
+//Steps a scene with noisy sensors a fixed number of times and hashes the final state
+class DeterminismTestManager : public sf::SimulationManager
+{
+public:
+    DeterminismTestManager(sf::Scalar stepsPerSecond, unsigned int stepCount);
+    
+    void BuildScenario();
+    void SimulationStepCompleted(sf::Scalar timeStep);
+    bool isFinished() const;
+    uint64_t getStateHash() const;
+    uint64_t getSensorHash() const;
+    
+private:
+    uint64_t ComputeSensorHash() const;
+    
+    unsigned int steps;
+    unsigned int step;
+    uint64_t stateHash;
+    uint64_t sensorHash;
+    std::vector<sf::ScalarSensor*> noisySensors;
+};
+
+#endif
@@ -0,0 +1,70 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  DeterminismTest
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include "DeterminismTestApp.h"
+
+//Usage: DeterminismTest [number of steps = 1000]
+int main(int argc, const char * argv[])
+{
+    long steps = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 1000;
+    if(steps <= 0)
+    {
+        std::printf("Usage: DeterminismTest [number of steps > 0]\n");
+        return 1;
+    }
+    
+    //Each pass builds and runs the scene from scratch in its own application
+    const int threads[3] = {1, 2, 8};
+    uint64_t stateHashes[3];
+    uint64_t sensorHashes[3];
+    sf::Scalar sps(200.0);
+    for(unsigned int i=0; i<3; ++i)
+    {
+        DeterminismTestManager* simulationManager = new DeterminismTestManager(sps, (unsigned int)steps);
+        DeterminismTestApp app(std::string(DATA_DIR_PATH), simulationManager, threads[i]);
+        app.Run(true, true, sf::Scalar(1)/sps);
+        
+        if(!simulationManager->isFinished())
+        {
+            std::printf("Determinism test failed: the run with %d thread(s) ended early!\n", threads[i]);
+            return 1;
+        }
+        stateHashes[i] = simulationManager->getStateHash();
+        sensorHashes[i] = simulationManager->getSensorHash();
+        std::printf("%d thread(s): state hash = %016llx, sensor hash = %016llx\n", threads[i],
+                    (unsigned long long)stateHashes[i], (unsigned long long)sensorHashes[i]);
+    }
+    
+    bool identical = true;
+    for(unsigned int i=1; i<3; ++i)
+        identical &= stateHashes[i] == stateHashes[0] && sensorHashes[i] == sensorHashes[0];
+    if(identical)
+        std::printf("Determinism test passed: identical states and sensor readings for all thread counts.\n");
+    else
+        std::printf("Determinism test failed: results depend on the number of threads!\n");
+    return identical ? 0 : 1;
+}
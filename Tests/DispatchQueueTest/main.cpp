@@ -0,0 +1,212 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  DispatchQueueTest
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include <sensors/SensorDispatcher.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Checks ordering, copying, overflow policies and detaching of the sensor dispatch queues (no simulation needed)
+
+static bool passed = true;
+
+static void Check(bool condition, const char* what)
+{
+    if(!condition)
+    {
+        std::printf("Check failed: %s\n", what);
+        passed = false;
+    }
+}
+
+static bool WaitFor(const std::atomic<bool>& flag)
+{
+    for(int i=0; i<5000 && !flag.load(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return flag.load();
+}
+
+static bool WaitForDispatched(sf::SensorDispatcher& disp, sf::DispatchChannel* ch, uint64_t count)
+{
+    for(int i=0; i<5000 && disp.getStats(ch).dispatched < count; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return disp.getStats(ch).dispatched == count;
+}
+
+//A consumer whose first callback blocks until released, so that the following samples stay in the queue
+struct Consumer
+{
+    std::atomic<bool> started;
+    std::atomic<bool> release;
+    std::mutex mtx;
+    std::vector<int> received;
+    std::function<void(void*)> callback;
+    
+    Consumer() : started(false), release(false)
+    {
+        callback = [this](void* d)
+        {
+            started = true;
+            while(!release.load())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::lock_guard<std::mutex> lock(mtx);
+            received.push_back(*(int*)d);
+        };
+    }
+};
+
+static bool PushValue(sf::SensorDispatcher& disp, sf::DispatchChannel* ch, Consumer& c, int value)
+{
+    return disp.Push(ch, sf::DispatchSegment(&value, sizeof(int)), c.callback);
+}
+
+static void TestOverflow(sf::SensorDispatcher& disp, sf::QueueOverflowPolicy policy, const std::vector<int>& expected, const char* name)
+{
+    std::printf("Overflow policy: %s\n", name);
+    sf::DispatchChannel ch;
+    Consumer c;
+    disp.Attach(&ch, 2, policy);
+    
+    PushValue(disp, &ch, c, 0);
+    Check(WaitFor(c.started), "first callback started");
+    Check(PushValue(disp, &ch, c, 1), "sample 1 queued");
+    Check(PushValue(disp, &ch, c, 2), "sample 2 queued");
+    bool queued = PushValue(disp, &ch, c, 3);
+    Check(queued == (policy == sf::QueueOverflowPolicy::DROP_OLDEST), "sample pushed to a full queue accepted only when dropping the oldest");
+    sf::DispatchQueueStats stats = disp.getStats(&ch);
+    Check(stats.depth == 2 && stats.maxDepth == 2, "queue depth limited to its capacity");
+    Check(stats.dropped == 1, "one sample dropped");
+    
+    c.release = true;
+    Check(WaitForDispatched(disp, &ch, expected.size()), "all queued samples dispatched");
+    Check(c.received == expected, "samples dispatched in order, without the dropped one");
+    disp.Detach(&ch);
+}
+
+static void TestBlock(sf::SensorDispatcher& disp)
+{
+    std::printf("Overflow policy: block\n");
+    sf::DispatchChannel ch;
+    Consumer c;
+    disp.Attach(&ch, 1, sf::QueueOverflowPolicy::BLOCK);
+    
+    PushValue(disp, &ch, c, 0);
+    Check(WaitFor(c.started), "first callback started");
+    Check(PushValue(disp, &ch, c, 1), "sample 1 queued");
+    std::atomic<bool> returned(false);
+    bool queued = false;
+    std::thread producer([&]()
+    {
+        queued = PushValue(disp, &ch, c, 2);
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    Check(!returned.load(), "producer blocked on a full queue");
+    
+    c.release = true;
+    producer.join();
+    Check(queued, "blocked sample queued after space was freed");
+    Check(WaitForDispatched(disp, &ch, 3), "all samples dispatched");
+    Check(c.received == std::vector<int>({0, 1, 2}), "no sample dropped");
+    Check(disp.getStats(&ch).dropped == 0, "no drops counted");
+    disp.Detach(&ch);
+}
+
+static void TestSegments(sf::SensorDispatcher& disp)
+{
+    std::printf("Data segments\n");
+    sf::DispatchChannel ch;
+    disp.Attach(&ch, 4, sf::QueueOverflowPolicy::DROP_OLDEST);
+    
+    char a[4] = {'a', 'b', 'c', 'd'};
+    double b = 1.5;
+    std::atomic<bool> done(false);
+    bool correct = false;
+    sf::DispatchSegment segments[3];
+    segments[0] = sf::DispatchSegment(a, sizeof(a));
+    segments[1] = sf::DispatchSegment(nullptr, 16);
+    segments[2] = sf::DispatchSegment(&b, sizeof(b));
+    disp.Push(&ch, segments, 3, [&](const std::vector<void*>& d)
+    {
+        correct = d.size() == 3 && std::memcmp(d[0], "abcd", 4) == 0 && d[1] == nullptr && *(double*)d[2] == 1.5;
+        done = true;
+    });
+    a[0] = 'x'; //Sample is a copy
+    b = 0.0;
+    Check(WaitFor(done), "multi-segment callback executed");
+    Check(correct, "segments copied and exposed in order, missing segments as null");
+    disp.Detach(&ch);
+}
+
+static void TestDetach(sf::SensorDispatcher& disp)
+{
+    std::printf("Detach\n");
+    sf::DispatchChannel ch;
+    Consumer c;
+    disp.Attach(&ch, 4, sf::QueueOverflowPolicy::DROP_OLDEST);
+    PushValue(disp, &ch, c, 0);
+    Check(WaitFor(c.started), "first callback started");
+    PushValue(disp, &ch, c, 1);
+    PushValue(disp, &ch, c, 2);
+    
+    std::thread releaser([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        c.release = true;
+    });
+    disp.Detach(&ch);
+    bool finished;
+    {
+        std::lock_guard<std::mutex> lock(c.mtx);
+        finished = c.received.size() == 1;
+    }
+    releaser.join();
+    Check(finished, "detach waits for the running callback");
+    Check(ch.depth == 0 && !ch.attached, "waiting samples discarded");
+    Check(!PushValue(disp, &ch, c, 3), "detached channel rejects samples");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    Check(c.received == std::vector<int>({0}), "no callbacks after detaching");
+}
+
+//Usage: DispatchQueueTest [number of workers = 2]
+int main(int argc, const char * argv[])
+{
+    unsigned int workers = argc > 1 ? (unsigned int)std::atoi(argv[1]) : 2;
+    sf::SensorDispatcher disp(workers);
+    
+    TestOverflow(disp, sf::QueueOverflowPolicy::DROP_OLDEST, {0, 2, 3}, "drop oldest");
+    TestOverflow(disp, sf::QueueOverflowPolicy::DROP_NEWEST, {0, 1, 2}, "drop newest");
+    TestBlock(disp);
+    TestSegments(disp);
+    TestDetach(disp);
+    
+    std::printf("Dispatch queue test %s.\n", passed ? "passed" : "failed");
+    return passed ? 0 : 1;
+}
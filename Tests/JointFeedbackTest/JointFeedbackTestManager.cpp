@@ -0,0 +1,142 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  JointFeedbackTestManager.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include "JointFeedbackTestManager.h"
+
+#include <entities/solids/Box.h>
+#include <core/FeatherstoneRobot.h>
+#include <entities/FeatherstoneEntity.h>
+#include <sensors/scalar/ForceTorque.h>
+#include <core/SimulationApp.h>
+#include <utils/PerformanceMonitor.h>
+#include <core/Console.h>
+#include <cmath>
+
+static const unsigned int CHAIN_LINKS = 50;
+static const sf::Scalar LINK_LENGTH = 0.1;
+static const unsigned int WARMUP_STEPS = 100;
+static const unsigned int MEASURED_STEPS = 2000;
+static const sf::Scalar MAX_WEIGHT_ERROR = 0.02; //Relative to the weight of the chain
+
+JointFeedbackTestManager::JointFeedbackTestManager(sf::Scalar stepsPerSecond, unsigned int sensorCount, sf::Scalar sensorRate, bool allFeedback)
+    : SimulationManager(stepsPerSecond, sf::SolverType::SOLVER_SI, sf::CollisionFilteringType::COLLISION_EXCLUSIVE),
+      sensors(sensorCount), rate(sensorRate), baseline(allFeedback), passed(true), chain(nullptr), topSensor(nullptr), steps(0), physicsTime(0.0)
+{
+}
+
+void JointFeedbackTestManager::Check(bool condition, const char* what)
+{
+    if(!condition)
+    {
+        cError("Check failed: %s", what);
+        passed = false;
+    }
+}
+
+bool JointFeedbackTestManager::hasPassed() const
+{
+    return passed;
+}
+
+void JointFeedbackTestManager::BuildScenario()
+{
+    CreateMaterial("Steel", 7800.0, 0.5);
+    
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = false;
+    
+    //Chain hanging at rest from a fixed base (the cost of the articulated-body passes does not depend on the motion)
+    sf::Box* base = new sf::Box("Base", phy, sf::Vector3(0.05, 0.05, 0.05), sf::I4(), "Steel", "");
+    std::vector<sf::SolidEntity*> links;
+    for(unsigned int i=0; i<CHAIN_LINKS; ++i)
+        links.push_back(new sf::Box("Link" + std::to_string(i+1), phy, sf::Vector3(0.02, 0.02, LINK_LENGTH), 
+                                    sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, LINK_LENGTH/sf::Scalar(2))), "Steel", ""));
+    
+    chain = new sf::FeatherstoneRobot("Chain", true);
+    chain->DefineLinks(base, links);
+    chain->DefineRevoluteJoint("Joint1", "Base", "Link1", sf::I4(), sf::VY());
+    for(unsigned int i=1; i<CHAIN_LINKS; ++i)
+        chain->DefineRevoluteJoint("Joint" + std::to_string(i+1), "Link" + std::to_string(i), "Link" + std::to_string(i+1),
+                                   sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, LINK_LENGTH)), sf::VY());
+    chain->BuildKinematicStructure();
+    
+    //Sensors spread evenly along the chain
+    for(unsigned int i=0; i<sensors; ++i)
+    {
+        unsigned int joint = sensors > 1 ? i * (CHAIN_LINKS-1)/(sensors-1) : 0;
+        sf::ForceTorque* ft = new sf::ForceTorque("FT" + std::to_string(i+1), sf::I4(), rate, 1);
+        chain->AddJointSensor(ft, "Joint" + std::to_string(joint+1));
+        if(joint == 0)
+            topSensor = ft;
+    }
+    
+    AddRobot(chain, sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, -10.0)));
+    
+    if(baseline)
+        for(unsigned int i=0; i<CHAIN_LINKS; ++i)
+            chain->getDynamics()->setJointFeedbackEnabled(i, true);
+}
+
+void JointFeedbackTestManager::SimulationStepCompleted(sf::Scalar timeStep)
+{
+    ++steps;
+    if(steps <= WARMUP_STEPS)
+        return;
+    physicsTime += getPerformanceMonitor().getPhysicsTime();
+    
+    if(steps == WARMUP_STEPS + MEASURED_STEPS)
+    {
+        std::string sampling = rate > sf::Scalar(0) ? "at " + std::to_string((int)rate) + " Hz" : "every step";
+        cInfo("Joint feedback test: %u links, %u force-torque sensors sampled %s, %s.", CHAIN_LINKS, sensors, sampling.c_str(), 
+              baseline ? "feedback of all joints computed every step" : "feedback computed on demand");
+        cInfo("Average physics step time: %1.2lf us (%u steps at %1.0lf Hz).", physicsTime/(double)MEASURED_STEPS, MEASURED_STEPS, getStepsPerSecond());
+        
+        //The top joint carries the weight of the whole chain
+        sf::FeatherstoneEntity* fe = chain->getDynamics();
+        sf::Scalar weight(0);
+        for(unsigned int i=1; i<fe->getNumOfLinks(); ++i)
+            weight += fe->getLink(i).solid->getMass();
+        weight *= getGravity().length();
+        
+        if(topSensor != nullptr)
+        {
+            sf::Sample s = topSensor->getLastSample();
+            sf::Scalar force = sf::Vector3(s.getValue(0), s.getValue(1), s.getValue(2)).length();
+            cInfo("Top sensor force: %1.3lf N (chain weight %1.3lf N).", force, weight);
+            Check(fabs(force - weight) < MAX_WEIGHT_ERROR * weight, "top force-torque sensor measures the weight of the chain");
+        }
+        if(baseline)
+        {
+            sf::Vector3 force, torque;
+            fe->getJointFeedback(0, force, torque);
+            cInfo("Top joint feedback: %1.3lf N.", force.length());
+            Check(fabs(force.length() - weight) < MAX_WEIGHT_ERROR * weight, "feedback of the top joint equals the weight of the chain");
+        }
+        cInfo("Joint feedback test %s.", passed ? "passed" : "failed");
+        sf::SimulationApp::getApp()->Quit();
+    }
+}
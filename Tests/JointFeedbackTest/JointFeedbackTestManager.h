@@ -0,0 +1,63 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  JointFeedbackTestManager.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__JointFeedbackTestManager__
+#define __Stonefish__JointFeedbackTestManager__
+
+#include <core/SimulationManager.h>
+
+namespace sf
+{
+    class FeatherstoneRobot;
+    class ForceTorque;
+}
+
+//Measures the step time of a long multibody chain with force-torque sensors on its joints,
+//optionally with the feedback of all joints computed in every step (behaviour before on-demand feedback),
+//and checks that the reaction at the top joint carries the weight of the chain
+class JointFeedbackTestManager : public sf::SimulationManager
+{
+public:
+    JointFeedbackTestManager(sf::Scalar stepsPerSecond, unsigned int sensorCount, sf::Scalar sensorRate, bool allFeedback);
+    
+    void BuildScenario();
+    void SimulationStepCompleted(sf::Scalar timeStep);
+    bool hasPassed() const;
+    
+private:
+    void Check(bool condition, const char* what);
+    
+    unsigned int sensors;
+    sf::Scalar rate;
+    bool baseline;
+    bool passed;
+    sf::FeatherstoneRobot* chain;
+    sf::ForceTorque* topSensor;
+    unsigned int steps;
+    double physicsTime;
+};
+
+#endif
@@ -0,0 +1,52 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  main.cpp
+//  JointFeedbackTest
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include <core/ConsoleSimulationApp.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "JointFeedbackTestManager.h"
+
+//Usage: JointFeedbackTest [number of force-torque sensors = 0] [sensor rate = -1 (every step)] [baseline]
+//("baseline" computes the feedback of all joints in every step, as before feedback was computed on demand)
+int main(int argc, const char * argv[])
+{
+    long sensors = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+    double rate = argc > 2 ? std::strtod(argv[2], nullptr) : -1.0;
+    bool baseline = argc > 3 && std::strcmp(argv[3], "baseline") == 0;
+    if(sensors < 0 || sensors > 50)
+    {
+        std::printf("Usage: JointFeedbackTest [number of force-torque sensors = 0..50] [sensor rate = -1 (every step)] [baseline]\n");
+        return 1;
+    }
+    
+    sf::Scalar sps(1000.0);
+    JointFeedbackTestManager* simulationManager = new JointFeedbackTestManager(sps, (unsigned int)sensors, rate, baseline);
+    sf::ConsoleSimulationApp app("JointFeedbackTest", std::string(DATA_DIR_PATH), simulationManager);
+    app.Run(true, true, sf::Scalar(1)/sps);
+    
+    return simulationManager->hasPassed() ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  MotorTestManager.cpp
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include "MotorTestManager.h"
+
+#include <entities/solids/Sphere.h>
+#include <joints/RevoluteJoint.h>
+#include <actuators/DCMotor.h>
+#include <core/SimulationApp.h>
+#include <core/Console.h>
+#include <cmath>
+
+//Motor parameters (electrical time constant of 1 ms)
+static const sf::Scalar MOTOR_R = 1.0;
+static const sf::Scalar MOTOR_L = 0.001;
+static const sf::Scalar MOTOR_KE = 0.01;
+static const sf::Scalar MOTOR_KT = 0.0955;
+static const sf::Scalar MOTOR_B = 1e-5;
+static const sf::Scalar MOTOR_V = 12.0;
+static const sf::Scalar TEST_DURATION = 2.0;
+static const unsigned int REFERENCE_SUBSTEPS = 1000;
+
+//Error limits, relative to the final reference joint velocity
+static const sf::Scalar MAX_FINAL_ERROR = 0.005; //Steady state
+static const sf::Scalar MAX_TRANSIENT_ERROR = 0.15; //Whole run, including the start-up
+
+MotorTestManager::MotorTestManager(sf::Scalar stepsPerSecond, bool implicitCoupling)
+    : SimulationManager(stepsPerSecond, sf::SolverType::SOLVER_SI, sf::CollisionFilteringType::COLLISION_EXCLUSIVE),
+      implicit(implicitCoupling), passed(true)
+{
+}
+
+void MotorTestManager::Check(bool condition, const char* what)
+{
+    if(!condition)
+    {
+        cError("Check failed: %s", what);
+        passed = false;
+    }
+}
+
+bool MotorTestManager::hasPassed() const
+{
+    return passed;
+}
+
+void MotorTestManager::BuildScenario()
+{
+    CreateMaterial("Steel", 7800.0, 0.5);
+    
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = false;
+    
+    //Wheels spinning about their centres, so that gravity does not load the motors
+    const sf::Scalar ratios[4] = {1.0, 10.0, 30.0, 100.0};
+    for(unsigned int i=0; i<4; ++i)
+    {
+        sf::Vector3 centre(0.0, sf::Scalar(i), -1.0);
+        sf::Sphere* wheel = new sf::Sphere("Wheel", phy, 0.1, sf::I4(), "Steel", "");
+        AddSolidEntity(wheel, sf::Transform(sf::IQ(), centre));
+        
+        sf::RevoluteJoint* joint = new sf::RevoluteJoint("Axle", wheel, centre, sf::VX());
+        AddJoint(joint);
+        
+        sf::DCMotor* motor = new sf::DCMotor("Motor", MOTOR_R, MOTOR_L, MOTOR_KE, MOTOR_KT, MOTOR_B);
+        motor->SetupGearbox(true, ratios[i], 1.0);
+        motor->setImplicitCoupling(implicit);
+        motor->AttachToJoint(joint);
+        motor->setIntensity(MOTOR_V);
+        AddActuator(motor);
+        
+        MotorCase c;
+        c.motor = motor;
+        c.joint = joint;
+        c.ratio = ratios[i];
+        c.J = wheel->getInertia().x();
+        c.I = sf::Scalar(0);
+        c.w = sf::Scalar(0);
+        c.maxError = sf::Scalar(0);
+        cases.push_back(c);
+    }
+}
+
+void MotorTestManager::StepReference(MotorCase& c, sf::Scalar dt)
+{
+    //RK4 integration of the coupled armature circuit and wheel dynamics
+    sf::Scalar KeRad = MOTOR_KE * sf::Scalar(9.5493);
+    auto f = [&](sf::Scalar I, sf::Scalar w, sf::Scalar& dI, sf::Scalar& dw)
+    {
+        sf::Scalar wm = w * c.ratio;
+        dI = (MOTOR_V - KeRad * wm - MOTOR_R * I)/MOTOR_L;
+        dw = (MOTOR_KT * I - MOTOR_B * wm) * c.ratio / c.J;
+    };
+    
+    sf::Scalar h = dt/sf::Scalar(REFERENCE_SUBSTEPS);
+    for(unsigned int i=0; i<REFERENCE_SUBSTEPS; ++i)
+    {
+        sf::Scalar dI1, dw1, dI2, dw2, dI3, dw3, dI4, dw4;
+        f(c.I, c.w, dI1, dw1);
+        f(c.I + sf::Scalar(0.5)*h*dI1, c.w + sf::Scalar(0.5)*h*dw1, dI2, dw2);
+        f(c.I + sf::Scalar(0.5)*h*dI2, c.w + sf::Scalar(0.5)*h*dw2, dI3, dw3);
+        f(c.I + h*dI3, c.w + h*dw3, dI4, dw4);
+        c.I += h/sf::Scalar(6) * (dI1 + sf::Scalar(2)*dI2 + sf::Scalar(2)*dI3 + dI4);
+        c.w += h/sf::Scalar(6) * (dw1 + sf::Scalar(2)*dw2 + sf::Scalar(2)*dw3 + dw4);
+    }
+}
+
+void MotorTestManager::SimulationStepCompleted(sf::Scalar timeStep)
+{
+    for(size_t i=0; i<cases.size(); ++i)
+    {
+        StepReference(cases[i], timeStep);
+        sf::Scalar error = fabs(cases[i].joint->getAngularVelocity() - cases[i].w);
+        cases[i].maxError = error > cases[i].maxError ? error : cases[i].maxError;
+    }
+    
+    if(getSimulationTime() >= TEST_DURATION)
+    {
+        cInfo("DC motor test at %1.0lf Hz (%s coupling):", getStepsPerSecond(), implicit ? "implicit" : "explicit");
+        for(size_t i=0; i<cases.size(); ++i)
+        {
+            sf::Scalar w = cases[i].joint->getAngularVelocity();
+            sf::Scalar finalError = fabs(w - cases[i].w)/fabs(cases[i].w);
+            sf::Scalar maxError = cases[i].maxError/fabs(cases[i].w);
+            cInfo("Gear ratio %1.1lf: joint velocity %1.4lf rad/s (reference %1.4lf rad/s), final error %1.3lf%%, max error %1.4lf rad/s (%1.3lf%%).", 
+                  cases[i].ratio, w, cases[i].w, finalError * 100.0, cases[i].maxError, maxError * 100.0);
+            Check(std::isfinite(w) && finalError < MAX_FINAL_ERROR, "final joint velocity matches the reference");
+            Check(maxError < MAX_TRANSIENT_ERROR, "joint velocity error stays within the limit during the run");
+        }
+        cInfo("DC motor test %s.", passed ? "passed" : "failed");
+        sf::SimulationApp::getApp()->Quit();
+    }
+}
@@ -0,0 +1,67 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  MotorTestManager.h
+//  Stonefish
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__MotorTestManager__
+#define __Stonefish__MotorTestManager__
+
+#include <core/SimulationManager.h>
+
+namespace sf
+{
+    class DCMotor;
+    class RevoluteJoint;
+}
+
+//Compares DC motors driving free wheels with a finely sub-stepped reference solution
+class MotorTestManager : public sf::SimulationManager
+{
+public:
+    MotorTestManager(sf::Scalar stepsPerSecond, bool implicitCoupling);
+    
+    void BuildScenario();
+    void SimulationStepCompleted(sf::Scalar timeStep);
+    bool hasPassed() const;
+    
+private:
+    struct MotorCase
+    {
+        sf::DCMotor* motor;
+        sf::RevoluteJoint* joint;
+        sf::Scalar ratio;
+        sf::Scalar J; //Inertia of the wheel [kg m^2]
+        sf::Scalar I; //Reference current [A]
+        sf::Scalar w; //Reference joint velocity [rad/s]
+        sf::Scalar maxError; //Maximum joint velocity error [rad/s]
+    };
+    
+    void StepReference(MotorCase& c, sf::Scalar dt);
+    void Check(bool condition, const char* what);
+    
+    bool implicit;
+    bool passed;
+    std::vector<MotorCase> cases;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  MotorTest
+//
+//  Created by agent on 18/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include <core/ConsoleSimulationApp.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "MotorTestManager.h"
+
+//Usage: MotorTest [steps per second = 1000] [explicit]
+int main(int argc, const char * argv[])
+{
+    double sps = argc > 1 ? std::strtod(argv[1], nullptr) : 1000.0;
+    bool implicit = !(argc > 2 && std::strcmp(argv[2], "explicit") == 0);
+    if(sps <= 0.0)
+    {
+        std::printf("Usage: MotorTest [steps per second > 0] [explicit]\n");
+        return 1;
+    }
+    
+    MotorTestManager* simulationManager = new MotorTestManager(sps, implicit);
+    sf::ConsoleSimulationApp app("MotorTest", std::string(DATA_DIR_PATH), simulationManager);
+    app.Run(true, true, sf::Scalar(1)/sps);
+    
+    return simulationManager->hasPassed() ? 0 : 1;
+}